@@ -1,14 +1,44 @@
-#version 330 core
+#version 460 core
 
+// The atlas holds signed distance fields: 0.5 on the outline, more inside,
+// less outside. The coordinates arrive in texels — the atlas grows in height,
+// and a placed glyph keeps its texels where its normalised coordinates would
+// shift. fwidth says how much distance one screen pixel spans, so the edge
+// ramps over exactly one pixel at any zoom and export resolution.
+//
+// The colour is the vertex colour tinted by the draw's colour: a FontShape
+// passes white vertices and its colour in the draw record, a text batch the
+// colour of each label in its vertices and white in the record.
 in vec2 vertex_texture_coord;
+in vec4 vertex_color;
 
 uniform sampler2D texture_sampler;
-uniform vec4 texture_color;
+
+// The frame's per-draw inputs, one per draw (DrawRecord in
+// frame_uniforms.hpp); draw_index picks this draw's.
+struct DrawRecord
+{
+	mat4 model;
+	vec4 color;
+	vec4 outline_color;
+	vec4 pattern;
+};
+
+layout(std430, binding = 1) readonly buffer DrawRecords
+{
+	DrawRecord draws[];
+};
+
+layout(location = 0) uniform uint draw_index;
 
 out vec4 color;
 
 void main()
 {
-    vec4 sampled = vec4(1.0, 1.0, 1.0, texture(texture_sampler, vertex_texture_coord).r);
-	color = texture_color * sampled;
+	vec2 atlas_size = vec2(textureSize(texture_sampler, 0));
+	float distance = texture(texture_sampler, vertex_texture_coord / atlas_size).r - 0.5;
+	float pixel = max(fwidth(distance), 1.0e-5);
+	float coverage = clamp(distance / pixel + 0.5, 0.0, 1.0);
+	vec4 tint = draws[draw_index].color * vertex_color;
+	color = vec4(tint.rgb, tint.a * coverage);
 }
@@ -1,16 +1,39 @@
-#version 330 core
+#version 460 core
 
 layout(location = 0) in vec3 position;
 layout(location = 1) in vec2 texture_coord;
+layout(location = 2) in vec4 color;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+// Projection and view, written once per frame (FrameUniforms).
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 projection;
+	mat4 view;
+};
+
+// The frame's per-draw inputs, one per draw (DrawRecord in
+// frame_uniforms.hpp); draw_index picks this draw's.
+struct DrawRecord
+{
+	mat4 model;
+	vec4 color;
+	vec4 outline_color;
+	vec4 pattern;
+};
+
+layout(std430, binding = 1) readonly buffer DrawRecords
+{
+	DrawRecord draws[];
+};
+
+layout(location = 0) uniform uint draw_index;
 
 out vec2 vertex_texture_coord;
+out vec4 vertex_color;
 
 void main()
 {
-	gl_Position = projection * view * model * vec4(position, 1.0);
+	gl_Position = projection * view * draws[draw_index].model * vec4(position, 1.0);
 	vertex_texture_coord = texture_coord;
+	vertex_color = color;
 }
@@ -0,0 +1,92 @@
+#version 460 core
+
+// grid_pattern::SampleColor (src/infrastructure/graphics/grid_pattern.cpp),
+// line by line: the colour the selected cells of one row leave here, their
+// fills and outlines composited in cell order.
+
+// The frame's per-draw inputs, one per draw (DrawRecord in
+// frame_uniforms.hpp); draw_index picks this draw's.
+struct DrawRecord
+{
+	mat4 model;
+	vec4 color;
+	vec4 outline_color;
+	vec4 pattern;
+};
+
+layout(std430, binding = 1) readonly buffer DrawRecords
+{
+	DrawRecord draws[];
+};
+
+layout(location = 0) uniform uint draw_index;
+
+sample in vec2 local_position;
+flat in vec4 row_edges;
+flat in float row_phase;
+
+out vec4 fragment_color;
+
+vec4 Composite(vec4 under, vec4 over)
+{
+	float alpha = over.a + under.a * (1.0 - over.a);
+	if (alpha <= 0.0)
+	{
+		return vec4(0.0);
+	}
+	vec3 premultiplied = over.rgb * over.a + under.rgb * under.a * (1.0 - over.a);
+	return vec4(premultiplied / alpha, alpha);
+}
+
+// The pattern: cell width, period, 1 to draw the cells at phase + k * period
+// or 0 for all others, line width.
+bool IsDrawn(int cell, vec4 pattern)
+{
+	int cycle = int(pattern.y);
+	int remainder = ((cell - int(row_phase)) % cycle + cycle) % cycle;
+	return (remainder == 0) == (pattern.z == 1.0);
+}
+
+void main()
+{
+	DrawRecord draw = draws[draw_index];
+	float cell_width = draw.pattern.x;
+	float half_line = draw.pattern.w * 0.5;
+	float left = row_edges.x;
+	float bottom = row_edges.z;
+	float top = row_edges.w;
+	vec2 point = local_position;
+
+	if (point.y < bottom - half_line || point.y >= top + half_line)
+	{
+		discard;
+	}
+	bool inside_vertically = point.y >= bottom + half_line && point.y < top - half_line;
+
+	int first = int(floor((point.x - left - half_line) / cell_width)) - 1;
+	int last = int(floor((point.x - left + half_line) / cell_width)) + 1;
+	int count = int(round((row_edges.y - left) / cell_width));
+
+	vec4 color = vec4(0.0);
+	for (int cell = first; cell <= last; ++cell)
+	{
+		if (cell < 0 || cell >= count || !IsDrawn(cell, draw.pattern))
+		{
+			continue;
+		}
+		float cell_left = left + float(cell) * cell_width;
+		float cell_right = cell_left + cell_width;
+		if (point.x < cell_left - half_line || point.x >= cell_right + half_line)
+		{
+			continue;
+		}
+		bool inside = inside_vertically && point.x >= cell_left + half_line && point.x < cell_right - half_line;
+		color = Composite(color, inside ? draw.color : draw.outline_color);
+	}
+
+	if (color.a <= 0.0)
+	{
+		discard;
+	}
+	fragment_color = color;
+}
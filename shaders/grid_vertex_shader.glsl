@@ -0,0 +1,54 @@
+#version 460 core
+
+// One record per row of cells, advanced per instance: the row's edges (left,
+// right, bottom, top) and the index of its first on-phase cell. The row
+// becomes one quad, grown by half the line width so it covers the outlines
+// straddling its edges; the cells get painted by the fragment shader.
+layout(location = 0) in vec4 edges;
+layout(location = 1) in float phase;
+
+// Projection and view, written once per frame (FrameUniforms).
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 projection;
+	mat4 view;
+};
+
+// The frame's per-draw inputs, one per draw (DrawRecord in
+// frame_uniforms.hpp); draw_index picks this draw's.
+struct DrawRecord
+{
+	mat4 model;
+	vec4 color;
+	vec4 outline_color;
+	vec4 pattern;
+};
+
+layout(std430, binding = 1) readonly buffer DrawRecords
+{
+	DrawRecord draws[];
+};
+
+layout(location = 0) uniform uint draw_index;
+
+// `sample` makes the position interpolate at each multisample position and
+// the fragment shader run per sample, so the cell edges get the coverage a
+// triangle edge would get under MSAA.
+sample out vec2 local_position;
+flat out vec4 row_edges;
+flat out float row_phase;
+
+const int kQuadVertexCorner[6] = int[6](0, 1, 2, 3, 2, 1);
+
+void main()
+{
+	int corner = kQuadVertexCorner[gl_VertexID % 6];
+	float half_line = draws[draw_index].pattern.w * 0.5;
+	float x = (corner & 1) == 0 ? edges.x - half_line : edges.y + half_line;
+	float y = (corner >> 1) == 0 ? edges.z - half_line : edges.w + half_line;
+
+	local_position = vec2(x, y);
+	row_edges = edges;
+	row_phase = phase;
+	gl_Position = projection * view * draws[draw_index].model * vec4(x, y, 0.0, 1.0);
+}
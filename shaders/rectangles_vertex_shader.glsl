@@ -1,12 +1,70 @@
 #version 460 core
 
-layout(location = 0) in vec3 position;
+// One record per rectangle, advanced per instance: the edges (left, right,
+// bottom, top), the outline width and the two colours. The thirty vertices of
+// the fill and the four outline strips get made here out of gl_VertexID.
+layout(location = 0) in vec4 edges;
+layout(location = 1) in float line_width;
+layout(location = 2) in vec4 outline_color;
+layout(location = 3) in vec4 fill_color;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+// Projection and view, written once per frame (FrameUniforms).
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 projection;
+	mat4 view;
+};
+
+// The frame's per-draw inputs, one per draw (DrawRecord in
+// frame_uniforms.hpp); draw_index picks this draw's.
+struct DrawRecord
+{
+	mat4 model;
+	vec4 color;
+	vec4 outline_color;
+	vec4 pattern;
+};
+
+layout(std430, binding = 1) readonly buffer DrawRecords
+{
+	DrawRecord draws[];
+};
+
+layout(location = 0) uniform uint draw_index;
+
+flat out vec4 vertex_color;
+
+// The four x and four y positions a rectangle's geometry uses, outside in:
+// outer edge, inner edge, inner edge, outer edge. The outline straddles each
+// edge by half its width.
+//
+// Per quad the four corners as (x, y) indices into those: the fill, then the
+// top, bottom, left and right outline strip. The strips meet diagonally in the
+// corners, so the outline comes out mitred.
+const ivec2 kCorners[20] = ivec2[20](
+	ivec2(1, 1), ivec2(2, 1), ivec2(1, 2), ivec2(2, 2),
+	ivec2(1, 2), ivec2(2, 2), ivec2(0, 3), ivec2(3, 3),
+	ivec2(0, 0), ivec2(3, 0), ivec2(1, 1), ivec2(2, 1),
+	ivec2(0, 0), ivec2(1, 1), ivec2(0, 3), ivec2(1, 2),
+	ivec2(2, 1), ivec2(3, 0), ivec2(2, 2), ivec2(3, 3));
+
+// Two triangles per quad out of its four corners: 0 1 2 and 3 2 1, both
+// counter-clockwise.
+const int kQuadVertexCorner[6] = int[6](0, 1, 2, 3, 2, 1);
 
 void main()
 {
-	gl_Position = projection * view * model * vec4(position, 1.0);
+	int quad = gl_VertexID / 6;
+	int corner = kQuadVertexCorner[gl_VertexID % 6];
+	ivec2 edge_index = kCorners[quad * 4 + corner];
+
+	float half_line = line_width * 0.5;
+	float xs[4] = float[4](edges.x - half_line, edges.x + half_line,
+	                       edges.y - half_line, edges.y + half_line);
+	float ys[4] = float[4](edges.z - half_line, edges.z + half_line,
+	                       edges.w - half_line, edges.w + half_line);
+
+	vec3 position = vec3(xs[edge_index.x], ys[edge_index.y], 0.0);
+	gl_Position = projection * view * draws[draw_index].model * vec4(position, 1.0);
+	vertex_color = quad == 0 ? fill_color : outline_color;
 }
@@ -1,10 +1,25 @@
 #version 460 core
 
-uniform vec4 color;
+// The frame's per-draw inputs, one per draw (DrawRecord in
+// frame_uniforms.hpp); draw_index picks this draw's.
+struct DrawRecord
+{
+	mat4 model;
+	vec4 color;
+	vec4 outline_color;
+	vec4 pattern;
+};
+
+layout(std430, binding = 1) readonly buffer DrawRecords
+{
+	DrawRecord draws[];
+};
+
+layout(location = 0) uniform uint draw_index;
 
 out vec4 fragment_color;
 
 void main()
 {
-	fragment_color = color;
+	fragment_color = draws[draw_index].color;
 }
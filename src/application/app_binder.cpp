@@ -10,6 +10,7 @@
 #include "../domain/shape_configuration_store.hpp"
 #include "../domain/state_topics.hpp"
 #include "../domain/text_edit_buffer.hpp"
+#include "../domain/title_config.hpp"
 #include "../domain/title_config_store.hpp"
 #include "../domain/transform_date_entry.hpp"
 #include "../infrastructure/graphics/pick_id.hpp"
@@ -19,6 +20,7 @@
 #include "../presentation/font_panel.hpp"
 #include "../presentation/gl_canvas.hpp"
 #include "../presentation/groups_panel.hpp"
+#include "../presentation/headless_canvas.hpp"
 #include "../presentation/page_panel.hpp"
 #include "../presentation/scene_tree_panel.hpp"
 #include "../presentation/shape_panel.hpp"
@@ -249,6 +251,7 @@ void BindInteraction(QObject& scope, EventBus& bus,
       [editor]() { return editor->IsEditing(); });
   components.gl_canvas.SetSelectedTextSource(
       [editor]() { return editor->SelectedText(); });
+  components.gl_canvas.SetExportPreparation([page]() { page->FinishGlyphs(); });
 
   Connect(scope, bus.hovered, &application::HoveredTopic::Published,
           components.calendar_page, &CalendarPage::ReceiveHovered);
@@ -258,6 +261,42 @@ void BindInteraction(QObject& scope, EventBus& bus,
           components.calendar_page, &CalendarPage::ReceiveTextEdit);
 }
 
+// The page-side half of BindDateEntries, BindDateGroups and the rest, for a
+// run with no panels. The order within each topic is theirs: the shape
+// configurations still come out of the palette before the scene rebuild that
+// reads them.
+void BindHeadlessTopics(QObject& scope, EventBus& bus,
+                        const HeadlessComponents& components) {
+  Connect(scope, bus.date_entries, &domain::DateEntriesTopic::Published,
+          components.transform_date_entry,
+          &TransformDateEntry::ReceiveDateEntries);
+  Connect(scope, bus.transformed_date_entries,
+          &domain::DateEntriesTopic::Published, components.calendar_page,
+          &CalendarPage::ReceiveDateEntries);
+
+  Connect(scope, bus.date_groups, &domain::DateGroupsTopic::Published,
+          components.date_entry_store, &DateEntryStore::ReceiveDateGroups);
+  Connect(scope, bus.date_groups, &domain::DateGroupsTopic::Published,
+          components.shape_configuration_store,
+          &ShapeConfigurationStore::ReceiveDateGroups);
+  Connect(scope, bus.date_groups, &domain::DateGroupsTopic::Published,
+          components.calendar_page, &CalendarPage::ReceiveDateGroups);
+
+  Connect(scope, bus.page_setup, &domain::PageSetupTopic::Published,
+          components.calendar_page, &CalendarPage::ReceivePageSetup);
+  Connect(scope, bus.page_setup, &domain::PageSetupTopic::Published,
+          components.headless_canvas, &HeadlessCanvas::ReceivePageSetup);
+
+  Connect(scope, bus.title_config, &domain::TitleConfigTopic::Published,
+          components.calendar_page, &CalendarPage::ReceiveTitleConfig);
+  Connect(scope, bus.state_burst, &domain::StateBurstTopic::Published,
+          components.calendar_page, &CalendarPage::ReceiveStateBurst);
+  Connect(scope, bus.shape_config_set, &domain::ShapeConfigSetTopic::Published,
+          components.calendar_page, &CalendarPage::ReceiveShapeConfigSet);
+  Connect(scope, bus.calendar_config, &domain::CalendarConfigTopic::Published,
+          components.calendar_page, &CalendarPage::ReceiveCalendarConfig);
+}
+
 }  // namespace
 
 void Bind(QObject& scope, EventBus& bus, const AppComponents& components) {
@@ -281,6 +320,7 @@ void ReleaseCallbacks(const CallbackTargets& targets) {
   targets.gl_canvas.SetTextInputCallback(nullptr);
   targets.gl_canvas.SetEditingQuery(nullptr);
   targets.gl_canvas.SetSelectedTextSource(nullptr);
+  targets.gl_canvas.SetExportPreparation(nullptr);
   targets.interaction_controller.SetPickSource(nullptr);
   targets.interaction_controller.SetPathSource(nullptr);
   targets.title_text_editor.SetPickSource(nullptr);
@@ -297,6 +337,25 @@ void SendInitialValues(EventBus& bus, const AppComponents& components) {
   components.calendar_configuration_store.SendCalendarConfig();
 }
 
+void BindHeadless(QObject& scope, EventBus& bus,
+                  const HeadlessComponents& components) {
+  BindHeadlessTopics(scope, bus, components);
+  auto* page = &components.calendar_page;
+  components.headless_canvas.SetExportPreparation(
+      [page]() { page->FinishGlyphs(); });
+}
+
+void SendHeadlessInitialValues(EventBus& bus,
+                               const HeadlessComponents& components) {
+  const application::StateBurst burst(bus.state_burst);
+  components.shape_configuration_store.SendShapeConfigSet();
+  components.date_groups_store.SendDefaultValues();
+  components.page_setup_store.ReceivePageSetup(
+      PageSetupPanel::DefaultPageSetup());
+  components.title_config_store.ReceiveTitleConfig(TitleConfig{});
+  components.calendar_configuration_store.SendCalendarConfig();
+}
+
 }  // namespace app_binder
 
 AppWiring::AppWiring(EventBus& bus, const AppComponents& components)
@@ -310,3 +369,14 @@ AppWiring::AppWiring(EventBus& bus, const AppComponents& components)
 }
 
 AppWiring::~AppWiring() { app_binder::ReleaseCallbacks(callback_targets_); }
+
+HeadlessWiring::HeadlessWiring(EventBus& bus,
+                               const HeadlessComponents& components)
+    : headless_canvas_(components.headless_canvas) {
+  app_binder::BindHeadless(connection_scope_, bus, components);
+  app_binder::SendHeadlessInitialValues(bus, components);
+}
+
+HeadlessWiring::~HeadlessWiring() {
+  headless_canvas_.SetExportPreparation(nullptr);
+}
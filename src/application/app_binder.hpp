@@ -16,6 +16,7 @@
 #include "../presentation/font_panel.hpp"
 #include "../presentation/gl_canvas.hpp"
 #include "../presentation/groups_panel.hpp"
+#include "../presentation/headless_canvas.hpp"
 #include "../presentation/page_panel.hpp"
 #include "../presentation/scene_tree_panel.hpp"
 #include "../presentation/shape_panel.hpp"
@@ -55,6 +56,21 @@ struct AppComponents {
   TitleTextEditor& title_text_editor;
 };
 
+// What a --headless run wires: the stores, the rendering adapter and the
+// headless canvas. No panel sends or shows anything, no pointer moves.
+struct HeadlessComponents {
+  DateGroupStore& date_groups_store;
+  DateEntryStore& date_entry_store;
+  TransformDateEntry& transform_date_entry;
+  PageSetupStore& page_setup_store;
+  TitleConfigStore& title_config_store;
+  ShapeConfigurationStore& shape_configuration_store;
+  CalendarConfigStore& calendar_configuration_store;
+
+  CalendarPage& calendar_page;
+  HeadlessCanvas& headless_canvas;
+};
+
 // The three that carry plain `std::function` callbacks instead of Qt
 // connections: they are queries as much as notifications (a pick returns a
 // hit), so no signal and no context object reaches them, and the wiring has to
@@ -78,6 +94,15 @@ void ReleaseCallbacks(const CallbackTargets& targets);
 
 void SendInitialValues(EventBus& bus, const AppComponents& components);
 
+// Bind without the panels and the pointer: every fact still reaches the
+// rendering adapter, in the same order, and the page size the canvas.
+void BindHeadless(QObject& scope, EventBus& bus,
+                  const HeadlessComponents& components);
+
+// SendInitialValues with the panels' defaults sent on their behalf.
+void SendHeadlessInitialValues(EventBus& bus,
+                               const HeadlessComponents& components);
+
 }  // namespace app_binder
 
 // The wiring as a lifetime instead of two calls paired by hand: it connects on
@@ -102,4 +127,20 @@ class AppWiring {
   QObject connection_scope_;
 };
 
+// AppWiring for a --headless run.
+class HeadlessWiring {
+ public:
+  HeadlessWiring(EventBus& bus, const HeadlessComponents& components);
+  ~HeadlessWiring();
+  HeadlessWiring(const HeadlessWiring&) = delete;
+  HeadlessWiring& operator=(const HeadlessWiring&) = delete;
+  HeadlessWiring(HeadlessWiring&&) = delete;
+  HeadlessWiring& operator=(HeadlessWiring&&) = delete;
+
+ private:
+  // The export preparation captures the rendering adapter.
+  HeadlessCanvas& headless_canvas_;
+  QObject connection_scope_;
+};
+
 #endif  // APP_BINDER_HPP
@@ -37,7 +37,7 @@ BarSceneResult BuildBars(const SectionContext& ctx) {
         ctx.rectangles_shader, calendar_layers::kBars);
   }
 
-  auto bar_labels = detail::TextPool(ctx, ctx.nodes.date_bar_labels);
+  auto bar_labels = detail::TextPool(ctx.nodes.date_bar_labels);
 
   const TimelineProjection projection(ctx.calendar_config);
   const auto number_bars = ctx.date_entry_bars.GetNumberBars();
@@ -105,7 +105,7 @@ BarSceneResult BuildBars(const SectionContext& ctx) {
 
 void BuildYearTotals(const SectionContext& ctx) {
   const auto& node_cells = ctx.nodes.year_totals;
-  auto total_labels = detail::TextPool(ctx, ctx.nodes.year_total_labels);
+  auto total_labels = detail::TextPool(ctx.nodes.year_total_labels);
 
   const std::size_t span_years = ctx.date_entry_bars.GetSpan();
   if (span_years == 0) {
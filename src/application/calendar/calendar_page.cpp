@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <cstddef>
+#include <functional>
 #include <glm/ext/vector_float2.hpp>
 #include <iostream>
 #include <memory>
@@ -25,6 +26,8 @@
 #include "../../infrastructure/graphics/page_geometry.hpp"
 #include "../../infrastructure/graphics/pick_id.hpp"
 #include "../render_surface.hpp"
+#include "glyph_prewarm.hpp"
+#include "scene_rebuild.hpp"
 
 CalendarPage::CalendarPage(GraphicsEngine& graphics_engine,
                            application::RenderSurface& render_surface,
@@ -33,7 +36,7 @@ CalendarPage::CalendarPage(GraphicsEngine& graphics_engine,
     : render_surface_(render_surface),
       snapshot_topic_(snapshot_topic),
       font_config_(font_config),
-      font_(std::make_shared<Font>(font_config.FilePath())),
+      font_(MakeFont(font_config.FilePath())),
       scene_composer_(graphics_engine, scene_, font_, font_config_, page_size_,
                       page_margin_, title_config_, calendar_config_,
                       shape_config_, date_groups_, date_entry_bars_) {}
@@ -42,12 +45,14 @@ void CalendarPage::ReceiveDateGroups(
     const std::vector<DateGroup>& date_groups_in) {
   date_groups_.Assign(date_groups_in);
   date_entry_bars_.ReceiveDateGroups(date_groups_in);
+  PrewarmInBurst([this] { return GroupGlyphText(date_groups_); });
   Update();
 }
 
 void CalendarPage::ReceiveDateEntries(
     const std::vector<DateEntry>& date_entries) {
   date_entry_bars_.ReceiveDateEntries(date_entries);
+  PrewarmInBurst([this] { return BarGlyphText(date_entry_bars_); });
   Update();
 }
 
@@ -61,15 +66,19 @@ void CalendarPage::ReceiveFont(const FontConfig& font_config) {
   if (font_config.FilePath() != font_config_.FilePath()) {
     // A font is GL: it rasters its glyphs into a texture.
     render_surface_.MakeGraphicsCurrent();
-    font_ = std::make_shared<Font>(font_config.FilePath());
+    font_ = MakeFont(font_config.FilePath());
+    PrewarmGlyphs();
   }
   font_config_ = font_config;
   Update();
 }
 
+const FontConfig& CalendarPage::Font() const { return font_config_; }
+
 void CalendarPage::ReceiveTitleConfig(
     const TitleConfig& incoming_title_config) {
   title_config_ = incoming_title_config;
+  PrewarmInBurst([this] { return title_config_.TitleText(); });
   Update();
 }
 
@@ -88,6 +97,9 @@ void CalendarPage::ReceiveShapeConfigSet(
 void CalendarPage::ReceiveStateBurst(bool open) {
   if (open) {
     ++open_bursts_;
+    if (open_bursts_ == 1) {
+      PrewarmInBurst(FixedGlyphText);
+    }
     return;
   }
   if (open_bursts_ > 0) {
@@ -101,12 +113,37 @@ void CalendarPage::ReceiveStateBurst(bool open) {
 
 void CalendarPage::Update() {
   if (open_bursts_ > 0) {
+    // A project is coming in piece by piece; the rebuild waits for the last.
+    // The glyphs of each piece were handed over as it arrived.
     pending_update_ = true;
     return;
   }
   Rebuild();
 }
 
+void CalendarPage::ReceiveGlyphsReady() {
+  render_surface_.MakeGraphicsCurrent();
+  if (!font_->UploadFinishedGlyphs()) {
+    return;
+  }
+  // Only the glyph quads change: the advances were right from the start, so
+  // neither the pick boxes nor the scene snapshot need redoing.
+  if (open_bursts_ > 0) {
+    pending_update_ = true;
+    return;
+  }
+  BuildScene("glyphs ready", calendar_sections::SceneChange::kGlyphs);
+  render_surface_.Repaint();
+}
+
+void CalendarPage::FinishGlyphs() {
+  render_surface_.MakeGraphicsCurrent();
+  if (font_->FinishPendingGlyphs()) {
+    BuildScene("glyphs finished", calendar_sections::SceneChange::kGlyphs);
+    render_surface_.Repaint();
+  }
+}
+
 std::optional<PickId> CalendarPage::Pick(glm::vec2 page_point) const {
   return physics_world_.Raycast(page_point);
 }
@@ -117,6 +154,10 @@ void CalendarPage::ReceiveHovered(const std::optional<PickId>& hovered) {
 }
 
 void CalendarPage::ReceiveSelectedNode(const std::optional<std::string>& path) {
+  // The overlay writes its quad into a fresh buffer region and fences the one
+  // it leaves — GL calls, so the context comes first. A hover only patches
+  // mapped memory and needs none.
+  render_surface_.MakeGraphicsCurrent();
   scene_composer_.SetSelectedNode(path);
   render_surface_.Repaint();
 }
@@ -124,7 +165,7 @@ void CalendarPage::ReceiveSelectedNode(const std::optional<std::string>& path) {
 void CalendarPage::ReceiveTextEdit(
     const std::optional<TextEditView>& text_edit) {
   scene_composer_.SetTextEdit(text_edit);
-  BuildScene("text edit");
+  BuildScene("text edit", calendar_sections::SceneChange::kTextEdit);
   render_surface_.Repaint();
 }
 
@@ -138,16 +179,29 @@ std::size_t CalendarPage::TitleCaretIndexAt(glm::vec2 page_point) const {
 }
 
 void CalendarPage::Rebuild() {
-  BuildScene("state change");
+  BuildScene("state change", calendar_sections::SceneChange::kState);
   physics_world_.Rebuild(scene_composer_.PickBoxes());
   render_surface_.RefreshView();
   snapshot_topic_.Publish(scene_composer_.SceneSnapshot());
 }
 
-void CalendarPage::BuildScene(const char* reason) {
+void CalendarPage::PrewarmGlyphs() {
+  font_->Prewarm(
+      ProjectGlyphText(title_config_, date_groups_, date_entry_bars_));
+}
+
+void CalendarPage::PrewarmInBurst(
+    const std::function<std::string()>& text_of) {
+  if (open_bursts_ > 0) {
+    font_->Prewarm(text_of());
+  }
+}
+
+void CalendarPage::BuildScene(const char* reason,
+                              calendar_sections::SceneChange change) {
   render_surface_.MakeGraphicsCurrent();
   const auto started = std::chrono::steady_clock::now();
-  scene_composer_.Build();
+  scene_composer_.Build(change);
   if (decade_debug::LogEnabled()) {
     const auto elapsed = std::chrono::duration<double, std::milli>(
         std::chrono::steady_clock::now() - started);
@@ -155,3 +209,12 @@ void CalendarPage::BuildScene(const char* reason) {
               << elapsed.count() << " ms\n";
   }
 }
+
+std::shared_ptr<Font> CalendarPage::MakeFont(const std::string& file_path) {
+  // The notification arrives on a worker thread; the upload is GL and goes to
+  // the surface's thread. A font replaced meanwhile leaves a posted call that
+  // finds nothing to upload in its successor.
+  return std::make_shared<Font>(file_path, [this] {
+    render_surface_.PostToGraphicsThread([this] { ReceiveGlyphsReady(); });
+  });
+}
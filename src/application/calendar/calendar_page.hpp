@@ -2,6 +2,7 @@
 #define CALENDAR_PAGE_HPP
 
 #include <chrono>
+#include <functional>
 #include <glm/vec2.hpp>
 #include <iostream>
 #include <memory>
@@ -30,6 +31,7 @@
 #include "../../infrastructure/physics/physics_world.hpp"
 #include "../render_surface.hpp"
 #include "calendar_scene_composer.hpp"
+#include "scene_rebuild.hpp"
 
 // Rendering adapter: owns the domain state relevant to the calendar drawing,
 // receives updates via the Receive* slots, and drives the CalendarSceneComposer
@@ -52,6 +54,8 @@ class CalendarPage {
   // without a reload, because Font rasters em-normalised.
   void ReceiveFont(const FontConfig& font_config);
 
+  [[nodiscard]] const FontConfig& Font() const;
+
   void ReceiveTitleConfig(const TitleConfig& incoming_title_config);
 
   void ReceiveCalendarConfig(const CalendarConfig& incoming_calendar_config);
@@ -64,6 +68,15 @@ class CalendarPage {
 
   void Update();
 
+  // The font's workers have rendered glyphs: uploads them and redraws the
+  // text that showed placeholders. Runs on the GL thread, posted there by the
+  // font's notification.
+  void ReceiveGlyphsReady();
+
+  // Waits for every glyph still being rendered and rebuilds if any arrived —
+  // before an export, which must not show placeholders.
+  void FinishGlyphs();
+
   // Hit-tests a page-space point against the pickable elements, returning the
   // element's PickId.
   [[nodiscard]] std::optional<PickId> Pick(glm::vec2 page_point) const;
@@ -100,7 +113,21 @@ class CalendarPage {
   // the GL context. A rebuild allocates buffers and textures, and it is driven
   // by the bus: a panel edit, a loaded project, a keystroke in the title. None
   // of those is a paint, so nothing has made a context current by then.
-  void BuildScene(const char* reason);
+  // `change` says how much: a keystroke rebuilds the title alone.
+  void BuildScene(const char* reason, calendar_sections::SceneChange change);
+
+  // Hands the project's characters to the font, whose workers start on the
+  // ones it has not rendered yet.
+  void PrewarmGlyphs();
+
+  // Hands the font `text_of()` while a burst is open: the characters of the
+  // piece of state that just arrived, so the workers render them while the
+  // rest comes in. Outside a burst the build meets them at once anyway, and
+  // the text is not collected.
+  void PrewarmInBurst(const std::function<std::string()>& text_of);
+
+  // Builds a font whose glyph notifications reach ReceiveGlyphsReady.
+  [[nodiscard]] std::shared_ptr<Font> MakeFont(const std::string& file_path);
 
   application::RenderSurface& render_surface_;
   // Nested brackets are counted, not toggled: a load inside a load would
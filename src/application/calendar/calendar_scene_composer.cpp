@@ -26,13 +26,17 @@
 #include "../../infrastructure/graphics/rect.hpp"
 #include "../../infrastructure/graphics/scene.hpp"
 #include "../../infrastructure/graphics/scene_graph.hpp"
+#include "../../infrastructure/graphics/scene_shape_filler.hpp"
 #include "../../infrastructure/graphics/shaders.hpp"
+#include "../../infrastructure/graphics/shape_node.hpp"
 #include "../../infrastructure/graphics/shapes.hpp"
+#include "../../infrastructure/graphics/text_batch.hpp"
 #include "bar_sections.hpp"
 #include "calendar_layout.hpp"
 #include "calendar_scene_nodes.hpp"
 #include "grid_sections.hpp"
 #include "legend_section.hpp"
+#include "scene_rebuild.hpp"
 #include "scene_highlighter.hpp"
 #include "scene_snapshot_builder.hpp"
 #include "section_context.hpp"
@@ -61,11 +65,12 @@ CalendarSceneComposer::CalendarSceneComposer(
       date_entry_bars_(date_entry_bars_in) {
   graphics_engine_.SetScene(scene_);
   Shader& simple_shader = RequireShader(graphics_engine_, "Simple Shader");
+  Shader& grid_shader = RequireShader(graphics_engine_, "Grid Shader");
 
   // The fixed scene skeleton (named nodes, their painter layers and parent
   // attachments) is built once here; the handles drive the section builders.
   nodes_ = BuildCalendarSceneNodes(scene_, simple_shader, rectangles_shader_,
-                                   font_shader_, font_);
+                                   grid_shader, font_shader_, font_);
 }
 
 Shader& CalendarSceneComposer::RequireShader(GraphicsEngine& graphics_engine,
@@ -77,7 +82,109 @@ Shader& CalendarSceneComposer::RequireShader(GraphicsEngine& graphics_engine,
   return found->get();
 }
 
-void CalendarSceneComposer::Build() {
+// One Build() of the composer's sections, as RunBuild drives it.
+class CalendarSceneComposer::SectionRun
+    : public calendar_sections::SectionBuilder {
+ public:
+  SectionRun(CalendarSceneComposer& composer,
+             const calendar_sections::SectionContext& ctx)
+      : composer_(composer), ctx_(ctx) {}
+
+  void Build(calendar_sections::Section section) override {
+    composer_.BuildSection(ctx_, section, bars_);
+  }
+
+  // Fresh bar nodes go to the highlighter, which re-applies the persisted
+  // hover and selection highlights to them; without, to what stands.
+  void Rehighlight() override {
+    if (bars_.has_value()) {
+      composer_.highlighter_.Refresh(std::move(bars_->bar_nodes));
+    } else {
+      composer_.highlighter_.Reapply();
+    }
+  }
+
+ private:
+  CalendarSceneComposer& composer_;
+  const calendar_sections::SectionContext& ctx_;
+  std::optional<calendar_sections::BarSceneResult> bars_;
+};
+
+void CalendarSceneComposer::Build(calendar_sections::SceneChange change) {
+  const calendar_sections::SectionContext ctx = MakeContext();
+  SectionRun run(*this, ctx);
+  calendar_sections::RunBuild(change, built_, run);
+  built_ = true;
+
+  // Geometry and transforms changed: the scene's draw list and its culling
+  // grids describe the previous build. Only the CPU-side index is dropped —
+  // the sections not rebuilt keep their uploaded buffers.
+  scene_.Invalidate();
+}
+
+void CalendarSceneComposer::BuildSection(
+    const calendar_sections::SectionContext& ctx,
+    calendar_sections::Section section,
+    std::optional<calendar_sections::BarSceneResult>& bars) {
+  using calendar_sections::Section;
+  // Every label layer draws as one batch of the labels its section just set.
+  switch (section) {
+    case Section::kPage:
+      BuildPage();
+      calendar_sections::BuildPrintArea(ctx);
+      pick_boxes_.clear();
+      return;
+    case Section::kTitle: {
+      // The title's box leads the pick boxes; a title-only rebuild replaces
+      // it in place.
+      const PickBox title = calendar_sections::BuildTitle(ctx);
+      if (pick_boxes_.empty()) {
+        pick_boxes_.push_back(title);
+      } else {
+        pick_boxes_.front() = title;
+      }
+      return;
+    }
+    case Section::kCalendarLabels:
+      calendar_sections::BuildCalendarLabels(ctx);
+      scene_shapes::CommitTextBatch(nodes_.month_labels);
+      scene_shapes::CommitTextBatch(nodes_.year_labels);
+      return;
+    case Section::kDays:
+      calendar_sections::BuildDays(ctx);
+      return;
+    case Section::kMonths:
+      calendar_sections::BuildMonths(ctx);
+      return;
+    case Section::kYears:
+      calendar_sections::BuildYears(ctx);
+      return;
+    case Section::kBars:
+      bars = calendar_sections::BuildBars(ctx);
+      pick_boxes_.insert(pick_boxes_.end(), bars->pick_boxes.begin(),
+                         bars->pick_boxes.end());
+      scene_shapes::CommitTextBatch(nodes_.date_bar_labels);
+      return;
+    case Section::kYearTotals:
+      calendar_sections::BuildYearTotals(ctx);
+      scene_shapes::CommitTextBatch(nodes_.year_total_labels);
+      return;
+    case Section::kLegend:
+      calendar_sections::BuildLegend(ctx);
+      scene_shapes::CommitTextBatch(nodes_.legend_labels);
+      return;
+    case Section::kText:
+      nodes_.title_text.Shape().Relayout();
+      for (const auto* batch :
+           {&nodes_.month_labels, &nodes_.year_labels, &nodes_.date_bar_labels,
+            &nodes_.year_total_labels, &nodes_.legend_labels}) {
+        scene_shapes::RelayoutTextBatch(*batch);
+      }
+      return;
+  }
+}
+
+void CalendarSceneComposer::BuildPage() {
   FillShape& page_shape = nodes_.page.Shape();
   page_shape.SetShape(page_size_);
   page_shape.SetColor(glm::vec4(kOne, kOne, kOne, kOne));
@@ -100,27 +207,14 @@ void CalendarSceneComposer::Build() {
   // absolute page space on the untransformed page node above.
   nodes_.print_area.Node()->SetModelMatrix(
       glm::translate(glm::mat4(1.0F), layout_.PrintAreaOrigin()));
-
-  const calendar_sections::SectionContext ctx = MakeContext();
-  calendar_sections::BuildPrintArea(ctx);
-  pick_boxes_.clear();
-  pick_boxes_.push_back(calendar_sections::BuildTitle(ctx));
-  calendar_sections::BuildCalendarLabels(ctx);
-  calendar_sections::BuildDays(ctx);
-  calendar_sections::BuildMonths(ctx);
-  calendar_sections::BuildYears(ctx);
-  calendar_sections::BarSceneResult bars = calendar_sections::BuildBars(ctx);
-  pick_boxes_.insert(pick_boxes_.end(), bars.pick_boxes.begin(),
-                     bars.pick_boxes.end());
-  calendar_sections::BuildYearTotals(ctx);
-  calendar_sections::BuildLegend(ctx);
-
-  // Hand the fresh bar nodes to the highlighter, which re-applies the
-  // persisted hover and selection highlights to the new geometry.
-  highlighter_.Refresh(std::move(bars.bar_nodes));
 }
 
 calendar_sections::SectionContext CalendarSceneComposer::MakeContext() const {
+  // The advances were measured with one font; another one measures anew.
+  if (title_advances_font_.lock() != font_) {
+    title_advances_.Clear();
+    title_advances_font_ = font_;
+  }
   return calendar_sections::SectionContext{
       .nodes = nodes_,
       .layout = layout_,
@@ -130,6 +224,7 @@ calendar_sections::SectionContext CalendarSceneComposer::MakeContext() const {
       .date_groups = date_groups_,
       .date_entry_bars = date_entry_bars_,
       .text_edit = text_edit_,
+      .title_advances = title_advances_,
       .font = font_,
       .font_config = font_config_,
       .rectangles_shader = rectangles_shader_,
@@ -151,6 +246,9 @@ void CalendarSceneComposer::SetHovered(const std::optional<PickId>& hovered) {
 void CalendarSceneComposer::SetSelectedNode(
     const std::optional<std::string>& path) {
   highlighter_.SetSelectedNode(path);
+  // The overlay moved to the new node's bounds (or vanished). A hover only
+  // recolours and leaves the grids valid.
+  scene_.Invalidate();
 }
 
 void CalendarSceneComposer::SetTextEdit(
@@ -18,6 +18,7 @@
 #include "../../domain/shape_configuration.hpp"
 #include "../../domain/text_edit_view.hpp"
 #include "../../domain/title_config.hpp"
+#include "../../infrastructure/graphics/advance_table.hpp"
 #include "../../infrastructure/graphics/font.hpp"
 #include "../../infrastructure/graphics/graphics_engine.hpp"
 #include "../../infrastructure/graphics/pick_id.hpp"
@@ -29,6 +30,7 @@
 #include "calendar_scene_nodes.hpp"
 #include "grid_sections.hpp"
 #include "legend_section.hpp"
+#include "scene_rebuild.hpp"
 #include "scene_highlighter.hpp"
 #include "scene_snapshot_builder.hpp"
 #include "section_context.hpp"
@@ -52,7 +54,9 @@ class CalendarSceneComposer {
                         const DateGroups& date_groups_in,
                         const DateEntryBars& date_entry_bars_in);
 
-  void Build();
+  // Refills the sections `change` calls for; the first build refills them
+  // all whatever the change.
+  void Build(calendar_sections::SceneChange change);
 
   // Bundles the references the section builders need into a context, built
   // fresh per Build() (never stored).
@@ -74,7 +78,7 @@ class CalendarSceneComposer {
   void SetSelectedNode(const std::optional<std::string>& path);
 
   // The state of the running text edit; the next Build() draws text, cursor and
-  // selection out of it.
+  // selection out of it — Build(SceneChange::kTextEdit) only those.
   void SetTextEdit(const std::optional<TextEditView>& text_edit);
 
   // The path "root/.../name" of the node a hit element means — the notion of
@@ -86,8 +90,19 @@ class CalendarSceneComposer {
   [[nodiscard]] std::size_t TitleCaretIndexAt(glm::vec2 page_point) const;
 
  private:
+  class SectionRun;
+
   static constexpr float kOne = 1.0F;
 
+  // Runs one section builder and commits the label batches it filled.
+  void BuildSection(const calendar_sections::SectionContext& ctx,
+                    calendar_sections::Section section,
+                    std::optional<calendar_sections::BarSceneResult>& bars);
+
+  // The page rectangle, the calendar span, the layout and the print area's
+  // transform: what the sections lay themselves out in.
+  void BuildPage();
+
   // The scene graph's owner is the Scene (held by CalendarPage); the builder
   // borrows it to mutate the graph. It is not owned here.
   Scene& scene_;
@@ -96,7 +111,7 @@ class CalendarSceneComposer {
   // Cached shader handles, looked up once in the constructor. The shaders live
   // in the GraphicsEngine for the builder's whole lifetime; they are forwarded
   // to the section builders via the SectionContext.
-  // The three shaders the calendar draws with are built unconditionally by
+  // The shaders the calendar draws with are built unconditionally by
   // `Shaders` out of embedded resources, so a miss here means a typo in the
   // name or a resource that went away — a fault, not a state to carry. It used
   // to fall to nullptr through `value_or`, and the null then died inside
@@ -130,11 +145,17 @@ class CalendarSceneComposer {
   CalendarLayout layout_;
   std::vector<PickBox> pick_boxes_;
   std::optional<TextEditView> text_edit_;
+  // Whether layout_ and the pick boxes come from a full build yet.
+  bool built_{false};
+  // The title's advance table and the font it was measured with. Mutable:
+  // hit-testing the title (a const query) brings it up to date as well.
+  mutable AdvanceTable title_advances_;
+  mutable std::weak_ptr<Font> title_advances_font_;
 
   // Interactive hover/selection highlighting. Declared last so its borrowed
   // references (scene_, the overlay and title nodes, shape_config_) are all
-  // initialised first; fed the fresh bar nodes via Refresh() after each
-  // Build().
+  // initialised first; re-applied after every Build(), with the fresh bar
+  // nodes where the bars were rebuilt.
   SceneHighlighter highlighter_{scene_, nodes_.selection_overlay,
                                 nodes_.title_area, shape_config_};
 };
@@ -5,14 +5,17 @@
 #include <string_view>
 
 #include "../../infrastructure/graphics/font.hpp"
+#include "../../infrastructure/graphics/grid_shape.hpp"
 #include "../../infrastructure/graphics/scene.hpp"
 #include "../../infrastructure/graphics/scene_graph.hpp"
 #include "../../infrastructure/graphics/shaders.hpp"
 #include "../../infrastructure/graphics/shape_node.hpp"
 #include "../../infrastructure/graphics/shapes.hpp"
+#include "../../infrastructure/graphics/text_batch.hpp"
 
 CalendarSceneNodes BuildCalendarSceneNodes(Scene& scene, Shader& simple_shader,
                                            Shader& rectangles_shader,
+                                           Shader& grid_shader,
                                            Shader& font_shader,
                                            const std::shared_ptr<Font>& font) {
   CalendarSceneNodes nodes;
@@ -42,6 +45,11 @@ CalendarSceneNodes BuildCalendarSceneNodes(Scene& scene, Shader& simple_shader,
     print_area->AddChild(node.Node());
     return node;
   };
+  const auto grid_under_print_area = [&](std::string_view name) {
+    auto node = ShapeNode<GridShape>::Make(std::string(name), grid_shader);
+    print_area->AddChild(node.Node());
+    return node;
+  };
   const auto fill_under_print_area = [&](std::string_view name) {
     auto node = ShapeNode<FillShape>::Make(std::string(name), simple_shader);
     print_area->AddChild(node.Node());
@@ -52,6 +60,11 @@ CalendarSceneNodes BuildCalendarSceneNodes(Scene& scene, Shader& simple_shader,
     print_area->AddChild(node);
     return node;
   };
+  const auto text_batch_under_print_area = [&](std::string_view name) {
+    auto node = ShapeNode<TextBatchShape>::Make(std::string(name), font_shader);
+    print_area->AddChild(node.Node());
+    return node;
+  };
 
   nodes.title_area =
       boxes_under_print_area(CalendarSceneNodes::kTitleFrameName);
@@ -61,15 +74,15 @@ CalendarSceneNodes BuildCalendarSceneNodes(Scene& scene, Shader& simple_shader,
   nodes.year_cells = boxes_under_print_area(CalendarSceneNodes::kYearCellsName);
   nodes.month_cells =
       boxes_under_print_area(CalendarSceneNodes::kMonthCellsName);
-  nodes.day_cells = boxes_under_print_area(CalendarSceneNodes::kDayCellsName);
+  nodes.day_cells = grid_under_print_area(CalendarSceneNodes::kDayCellsName);
   nodes.sunday_cells =
-      boxes_under_print_area(CalendarSceneNodes::kSundayCellsName);
+      grid_under_print_area(CalendarSceneNodes::kSundayCellsName);
   nodes.date_bars =
       container_under_print_area(CalendarSceneNodes::kDateBarsName);
   nodes.year_totals =
       boxes_under_print_area(CalendarSceneNodes::kYearTotalsName);
   nodes.year_total_labels =
-      container_under_print_area(CalendarSceneNodes::kYearTotalLabelsName);
+      text_batch_under_print_area(CalendarSceneNodes::kYearTotalLabelsName);
 
   // A leaf with no later updates, hence no handle in the struct — but it needs
   // its draw layer below, so it stays named here.
@@ -79,7 +92,7 @@ CalendarSceneNodes BuildCalendarSceneNodes(Scene& scene, Shader& simple_shader,
   nodes.legend_entries =
       container_under_print_area(CalendarSceneNodes::kLegendEntriesName);
   nodes.legend_labels =
-      container_under_print_area(CalendarSceneNodes::kLegendLabelsName);
+      text_batch_under_print_area(CalendarSceneNodes::kLegendLabelsName);
 
   nodes.title_text = ShapeNode<FontShape>::Make(
       std::string(CalendarSceneNodes::kTitleTextName), font_shader);
@@ -93,11 +106,11 @@ CalendarSceneNodes BuildCalendarSceneNodes(Scene& scene, Shader& simple_shader,
       fill_under_print_area(CalendarSceneNodes::kTitleCaretName);
 
   nodes.month_labels =
-      container_under_print_area(CalendarSceneNodes::kMonthLabelsName);
+      text_batch_under_print_area(CalendarSceneNodes::kMonthLabelsName);
   nodes.year_labels =
-      container_under_print_area(CalendarSceneNodes::kYearLabelsName);
+      text_batch_under_print_area(CalendarSceneNodes::kYearLabelsName);
   nodes.date_bar_labels =
-      container_under_print_area(CalendarSceneNodes::kDateBarLabelsName);
+      text_batch_under_print_area(CalendarSceneNodes::kDateBarLabelsName);
 
   nodes.page.Node()->SetDrawLayer(calendar_layers::kPage);
   nodes.print_area.Node()->SetDrawLayer(calendar_layers::kArea);
@@ -111,6 +124,11 @@ CalendarSceneNodes BuildCalendarSceneNodes(Scene& scene, Shader& simple_shader,
   nodes.sunday_cells.Node()->SetDrawLayer(calendar_layers::kGrid);
   nodes.year_totals.Node()->SetDrawLayer(calendar_layers::kBars);
   nodes.title_text.Node()->SetDrawLayer(calendar_layers::kText);
+  nodes.year_total_labels.Node()->SetDrawLayer(calendar_layers::kText);
+  nodes.legend_labels.Node()->SetDrawLayer(calendar_layers::kText);
+  nodes.month_labels.Node()->SetDrawLayer(calendar_layers::kText);
+  nodes.year_labels.Node()->SetDrawLayer(calendar_layers::kText);
+  nodes.date_bar_labels.Node()->SetDrawLayer(calendar_layers::kText);
   nodes.title_selection.Node()->SetDrawLayer(calendar_layers::kTextSelection);
   nodes.title_caret.Node()->SetDrawLayer(calendar_layers::kCaret);
   nodes.selection_overlay.Node()->SetDrawLayer(calendar_layers::kOverlay);
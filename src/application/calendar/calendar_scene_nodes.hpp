@@ -6,11 +6,13 @@
 #include <string_view>
 
 #include "../../infrastructure/graphics/font.hpp"
+#include "../../infrastructure/graphics/grid_shape.hpp"
 #include "../../infrastructure/graphics/scene.hpp"
 #include "../../infrastructure/graphics/scene_graph.hpp"
 #include "../../infrastructure/graphics/shaders.hpp"
 #include "../../infrastructure/graphics/shape_node.hpp"
 #include "../../infrastructure/graphics/shapes.hpp"
+#include "../../infrastructure/graphics/text_batch.hpp"
 
 // Painter draw layers for the calendar (lower = further back). The bars sit
 // above the grid background so the day/sunday/month cells no longer cover them;
@@ -29,8 +31,10 @@ inline constexpr int kOverlay = 50;
 }  // namespace calendar_layers
 
 // Stable handles to the fixed scene-skeleton nodes, created once and reached
-// directly by the section builders. Container nodes (the date bars, the text
-// groups, …) carry no shape; their dynamic children are (re)built each frame.
+// directly by the section builders. Container nodes (the date bars, the legend
+// entries) carry no shape; their dynamic children are (re)built each frame.
+// The text groups are containers too, but carry the TextBatchShape that draws
+// all their labels at once.
 //
 // Each node's display name lives here as a `k…Name` constant right next to its
 // handle, so the name and the variable are defined together in one place (the
@@ -73,11 +77,13 @@ struct CalendarSceneNodes {
   static constexpr std::string_view kMonthCellsName = "Month Cells";
   ShapeNode<BoxesShape> month_cells;
 
+  // One grid row per year each; the day cells take the weekdays, the Sunday
+  // cells every seventh day on top of them.
   static constexpr std::string_view kDayCellsName = "Day Cells";
-  ShapeNode<BoxesShape> day_cells;
+  ShapeNode<GridShape> day_cells;
 
   static constexpr std::string_view kSundayCellsName = "Sunday Cells";
-  ShapeNode<BoxesShape> sunday_cells;
+  ShapeNode<GridShape> sunday_cells;
 
   static constexpr std::string_view kDateBarsName = "Date Bars";
   std::shared_ptr<SceneNode> date_bars;
@@ -86,7 +92,7 @@ struct CalendarSceneNodes {
   ShapeNode<BoxesShape> year_totals;
 
   static constexpr std::string_view kYearTotalLabelsName = "Year Total Labels";
-  std::shared_ptr<SceneNode> year_total_labels;
+  ShapeNode<TextBatchShape> year_total_labels;
 
   static constexpr std::string_view kLegendFrameName = "Legend Frame";
   // The legend frame is a leaf with no later updates, so it has no handle here;
@@ -96,16 +102,16 @@ struct CalendarSceneNodes {
   std::shared_ptr<SceneNode> legend_entries;
 
   static constexpr std::string_view kLegendLabelsName = "Legend Labels";
-  std::shared_ptr<SceneNode> legend_labels;
+  ShapeNode<TextBatchShape> legend_labels;
 
   static constexpr std::string_view kMonthLabelsName = "Month Labels";
-  std::shared_ptr<SceneNode> month_labels;
+  ShapeNode<TextBatchShape> month_labels;
 
   static constexpr std::string_view kYearLabelsName = "Year Labels";
-  std::shared_ptr<SceneNode> year_labels;
+  ShapeNode<TextBatchShape> year_labels;
 
   static constexpr std::string_view kDateBarLabelsName = "Date Bar Labels";
-  std::shared_ptr<SceneNode> date_bar_labels;
+  ShapeNode<TextBatchShape> date_bar_labels;
 };
 
 // Builds the fixed scene skeleton under the scene's root once: every named node
@@ -114,6 +120,7 @@ struct CalendarSceneNodes {
 // areas), with the selection overlay as a hidden top-layer sibling of the page.
 [[nodiscard]] CalendarSceneNodes BuildCalendarSceneNodes(
     Scene& scene, Shader& simple_shader, Shader& rectangles_shader,
-    Shader& font_shader, const std::shared_ptr<Font>& font);
+    Shader& grid_shader, Shader& font_shader,
+    const std::shared_ptr<Font>& font);
 
 #endif  // CALENDAR_SCENE_NODES_HPP
@@ -0,0 +1,90 @@
+#include "glyph_prewarm.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "../../domain/date_entry_bars.hpp"
+#include "../../domain/date_group.hpp"
+#include "../../domain/title_config.hpp"
+#include "../../infrastructure/graphics/utf8_codec.hpp"
+#include "grid_sections.hpp"
+#include "legend_section.hpp"
+
+namespace {
+
+// Year numbers, day counts, "12.5 %".
+constexpr std::string_view kNumberCharacters = "0123456789.,-% ";
+
+class DistinctCharacters {
+ public:
+  void Add(const std::string& text) {
+    DecodeUtf8Into(text, decoded_);
+    for (const char32_t code_point : decoded_) {
+      if (seen_.insert(code_point).second) {
+        code_points_.push_back(code_point);
+      }
+    }
+  }
+
+  [[nodiscard]] std::string Text() const { return EncodeUtf8(code_points_); }
+
+ private:
+  std::vector<char32_t> decoded_;
+  std::unordered_set<char32_t> seen_;
+  std::u32string code_points_;
+};
+
+void AddFixedText(DistinctCharacters& characters) {
+  characters.Add(std::string(kNumberCharacters));
+  for (const std::string& month : calendar_sections::MonthAbbreviations()) {
+    characters.Add(month);
+  }
+  characters.Add(std::string(calendar_sections::kAnnualSumLabel));
+}
+
+void AddGroupText(DistinctCharacters& characters,
+                  const DateGroups& date_groups) {
+  for (const DateGroup& group : date_groups.Items()) {
+    characters.Add(group.GetName());
+  }
+}
+
+void AddBarText(DistinctCharacters& characters, const DateEntryBars& bars) {
+  for (std::size_t index = 0; index < bars.GetNumberBars(); ++index) {
+    characters.Add(bars.GetBar(index).GetText());
+  }
+}
+
+}  // namespace
+
+std::string ProjectGlyphText(const TitleConfig& title_config,
+                             const DateGroups& date_groups,
+                             const DateEntryBars& bars) {
+  DistinctCharacters characters;
+  AddFixedText(characters);
+  AddGroupText(characters, date_groups);
+  AddBarText(characters, bars);
+  characters.Add(title_config.TitleText());
+  return characters.Text();
+}
+
+std::string FixedGlyphText() {
+  DistinctCharacters characters;
+  AddFixedText(characters);
+  return characters.Text();
+}
+
+std::string GroupGlyphText(const DateGroups& date_groups) {
+  DistinctCharacters characters;
+  AddGroupText(characters, date_groups);
+  return characters.Text();
+}
+
+std::string BarGlyphText(const DateEntryBars& bars) {
+  DistinctCharacters characters;
+  AddBarText(characters, bars);
+  return characters.Text();
+}
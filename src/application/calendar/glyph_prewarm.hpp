@@ -0,0 +1,32 @@
+#ifndef GLYPH_PREWARM_HPP
+#define GLYPH_PREWARM_HPP
+
+#include <string>
+
+#include "../../domain/date_entry_bars.hpp"
+#include "../../domain/date_group.hpp"
+#include "../../domain/title_config.hpp"
+
+// The characters a calendar of this project draws, as one UTF-8 string: the
+// digits and signs of the year numbers, day counts and percentages, the
+// locale's month abbreviations, the legend captions, the group names, the bar
+// texts and the title. Each character appears once.
+//
+// Handed to Font::Prewarm when a font is chosen, so the font's workers render
+// those glyphs instead of meeting them one by one in the build.
+[[nodiscard]] std::string ProjectGlyphText(const TitleConfig& title_config,
+                                           const DateGroups& date_groups,
+                                           const DateEntryBars& bars);
+
+// The parts of it, for a project arriving piece by piece: each piece of state
+// hands over its own characters as it comes in, and the whole project is not
+// collected again for every one.
+//
+// What every calendar draws, whatever the project: numbers, months, captions.
+[[nodiscard]] std::string FixedGlyphText();
+
+[[nodiscard]] std::string GroupGlyphText(const DateGroups& date_groups);
+
+[[nodiscard]] std::string BarGlyphText(const DateEntryBars& bars);
+
+#endif  // GLYPH_PREWARM_HPP
@@ -10,17 +10,17 @@
 #include "../../domain/date.hpp"
 #include "../../domain/shape_configuration.hpp"
 #include "../../domain/timeline_projection.hpp"
+#include "../../infrastructure/graphics/grid_pattern.hpp"
 #include "../../infrastructure/graphics/rect.hpp"
 #include "calendar_scene_nodes.hpp"
 #include "section_context.hpp"
 
 namespace calendar_sections {
 
-void BuildCalendarLabels(const SectionContext& ctx) {
-  constexpr size_t number_months = 12;
+std::array<std::string, kMonthsPerYear> MonthAbbreviations() {
   std::array<char, detail::kMonthNameBufferSize> buf{};
   constexpr const char* format = "%b";
-  std::array<std::string, number_months> months_names;
+  std::array<std::string, kMonthsPerYear> months_names;
 
   for (size_t index = 0; index < months_names.size(); ++index) {
     std::tm month_tm = {};
@@ -30,6 +30,13 @@ void BuildCalendarLabels(const SectionContext& ctx) {
       months_names.at(index) = buf.data();
     }
   }
+  return months_names;
+}
+
+void BuildCalendarLabels(const SectionContext& ctx) {
+  constexpr size_t number_months = kMonthsPerYear;
+  const std::array<std::string, number_months> months_names =
+      MonthAbbreviations();
 
   std::vector<RectF> x_label_frames(number_months);
   // Month names and year numbers carry the application-wide chosen size in
@@ -37,7 +44,7 @@ void BuildCalendarLabels(const SectionContext& ctx) {
   // not travel with the cell size.
   const float labels_font_size = ctx.font_config.SizeMillimetres();
 
-  auto month_labels = detail::TextPool(ctx, ctx.nodes.month_labels);
+  auto month_labels = detail::TextPool(ctx.nodes.month_labels);
   for (size_t index = 0; index < number_months; ++index) {
     const auto float_index = static_cast<float>(index);
     const auto left = ctx.layout.XLabelsArea().Left() +
@@ -57,7 +64,7 @@ void BuildCalendarLabels(const SectionContext& ctx) {
   detail::FillRectangles(ctx.nodes.column_labels, x_label_frames, config);
 
   const std::size_t span_years = ctx.calendar_config.GetSpanLengthYears();
-  auto year_labels = detail::TextPool(ctx, ctx.nodes.year_labels);
+  auto year_labels = detail::TextPool(ctx.nodes.year_labels);
   if (span_years == 0) {
     return;
   }
@@ -161,54 +168,44 @@ void BuildDays(const SectionContext& ctx) {
     return;
   }
 
-  std::int64_t days_index = 0;
-  const auto number_days_cells = static_cast<size_t>(span_days);
-
-  std::vector<RectF> day_cells;
-  std::vector<RectF> sunday_cells;
-  day_cells.resize(number_days_cells);
-  sunday_cells.resize(number_days_cells);
-
+  // One grid row per year instead of one rectangle per day: the row knows
+  // where its days start and which of them is its first Sunday, and the grid
+  // shader cuts the cells out of it. The day cells take every day but the
+  // Sundays, the Sunday cells exactly those — drawn after them, as before.
+  constexpr int kDaysPerWeek = 7;
   const std::size_t span_years = ctx.calendar_config.GetSpanLengthYears();
   const TimelineProjection projection(ctx.calendar_config);
+  const Date span_begin = ctx.calendar_config.GetSpanLimitsDate().at(0);
+  std::vector<grid_pattern::CellRow> rows;
+  rows.reserve(span_years);
+
+  std::int64_t days_index = 0;
   for (std::size_t index = 0; index < span_years; ++index) {
     const int current_year = projection.YearForRow(index);
     const std::int64_t number_days = DaysInYear(current_year);
 
-    for (std::int64_t subindex = 0; subindex < number_days; ++subindex) {
-      const auto float_subindex = static_cast<float>(subindex);
-      const auto current_cell = ctx.layout.GetSubArea(index, 1);
+    RectF row_cells = ctx.layout.GetSubArea(index, 1);
+    row_cells.SetRight(row_cells.Left() + (static_cast<float>(number_days) *
+                                           ctx.layout.DayWidth()));
 
-      const Date current_date =
-          ctx.calendar_config.GetSpanLimitsDate().at(0).AddDays(
-              static_cast<int>(days_index));
-
-      if (current_date.DayOfWeek() == Weekday::kSunday) {
-        RectF day_cell;
-        day_cell.SetLeft(current_cell.Left() +
-                         (float_subindex * ctx.layout.DayWidth()));
-        day_cell.SetRight(day_cell.Left() + ctx.layout.DayWidth());
-        day_cell.SetBottom(current_cell.Bottom());
-        day_cell.SetTop(current_cell.Top());
-        sunday_cells[static_cast<size_t>(days_index)] = day_cell;
-      } else {
-        RectF day_cell;
-        day_cell.SetLeft(current_cell.Left() +
-                         (float_subindex * ctx.layout.DayWidth()));
-        day_cell.SetRight(day_cell.Left() + ctx.layout.DayWidth());
-        day_cell.SetBottom(current_cell.Bottom());
-        day_cell.SetTop(current_cell.Top());
-        day_cells[static_cast<size_t>(days_index)] = day_cell;
-      }
-      ++days_index;
-    }
+    const Date row_begin = span_begin.AddDays(static_cast<int>(days_index));
+    const int weekday = static_cast<int>(row_begin.DayOfWeek());
+    const int first_sunday =
+        (static_cast<int>(Weekday::kSunday) - weekday + kDaysPerWeek) %
+        kDaysPerWeek;
+    rows.push_back(
+        grid_pattern::CellRow{.cells = row_cells, .phase = first_sunday});
+
+    days_index += number_days;
   }
 
-  detail::FillRectangles(
-      ctx.nodes.day_cells, day_cells,
+  detail::FillGrid(
+      ctx.nodes.day_cells, rows, ctx.layout.DayWidth(), kDaysPerWeek,
+      grid_pattern::CellSelection::kOffPhase,
       ctx.shape_config.GetShapeConfiguration(ShapeConfigSet::kDayShapes));
-  detail::FillRectangles(
-      ctx.nodes.sunday_cells, sunday_cells,
+  detail::FillGrid(
+      ctx.nodes.sunday_cells, rows, ctx.layout.DayWidth(), kDaysPerWeek,
+      grid_pattern::CellSelection::kOnPhase,
       ctx.shape_config.GetShapeConfiguration(ShapeConfigSet::kSundayShapes));
 }
 
@@ -1,6 +1,10 @@
 #ifndef GRID_SECTIONS_HPP
 #define GRID_SECTIONS_HPP
 
+#include <array>
+#include <cstddef>
+#include <string>
+
 #include "section_context.hpp"
 
 // The calendar grid: the month and year labels around it and the year, month
@@ -8,6 +12,12 @@
 
 namespace calendar_sections {
 
+inline constexpr std::size_t kMonthsPerYear = 12;
+
+// The current locale's abbreviated month names (strftime's %b), January
+// first — the column labels, and part of what the font is prewarmed with.
+[[nodiscard]] std::array<std::string, kMonthsPerYear> MonthAbbreviations();
+
 void BuildCalendarLabels(const SectionContext& ctx);
 
 void BuildYears(const SectionContext& ctx);
@@ -17,7 +17,7 @@ namespace calendar_sections {
 void BuildLegend(const SectionContext& ctx) {
   ShapeChildPool<BoxesShape> entry_pool(
       ctx.nodes.legend_entries, ctx.rectangles_shader, calendar_layers::kBars);
-  auto entry_labels = detail::TextPool(ctx, ctx.nodes.legend_labels);
+  auto entry_labels = detail::TextPool(ctx.nodes.legend_labels);
 
   const size_t number_entry_frames = (ctx.date_groups.Items().size() + 1) * 2;
   std::vector<RectF> legend_entries_frames(number_entry_frames);
@@ -82,7 +82,8 @@ void BuildLegend(const SectionContext& ctx) {
 
   {
     detail::SetCenteredText(
-        ctx, entry_labels, std::string("legend label year total"), "Annual sum",
+        ctx, entry_labels, std::string("legend label year total"),
+        std::string(kAnnualSumLabel),
         legend_entries_frames.at(legend_entries_frames.size() - 2).Center(),
         legend_font_size);
 
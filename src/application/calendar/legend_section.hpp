@@ -1,6 +1,8 @@
 #ifndef LEGEND_SECTION_HPP
 #define LEGEND_SECTION_HPP
 
+#include <string_view>
+
 #include "section_context.hpp"
 
 // The legend below the calendar: one label plus one sample bar per date group,
@@ -8,6 +10,9 @@
 
 namespace calendar_sections {
 
+// The caption of the annual sum's legend entry.
+inline constexpr std::string_view kAnnualSumLabel = "Annual sum";
+
 void BuildLegend(const SectionContext& ctx);
 
 }  // namespace calendar_sections
@@ -31,6 +31,10 @@ SceneHighlighter::SceneHighlighter(const Scene& scene,
 void SceneHighlighter::Refresh(
     std::unordered_map<std::size_t, std::shared_ptr<SceneNode>> bar_nodes) {
   bar_nodes_ = std::move(bar_nodes);
+  Reapply();
+}
+
+void SceneHighlighter::Reapply() {
   if (hovered_.has_value()) {
     ApplyHover(*hovered_, /*highlighted=*/true);
   }
@@ -131,8 +135,15 @@ void SceneHighlighter::ApplyHover(const PickId& picked, bool highlighted) {
     return;
   }
   auto& shape = static_cast<BoxesShape&>(*drawable);
+  if (shape.RectangleCount() == 0) {
+    return;
+  }
+  // The element is the first rectangle of its shape — a bar node and the title
+  // frame carry one each. Patching it rather than repainting the set keeps the
+  // hover at a handful of bytes however the rectangles get grouped.
   const auto config = shape_config_.GetShapeConfiguration(node->GetStyleId());
   const glm::vec4 hover_outline(kOne, kHoverOutlineGreen, kZero, kOne);
-  shape.SetColors(highlighted ? hover_outline : config.OutlineColor(),
-                  config.FillColor());
+  shape.SetRectangleColors(
+      0, highlighted ? hover_outline : config.OutlineColor(),
+      config.FillColor());
 }
@@ -20,14 +20,16 @@
 // (CalendarSceneComposer / section builders). It owns the two transient
 // highlights:
 //
-//   * the hovered element (a bar or the title frame), recoloured in place via
-//     its shape; and
+//   * the hovered element (a bar or the title frame), recoloured in place by a
+//     colour patch of its rectangle (BoxesShape::SetRectangleColors); and
 //   * the scene-tree-selected node and its subtree, covered by a translucent
-//     overlay quad.
+//     overlay quad whose six vertices get overwritten in their buffer.
 //
-// Both are applied without a scene rebuild. The coordinator calls Refresh()
-// once per rebuild to hand over the freshly built bar nodes and re-apply the
-// persisted highlights to the new geometry.
+// Both are applied without a scene rebuild and without re-specifying any
+// buffer — a pointer sweeping across a dense calendar sends a few bytes per
+// change. The coordinator calls Refresh() or Reapply() after every rebuild,
+// to hand over freshly built bar nodes and re-apply the persisted highlights
+// to the new geometry.
 class SceneHighlighter {
  public:
   SceneHighlighter(const Scene& scene, const ShapeNode<FillShape>& overlay_node,
@@ -39,6 +41,10 @@ class SceneHighlighter {
   void Refresh(
       std::unordered_map<std::size_t, std::shared_ptr<SceneNode>> bar_nodes);
 
+  // The same for a rebuild that left the bars standing: the title frame's
+  // colours and the selected node's bounds may still have changed.
+  void Reapply();
+
   // Highlights the hovered element (and restores the previously hovered one) by
   // recolouring its shape in place — no scene rebuild. A null value clears it.
   void SetHovered(const std::optional<PickId>& hovered);
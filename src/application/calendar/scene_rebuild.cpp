@@ -0,0 +1,42 @@
+#include "scene_rebuild.hpp"
+
+#include <array>
+#include <span>
+
+namespace calendar_sections {
+
+namespace {
+
+constexpr std::array kAllSections = {
+    Section::kPage, Section::kTitle, Section::kCalendarLabels, Section::kDays,
+    Section::kMonths, Section::kYears, Section::kBars, Section::kYearTotals,
+    Section::kLegend};
+
+constexpr std::array kTitleSections = {Section::kTitle};
+
+constexpr std::array kTextSections = {Section::kText};
+
+}  // namespace
+
+std::span<const Section> SectionsFor(SceneChange change) {
+  switch (change) {
+    case SceneChange::kState:
+      return kAllSections;
+    case SceneChange::kTextEdit:
+      return kTitleSections;
+    case SceneChange::kGlyphs:
+      return kTextSections;
+  }
+  return kAllSections;
+}
+
+void RunBuild(SceneChange change, bool after_full_build,
+              SectionBuilder& builder) {
+  for (const Section section :
+       SectionsFor(after_full_build ? change : SceneChange::kState)) {
+    builder.Build(section);
+  }
+  builder.Rehighlight();
+}
+
+}  // namespace calendar_sections
@@ -0,0 +1,78 @@
+#ifndef SCENE_REBUILD_HPP
+#define SCENE_REBUILD_HPP
+
+#include <cstdint>
+#include <span>
+
+// Which parts of the calendar scene a change refills. CalendarSceneComposer
+// walks the plan; keeping it apart from the GL-bound builders lets a test pin
+// it down.
+
+namespace calendar_sections {
+
+// What made the scene stale.
+enum class SceneChange : std::uint8_t {
+  // Any change to the project state, the page or the font: everything.
+  kState,
+  // A keystroke, click or drag in the title editor. Text, caret and selection
+  // move; the layout, the grid, the bars and the legend stay as they are,
+  // along with their uploaded buffers.
+  kTextEdit,
+  // Glyphs the font rendered after the build reached the atlas. Their
+  // advances were right from the start, so only the glyph quads change: no
+  // layout, no pick box, no shape but the text.
+  kGlyphs,
+};
+
+// The section builders, in the order a full build runs them.
+enum class Section : std::uint8_t {
+  // The page, the layout and the print area — what every other section
+  // places itself in.
+  kPage,
+  // The title frame, text, caret and selection.
+  kTitle,
+  kCalendarLabels,
+  kDays,
+  kMonths,
+  kYears,
+  kBars,
+  kYearTotals,
+  kLegend,
+  // The title and every label laid out again where they stand. No part of a
+  // full build, whose sections lay their text out themselves.
+  kText,
+};
+
+// The sections `change` rebuilds, in build order.
+[[nodiscard]] std::span<const Section> SectionsFor(SceneChange change);
+
+// What a build does with the plan: CalendarSceneComposer refills the nodes,
+// a test counts.
+class SectionBuilder {
+ public:
+  SectionBuilder() = default;
+  SectionBuilder(const SectionBuilder&) = delete;
+  SectionBuilder& operator=(const SectionBuilder&) = delete;
+  SectionBuilder(SectionBuilder&&) = delete;
+  SectionBuilder& operator=(SectionBuilder&&) = delete;
+  virtual ~SectionBuilder() = default;
+
+  // Refills the nodes of `section`.
+  virtual void Build(Section section) = 0;
+
+  // Puts hover and selection back on the nodes as they now stand. Any
+  // section's fill resets the colours a hover patched — the title frame's
+  // among them — and the selection overlay covers the geometry of the build
+  // before.
+  virtual void Rehighlight() = 0;
+};
+
+// Runs the sections `change` calls for and rehighlights after, whichever ran.
+// A partial build places itself in the layout of the full build before it;
+// unless `after_full_build`, there is none yet, and every section runs.
+void RunBuild(SceneChange change, bool after_full_build,
+              SectionBuilder& builder);
+
+}  // namespace calendar_sections
+
+#endif  // SCENE_REBUILD_HPP
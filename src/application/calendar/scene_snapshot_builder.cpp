@@ -13,6 +13,7 @@
 #include "../../infrastructure/graphics/font.hpp"
 #include "../../infrastructure/graphics/rect.hpp"
 #include "../../infrastructure/graphics/scene_graph.hpp"
+#include "../../infrastructure/graphics/text_batch.hpp"
 
 SnapshotShapeKind ClassifyShape(const Drawable* shape) {
   if (shape == nullptr) {
@@ -23,8 +24,13 @@ SnapshotShapeKind ClassifyShape(const Drawable* shape) {
       return SnapshotShapeKind::kFill;
     case DrawableKind::kBoxes:
       return SnapshotShapeKind::kBoxes;
+    case DrawableKind::kGrid:
+      return SnapshotShapeKind::kGrid;
     case DrawableKind::kText:
+    case DrawableKind::kTextLabel:
       return SnapshotShapeKind::kFont;
+    case DrawableKind::kTextBatch:
+      return SnapshotShapeKind::kTextBatch;
     case DrawableKind::kNone:
       break;
   }
@@ -59,12 +65,20 @@ SnapshotBounds ToWorldBounds(const RectF& local, const glm::mat4& world) {
 }
 
 std::optional<SnapshotTextDetail> TextDetailOf(const Drawable* shape) {
-  if (shape == nullptr || shape->Kind() != DrawableKind::kText) {
+  if (shape == nullptr) {
     return std::nullopt;
   }
-  const auto& font_shape = static_cast<const FontShape&>(*shape);
-  return SnapshotTextDetail{.text = font_shape.Text(),
-                            .size_millimetres = font_shape.FontSize()};
+  if (shape->Kind() == DrawableKind::kText) {
+    const auto& font_shape = static_cast<const FontShape&>(*shape);
+    return SnapshotTextDetail{.text = font_shape.Text(),
+                              .size_millimetres = font_shape.FontSize()};
+  }
+  if (shape->Kind() == DrawableKind::kTextLabel) {
+    const auto& label = static_cast<const TextLabel&>(*shape);
+    return SnapshotTextDetail{.text = label.Text(),
+                              .size_millimetres = label.FontSize()};
+  }
+  return std::nullopt;
 }
 
 void FillSnapshotValues(SceneNodeValues& destination, const SceneNode& source,
@@ -4,15 +4,16 @@
 #include <memory>
 #include <string>
 
-#include "../../infrastructure/graphics/scene_graph.hpp"
 #include "../../infrastructure/graphics/scene_shape_filler.hpp"
+#include "../../infrastructure/graphics/shape_node.hpp"
+#include "../../infrastructure/graphics/text_batch.hpp"
 #include "calendar_scene_nodes.hpp"
 
 namespace calendar_sections::detail {
 
-scene_shapes::TextChildPool TextPool(const SectionContext& ctx,
-                                     const std::shared_ptr<SceneNode>& parent) {
-  return {parent, ctx.font_shader, calendar_layers::kText};
+scene_shapes::TextChildPool TextPool(
+    const ShapeNode<TextBatchShape>& parent) {
+  return {parent.Node(), calendar_layers::kText};
 }
 
 void SetCenteredText(const SectionContext& ctx,
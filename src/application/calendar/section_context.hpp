@@ -16,18 +16,22 @@
 #include "../../domain/shape_configuration.hpp"
 #include "../../domain/text_edit_view.hpp"
 #include "../../domain/title_config.hpp"
+#include "../../infrastructure/graphics/advance_table.hpp"
 #include "../../infrastructure/graphics/font.hpp"
+#include "../../infrastructure/graphics/grid_pattern.hpp"
+#include "../../infrastructure/graphics/grid_shape.hpp"
 #include "../../infrastructure/graphics/pick_id.hpp"
 #include "../../infrastructure/graphics/scene_graph.hpp"
 #include "../../infrastructure/graphics/scene_shape_filler.hpp"
 #include "../../infrastructure/graphics/shaders.hpp"
 #include "../../infrastructure/graphics/shape_node.hpp"
 #include "../../infrastructure/graphics/shapes.hpp"
+#include "../../infrastructure/graphics/text_batch.hpp"
 #include "calendar_layout.hpp"
 #include "calendar_scene_nodes.hpp"
 
 // The shared ground of the section builders: what every one of them gets
-// handed, what BuildBars hands back, and the two adapters that map a domain
+// handed, what BuildBars hands back, and the adapters that map a domain
 // ShapeConfiguration onto the general scene primitives.
 
 namespace calendar_sections {
@@ -42,6 +46,9 @@ struct SectionContext {
   const DateEntryBars& date_entry_bars;
   // Empty while nobody edits text in the canvas.
   const std::optional<TextEditView>& text_edit;
+  // Where each character of the title starts, kept across builds so an edit
+  // measures only from the changed character on.
+  AdvanceTable& title_advances;
   const std::shared_ptr<Font>& font;
   // The application-wide chosen font including its point size.
   const FontConfig& font_config;
@@ -77,11 +84,31 @@ inline void FillRectangles(const ShapeNode<BoxesShape>& node,
   node.Node()->SetStyleId(config.Name());
 }
 
-// A pool of text children under `parent`, on the text draw layer. One per
-// label group and rebuild; it hands the nodes of the previous rebuild back out
-// instead of building new ones (#69).
+// The same for a grid node: every `period`-th cell of each row from its phase
+// on, or every other cell, drawn in the configuration's colours.
+inline void FillGrid(const ShapeNode<GridShape>& node,
+                     const std::vector<grid_pattern::CellRow>& rows,
+                     float cell_width, int period,
+                     grid_pattern::CellSelection selection,
+                     const ShapeConfiguration& config) {
+  node.Shape().SetShape(
+      rows, grid_pattern::Pattern{
+                .cell_width = cell_width,
+                .period = period,
+                .selection = selection,
+                .style = grid_pattern::CellStyle{
+                    .line_width = config.LineWidth(),
+                    .outline_color = config.OutlineColor(),
+                    .fill_color = config.FillColor()}});
+  node.Node()->SetStyleId(config.Name());
+}
+
+// A pool of text labels under the batch node `parent`, on the text draw layer.
+// One per label group and rebuild; it hands the nodes of the previous rebuild
+// back out instead of building new ones (#69). The composer commits the batch
+// once every section is built.
 [[nodiscard]] scene_shapes::TextChildPool TextPool(
-    const SectionContext& ctx, const std::shared_ptr<SceneNode>& parent);
+    const ShapeNode<TextBatchShape>& parent);
 
 void SetCenteredText(const SectionContext& ctx,
                      scene_shapes::TextChildPool& pool, const std::string& name,
@@ -23,11 +23,14 @@ TextLine Layout(const SectionContext& ctx) {
   TextLine line;
   line.text = ctx.text_edit.has_value() ? ctx.text_edit->text
                                         : ctx.title_config.TitleText();
-  const std::vector<char32_t> decoded = DecodeUtf8(line.text);
-  line.code_points.assign(decoded.begin(), decoded.end());
+  DecodeUtf8Into(line.text, line.code_points);
+  ctx.title_advances.Update(line.code_points, [&ctx](char32_t code_point) {
+    return ctx.font->GetLetter(code_point).advance;
+  });
   line.font_size = ctx.title_config.FontSizeMillimetres();
-  line.left = ctx.layout.TitleArea().Center().x -
-              (ctx.font->TextWidth(line.text, line.font_size) * detail::kHalf);
+  const float width =
+      ctx.title_advances.Width(line.code_points.size()) * line.font_size;
+  line.left = ctx.layout.TitleArea().Center().x - (width * detail::kHalf);
   return line;
 }
 
@@ -45,8 +48,7 @@ void FillCaretAndSelection(const SectionContext& ctx, const TextLine& line) {
   const float bottom = center_y - (text_height * detail::kHalf);
   const float top = center_y + (text_height * detail::kHalf);
   const auto offset = [&](std::size_t index) {
-    return line.left +
-           ctx.font->TextWidth(line.code_points, line.font_size, index);
+    return line.left + (ctx.title_advances.Width(index) * line.font_size);
   };
 
   const float caret_x = offset(ctx.text_edit->caret);
@@ -68,8 +70,10 @@ void FillCaretAndSelection(const SectionContext& ctx, const TextLine& line) {
 std::size_t CaretIndexAt(const SectionContext& ctx, const TextLine& line,
                          glm::vec2 page_point) {
   const float local_x = page_point.x - ctx.layout.PrintAreaOrigin().x;
-  return ctx.font->IndexAtOffset(line.code_points, line.font_size,
-                                 local_x - line.left);
+  if (line.font_size <= 0.0F) {
+    return 0;
+  }
+  return ctx.title_advances.IndexAt((local_x - line.left) / line.font_size);
 }
 
 }  // namespace title_edit
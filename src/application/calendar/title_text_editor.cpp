@@ -146,8 +146,9 @@ void TitleTextEditor::Commit() {
 void TitleTextEditor::Cancel() { End(); }
 
 std::u32string TitleTextEditor::ToCodePoints(const std::string& text) {
-  const std::vector<char32_t> decoded = DecodeUtf8(text);
-  return {decoded.begin(), decoded.end()};
+  std::u32string code_points;
+  DecodeUtf8Into(text, code_points);
+  return code_points;
 }
 
 void TitleTextEditor::End() {
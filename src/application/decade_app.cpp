@@ -12,8 +12,10 @@
 #include <memory>
 
 #include "../common/debug_log.hpp"
+#include "../infrastructure/graphics/render_to_png.hpp"
 #include "../presentation/gl_canvas.hpp"
 #include "app_composition.hpp"
+#include "headless_composition.hpp"
 #include "locale_services.hpp"
 #include "runtime_info.hpp"
 #include "runtime_options.hpp"
@@ -39,9 +41,14 @@ void MessageHandler(QtMsgType type, const QMessageLogContext& /*unused*/,
 }  // namespace
 
 int RunDecadeApp(int& argument_count, char** arguments) {
-  QSurfaceFormat::setDefaultFormat(GLCanvas::SurfaceFormat());
-
-  const QApplication app(argument_count, arguments);
+  const bool headless = RequestsHeadless(argument_count, arguments);
+  std::unique_ptr<QCoreApplication> app;
+  if (headless) {
+    app = std::make_unique<QCoreApplication>(argument_count, arguments);
+  } else {
+    QSurfaceFormat::setDefaultFormat(GLCanvas::SurfaceFormat());
+    app = std::make_unique<QApplication>(argument_count, arguments);
+  }
   QCoreApplication::setApplicationName("decade");
 
   QCommandLineParser parser;
@@ -49,10 +56,13 @@ int RunDecadeApp(int& argument_count, char** arguments) {
       "A calendar and timeline for periods across several years.");
   parser.addHelpOption();
   AddRuntimeOptions(parser);
-  parser.process(app);
+  parser.process(*app);
 
   const RuntimeOptions runtime_options = RuntimeOptionsFromParser(parser);
   decade_debug::SetLogEnabled(runtime_options.debug_log);
+  if (runtime_options.export_gpu_budget_mib) {
+    SetExportGpuBudget(*runtime_options.export_gpu_budget_mib << 20U);
+  }
   qInstallMessageHandler(MessageHandler);
 
   std::unique_ptr<LocaleServices> locale_services;
@@ -67,6 +77,11 @@ int RunDecadeApp(int& argument_count, char** arguments) {
     PrintRuntimeInfo(std::cout);
   }
 
+  if (headless) {
+    HeadlessComposition composition(locale_services->date_formatter(),
+                                    runtime_options);
+    return composition.Run();
+  }
   const AppComposition composition(locale_services->date_formatter(),
                                    runtime_options);
   return QApplication::exec();
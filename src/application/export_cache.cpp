@@ -0,0 +1,91 @@
+#include "export_cache.hpp"
+
+#include <array>
+#include <charconv>
+#include <clocale>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "../common/fnv_hash.hpp"
+#include "../domain/font_config.hpp"
+#include "../infrastructure/graphics/png_strip_encoder.hpp"
+#include "../infrastructure/graphics/png_writer.hpp"
+#include "../infrastructure/graphics/software_raster.hpp"
+
+namespace application {
+namespace {
+
+// Raised whenever the page drawing changes what an unchanged project looks
+// like; every image written before then reads as stale.
+constexpr std::string_view kKeyVersion = "1";
+
+// The font file as far as the key cares: where it is, how large and when it
+// last changed. A file that cannot be looked at is its path alone.
+std::string FontIdentity(const std::string& file_path) {
+  std::string identity = file_path;
+  std::error_code error;
+  const auto size = std::filesystem::file_size(file_path, error);
+  if (error) {
+    return identity;
+  }
+  const auto changed = std::filesystem::last_write_time(file_path, error);
+  if (error) {
+    return identity;
+  }
+  identity += '|' + std::to_string(size) + '|' +
+              std::to_string(changed.time_since_epoch().count());
+  return identity;
+}
+
+std::string Number(float value) {
+  std::array<char, 32> buffer{};
+  const auto result =
+      std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+  return {buffer.data(), result.ptr};
+}
+
+}  // namespace
+
+std::string ExportKey(std::string_view project_state,
+                      const FontConfig& font_config,
+                      std::string_view time_locale, int dpi,
+                      int msaa_samples, const png_io::EncodeOptions& encoding,
+                      software_raster::PageRenderer renderer) {
+  std::uint64_t hash = fnv_hash::kOffsetBasis;
+  hash = fnv_hash::AddField(hash, project_state);
+  hash = fnv_hash::AddField(hash, FontIdentity(font_config.FilePath()));
+  hash = fnv_hash::AddField(hash, Number(font_config.SizePoints()));
+  hash = fnv_hash::AddField(hash, time_locale);
+  hash = fnv_hash::AddField(hash, std::to_string(dpi));
+  hash = fnv_hash::AddField(hash, std::to_string(msaa_samples));
+  hash = fnv_hash::AddField(hash,
+                            std::to_string(encoding.compression_level));
+  hash = fnv_hash::AddField(
+      hash, std::to_string(static_cast<int>(encoding.filter)));
+  hash = fnv_hash::AddField(hash,
+                            std::to_string(static_cast<int>(renderer)));
+
+  constexpr int kHexBase = 16;
+  constexpr std::size_t kHexDigits = 16;
+  std::array<char, kHexDigits> digits{};
+  const auto result = std::to_chars(
+      digits.data(), digits.data() + digits.size(), hash, kHexBase);
+  const std::string hex(digits.data(), result.ptr);
+  return "v" + std::string(kKeyVersion) + "-" +
+         std::string(kHexDigits - hex.size(), '0') + hex;
+}
+
+std::string TimeLocaleName() {
+  const char* name = std::setlocale(LC_TIME, nullptr);
+  return name != nullptr ? name : "";
+}
+
+bool IsExportUpToDate(const std::string& file_path, std::string_view key) {
+  const auto stored = png_io::ReadPngText(file_path, kExportKeyword);
+  return stored.has_value() && *stored == key;
+}
+
+}  // namespace application
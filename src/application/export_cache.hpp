@@ -0,0 +1,47 @@
+#ifndef EXPORT_CACHE_HPP
+#define EXPORT_CACHE_HPP
+
+#include <string>
+#include <string_view>
+
+#include "../domain/font_config.hpp"
+#include "../infrastructure/graphics/png_strip_encoder.hpp"
+#include "../infrastructure/graphics/software_raster.hpp"
+
+namespace application {
+
+// Lets a page export skip the render when the PNG already on disk was made
+// from the same inputs — a nightly run re-exports many calendars nobody
+// touched. Every --dump-png and --export-batch image carries a key in a tEXt
+// chunk, a hash over everything the pixels depend on; before rendering, the
+// key of the file at the output path is read back (without decoding the
+// image) and compared.
+//
+// The inputs: the project in its canonical form (ProjectDocument::
+// CanonicalState, the saved XML — entries, groups, page setup, title, shape
+// and calendar configuration), the font file's identity (path, size and time
+// of last change, so a replaced file counts as another font) and point size,
+// and the export settings. kKeyVersion stands for the renderer itself; it is
+// raised when a change to the drawing code makes older images stale.
+inline constexpr std::string_view kExportKeyword = "Decade export key";
+
+// `project_state` hashed together with the font, the time locale and the
+// export settings; a version prefix and 16 hex digits.
+[[nodiscard]] std::string ExportKey(std::string_view project_state,
+                                    const FontConfig& font_config,
+                                    std::string_view time_locale, int dpi,
+                                    int msaa_samples,
+                                    const png_io::EncodeOptions& encoding,
+                                    software_raster::PageRenderer renderer);
+
+// The name of the C library's LC_TIME locale, which strftime spells the month
+// labels in; empty when it cannot be queried.
+[[nodiscard]] std::string TimeLocaleName();
+
+// True when the PNG at `file_path` exists and carries `key`.
+[[nodiscard]] bool IsExportUpToDate(const std::string& file_path,
+                                    std::string_view key);
+
+}  // namespace application
+
+#endif  // EXPORT_CACHE_HPP
@@ -0,0 +1,156 @@
+#include "export_manifest.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "../domain/calendar_config.hpp"
+
+namespace application {
+namespace {
+
+// Splits `line` at blanks; a token in double quotes may hold blanks. Nullopt
+// when a quote stays open.
+std::optional<std::vector<std::string>> Tokens(std::string_view line) {
+  std::vector<std::string> tokens;
+  std::size_t index = 0;
+  while (true) {
+    while (index < line.size() && (line[index] == ' ' || line[index] == '\t')) {
+      ++index;
+    }
+    if (index == line.size()) {
+      return tokens;
+    }
+    if (line[index] == '"') {
+      const std::size_t close = line.find('"', index + 1);
+      if (close == std::string_view::npos) {
+        return std::nullopt;
+      }
+      tokens.emplace_back(line.substr(index + 1, close - index - 1));
+      index = close + 1;
+      continue;
+    }
+    const std::size_t end = line.find_first_of(" \t", index);
+    const std::size_t stop = end == std::string_view::npos ? line.size() : end;
+    tokens.emplace_back(line.substr(index, stop - index));
+    index = stop;
+  }
+}
+
+// The whole of `text` as an int, or nullopt.
+std::optional<int> Integer(std::string_view text) {
+  int value = 0;
+  const auto [end, error] =
+      std::from_chars(text.data(), text.data() + text.size(), value);
+  if (error != std::errc{} || end != text.data() + text.size()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+std::optional<CalendarSpan::YearSpan> Years(std::string_view text) {
+  // Past the first character, so a negative first year would still split
+  // right — not that a calendar goes there.
+  const std::size_t dash = text.find('-', 1);
+  if (dash == std::string_view::npos) {
+    return std::nullopt;
+  }
+  const auto first = Integer(text.substr(0, dash));
+  const auto last = Integer(text.substr(dash + 1));
+  if (!first || !last || *last < *first) {
+    return std::nullopt;
+  }
+  return CalendarSpan::YearSpan{.first_year = *first, .last_year = *last};
+}
+
+// Applies one `key=value` option to `job`; the complaint when it is wrong.
+std::optional<std::string> ApplyOption(std::string_view option,
+                                       ExportJob& job) {
+  const std::size_t equals = option.find('=');
+  const std::string_view key = option.substr(0, equals);
+  const std::string_view value = equals == std::string_view::npos
+                                     ? std::string_view{}
+                                     : option.substr(equals + 1);
+  if (key == "dpi") {
+    const auto dpi = Integer(value);
+    if (!dpi || *dpi <= 0) {
+      return "dpi must be a positive number, not '" + std::string(value) + "'";
+    }
+    job.dpi = dpi;
+    return std::nullopt;
+  }
+  if (key == "years") {
+    job.years = Years(value);
+    if (!job.years) {
+      return "years must read <first>-<last>, not '" + std::string(value) +
+             "'";
+    }
+    return std::nullopt;
+  }
+  return "unknown option '" + std::string(option) + "'";
+}
+
+}  // namespace
+
+ExportManifest ParseExportManifest(
+    std::istream& text, const std::filesystem::path& base_directory) {
+  ExportManifest manifest;
+  std::string line;
+  for (std::size_t number = 1; std::getline(text, line); ++number) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    const auto complain = [&manifest, number](const std::string& what) {
+      manifest.errors.push_back("line " + std::to_string(number) + ": " +
+                                what);
+    };
+
+    const std::size_t start = line.find_first_not_of(" \t");
+    if (start == std::string::npos || line[start] == '#') {
+      continue;
+    }
+    const auto tokens = Tokens(line);
+    if (!tokens) {
+      complain("unclosed quote");
+      continue;
+    }
+    if (tokens->size() < 2) {
+      complain("needs an input file and an output path");
+      continue;
+    }
+
+    ExportJob job{.input = base_directory / (*tokens)[0],
+                  .output = base_directory / (*tokens)[1],
+                  .dpi = std::nullopt,
+                  .years = std::nullopt};
+    std::optional<std::string> error;
+    for (std::size_t index = 2; index < tokens->size() && !error; ++index) {
+      error = ApplyOption((*tokens)[index], job);
+    }
+    if (error) {
+      complain(*error);
+      continue;
+    }
+    manifest.jobs.push_back(std::move(job));
+  }
+  return manifest;
+}
+
+std::optional<ExportManifest> ReadExportManifest(
+    const std::filesystem::path& file) {
+  std::ifstream text(file);
+  if (!text) {
+    return std::nullopt;
+  }
+  return ParseExportManifest(text, file.parent_path());
+}
+
+}  // namespace application
@@ -0,0 +1,50 @@
+#ifndef EXPORT_MANIFEST_HPP
+#define EXPORT_MANIFEST_HPP
+
+#include <filesystem>
+#include <istream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../domain/calendar_config.hpp"
+
+namespace application {
+
+// One image of an --export-batch run: the project or CSV file to load, the
+// PNG to write, and what the item sets apart from the run's defaults.
+struct ExportJob {
+  std::filesystem::path input;
+  std::filesystem::path output;
+  std::optional<int> dpi;
+  // A fixed year span in place of the one the file brings.
+  std::optional<CalendarSpan::YearSpan> years;
+};
+
+struct ExportManifest {
+  std::vector<ExportJob> jobs;
+  // "line N: ..." for every line that got skipped.
+  std::vector<std::string> errors;
+};
+
+// Reads a batch manifest: one image per line, the input file and the output
+// path first, then optional `dpi=<dots per inch>` and `years=<first>-<last>`,
+// all separated by blanks. A path holding blanks goes in double quotes;
+// relative paths count from `base_directory`, the manifest's own. Blank lines
+// and lines opening with '#' are ignored. A line that does not parse is
+// skipped and named in `errors`, so one typo does not cost the whole night's
+// run.
+//
+//   # input                  output              options
+//   projects/team_a.xml      out/team_a.png      dpi=300
+//   "data/leave 2025.csv"    out/leave_2025.png  years=2025-2025
+[[nodiscard]] ExportManifest ParseExportManifest(
+    std::istream& text, const std::filesystem::path& base_directory);
+
+// The manifest in `file`, nullopt when the file cannot be read.
+[[nodiscard]] std::optional<ExportManifest> ReadExportManifest(
+    const std::filesystem::path& file);
+
+}  // namespace application
+
+#endif  // EXPORT_MANIFEST_HPP
@@ -0,0 +1,120 @@
+#include "headless_composition.hpp"
+
+#include <fontconfig/fontconfig.h>
+
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../common/debug_log.hpp"
+#include "../domain/date_format.hpp"
+#include "../domain/font_config.hpp"
+#include "../infrastructure/graphics/font_match.hpp"
+#include "../infrastructure/graphics/png_strip_encoder.hpp"
+#include "../infrastructure/graphics/png_writer.hpp"
+#include "../infrastructure/graphics/software_raster.hpp"
+#include "../presentation/headless_canvas.hpp"
+#include "app_binder.hpp"
+#include "calendar/calendar_page.hpp"
+#include "project_document.hpp"
+#include "runtime_options.hpp"
+#include "startup_script.hpp"
+
+namespace application {
+
+namespace {
+
+struct FcConfigDeleter {
+  void operator()(FcConfig* config) const { FcConfigDestroy(config); }
+};
+
+}  // namespace
+
+HeadlessComposition::HeadlessComposition(
+    LocaleDateFormatter& locale_date_formatter, RuntimeOptions options)
+    : runtime_options_(std::move(options)),
+      document_(bus_, locale_date_formatter),
+      startup_script_(runtime_options_, document_) {}
+
+HeadlessComposition::~HeadlessComposition() {
+  wiring_.reset();
+  if (calendar_page_.has_value()) {
+    canvas_->MakeGraphicsCurrent();
+  }
+  calendar_page_.reset();
+}
+
+int HeadlessComposition::Run() {
+  if (runtime_options_.dump_frame_png_path) {
+    std::cerr << "--dump-frame-png needs the window; ignored with --headless\n";
+  }
+  if (!runtime_options_.dump_png_path && !runtime_options_.dump_dzi_path &&
+      !runtime_options_.dump_svg_path && !runtime_options_.dump_pdf_path &&
+      !runtime_options_.export_batch_path) {
+    std::cerr << "--headless: nothing to write; give --dump-png, --dump-dzi, "
+                 "--dump-svg or --export-batch\n";
+    return 0;
+  }
+
+  try {
+    HeadlessCanvas& canvas = canvas_.emplace();
+    CalendarPage& calendar_page = calendar_page_.emplace(
+        canvas.Engine(), canvas, DefaultFontConfig(), bus_.scene_snapshot);
+    const HeadlessComponents components{
+        .date_groups_store = document_.DateGroups(),
+        .date_entry_store = document_.DateEntries(),
+        .transform_date_entry = document_.Transform(),
+        .page_setup_store = document_.PageSetup(),
+        .title_config_store = document_.TitleConfiguration(),
+        .shape_configuration_store = document_.ShapeConfiguration(),
+        .calendar_configuration_store = document_.CalendarConfiguration(),
+        .calendar_page = calendar_page,
+        .headless_canvas = canvas,
+    };
+    wiring_.emplace(bus_, components);
+  } catch (const std::exception& error) {
+    wiring_.reset();
+    calendar_page_.reset();
+    canvas_.reset();
+    std::cerr << "--headless: " << error.what() << '\n';
+    return 1;
+  }
+
+  startup_script_.RunHeadless(
+      calendar_page_->Font(), canvas_->ExportSamples(),
+      [this](const std::string& file_path, int dpi,
+             const png_io::EncodeOptions& encoding,
+             software_raster::PageRenderer renderer,
+             const std::vector<png_io::PngText>& text) {
+        return canvas_->SavePNG(file_path, dpi, encoding, renderer, text);
+      },
+      [this](const std::string& file_path, int dpi,
+             const png_io::EncodeOptions& encoding,
+             software_raster::PageRenderer renderer) {
+        return canvas_->SaveDeepZoom(file_path, dpi, encoding, renderer);
+      },
+      [this]() { return canvas_->VectorPage(); });
+  return 0;
+}
+
+FontConfig HeadlessComposition::DefaultFontConfig() {
+  FontConfig font_config;
+  const std::unique_ptr<FcConfig, FcConfigDeleter> fc_config(
+      FcInitLoadConfigAndFonts());
+  if (const auto file_path =
+          MatchFontFile(fc_config.get(),
+                        {.family = "sans-serif",
+                         .point_size = font_config.SizePoints()})) {
+    font_config.SetFilePath(*file_path);
+  }
+  if (decade_debug::LogEnabled()) {
+    std::cout << "font_filepath: " << font_config.FilePath() << '\n';
+  }
+  return font_config;
+}
+
+}  // namespace application
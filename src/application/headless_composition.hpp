@@ -0,0 +1,64 @@
+#ifndef HEADLESS_COMPOSITION_HPP
+#define HEADLESS_COMPOSITION_HPP
+
+#include <optional>
+
+#include "../domain/date_format.hpp"
+#include "../domain/font_config.hpp"
+#include "../presentation/headless_canvas.hpp"
+#include "app_binder.hpp"
+#include "calendar/calendar_page.hpp"
+#include "event_bus.hpp"
+#include "project_document.hpp"
+#include "runtime_options.hpp"
+#include "startup_script.hpp"
+
+namespace application {
+
+// The composition root of a --headless run: AppComposition without the
+// window. The document and the rendering adapter are the same; the adapter
+// draws on a HeadlessCanvas, the wiring is HeadlessWiring, and the startup
+// script writes the page images and is done — no event loop runs, so the
+// process ends with the last image instead of a timer.
+//
+// What the window brings up and an export never looks at — the widgets, the
+// platform plugin, the connection to a display server — stays out, and with
+// it the bulk of a --dump-png start.
+class HeadlessComposition {
+ public:
+  HeadlessComposition(LocaleDateFormatter& locale_date_formatter,
+                      RuntimeOptions options);
+
+  ~HeadlessComposition();
+  HeadlessComposition(const HeadlessComposition&) = delete;
+  HeadlessComposition& operator=(const HeadlessComposition&) = delete;
+  HeadlessComposition(HeadlessComposition&&) = delete;
+  HeadlessComposition& operator=(HeadlessComposition&&) = delete;
+
+  // Brings up context, page and wiring, then writes the images. The process
+  // exit status: 1 when there was no context or no scene to draw with, 0
+  // otherwise — an image that failed has said so on stderr already.
+  [[nodiscard]] int Run();
+
+ private:
+  // The file of the default font: what fontconfig makes of "sans-serif" at
+  // the default size, as the font panel would for a desktop without a
+  // configured font. Empty when nothing matches, and the page fails to come
+  // up then, as it would in the window.
+  [[nodiscard]] static FontConfig DefaultFontConfig();
+
+  // Declared first, so destroyed last, as in AppComposition.
+  EventBus bus_;
+
+  RuntimeOptions runtime_options_;
+  ProjectDocument document_;
+  StartupScript startup_script_;
+
+  std::optional<HeadlessCanvas> canvas_;
+  std::optional<CalendarPage> calendar_page_;
+  std::optional<HeadlessWiring> wiring_;
+};
+
+}  // namespace application
+
+#endif  // HEADLESS_COMPOSITION_HPP
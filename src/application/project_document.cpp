@@ -57,12 +57,31 @@ std::optional<std::string> ProjectDocument::SaveXml(std::string file_path) {
   return std::nullopt;
 }
 
+std::string ProjectDocument::CanonicalState() const {
+  return persistence::ProjectXml(date_groups_store_, date_entry_store_,
+                                 page_setup_store_, title_config_store_,
+                                 shape_configuration_store_,
+                                 calendar_configuration_store_);
+}
+
 void ProjectDocument::ImportCsv(const std::string& file_path) {
   const StateBurst burst(state_burst_topic_);
   date_entry_store_.ReceiveDateEntries(
       persistence::ReadDateEntriesFromCsv(file_path, locale_date_formatter_));
 }
 
+void ProjectDocument::Reset() {
+  const StateBurst burst(state_burst_topic_);
+  // Groups before entries, as on a load.
+  date_groups_store_.ReceiveDateGroups({});
+  date_entry_store_.ReceiveDateEntries({});
+  page_setup_store_.ReceivePageSetup(PageSetupConfig{});
+  title_config_store_.ReceiveTitleConfig(TitleConfig{});
+  shape_configuration_store_.ReceiveShapeConfigSet(ShapeConfigSet{});
+  calendar_configuration_store_.ReceiveCalendarConfig(CalendarConfig{});
+  SetFilePath({});
+}
+
 std::optional<std::string> ProjectDocument::ExportCsv(
     const std::string& file_path) const {
   return persistence::WriteDateEntriesToCsv(
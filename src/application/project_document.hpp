@@ -42,9 +42,16 @@ class ProjectDocument {
 
   void ImportCsv(const std::string& file_path);
 
+  // Back to the project a start without a file opens: every store at its
+  // default and no path. One change on the bus, like a load.
+  void Reset();
+
   [[nodiscard]] std::optional<std::string> ExportCsv(
       const std::string& file_path) const;
 
+  // The project as SaveXml would write it, for the export cache's key.
+  [[nodiscard]] std::string CanonicalState() const;
+
   [[nodiscard]] bool HasFilePath() const;
   [[nodiscard]] const std::string& FilePath() const;
 
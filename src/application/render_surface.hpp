@@ -1,6 +1,8 @@
 #ifndef RENDER_SURFACE_HPP
 #define RENDER_SURFACE_HPP
 
+#include <functional>
+
 namespace application {
 
 // The port through which the rendering adapter asks for a repaint, without
@@ -36,6 +38,11 @@ class RenderSurface {
   // textures. The surface makes its context current; without it the calls
   // dispatch into whatever context happens to be current, which is none.
   virtual void MakeGraphicsCurrent() = 0;
+
+  // Runs `task` later on the thread the surface belongs to, whichever thread
+  // asks. Work finished elsewhere (glyphs the font's workers rendered) comes
+  // back this way to where GL may be called.
+  virtual void PostToGraphicsThread(std::function<void()> task) = 0;
 };
 
 }  // namespace application
@@ -9,14 +9,42 @@
 #include <cstddef>
 #include <iostream>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+
+#include "../infrastructure/graphics/png_strip_encoder.hpp"
+#include "../infrastructure/graphics/software_raster.hpp"
 
 namespace application {
 
 bool IsNonInteractiveRun(const RuntimeOptions& options) {
   return options.dump_png_path.has_value() ||
+         options.dump_svg_path.has_value() ||
+         options.dump_pdf_path.has_value() ||
+         options.dump_dzi_path.has_value() ||
          options.dump_frame_png_path.has_value() ||
-         options.exit_after_ms.has_value();
+         options.export_batch_path.has_value() ||
+         options.exit_after_ms.has_value() || options.headless;
+}
+
+bool RequestsHeadless(int argument_count, const char* const* arguments) {
+  const std::span<const char* const> all(
+      arguments, static_cast<std::size_t>(argument_count));
+  if (all.empty()) {
+    return false;
+  }
+  for (const char* argument : all.subspan(1)) {
+    const std::string_view text(argument);
+    // Past "--" everything is a positional argument.
+    if (text == "--") {
+      return false;
+    }
+    if (text == "--headless") {
+      return true;
+    }
+  }
+  return false;
 }
 
 // Registers every runtime option at the parser. The descriptions turn up in the
@@ -25,8 +53,36 @@ void AddRuntimeOptions(QCommandLineParser& parser) {
   parser.addOption(
       {"dump-png", "render the calendar page to PNG (off-screen FBO)", "path"});
   parser.addOption({"dump-png-dpi", "export DPI for --dump-png", "dpi"});
+  parser.addOption({"dump-png-compression",
+                    "zlib level 0-9 for --dump-png (default 6)", "level"});
+  parser.addOption({"dump-png-filter",
+                    "row filter for --dump-png: none, sub, up, average, "
+                    "paeth or adaptive (default)",
+                    "filter"});
+  parser.addOption({"dump-png-renderer",
+                    "who draws --dump-png: gl (default) or cpu, a software "
+                    "rasterizer",
+                    "renderer"});
+  parser.addOption(
+      {"dump-svg", "write the calendar page as SVG vector graphics", "path"});
+  parser.addOption({"dump-pdf",
+                    "write the calendar page as a PDF (not with --headless)",
+                    "path"});
+  parser.addOption({"dump-dzi",
+                    "write the calendar page as a Deep Zoom tile pyramid at "
+                    "--dump-png-dpi",
+                    "path"});
   parser.addOption(
       {"dump-frame-png", "capture the whole main frame to PNG", "path"});
+  parser.addOption({"export-batch",
+                    "write every image a manifest lists, then exit", "path"});
+  parser.addOption({"export-force",
+                    "render --dump-png and --export-batch images even when "
+                    "the file is up to date"});
+  parser.addOption({"export-gpu-budget",
+                    "GPU memory for one --dump-png tile in MiB (default 512); "
+                    "the tile size follows from it",
+                    "mib"});
   parser.addOption({"select-tab",
                     "pre-select a notebook tab by label (case-insensitive)",
                     "label"});
@@ -42,6 +98,10 @@ void AddRuntimeOptions(QCommandLineParser& parser) {
                     "force the scene-tree selection on node path root/.../name",
                     "path"});
   parser.addOption({"debug-log", "enable debug logging"});
+  parser.addOption({"headless",
+                    "write --dump-png, --dump-svg, --dump-dzi and "
+                    "--export-batch images "
+                    "without a window or display server, then exit"});
   parser.addPositionalArgument("file", "project or CSV file to load at start",
                                "[file]");
 }
@@ -82,12 +142,18 @@ RuntimeOptions RuntimeOptionsFromParser(const QCommandLineParser& parser) {
     options.startup_file = positional.first().toStdString();
   }
   options.dump_png_path = FoundString(parser, "dump-png");
+  options.dump_svg_path = FoundString(parser, "dump-svg");
+  options.dump_pdf_path = FoundString(parser, "dump-pdf");
+  options.dump_dzi_path = FoundString(parser, "dump-dzi");
   options.dump_frame_png_path = FoundString(parser, "dump-frame-png");
+  options.export_batch_path = FoundString(parser, "export-batch");
+  options.export_force = parser.isSet("export-force");
   options.select_tab = FoundString(parser, "select-tab");
   options.debug_select_node = FoundString(parser, "debug-select-node");
   options.debug_hover_title = parser.isSet("debug-hover-title");
   options.debug_edit_title = FoundString(parser, "debug-edit-title");
   options.debug_log = parser.isSet("debug-log");
+  options.headless = parser.isSet("headless");
 
   if (const auto dump_png_dpi = FoundNumber(parser, "dump-png-dpi")) {
     if (*dump_png_dpi > 0) {
@@ -97,6 +163,42 @@ RuntimeOptions RuntimeOptionsFromParser(const QCommandLineParser& parser) {
     }
   }
 
+  constexpr long long kMaxCompression = 9;
+  if (const auto compression = FoundNumber(parser, "dump-png-compression")) {
+    if (*compression >= 0 && *compression <= kMaxCompression) {
+      options.dump_png_compression = static_cast<int>(*compression);
+    } else {
+      std::cerr << "--dump-png-compression must be 0 to 9; ignored\n";
+    }
+  }
+
+  if (const auto filter = FoundString(parser, "dump-png-filter")) {
+    options.dump_png_filter = png_io::FilterFromName(*filter);
+    if (!options.dump_png_filter) {
+      std::cerr << "--dump-png-filter " << *filter << " is unknown; ignored\n";
+    }
+  }
+
+  if (const auto renderer = FoundString(parser, "dump-png-renderer")) {
+    options.dump_png_renderer =
+        software_raster::PageRendererFromName(*renderer);
+    if (!options.dump_png_renderer) {
+      std::cerr << "--dump-png-renderer " << *renderer
+                << " is unknown; ignored\n";
+    }
+  }
+
+  // A terabyte is beyond any card and keeps the byte count clear of overflow.
+  constexpr long long kMaxGpuBudgetMib = 1LL << 20;
+  if (const auto budget = FoundNumber(parser, "export-gpu-budget")) {
+    if (*budget > 0 && *budget <= kMaxGpuBudgetMib) {
+      options.export_gpu_budget_mib = static_cast<std::size_t>(*budget);
+    } else {
+      std::cerr << "--export-gpu-budget must be 1 to " << kMaxGpuBudgetMib
+                << "; ignored\n";
+    }
+  }
+
   if (const auto exit_after_ms = FoundNumber(parser, "exit-after-ms")) {
     if (*exit_after_ms > 0) {
       options.exit_after_ms = *exit_after_ms;
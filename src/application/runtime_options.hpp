@@ -7,6 +7,9 @@
 #include <optional>
 #include <string>
 
+#include "../infrastructure/graphics/png_strip_encoder.hpp"
+#include "../infrastructure/graphics/software_raster.hpp"
+
 namespace application {
 
 // The runtime options for non-interactive runs (CI, screenshots, smoke tests)
@@ -21,7 +24,26 @@ struct RuntimeOptions {
   std::optional<std::string> dump_png_path;
   // The export DPI for dump_png_path; the fallback is GLCanvas::kExportPngDpi.
   std::optional<int> dump_png_dpi;
+  // How dump_png_path gets compressed; unset parts keep png_io's defaults.
+  std::optional<int> dump_png_compression;
+  std::optional<png_io::PngFilter> dump_png_filter;
+  // Who draws the --dump-png and --export-batch images; unset is the GL
+  // pipeline.
+  std::optional<software_raster::PageRenderer> dump_png_renderer;
+  // The page as vectors, sized in millimetres whatever the dpi.
+  std::optional<std::string> dump_svg_path;
+  std::optional<std::string> dump_pdf_path;
+  // The page as a Deep Zoom tile pyramid, its largest level at the dpi.
+  std::optional<std::string> dump_dzi_path;
   std::optional<std::string> dump_frame_png_path;
+  // A manifest of images to write one after another; see export_manifest.hpp.
+  std::optional<std::string> export_batch_path;
+  // Renders the --dump-png and --export-batch images even where the file on
+  // disk is up to date (export_cache.hpp).
+  bool export_force{false};
+  // The GPU memory one export tile may take, in MiB; unset keeps
+  // tile_budget::kDefaultBudgetBytes.
+  std::optional<std::size_t> export_gpu_budget_mib;
   std::optional<std::string> select_tab;
   std::optional<std::int64_t> exit_after_ms;
   // A debug and screenshot aid: it forces the hover highlight onto this bar
@@ -37,14 +59,25 @@ struct RuntimeOptions {
   // node path at start, so the selection overlay is checkable without a mouse.
   std::optional<std::string> debug_select_node;
   bool debug_log{false};
+  // No window at all: the page images only, on a context of their own.
+  bool headless{false};
 };
 
 // The mark of a non-interactive run: an image capture or an auto exit is asked
 // for. No modal dialogue may stand there — it blocks the run until the timeout
 // instead of reporting. This run needs a display too; headless in the literal
-// sense it is not.
+// sense is --headless alone.
 [[nodiscard]] bool IsNonInteractiveRun(const RuntimeOptions& options);
 
+// Whether the raw command line asks for --headless. The one option read ahead
+// of the parser, because it decides which application object gets made — and
+// the parser wants that object before it runs. QApplication would load the
+// platform plugin and with it reach for a display; a headless run makes a
+// bare QCoreApplication instead. The parser then reads the option again, so
+// --help still lists it.
+[[nodiscard]] bool RequestsHeadless(int argument_count,
+                                    const char* const* arguments);
+
 // Registers every runtime option at the parser. The descriptions turn up in the
 // --help output.
 void AddRuntimeOptions(QCommandLineParser& parser);
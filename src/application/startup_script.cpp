@@ -4,16 +4,31 @@
 #include <QtCore/QObject>
 #include <QtCore/QString>
 #include <QtCore/QTimer>
+#include <chrono>
+#include <cstddef>
+#include <functional>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "../common/debug_log.hpp"
+#include "../domain/calendar_config.hpp"
+#include "../domain/calendar_config_store.hpp"
+#include "../domain/font_config.hpp"
 #include "../infrastructure/graphics/pick_id.hpp"
+#include "../infrastructure/graphics/png_strip_encoder.hpp"
+#include "../infrastructure/graphics/png_writer.hpp"
+#include "../infrastructure/graphics/software_raster.hpp"
+#include "../infrastructure/graphics/vector_page.hpp"
 #include "../presentation/gl_canvas.hpp"
 #include "../presentation/main_frame.hpp"
+#include "../presentation/pdf_page_writer.hpp"
 #include "../presentation/scene_tree_panel.hpp"
 #include "calendar/calendar_page.hpp"
 #include "calendar/title_text_editor.hpp"
+#include "export_cache.hpp"
+#include "export_manifest.hpp"
 #include "project_document.hpp"
 #include "runtime_options.hpp"
 
@@ -36,9 +51,47 @@ void StartupScript::RunBeforeGraphics(MainFrame& frame) const {
 void StartupScript::RunAfterGraphics(MainFrame& frame,
                                      CalendarPage& calendar_page,
                                      TitleTextEditor& title_text_editor) const {
+  const PageWriter write_page =
+      [&frame](const std::string& file_path, int dpi,
+               const png_io::EncodeOptions& encoding,
+               software_raster::PageRenderer renderer,
+               const std::vector<png_io::PngText>& text) {
+        return frame.Canvas().SavePNG(file_path, dpi, encoding, renderer,
+                                      text);
+      };
+  // Asked of the driver only when a page image is to be written.
+  const int msaa_samples =
+      options_.dump_png_path || options_.export_batch_path
+          ? frame.Canvas().ExportSamples()
+          : GLCanvas::kExportMsaaSamples;
   LoadStartupFile();
   ApplyDebugHighlights(frame, calendar_page, title_text_editor);
-  WriteRequestedImages(frame);
+  WritePageImage(write_page, calendar_page.Font(), msaa_samples);
+  WritePagePyramid([&frame](const std::string& file_path, int dpi,
+                            const png_io::EncodeOptions& encoding,
+                            software_raster::PageRenderer renderer) {
+    return frame.Canvas().SaveDeepZoom(file_path, dpi, encoding, renderer);
+  });
+  WriteVectorPages([&frame]() { return frame.Canvas().VectorPage(); });
+  WriteFrameImage(frame);
+  if (options_.export_batch_path) {
+    RunExportBatch(write_page, calendar_page.Font(), msaa_samples);
+    // The window has nothing more to do once the batch is through, whatever
+    // became of it.
+    frame.CloseAfter(0);
+  }
+}
+
+void StartupScript::RunHeadless(const FontConfig& font_config,
+                                int msaa_samples,
+                                const PageWriter& write_page,
+                                const PyramidWriter& write_pyramid,
+                                const VectorPageSource& build_page) const {
+  LoadStartupFile();
+  WritePageImage(write_page, font_config, msaa_samples);
+  WritePagePyramid(write_pyramid);
+  WriteVectorPages(build_page);
+  RunExportBatch(write_page, font_config, msaa_samples);
 }
 
 void StartupScript::SelectStartupTab(MainFrame& frame) const {
@@ -55,25 +108,30 @@ void StartupScript::LoadStartupFile() const {
   if (!options_.startup_file) {
     return;
   }
-  const std::string& path = *options_.startup_file;
+  (void)LoadFile(*options_.startup_file, "LoadStartupFile");
+}
 
+bool StartupScript::LoadFile(const std::string& path,
+                             const char* context) const {
   if (!QFileInfo::exists(QString::fromStdString(path))) {
-    std::cerr << "LoadStartupFile: " << path << " not found, skipping\n";
-    return;
+    std::cerr << context << ": " << path << " not found, skipping\n";
+    return false;
   }
 
   if (decade_debug::LogEnabled()) {
-    std::cout << "LoadStartupFile: loading " << path << '\n';
+    std::cout << context << ": loading " << path << '\n';
   }
   if (path.ends_with(".xml")) {
     // Headless runs: errors to the console instead of into a modal dialogue,
     // which would block an --exit-after-ms run.
     if (const auto error = document_.LoadXml(path)) {
-      std::cerr << "LoadStartupFile: " << *error << '\n';
+      std::cerr << context << ": " << *error << '\n';
+      return false;
     }
-    return;
+    return true;
   }
   document_.ImportCsv(path);
+  return true;
 }
 
 void StartupScript::ApplyDebugHighlights(
@@ -101,15 +159,97 @@ void StartupScript::ApplyDebugHighlights(
   }
 }
 
-void StartupScript::WriteRequestedImages(MainFrame& frame) const {
-  if (options_.dump_png_path) {
-    const int dpi = options_.dump_png_dpi.value_or(GLCanvas::kExportPngDpi);
+StartupScript::ExportOutcome StartupScript::ExportPage(
+    const PageWriter& write_page, const FontConfig& font_config,
+    int msaa_samples, const std::string& file_path, int dpi) const {
+  const png_io::EncodeOptions encoding = PngEncoding();
+  const software_raster::PageRenderer renderer = Renderer();
+  const std::string key =
+      ExportKey(document_.CanonicalState(), font_config, TimeLocaleName(),
+                dpi, msaa_samples, encoding, renderer);
+  if (!options_.export_force && IsExportUpToDate(file_path, key)) {
+    return ExportOutcome::kUpToDate;
+  }
+  const std::vector<png_io::PngText> text{
+      png_io::PngText{.keyword = std::string(kExportKeyword), .text = key}};
+  return write_page(file_path, dpi, encoding, renderer, text)
+             ? ExportOutcome::kWritten
+             : ExportOutcome::kFailed;
+}
+
+void StartupScript::WritePageImage(const PageWriter& write_page,
+                                   const FontConfig& font_config,
+                                   int msaa_samples) const {
+  if (!options_.dump_png_path) {
+    return;
+  }
+  const std::string& path = *options_.dump_png_path;
+  const int dpi = options_.dump_png_dpi.value_or(GLCanvas::kExportPngDpi);
+  if (decade_debug::LogEnabled()) {
+    std::cout << "--dump-png: writing " << path << " at " << dpi << " dpi\n";
+  }
+  const ExportOutcome outcome =
+      ExportPage(write_page, font_config, msaa_samples, path, dpi);
+  if (!decade_debug::LogEnabled()) {
+    return;
+  }
+  switch (outcome) {
+    case ExportOutcome::kUpToDate:
+      std::cout << "--dump-png: " << path << " is up to date; not rendered\n";
+      break;
+    case ExportOutcome::kWritten:
+      std::cout << "--dump-png: " << path << " rendered\n";
+      break;
+    case ExportOutcome::kFailed:
+      break;
+  }
+}
+
+void StartupScript::WritePagePyramid(
+    const PyramidWriter& write_pyramid) const {
+  if (!options_.dump_dzi_path) {
+    return;
+  }
+  const int dpi = options_.dump_png_dpi.value_or(GLCanvas::kExportPngDpi);
+  if (decade_debug::LogEnabled()) {
+    std::cout << "--dump-dzi: writing " << *options_.dump_dzi_path << " at "
+              << dpi << " dpi\n";
+  }
+  (void)write_pyramid(*options_.dump_dzi_path, dpi, PngEncoding(),
+                      Renderer());
+}
+
+void StartupScript::WriteVectorPages(
+    const VectorPageSource& build_page) const {
+  if (!options_.dump_svg_path && !options_.dump_pdf_path) {
+    return;
+  }
+  const auto started = std::chrono::steady_clock::now();
+  const vector_page::Page page = build_page();
+  const auto write = [&page, started](
+                         const std::optional<std::string>& path,
+                         const char* option, const auto& write_file) {
+    if (!path) {
+      return;
+    }
+    if (const auto error = write_file(page, *path)) {
+      std::cerr << option << ": " << *error << '\n';
+      return;
+    }
     if (decade_debug::LogEnabled()) {
-      std::cout << "--dump-png: writing " << *options_.dump_png_path << " at "
-                << dpi << " dpi\n";
+      std::cout << option << ": " << page.items.size() << " items written to "
+                << *path << " in "
+                << std::chrono::duration<double, std::milli>(
+                       std::chrono::steady_clock::now() - started)
+                       .count()
+                << " ms\n";
     }
-    frame.Canvas().SavePNG(*options_.dump_png_path, dpi);
-  }
+  };
+  write(options_.dump_svg_path, "--dump-svg", vector_page::WriteSvgFile);
+  write(options_.dump_pdf_path, "--dump-pdf", pdf_page_writer::WritePdfFile);
+}
+
+void StartupScript::WriteFrameImage(MainFrame& frame) const {
   if (options_.dump_frame_png_path) {
     const std::string path = *options_.dump_frame_png_path;
     // After the first real paint alone, so every panel is drawn: queued on
@@ -125,4 +265,93 @@ void StartupScript::WriteRequestedImages(MainFrame& frame) const {
   }
 }
 
+void StartupScript::RunExportBatch(const PageWriter& write_page,
+                                   const FontConfig& font_config,
+                                   int msaa_samples) const {
+  if (!options_.export_batch_path) {
+    return;
+  }
+  const std::string& manifest_path = *options_.export_batch_path;
+  const auto manifest = ReadExportManifest(manifest_path);
+  if (!manifest) {
+    std::cerr << "--export-batch: cannot read " << manifest_path << '\n';
+    return;
+  }
+  for (const std::string& error : manifest->errors) {
+    std::cerr << "--export-batch: " << manifest_path << ", " << error
+              << "; skipped\n";
+  }
+
+  using Clock = std::chrono::steady_clock;
+  const auto millis = [](Clock::duration time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+  };
+  const int default_dpi =
+      options_.dump_png_dpi.value_or(GLCanvas::kExportPngDpi);
+  CalendarConfigStore& calendar_config = document_.CalendarConfiguration();
+
+  const auto batch_started = Clock::now();
+  std::size_t written = 0;
+  std::size_t up_to_date = 0;
+  const std::size_t count = manifest->jobs.size();
+  for (std::size_t index = 0; index < count; ++index) {
+    const ExportJob& job = manifest->jobs[index];
+    std::cout << "--export-batch: [" << (index + 1) << '/' << count << "] "
+              << job.output.string() << ": ";
+    const auto started = Clock::now();
+    // Every item starts from a fresh project, so nothing of the one before —
+    // groups, page setup, title, shapes, calendar configuration beside a CSV's
+    // entries — ends up in its image, whatever the manifest's order.
+    document_.Reset();
+    if (!LoadFile(job.input.string(), "--export-batch")) {
+      std::cout << "input failed to load\n";
+      continue;
+    }
+    if (job.years) {
+      CalendarConfig config = calendar_config.Get();
+      config.SetAutoCalendarSpan(false);
+      config.SetSpan(*job.years);
+      calendar_config.ReceiveCalendarConfig(config);
+    }
+    const auto loaded = Clock::now();
+    const ExportOutcome outcome =
+        ExportPage(write_page, font_config, msaa_samples,
+                   job.output.string(), job.dpi.value_or(default_dpi));
+    const auto exported = Clock::now();
+
+    if (outcome == ExportOutcome::kFailed) {
+      std::cout << "export failed\n";
+      continue;
+    }
+    if (outcome == ExportOutcome::kUpToDate) {
+      ++up_to_date;
+      std::cout << "up to date, load " << millis(loaded - started)
+                << " ms\n";
+      continue;
+    }
+    ++written;
+    std::cout << "load " << millis(loaded - started) << " ms, export "
+              << millis(exported - loaded) << " ms\n";
+  }
+  std::cout << "--export-batch: " << written << " of " << count
+            << " images rendered, " << up_to_date << " up to date, in "
+            << millis(Clock::now() - batch_started) << " ms\n";
+}
+
+png_io::EncodeOptions StartupScript::PngEncoding() const {
+  png_io::EncodeOptions encoding;
+  if (options_.dump_png_compression) {
+    encoding.compression_level = *options_.dump_png_compression;
+  }
+  if (options_.dump_png_filter) {
+    encoding.filter = *options_.dump_png_filter;
+  }
+  return encoding;
+}
+
+software_raster::PageRenderer StartupScript::Renderer() const {
+  return options_.dump_png_renderer.value_or(
+      software_raster::PageRenderer::kGl);
+}
+
 }  // namespace application
@@ -1,6 +1,16 @@
 #ifndef STARTUP_SCRIPT_HPP
 #define STARTUP_SCRIPT_HPP
 
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../domain/font_config.hpp"
+#include "../infrastructure/graphics/png_strip_encoder.hpp"
+#include "../infrastructure/graphics/png_writer.hpp"
+#include "../infrastructure/graphics/software_raster.hpp"
+#include "../infrastructure/graphics/vector_page.hpp"
 #include "../presentation/main_frame.hpp"
 #include "calendar/calendar_page.hpp"
 #include "calendar/title_text_editor.hpp"
@@ -15,9 +25,27 @@ namespace application {
 // window knows nothing of runtime options any more.
 //
 // Two moments, because OpenGL stands ready with a delay: whatever works without
-// a context runs at once, the rest afterwards.
+// a context runs at once, the rest afterwards. A --headless run has no window
+// and only the second moment, with the page image steps alone.
 class StartupScript {
  public:
+  // Writes the page image: GLCanvas::SavePNG, or HeadlessCanvas's. False when
+  // nothing got written. `text` is the export cache's key.
+  using PageWriter = std::function<bool(
+      const std::string& file_path, int dpi,
+      const png_io::EncodeOptions& encoding,
+      software_raster::PageRenderer renderer,
+      const std::vector<png_io::PngText>& text)>;
+
+  // Writes the tile pyramid: GLCanvas::SaveDeepZoom, or HeadlessCanvas's.
+  using PyramidWriter = std::function<bool(
+      const std::string& file_path, int dpi,
+      const png_io::EncodeOptions& encoding,
+      software_raster::PageRenderer renderer)>;
+
+  // The page as vectors: GLCanvas::VectorPage, or HeadlessCanvas's.
+  using VectorPageSource = std::function<vector_page::Page()>;
+
   StartupScript(const RuntimeOptions& options, ProjectDocument& document);
 
   void RunBeforeGraphics(MainFrame& frame) const;
@@ -25,6 +53,16 @@ class StartupScript {
   void RunAfterGraphics(MainFrame& frame, CalendarPage& calendar_page,
                         TitleTextEditor& title_text_editor) const;
 
+  // Loads the startup file, then writes --dump-png and the --export-batch
+  // images through `write_page`, --dump-dzi through `write_pyramid` and
+  // --dump-svg and --dump-pdf from `build_page`. `font_config` is the page's
+  // font and `msaa_samples` what the page render really runs with; the
+  // export cache's key covers both.
+  void RunHeadless(const FontConfig& font_config, int msaa_samples,
+                   const PageWriter& write_page,
+                   const PyramidWriter& write_pyramid,
+                   const VectorPageSource& build_page) const;
+
  private:
   void SelectStartupTab(MainFrame& frame) const;
 
@@ -33,10 +71,54 @@ class StartupScript {
   // directory deliberately does not exist.
   void LoadStartupFile() const;
 
+  // Loads an XML project or imports a CSV; `context` heads the messages.
+  // False when the file is missing or does not load.
+  [[nodiscard]] bool LoadFile(const std::string& path,
+                              const char* context) const;
+
   void ApplyDebugHighlights(MainFrame& frame, CalendarPage& calendar_page,
                             TitleTextEditor& title_text_editor) const;
 
-  void WriteRequestedImages(MainFrame& frame) const;
+  // What became of one cached page export.
+  enum class ExportOutcome : std::uint8_t { kWritten, kUpToDate, kFailed };
+
+  // Writes the page to `file_path` through `write_page`, stamped with its
+  // export key — or leaves the file alone when it already carries that key
+  // and --export-force was not given.
+  [[nodiscard]] ExportOutcome ExportPage(const PageWriter& write_page,
+                                         const FontConfig& font_config,
+                                         int msaa_samples,
+                                         const std::string& file_path,
+                                         int dpi) const;
+
+  // --dump-png; with --debug-log, reports whether the image was up to date.
+  void WritePageImage(const PageWriter& write_page,
+                      const FontConfig& font_config, int msaa_samples) const;
+
+  // --dump-dzi, at the --dump-png dpi and encoding.
+  void WritePagePyramid(const PyramidWriter& write_pyramid) const;
+
+  // --dump-svg and --dump-pdf, from one build of the page.
+  void WriteVectorPages(const VectorPageSource& build_page) const;
+
+  void WriteFrameImage(MainFrame& frame) const;
+
+  // Works through the --export-batch manifest in this one process: each item
+  // loads its file into a fresh project and writes its image with the GL
+  // context, the shader programs, the font and its glyphs all still standing
+  // from the item before — the start-up that a --dump-png run pays per image
+  // is paid once, the project state is not carried over.
+  // Reports every item's load and export time on stdout, since that report is
+  // what the run was started for. Items whose image is up to date are not
+  // rendered again.
+  void RunExportBatch(const PageWriter& write_page,
+                      const FontConfig& font_config, int msaa_samples) const;
+
+  // The --dump-png-compression and --dump-png-filter choice.
+  [[nodiscard]] png_io::EncodeOptions PngEncoding() const;
+
+  // The --dump-png-renderer choice, GL when none was made.
+  [[nodiscard]] software_raster::PageRenderer Renderer() const;
 
   const RuntimeOptions& options_;
   ProjectDocument& document_;
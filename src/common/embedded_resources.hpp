@@ -39,6 +39,12 @@ inline constexpr auto kRectanglesVertexShaderData = std::to_array<char>({
 inline constexpr auto kRectanglesFragmentShaderData = std::to_array<char>({
 #embed "../../shaders/rectangles_fragment_shader.glsl"
 });
+inline constexpr auto kGridVertexShaderData = std::to_array<char>({
+#embed "../../shaders/grid_vertex_shader.glsl"
+});
+inline constexpr auto kGridFragmentShaderData = std::to_array<char>({
+#embed "../../shaders/grid_fragment_shader.glsl"
+});
 
 }  // namespace detail
 
@@ -59,6 +65,11 @@ inline constexpr std::string_view kRectanglesVertexShader{
 inline constexpr std::string_view kRectanglesFragmentShader{
     detail::kRectanglesFragmentShaderData.data(),
     detail::kRectanglesFragmentShaderData.size()};
+inline constexpr std::string_view kGridVertexShader{
+    detail::kGridVertexShaderData.data(), detail::kGridVertexShaderData.size()};
+inline constexpr std::string_view kGridFragmentShader{
+    detail::kGridFragmentShaderData.data(),
+    detail::kGridFragmentShaderData.size()};
 
 }  // namespace resources
 
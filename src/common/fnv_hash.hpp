@@ -0,0 +1,31 @@
+#ifndef FNV_HASH_HPP
+#define FNV_HASH_HPP
+
+#include <cstdint>
+#include <string_view>
+
+// 64-bit FNV-1a, for keys that say whether something stored on disk was made
+// from the same inputs: the program binary cache, the export cache. Stable
+// across runs and platforms, unlike std::hash; no defence against anyone
+// crafting a collision, which no key here needs.
+namespace fnv_hash {
+
+inline constexpr std::uint64_t kOffsetBasis = 0xcbf29ce484222325ULL;
+inline constexpr std::uint64_t kPrime = 0x100000001b3ULL;
+
+// Folds `bytes` into `hash`, closed by a zero byte so that moving text from
+// one field to the next changes the result.
+[[nodiscard]] constexpr std::uint64_t AddField(std::uint64_t hash,
+                                               std::string_view bytes) {
+  for (const char byte : bytes) {
+    hash ^= static_cast<std::uint8_t>(byte);
+    hash *= kPrime;
+  }
+  // The closing zero byte: the xor leaves the hash as it is.
+  hash *= kPrime;
+  return hash;
+}
+
+}  // namespace fnv_hash
+
+#endif  // FNV_HASH_HPP
@@ -13,7 +13,10 @@ enum class SnapshotShapeKind : std::uint8_t {
   kNone,
   kFill,
   kBoxes,
+  kGrid,
   kFont,
+  // The one draw of a whole label layer; its labels are its children.
+  kTextBatch,
 };
 
 // An axis-aligned box in page millimetres. A type of its own instead of the
@@ -0,0 +1,32 @@
+#include "advance_table.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+void AdvanceTable::Clear() {
+  code_points_.clear();
+  pens_.assign(1, 0.0F);
+}
+
+std::size_t AdvanceTable::Size() const { return code_points_.size(); }
+
+float AdvanceTable::Width(std::size_t count) const {
+  return pens_[std::min(count, Size())];
+}
+
+std::size_t AdvanceTable::IndexAt(float offset) const {
+  // The midpoints of the characters rise with the index, so the first one
+  // right of the offset is found by bisection.
+  std::size_t low = 0;
+  std::size_t high = Size();
+  while (low < high) {
+    const std::size_t middle = low + ((high - low) / 2);
+    const float advance = pens_[middle + 1] - pens_[middle];
+    if (offset < pens_[middle] + (advance * kHalfAdvance)) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
+  }
+  return low;
+}
@@ -0,0 +1,60 @@
+#ifndef ADVANCE_TABLE_HPP
+#define ADVANCE_TABLE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Where each character of one line of text starts: the prefix sums of its
+// glyph advances, in em. Entry i is the pen position before code point i, the
+// last entry the width of the whole line.
+//
+// The title editor measures with it on every keystroke, click and drag — the
+// caret and the selection edges are a lookup, the character under the pointer
+// a binary search, where each used to walk the line with a glyph lookup per
+// character. Update keeps the entries in front of the first changed code
+// point, so typing at the end of a title costs one advance.
+//
+// The table knows no font: the owner hands in the advances, and clears the
+// table when the font changes.
+class AdvanceTable {
+ public:
+  // A click counts to the nearer character edge: up to half the advance width
+  // it still belongs before the character.
+  static constexpr float kHalfAdvance = 0.5F;
+
+  // Brings the table to `code_points`, asking `advance_of(code_point)` for the
+  // advance in em of each one not measured before.
+  template <typename AdvanceOf>
+  void Update(const std::u32string& code_points, AdvanceOf advance_of) {
+    const auto [changed, unused] = std::ranges::mismatch(code_points,
+                                                         code_points_);
+    const auto kept = static_cast<std::size_t>(changed - code_points.begin());
+    code_points_.resize(kept);
+    code_points_.append(code_points, kept);
+    pens_.resize(kept + 1);
+    for (std::size_t index = kept; index < code_points.size(); ++index) {
+      pens_.push_back(pens_.back() + advance_of(code_points[index]));
+    }
+  }
+
+  void Clear();
+
+  // The number of code points measured.
+  [[nodiscard]] std::size_t Size() const;
+
+  // The width in em of the first `count` code points — the caret sits behind
+  // character `count`. Counts past the end measure the whole line.
+  [[nodiscard]] float Width(std::size_t count) const;
+
+  // The inverse: the caret index an `offset` in em right of the line start
+  // means, the nearer of the two character edges winning.
+  [[nodiscard]] std::size_t IndexAt(float offset) const;
+
+ private:
+  std::u32string code_points_;
+  std::vector<float> pens_{0.0F};
+};
+
+#endif  // ADVANCE_TABLE_HPP
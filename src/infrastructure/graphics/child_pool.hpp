@@ -2,6 +2,7 @@
 #define CHILD_POOL_HPP
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -63,7 +64,16 @@ class ShapeChildPool {
 
   ShapeChildPool(std::shared_ptr<SceneNode> parent, Shader& shader,
                  int draw_layer)
-      : parent_(std::move(parent)), shader_(shader), draw_layer_(draw_layer) {}
+      : parent_(std::move(parent)),
+        make_shape_([&shader] { return std::make_unique<ShapeT>(shader); }),
+        draw_layer_(draw_layer) {}
+
+  // For drawables made without a shader: the text labels, which the batch of
+  // their parent draws.
+  ShapeChildPool(std::shared_ptr<SceneNode> parent, int draw_layer)
+      : parent_(std::move(parent)),
+        make_shape_([] { return std::make_unique<ShapeT>(); }),
+        draw_layer_(draw_layer) {}
 
   ~ShapeChildPool() { parent_->TruncateChildren(used_); }
 
@@ -74,8 +84,7 @@ class ShapeChildPool {
 
   [[nodiscard]] Child Next(const std::string& name) {
     if (used_ == parent_->GetChildren().size()) {
-      parent_->AddChild(
-          std::make_shared<SceneNode>(name, std::make_unique<ShapeT>(shader_)));
+      parent_->AddChild(std::make_shared<SceneNode>(name, make_shape_()));
     }
     std::shared_ptr<SceneNode> child = parent_->GetChildren()[used_];
     ++used_;
@@ -87,7 +96,7 @@ class ShapeChildPool {
 
  private:
   std::shared_ptr<SceneNode> parent_;
-  Shader& shader_;
+  std::function<std::unique_ptr<ShapeT>()> make_shape_;
   int draw_layer_;
   std::size_t used_{0};
 };
@@ -8,13 +8,17 @@
 
 // What a drawable is, without asking the RTTI. The scene tree shows the kind,
 // and the snapshot builder translates it into its own GL-free enum; a shape
-// answering kNone is none of the three the calendar draws (a test double, for
-// instance).
+// answering kNone is none of those the calendar draws (a test double, for
+// instance). A kTextLabel is one label of a batched text layer, drawn by the
+// kTextBatch of its parent node.
 enum class DrawableKind : std::uint8_t {
   kNone,
   kFill,
   kBoxes,
+  kGrid,
   kText,
+  kTextLabel,
+  kTextBatch,
 };
 
 // What a scene node needs of the thing it draws, and nothing more: paint
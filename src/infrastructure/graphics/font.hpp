@@ -8,33 +8,50 @@
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "drawable.hpp"
-#include "freetype.hpp"
+#include "freetype_face.hpp"
+#include "glyph_atlas.hpp"
+#include "glyph_rasterizer.hpp"
+#include "lru_cache.hpp"
 #include "rect.hpp"
 #include "shaders.hpp"
 #include "shapes_base.hpp"
-#include "texture_object.hpp"
+#include "text_layout.hpp"
 
-struct Letter {
-  Texture texture_object;
-  glm::vec2 size{0.0F, 0.0F};
-  glm::vec2 bearing{0.0F, 0.0F};
-  float advance{0.0F};
-};
-
-// Renders glyphs from a font file on demand and caches them as GL textures.
+// Renders glyphs from a font file on demand into a signed-distance-field atlas.
 //
 // FreeType is kept alive for the whole lifetime of the object (RAII), because
-// glyphs are rasterised lazily the first time their code point is requested —
-// there is no fixed alphabet. A packed atlas is deliberately avoided: at
-// kFontPixelHeight a single glyph is several megabytes, so an atlas would hold
-// only a handful; one texture per used code point is both simpler and uses
-// less memory for the typical (Latin) text this application renders.
+// glyphs are rendered lazily the first time their code point is requested —
+// there is no fixed alphabet. Each one becomes a small distance field
+// (FreeTypeFace::kPixelHeight to the em, kSdfSpread pixels of distance on
+// either side of the outline) packed into one GlyphAtlas texture, a few
+// kilobytes a glyph where a coverage bitmap sharp enough for print took
+// megabytes. The font shader turns distance into coverage over one screen
+// pixel, so the edge stays crisp at any zoom and export resolution.
+//
+// Rendering happens off the caller's thread, in a GlyphRasterizer. A code
+// point met for the first time gets a placeholder carrying its true advance
+// (FT_Get_Advance, no outline loaded) and nothing to draw, so the text around
+// it already lays out where it finally belongs. When the rasterizer reports,
+// the owner uploads the finished glyphs on the GL thread
+// (UploadFinishedGlyphs) and lays the text out again.
+//
+// The layout metrics do not come from the field's pixels: sizes, bearings and
+// advances are taken unhinted from the outline, so text measures the same
+// whatever size the field is generated at.
+//
+// Layout is done once per distinct text: the run is built at em size 1 with
+// its pen starting at the origin and kept in an LRU cache, and every Layout
+// call only scales and shifts a copy. Unhinted metrics scale linearly, so the
+// result is the one a fresh layout would give. A calendar repeats the same
+// few hundred strings (month names, day numbers, years) at every rebuild;
+// those are decoded, looked up glyph by glyph and measured once.
 class Font {
  public:
   struct TextScale {
@@ -42,11 +59,9 @@ class Font {
     float width_ratio;
   };
 
-  // A click counts to the nearer character edge: up to half the advance width
-  // it still belongs before the character.
-  static constexpr float kHalfAdvance = 0.5F;
-
-  explicit Font(const std::string& filepath);
+  // `on_glyphs_ready` is called on a worker thread whenever rendered glyphs
+  // wait for UploadFinishedGlyphs; it should post that to the GL thread.
+  Font(const std::string& filepath, std::function<void()> on_glyphs_ready);
 
   ~Font();
 
@@ -57,54 +72,95 @@ class Font {
 
   // Memoised glyph lookup. Logically const (a cache), so the cache is mutable;
   // references into it stay valid across later insertions because the cache is
-  // node-based (std::unordered_map).
+  // node-based (std::unordered_map). A glyph not rendered yet answers with its
+  // placeholder, which the upload later overwrites in place.
   [[nodiscard]] const Letter& GetLetter(char32_t code_point) const;
 
-  [[nodiscard]] float TextWidth(const std::string& text, float size) const;
+  // Packs the glyphs the rasterizer has finished into the atlas, replacing
+  // their placeholders, and drops the cached layouts that may hold those. GL:
+  // the context must be current. True when anything was uploaded — the text
+  // then needs laying out again.
+  bool UploadFinishedGlyphs();
+
+  // The same after waiting for every glyph still being rendered — for the
+  // export, which must not draw a placeholder.
+  bool FinishPendingGlyphs();
+
+  // Sets rendering going for every character of `text` not met before, so the
+  // glyphs are in the atlas, or on their way, when a build needs them.
+  void Prewarm(const std::string& text) const;
+
+  // The atlas texture every Letter's region refers to. Ask at draw time: the
+  // name changes when the atlas grows.
+  [[nodiscard]] GLuint AtlasTexture() const;
+
+  // The atlas itself, for its CPU copy of the texels (the software export).
+  [[nodiscard]] const GlyphAtlas& Atlas() const;
 
-  // The width of the first `count` code points — the measure the text editor
-  // computes in: the cursor sits behind character `count`.
-  [[nodiscard]] float TextWidth(const std::u32string& text, float size,
-                                std::size_t count) const;
+  // The face's family name and the file it was loaded from, for the vector
+  // export, which names or embeds the font instead of drawing its atlas.
+  [[nodiscard]] std::string FamilyName() const;
 
-  // The inverse: the cursor index a click `offset` right of the text start
-  // means. The nearer of the two character edges wins, so a click on the left
-  // half of a character lands before it.
-  [[nodiscard]] std::size_t IndexAtOffset(const std::u32string& text,
-                                          float size, float offset) const;
+  [[nodiscard]] const std::string& FilePath() const;
 
+  [[nodiscard]] float TextWidth(const std::string& text, float size) const;
+
+  // The cap height: the tallest bearing among the digits and Latin letters,
+  // measured once at construction.
   [[nodiscard]] float TextHeight(float size) const;
 
+  // The quads of `text` with its baseline starting at `position`, em size
+  // `size`. What FontShape and the batched text labels draw alike.
+  [[nodiscard]] TextRun Layout(const std::string& text,
+                               const glm::vec3& position, float size) const;
+
+  // The same, placed so that the text's width and cap height centre on
+  // `center`.
+  [[nodiscard]] TextRun LayoutCentered(const std::string& text,
+                                       const glm::vec3& center,
+                                       float size) const;
+
   // The largest em size at which `text` fits into `cell`: from the cell height
   // first, then taken back to the cell width where needed.
   [[nodiscard]] float AdjustTextSize(const RectF& cell, const std::string& text,
                                      TextScale scale) const;
 
  private:
-  void InitFreetype();
-
-  // Releases the FreeType resources without throwing — it runs from the
-  // destructor, so failures are logged rather than propagated.
-  void ReleaseFreetype() noexcept;
+  void PrintVersion() const;
 
-  void PrintVersion();
+  // A placeholder for `code_point` while its field is rendered: the advance
+  // alone. Throws std::runtime_error when FreeType fails.
+  [[nodiscard]] Letter Placeholder(char32_t code_point) const;
 
-  void LoadFont(const std::string& file_path);
+  // Uploads the field of one rendered glyph and stores its letter.
+  void Upload(const RasterizedGlyph& glyph);
 
-  void ConfigureFace();
+  // The cached shaping of `text` (text_layout::Shape), building it on a miss.
+  [[nodiscard]] const text_layout::ShapedText& Shaped(
+      const std::string& text) const;
 
-  // Rasterises a single code point and uploads it as a GL_RED texture. Const
-  // because it only feeds the memoising cache; it mutates the shared FreeType
-  // glyph slot and GL state, not the logical state of the font.
-  [[nodiscard]] Letter RenderGlyph(char32_t code_point) const;
+  // Reads the outline metrics of the digits and Latin letters without
+  // rendering them — no atlas, so no GL context is needed.
+  [[nodiscard]] float MeasureCapHeight() const;
 
-  static constexpr float kFreeTypeFixedScale = 64.0F;
-  static constexpr FT_UInt kFontPixelHeight = 2048;
+  // Distinct strings kept laid out; a year view has a few hundred.
+  static constexpr std::size_t kLayoutCacheCapacity = 1024;
 
-  FT_Library ft_library_{nullptr};
-  FT_Face ft_face_{nullptr};
-  FT_UInt font_pixel_height_{kFontPixelHeight};
+  // Measures on the caller's thread; the rasterizer renders through faces of
+  // its own.
+  FreeTypeFace face_;
+  std::string file_path_;
   mutable std::unordered_map<char32_t, Letter> glyph_cache_;
+  // The decoded text of the latest layout or prewarm, kept for its capacity.
+  mutable std::vector<char32_t> code_points_;
+  mutable GlyphAtlas atlas_;
+  // Runs refer to the atlas by texel position, which growth preserves, so a
+  // cached run stays valid for the font's lifetime.
+  mutable LruCache<std::string, text_layout::ShapedText> layout_cache_{
+      kLayoutCacheCapacity};
+  float cap_height_{0.0F};
+  // Last: its workers stop before anything above goes away.
+  mutable GlyphRasterizer rasterizer_;
 };
 
 class FontShape : public Shape {
@@ -124,22 +180,36 @@ class FontShape : public Shape {
 
   [[nodiscard]] float FontSize() const;
 
+  // What Draw() paints — the quads, their colour and the font whose atlas
+  // they sample — for the software export.
+  [[nodiscard]] const TextRun& Run() const;
+
+  [[nodiscard]] const glm::vec4& Color() const;
+
+  [[nodiscard]] const std::shared_ptr<Font>& GetFont() const;
+
   void SetShape(const std::string& text, const glm::vec3& position, float size);
 
   void SetShapeCentered(const std::string& text, const glm::vec3& position,
                         float size);
 
+  // As TextLabel::Relayout.
+  void Relayout();
+
   void Draw(const glm::mat4& model) const override;
 
  private:
   static constexpr float kZero = 0.0F;
   static constexpr float kOne = 1.0F;
   static constexpr float kHalf = 0.5F;
-  static constexpr size_t kVerticesPerGlyph = 6;
 
-  std::vector<glm::vec3> positions_;
-  std::vector<glm::vec2> texture_positions_;
-  std::vector<GLuint> text_textures_;
+  void SetRun(TextRun run);
+
+  TextRun run_;
+  // White throughout: the font shader multiplies the vertex colour by the
+  // colour of the draw record, which carries this shape's colour. The batched
+  // labels use the vertex colour instead (TextBatchShape).
+  std::vector<glm::vec4> vertex_colors_;
   std::shared_ptr<Font> font_;
   glm::vec4 color_{kZero, kZero, kZero, kOne};
   std::string text_;
@@ -0,0 +1,58 @@
+#include "font_match.hpp"
+
+#include <fontconfig/fontconfig.h>
+
+#include <iostream>
+#include <optional>
+#include <string>
+
+std::optional<std::string> MatchFontFile(FcConfig* config,
+                                         const FontQuery& query) {
+  FcPattern* pattern = FcPatternCreate();
+  if (pattern == nullptr) {
+    std::cerr << "MatchFontFile: FcPatternCreate failed\n";
+    return std::nullopt;
+  }
+  FcPatternAddString(pattern, FC_FAMILY,
+                     reinterpret_cast<const FcChar8*>(query.family.c_str()));
+
+  // FC_SIZE is a double according to fontconfig.h (the point size); an
+  // integer here would be a type break that fontconfig matches worse in
+  // silence. For scalable fonts the size chooses no other file anyway — it
+  // stands in the pattern so that size-specific cuts (bitmap fonts, optical
+  // grades) resolve correctly.
+  FcPatternAddDouble(pattern, FC_SIZE, query.point_size);
+
+  // As a double, so an interpolated value survives instead of being cut
+  // back onto a step.
+  FcPatternAddDouble(pattern, FC_WEIGHT, query.weight);
+  FcPatternAddInteger(pattern, FC_SLANT, query.slant);
+
+  // The mandatory prelude to FcFontMatch: FcConfigSubstitute applies the
+  // rules of the system configuration (aliases such as "sans-serif"),
+  // FcDefaultSubstitute fills in the underspecified and converts the point
+  // size into a pixel size. Without both, fontconfig matches wrongly
+  // according to the manual.
+  FcConfigSubstitute(config, pattern, FcMatchPattern);
+  FcDefaultSubstitute(pattern);
+
+  FcResult result = FcResultNoMatch;
+  FcPattern* match = FcFontMatch(config, pattern, &result);
+  FcPatternDestroy(pattern);
+  if (match == nullptr) {
+    std::cerr << "MatchFontFile: no matching font found\n";
+    return std::nullopt;
+  }
+
+  // https://fontconfig.pages.freedesktop.org/fontconfig/fontconfig-devel/fcpatternget.html
+  FcChar8* file_path = nullptr;
+  std::optional<std::string> matched;
+  if (FcPatternGetString(match, FC_FILE, 0, &file_path) == FcResultMatch &&
+      file_path != nullptr) {
+    matched = std::string(reinterpret_cast<const char*>(file_path));
+  } else {
+    std::cerr << "MatchFontFile: matched font has no file path\n";
+  }
+  FcPatternDestroy(match);
+  return matched;
+}
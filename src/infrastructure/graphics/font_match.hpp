@@ -0,0 +1,27 @@
+#ifndef FONT_MATCH_HPP
+#define FONT_MATCH_HPP
+
+#include <fontconfig/fontconfig.h>
+
+#include <optional>
+#include <string>
+
+// A font as a person names it — family, size, weight and slant in fontconfig's
+// own scales (FC_WEIGHT_*, FC_SLANT_*).
+struct FontQuery {
+  std::string family;
+  double point_size{0.0};
+  double weight{FC_WEIGHT_REGULAR};
+  int slant{FC_SLANT_ROMAN};
+};
+
+// The file fontconfig picks for `query` under `config`, the way a desktop
+// application would: the system's substitution rules (aliases such as
+// "sans-serif") first, the underspecified filled in, then the best match.
+// nullopt when nothing matches; the reason went to stderr.
+//
+// Source: FcFontMatch (https://man.archlinux.org/man/FcFontMatch.3.en)
+[[nodiscard]] std::optional<std::string> MatchFontFile(FcConfig* config,
+                                                       const FontQuery& query);
+
+#endif  // FONT_MATCH_HPP
@@ -0,0 +1,124 @@
+#include "frame_uniforms.hpp"
+
+#include <epoxy/gl.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "mvp_matrices.hpp"
+
+namespace {
+
+// Where the GLSL side's std430 array stride and the struct agree.
+constexpr std::size_t kDrawRecordSize = 112;
+static_assert(sizeof(DrawRecord) == kDrawRecordSize);
+
+}  // namespace
+
+FrameUniforms::FrameUniforms() {
+  glCreateBuffers(1, &camera_buffer_);
+  glNamedBufferStorage(camera_buffer_, sizeof(CameraBlock), nullptr,
+                       GL_DYNAMIC_STORAGE_BIT);
+
+  GLint alignment = 0;
+  glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+  offset_alignment_ = static_cast<std::size_t>(std::max(alignment, 1));
+  GrowRecords(kInitialRecords);
+}
+
+FrameUniforms::~FrameUniforms() {
+  for (GLsync& fence : fences_) {
+    glDeleteSync(fence);
+  }
+  // Deleting a mapped buffer unmaps it.
+  glDeleteBuffers(1, &record_buffer_);
+  glDeleteBuffers(1, &camera_buffer_);
+}
+
+void FrameUniforms::BeginFrame(const MVP& mvp) {
+  const CameraBlock camera{.projection = mvp.GetProjection(),
+                           .view = mvp.GetView()};
+  glNamedBufferSubData(camera_buffer_, 0, sizeof(CameraBlock), &camera);
+  glBindBufferBase(GL_UNIFORM_BUFFER, kCameraBinding, camera_buffer_);
+
+  current_region_ = (current_region_ + 1) % kRegionCount;
+  WaitForRegion(current_region_);
+  record_count_ = 0;
+  BindRecords();
+}
+
+void FrameUniforms::EndFrame() {
+  // GL deletes a fence nobody waited on without fuss.
+  glDeleteSync(fences_.at(current_region_));
+  fences_.at(current_region_) = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void FrameUniforms::SetDrawRecord(const DrawRecord& record) {
+  if (record_count_ == region_records_) {
+    GrowRecords(region_records_ * 2);
+  }
+  std::memcpy(mapped_ + RegionOffset() + (record_count_ * sizeof(DrawRecord)),
+              &record, sizeof(DrawRecord));
+  glUniform1ui(kDrawIndexLocation, static_cast<GLuint>(record_count_));
+  ++record_count_;
+}
+
+void FrameUniforms::GrowRecords(std::size_t required) {
+  for (GLsync& fence : fences_) {
+    glDeleteSync(fence);
+    fence = nullptr;
+  }
+  glDeleteBuffers(1, &record_buffer_);
+
+  region_bytes_ = required * sizeof(DrawRecord);
+  region_bytes_ =
+      ((region_bytes_ + offset_alignment_ - 1) / offset_alignment_) *
+      offset_alignment_;
+  region_records_ = region_bytes_ / sizeof(DrawRecord);
+  // The frame goes on in the first region of the new buffer; the records it
+  // wrote before stay with the draws that read them from the old one.
+  current_region_ = 0;
+
+  constexpr GLbitfield kFlags =
+      GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  const auto total = static_cast<GLsizeiptr>(region_bytes_ * kRegionCount);
+  glCreateBuffers(1, &record_buffer_);
+  glNamedBufferStorage(record_buffer_, total, nullptr, kFlags);
+  mapped_ = static_cast<std::byte*>(
+      glMapNamedBufferRange(record_buffer_, 0, total, kFlags));
+  if (mapped_ == nullptr) {
+    throw std::runtime_error("mapping a draw record buffer of " +
+                             std::to_string(total) + " bytes failed");
+  }
+  BindRecords();
+}
+
+void FrameUniforms::WaitForRegion(std::size_t region) {
+  GLsync& fence = fences_.at(region);
+  if (fence == nullptr) {
+    return;
+  }
+  // As PersistentVertexBuffer: a GPU that takes longer than a second per
+  // round for a frame is hung.
+  constexpr GLuint64 kWaitNanoseconds = 1'000'000'000;
+  GLenum status = GL_TIMEOUT_EXPIRED;
+  while (status == GL_TIMEOUT_EXPIRED) {
+    status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                              kWaitNanoseconds);
+  }
+  glDeleteSync(fence);
+  fence = nullptr;
+}
+
+void FrameUniforms::BindRecords() const {
+  glBindBufferRange(GL_SHADER_STORAGE_BUFFER, kDrawRecordBinding,
+                    record_buffer_, static_cast<GLintptr>(RegionOffset()),
+                    static_cast<GLsizeiptr>(region_bytes_));
+}
+
+std::size_t FrameUniforms::RegionOffset() const {
+  return current_region_ * region_bytes_;
+}
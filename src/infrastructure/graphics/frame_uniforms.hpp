@@ -0,0 +1,110 @@
+#ifndef FRAME_UNIFORMS_HPP
+#define FRAME_UNIFORMS_HPP
+
+#include <epoxy/gl.h>
+
+#include <array>
+#include <cstddef>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include "mvp_matrices.hpp"
+
+// What one draw hands its shaders, as the shaders read it: one element of the
+// std430 array `draws[]` at binding kDrawRecordBinding. Every shader reads the
+// same record; each uses the fields its shape fills and ignores the rest.
+struct DrawRecord {
+  explicit DrawRecord(const glm::mat4& model_in) : model(model_in) {}
+
+  glm::mat4 model;
+  // The fill colour of a FillShape and a GridShape, the tint of a text.
+  glm::vec4 color{1.0F};
+  // The outline colour of a GridShape.
+  glm::vec4 outline_color{0.0F};
+  // A GridShape's pattern: cell width, period, 1 to draw the on-phase cells
+  // or 0 for the others, line width.
+  glm::vec4 pattern{0.0F};
+};
+
+// The GPU side of the frame-global and per-draw shader inputs.
+//
+// The camera — projection and view — is one std140 uniform block at binding
+// kCameraBinding, written and bound once per frame. Every shader declares the
+// block, so no program needs the matrices set on it; they used to be set by
+// name on each program in turn.
+//
+// The per-draw data — model matrix and colours — goes into a shader storage
+// buffer, one DrawRecord per draw in the order the draws are issued. A draw
+// finds its record through the uniform at kDrawIndexLocation, set by location
+// and not by name; a multi-draw would take the index from gl_DrawID instead
+// and leave everything else as it is. Before, each draw set its model and
+// colours through string-keyed uniform lookups.
+//
+// The records live in persistently mapped memory split into kRegionCount
+// regions used frame by frame, the way PersistentVertexBuffer does it: a
+// fence set at the end of a frame says when the GPU is done with its region,
+// and by the time the ring comes round again it normally is. A frame with
+// more draws than a region holds grows the buffer — all regions, by doubling.
+//
+// GL: construct, use and destroy with the context current.
+class FrameUniforms {
+ public:
+  static constexpr GLuint kCameraBinding = 0;
+  static constexpr GLuint kDrawRecordBinding = 1;
+  static constexpr GLint kDrawIndexLocation = 0;
+
+  FrameUniforms();
+
+  ~FrameUniforms();
+
+  FrameUniforms(const FrameUniforms&) = delete;
+  FrameUniforms& operator=(const FrameUniforms&) = delete;
+  FrameUniforms(FrameUniforms&&) = delete;
+  FrameUniforms& operator=(FrameUniforms&&) = delete;
+
+  // Writes and binds the camera block and starts the next region of draw
+  // records.
+  void BeginFrame(const MVP& mvp);
+
+  // Fences the frame's region.
+  void EndFrame();
+
+  // Appends `record` to the frame's records and points the program in use at
+  // it.
+  void SetDrawRecord(const DrawRecord& record);
+
+ private:
+  // The std140 camera block; two column-major mat4 need no padding.
+  struct CameraBlock {
+    glm::mat4 projection;
+    glm::mat4 view;
+  };
+
+  // Replaces the record storage by one whose regions hold at least
+  // `required` records. Deleting the old buffer is safe with draws still in
+  // flight: GL keeps the storage alive until they are done.
+  void GrowRecords(std::size_t required);
+
+  // Blocks until the GPU has finished the frame fenced for `region`.
+  void WaitForRegion(std::size_t region);
+
+  void BindRecords() const;
+
+  [[nodiscard]] std::size_t RegionOffset() const;
+
+  static constexpr std::size_t kRegionCount = 3;
+  static constexpr std::size_t kInitialRecords = 256;
+
+  GLuint camera_buffer_{0};
+  GLuint record_buffer_{0};
+  std::byte* mapped_{nullptr};
+  // Bytes per region: a multiple of the storage buffer offset alignment.
+  std::size_t region_bytes_{0};
+  std::size_t region_records_{0};
+  std::size_t offset_alignment_{0};
+  std::size_t current_region_{0};
+  std::size_t record_count_{0};
+  std::array<GLsync, kRegionCount> fences_{};
+};
+
+#endif  // FRAME_UNIFORMS_HPP
@@ -7,9 +7,11 @@
 // moved between versions. Including the internal paths
 // (<freetype2/freetype/freetype.h>, ...) directly only worked because the
 // include path happened to contain freetype2/ and is not portable. The base
-// API header alone is sufficient here — it transitively pulls in ftimage.h
-// (FT_GLYPH_FORMAT_BITMAP) and fterrors.h (FT_Error_String); the glyph/image
-// sub-APIs are not used.
+// API header transitively pulls in ftimage.h (FT_GLYPH_FORMAT_BITMAP) and
+// fterrors.h (FT_Error_String); FT_MODULE_H adds FT_Property_Set, which sets
+// the spread of the SDF renderers, and FT_ADVANCES_H adds FT_Get_Advance, the
+// advance of a glyph without loading its outline. The glyph/image sub-APIs
+// are not used.
 // FT_FREETYPE_H is a macro defined by ft2build.h, so it can only be included
 // after it. clang-tidy's include sorter would order FT_FREETYPE_H first
 // (case-sensitive, brackets stripped), which breaks the build; FreeType's
@@ -17,5 +19,7 @@
 // NOLINTNEXTLINE(llvm-include-order)
 #include <ft2build.h>   // IWYU pragma: export
 #include FT_FREETYPE_H  // IWYU pragma: export
+#include FT_MODULE_H    // IWYU pragma: export
+#include FT_ADVANCES_H  // IWYU pragma: export
 
 #endif  // FREETYPE_HPP
@@ -0,0 +1,81 @@
+#include "freetype_face.hpp"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "freetype.hpp"
+
+FreeTypeFace::FreeTypeFace(const std::string& file_path) {
+  const FT_Error init_error = FT_Init_FreeType(&library_);
+  if (init_error != FT_Err_Ok) {
+    throw std::runtime_error(std::string("Freetype FT_Init_FreeType failed ") +
+                             std::to_string(init_error));
+  }
+
+  // From here on a throw leaves the constructor unfinished, and no destructor
+  // would run: release by hand.
+  try {
+    const FT_Error face_error =
+        FT_New_Face(library_, file_path.c_str(), 0, &face_);
+    if (face_error != FT_Err_Ok) {
+      throw std::runtime_error(std::string("Freetype FT_New_Face failed ") +
+                               std::to_string(face_error));
+    }
+
+    const FT_Error size_error = FT_Set_Pixel_Sizes(face_, 0, kPixelHeight);
+    if (size_error != FT_Err_Ok) {
+      throw std::runtime_error(
+          std::string("Freetype FT_Set_Pixel_Sizes failed ") +
+          std::to_string(size_error));
+    }
+
+    // Both renderers: "sdf" works from outlines, "bsdf" from the embedded
+    // bitmaps some fonts carry instead.
+    for (const char* const renderer : {"sdf", "bsdf"}) {
+      const FT_Error property_error =
+          FT_Property_Set(library_, renderer, "spread", &kSdfSpread);
+      if (property_error != FT_Err_Ok) {
+        throw std::runtime_error(std::string("Freetype FT_Property_Set ") +
+                                 renderer + " spread failed " +
+                                 std::to_string(property_error));
+      }
+    }
+  } catch (...) {
+    Release();
+    throw;
+  }
+}
+
+FreeTypeFace::~FreeTypeFace() { Release(); }
+
+FT_Library FreeTypeFace::Library() const { return library_; }
+
+FT_Face FreeTypeFace::Face() const { return face_; }
+
+float FreeTypeFace::EmFromFixed(FT_Pos value) {
+  return static_cast<float>(value) / kFixedScale /
+         static_cast<float>(kPixelHeight);
+}
+
+float FreeTypeFace::EmFromLinear(FT_Fixed value) {
+  return static_cast<float>(value) / kLinearScale /
+         static_cast<float>(kPixelHeight);
+}
+
+void FreeTypeFace::Release() noexcept {
+  if (face_ != nullptr) {
+    const FT_Error ft_error = FT_Done_Face(face_);
+    if (ft_error != FT_Err_Ok) {
+      std::cerr << "Freetype FT_Done_Face failed " << ft_error << '\n';
+    }
+    face_ = nullptr;
+  }
+  if (library_ != nullptr) {
+    const FT_Error ft_error = FT_Done_FreeType(library_);
+    if (ft_error != FT_Err_Ok) {
+      std::cerr << "Freetype FT_Done_FreeType failed " << ft_error << '\n';
+    }
+    library_ = nullptr;
+  }
+}
@@ -0,0 +1,52 @@
+#ifndef FREETYPE_FACE_HPP
+#define FREETYPE_FACE_HPP
+
+#include <string>
+
+#include "freetype.hpp"
+
+// A FreeType library with one face of a font file loaded into it, set up the
+// way every glyph of this program is rendered: kPixelHeight to the em, signed
+// distance fields with kSdfSpread pixels of distance on either side.
+//
+// Library and face come as a pair because FreeType objects are not to be
+// shared between threads: the font measures through one pair on the GL
+// thread, and every rasterizer worker renders through a pair of its own.
+// RAII — both are released on destruction, failures there only logged.
+class FreeTypeFace {
+ public:
+  static constexpr FT_UInt kPixelHeight = 64;
+  static constexpr FT_Int kSdfSpread = 8;
+
+  // Throws std::runtime_error when FreeType fails to start or to load the
+  // file.
+  explicit FreeTypeFace(const std::string& file_path);
+
+  ~FreeTypeFace();
+
+  FreeTypeFace(const FreeTypeFace&) = delete;
+  FreeTypeFace& operator=(const FreeTypeFace&) = delete;
+  FreeTypeFace(FreeTypeFace&&) = delete;
+  FreeTypeFace& operator=(FreeTypeFace&&) = delete;
+
+  [[nodiscard]] FT_Library Library() const;
+
+  [[nodiscard]] FT_Face Face() const;
+
+  // Em units from FreeType's 26.6 pixel metrics and from its 16.16 linear
+  // advances, both at kPixelHeight.
+  [[nodiscard]] static float EmFromFixed(FT_Pos value);
+
+  [[nodiscard]] static float EmFromLinear(FT_Fixed value);
+
+ private:
+  void Release() noexcept;
+
+  static constexpr float kFixedScale = 64.0F;
+  static constexpr float kLinearScale = 65536.0F;
+
+  FT_Library library_{nullptr};
+  FT_Face face_{nullptr};
+};
+
+#endif  // FREETYPE_FACE_HPP
@@ -0,0 +1,132 @@
+#include "glyph_atlas.hpp"
+
+#include <epoxy/gl.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../common/debug_log.hpp"
+#include "shelf_packer.hpp"
+#include "texture_object.hpp"
+
+GlyphAtlas::GlyphAtlas() : packer_(kWidth, kInitialHeight) {}
+
+GlyphAtlas::Region GlyphAtlas::Insert(std::span<const std::uint8_t> pixels,
+                                      int width, int height, int pitch) {
+  // Blank glyphs (the space) have a quad of no size and need no texels.
+  if (width <= 0 || height <= 0) {
+    return {.x = 0, .y = 0, .width = 0, .height = 0};
+  }
+  if (!texture_.has_value()) {
+    texture_ = CreateTexture(packer_.Height());
+    texels_.assign(static_cast<std::size_t>(kWidth) *
+                       static_cast<std::size_t>(packer_.Height()),
+                   0);
+  }
+
+  std::optional<ShelfPacker::Slot> slot =
+      packer_.Insert(width + (2 * kGap), height + (2 * kGap));
+  while (!slot.has_value()) {
+    Grow(packer_.Height() * 2);
+    slot = packer_.Insert(width + (2 * kGap), height + (2 * kGap));
+  }
+  const Region region{.x = slot->x + kGap,
+                      .y = slot->y + kGap,
+                      .width = width,
+                      .height = height};
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, pitch);
+  glBindTexture(GL_TEXTURE_2D, texture_->Name());
+  glTexSubImage2D(GL_TEXTURE_2D, 0, region.x, region.y, region.width,
+                  region.height, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+  // The CPU copy, row by row as the texture took it.
+  for (int row = 0; row < height; ++row) {
+    const std::span<const std::uint8_t> source =
+        pixels.subspan(static_cast<std::size_t>(row) *
+                           static_cast<std::size_t>(pitch),
+                       static_cast<std::size_t>(width));
+    const std::size_t target =
+        (static_cast<std::size_t>(region.y + row) * kWidth) +
+        static_cast<std::size_t>(region.x);
+    std::ranges::copy(source,
+                      texels_.begin() + static_cast<std::ptrdiff_t>(target));
+  }
+
+  return region;
+}
+
+GLuint GlyphAtlas::TextureName() const {
+  return texture_.has_value() ? texture_->Name() : 0;
+}
+
+std::span<const std::uint8_t> GlyphAtlas::Texels() const { return texels_; }
+
+int GlyphAtlas::Height() const {
+  return texture_.has_value() ? packer_.Height() : 0;
+}
+
+std::size_t GlyphAtlas::TextureBytes() const {
+  if (!texture_.has_value()) {
+    return 0;
+  }
+  return static_cast<std::size_t>(packer_.Width()) *
+         static_cast<std::size_t>(packer_.Height());
+}
+
+void GlyphAtlas::Grow(int height) {
+  GLint max_size = 0;
+  glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_size);
+  if (height > max_size) {
+    throw std::runtime_error("Glyph atlas of " + std::to_string(height) +
+                             " rows exceeds GL_MAX_TEXTURE_SIZE " +
+                             std::to_string(max_size));
+  }
+
+  Texture grown = CreateTexture(height);
+  const int used_height = packer_.UsedHeight();
+  if (used_height > 0) {
+    glCopyImageSubData(texture_->Name(), GL_TEXTURE_2D, 0, 0, 0, 0,
+                       grown.Name(), GL_TEXTURE_2D, 0, 0, 0, 0, kWidth,
+                       used_height, 1);
+  }
+  texture_ = std::move(grown);
+  packer_.Grow(height);
+  // Rows of one width: the new rows go on behind the old, zero like the
+  // texture's.
+  texels_.resize(static_cast<std::size_t>(kWidth) *
+                     static_cast<std::size_t>(height),
+                 0);
+
+  if (decade_debug::LogEnabled()) {
+    std::cout << "glyph atlas grown to " << kWidth << "x" << height << '\n';
+  }
+}
+
+Texture GlyphAtlas::CreateTexture(int height) {
+  Texture texture;
+  glBindTexture(GL_TEXTURE_2D, texture.Name());
+  glTexStorage2D(GL_TEXTURE_2D, 1, GL_R8, kWidth, height);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  // Zero is the farthest outside a field encodes: the gaps between glyphs
+  // and the rows not yet used read as empty.
+  constexpr GLubyte kOutside = 0;
+  glClearTexImage(texture.Name(), 0, GL_RED, GL_UNSIGNED_BYTE, &kOutside);
+  return texture;
+}
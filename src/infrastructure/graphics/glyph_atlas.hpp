@@ -0,0 +1,78 @@
+#ifndef GLYPH_ATLAS_HPP
+#define GLYPH_ATLAS_HPP
+
+#include <epoxy/gl.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "shelf_packer.hpp"
+#include "texture_object.hpp"
+
+// One GL_R8 texture holding the signed distance fields of every glyph a Font
+// has rendered, packed by a ShelfPacker.
+//
+// The texture is as wide as kWidth and starts kInitialHeight rows tall; when
+// a glyph no longer fits it doubles in height, copying what it holds into the
+// larger texture. Glyphs keep their texel positions through that, and the
+// font shader divides by the texture's current size, so geometry built before
+// a growth stays correct — only the texture name changes, which is why
+// FontShape asks for TextureName() at every draw instead of keeping it.
+//
+// The texture is created with the first glyph, not with the atlas: a Font may
+// be constructed before the GL context is current, a glyph never is.
+//
+// The texels are kept on the CPU as well, a copy the size of the texture,
+// for the software rasterizer (software_raster.hpp): an export drawn on the
+// CPU reads the glyphs from there, where reading the texture back would need
+// the GL driver the CPU path is there to do without.
+class GlyphAtlas {
+ public:
+  struct Region {
+    int x;
+    int y;
+    int width;
+    int height;
+  };
+
+  static constexpr int kWidth = 1024;
+  static constexpr int kInitialHeight = 256;
+  // Empty texels around each glyph, so linear filtering at a quad's border
+  // reads the glyph's own outside distance and not its neighbour's.
+  static constexpr int kGap = 1;
+
+  GlyphAtlas();
+
+  // Packs and uploads a `width` x `height` 8-bit field whose rows lie `pitch`
+  // bytes apart, first row at the region's y. Throws std::runtime_error when
+  // the atlas would outgrow GL_MAX_TEXTURE_SIZE.
+  [[nodiscard]] Region Insert(std::span<const std::uint8_t> pixels, int width,
+                              int height, int pitch);
+
+  // The texture name to bind, 0 while the atlas is still empty.
+  [[nodiscard]] GLuint TextureName() const;
+
+  // Bytes the texture occupies on the GPU, for the debug log.
+  [[nodiscard]] std::size_t TextureBytes() const;
+
+  // The CPU copy of the texture, kWidth texels a row, Height() rows; empty
+  // while the atlas is. Valid until the next Insert, which may grow it.
+  [[nodiscard]] std::span<const std::uint8_t> Texels() const;
+
+  [[nodiscard]] int Height() const;
+
+ private:
+  // Replaces the texture by one `height` rows tall holding the old contents.
+  void Grow(int height);
+
+  [[nodiscard]] static Texture CreateTexture(int height);
+
+  ShelfPacker packer_;
+  std::optional<Texture> texture_;
+  std::vector<std::uint8_t> texels_;
+};
+
+#endif  // GLYPH_ATLAS_HPP
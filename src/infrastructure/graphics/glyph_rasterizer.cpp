@@ -0,0 +1,173 @@
+#include "glyph_rasterizer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <glm/ext/vector_float2.hpp>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "freetype.hpp"
+#include "freetype_face.hpp"
+
+namespace {
+
+unsigned WorkerCount() {
+  const unsigned cores = std::thread::hardware_concurrency();
+  return cores > 1 ? std::min(cores - 1, GlyphRasterizer::kMaxWorkers) : 1;
+}
+
+}  // namespace
+
+GlyphRasterizer::GlyphRasterizer(const std::string& file_path,
+                                 std::function<void()> on_finished)
+    : on_finished_(std::move(on_finished)) {
+  const unsigned count = WorkerCount();
+  for (unsigned index = 0; index < count; ++index) {
+    faces_.push_back(std::make_unique<FreeTypeFace>(file_path));
+  }
+  for (const auto& face : faces_) {
+    workers_.emplace_back([this, &face = *face] { Work(face); });
+  }
+}
+
+GlyphRasterizer::~GlyphRasterizer() {
+  {
+    const std::scoped_lock lock(mutex_);
+    stopping_ = true;
+  }
+  work_queued_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+void GlyphRasterizer::Request(char32_t code_point) {
+  {
+    const std::scoped_lock lock(mutex_);
+    queue_.push_back(code_point);
+  }
+  work_queued_.notify_one();
+}
+
+std::vector<RasterizedGlyph> GlyphRasterizer::TakeFinished() {
+  const std::scoped_lock lock(mutex_);
+  return std::exchange(finished_, {});
+}
+
+std::vector<RasterizedGlyph> GlyphRasterizer::WaitForAll() {
+  std::unique_lock lock(mutex_);
+  work_done_.wait(lock, [this] { return queue_.empty() && in_flight_ == 0; });
+  return std::exchange(finished_, {});
+}
+
+RasterizedGlyph GlyphRasterizer::Rasterize(FT_Face face, char32_t code_point) {
+  const FT_Error load_char_error = FT_Load_Char(
+      face, static_cast<FT_ULong>(code_point), FT_LOAD_NO_HINTING);
+  if (load_char_error != FT_Err_Ok) {
+    throw std::runtime_error(std::string("Freetype FT_Load_Char failed ") +
+                             std::to_string(load_char_error));
+  }
+
+  const FT_GlyphSlotRec_* const glyph = face->glyph;
+  Letter letter;
+  letter.size = glm::vec2(FreeTypeFace::EmFromFixed(glyph->metrics.width),
+                          FreeTypeFace::EmFromFixed(glyph->metrics.height));
+  letter.bearing =
+      glm::vec2(FreeTypeFace::EmFromFixed(glyph->metrics.horiBearingX),
+                FreeTypeFace::EmFromFixed(glyph->metrics.horiBearingY));
+  letter.advance = FreeTypeFace::EmFromLinear(glyph->linearHoriAdvance);
+
+  RasterizedGlyph result;
+  result.code_point = code_point;
+
+  // Blank glyphs (the space) have an advance and nothing to draw; the SDF
+  // renderer has no field to make of an empty outline.
+  const bool blank = glyph->format == FT_GLYPH_FORMAT_OUTLINE &&
+                     glyph->outline.n_points == 0;
+  if (blank) {
+    result.letter = letter;
+    return result;
+  }
+
+  const FT_Error render_error =
+      FT_Render_Glyph(face->glyph, FT_RENDER_MODE_SDF);
+  if (render_error != FT_Err_Ok) {
+    throw std::runtime_error(std::string("Freetype FT_Render_Glyph failed ") +
+                             std::to_string(render_error));
+  }
+  const auto& bitmap = glyph->bitmap;
+  if (bitmap.pixel_mode != FT_PIXEL_MODE_GRAY || bitmap.pitch < 0) {
+    throw std::runtime_error(
+        std::string("Freetype SDF bitmap is not top-down 8-bit gray"));
+  }
+
+  // Copied row by row: the slot's buffer belongs to the face and is reused by
+  // the next glyph, and its rows may be padded beyond the width.
+  result.width = static_cast<int>(bitmap.width);
+  result.rows = static_cast<int>(bitmap.rows);
+  result.pixels.resize(static_cast<std::size_t>(bitmap.width) * bitmap.rows);
+  for (unsigned row = 0; row < bitmap.rows; ++row) {
+    const std::uint8_t* source =
+        bitmap.buffer + (static_cast<std::ptrdiff_t>(row) * bitmap.pitch);
+    std::copy_n(source, bitmap.width,
+                result.pixels.begin() +
+                    static_cast<std::ptrdiff_t>(row * bitmap.width));
+  }
+
+  const auto pixel_height = static_cast<float>(FreeTypeFace::kPixelHeight);
+  letter.quad_size = glm::vec2(static_cast<float>(result.width) / pixel_height,
+                               static_cast<float>(result.rows) / pixel_height);
+  letter.quad_bearing =
+      glm::vec2(static_cast<float>(glyph->bitmap_left) / pixel_height,
+                static_cast<float>(glyph->bitmap_top) / pixel_height);
+  result.letter = letter;
+  return result;
+}
+
+void GlyphRasterizer::Work(const FreeTypeFace& face) {
+  while (true) {
+    char32_t code_point = 0;
+    {
+      std::unique_lock lock(mutex_);
+      work_queued_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+      if (stopping_) {
+        return;
+      }
+      code_point = queue_.front();
+      queue_.pop_front();
+      ++in_flight_;
+    }
+
+    RasterizedGlyph result;
+    try {
+      result = Rasterize(face.Face(), code_point);
+    } catch (const std::exception& error) {
+      std::cerr << "glyph U+" << std::hex
+                << static_cast<std::uint32_t>(code_point) << std::dec
+                << " not rendered: " << error.what() << '\n';
+      result = RasterizedGlyph();
+      result.code_point = code_point;
+    }
+
+    bool first_waiting = false;
+    {
+      const std::scoped_lock lock(mutex_);
+      first_waiting = finished_.empty();
+      finished_.push_back(std::move(result));
+      --in_flight_;
+    }
+    work_done_.notify_all();
+    if (first_waiting && on_finished_) {
+      on_finished_();
+    }
+  }
+}
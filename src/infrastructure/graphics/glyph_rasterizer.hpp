@@ -0,0 +1,111 @@
+#ifndef GLYPH_RASTERIZER_HPP
+#define GLYPH_RASTERIZER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <glm/vec2.hpp>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "freetype_face.hpp"
+#include "glyph_atlas.hpp"
+
+// One glyph, in em units (multiples of the font size) unless said otherwise.
+struct Letter {
+  // The outline's box and the pen advance — what text layout measures with.
+  glm::vec2 size{0.0F, 0.0F};
+  glm::vec2 bearing{0.0F, 0.0F};
+  float advance{0.0F};
+  // The quad the distance field is drawn on, relative to the pen position. It
+  // exceeds the outline by the field's spread on every side.
+  glm::vec2 quad_size{0.0F, 0.0F};
+  glm::vec2 quad_bearing{0.0F, 0.0F};
+  // Where the field lies in the atlas, in texels.
+  GlyphAtlas::Region atlas_region{};
+};
+
+// A glyph's metrics and distance field, rendered but not yet in the atlas.
+// `letter` is nullopt when FreeType failed on the code point; `pixels` holds
+// `rows` rows of `width` bytes, top row first, and is empty for blank glyphs.
+struct RasterizedGlyph {
+  char32_t code_point{0};
+  std::optional<Letter> letter;
+  std::vector<std::uint8_t> pixels;
+  int width{0};
+  int rows{0};
+};
+
+// Renders glyph distance fields on worker threads, so a scene build meeting
+// new characters does not wait for them.
+//
+// Rendering a distance field is the expensive part of a glyph — FreeType's
+// SDF renderer computes a distance for every texel of the quad — while the
+// upload into the atlas is a small texture write. The two are split along
+// that line: each worker holds a FreeTypeFace of its own (FreeType objects are
+// not thread-safe) and renders into plain memory; the GL thread collects the
+// results (TakeFinished) and uploads them.
+//
+// `on_finished` is called on a worker thread when results wait where none
+// waited before — once per batch, not per glyph — so its owner can hand the
+// upload over to the GL thread. It must not call back into the rasterizer.
+class GlyphRasterizer {
+ public:
+  // Workers at most: a year of labels needs a hundred glyphs or so, and the
+  // GL thread keeps a core of its own.
+  static constexpr unsigned kMaxWorkers = 4;
+
+  // Opens one face per worker; throws std::runtime_error when the file does
+  // not load.
+  GlyphRasterizer(const std::string& file_path,
+                  std::function<void()> on_finished);
+
+  // Waits for the glyph each worker is rendering, drops the queued ones.
+  ~GlyphRasterizer();
+
+  GlyphRasterizer(const GlyphRasterizer&) = delete;
+  GlyphRasterizer& operator=(const GlyphRasterizer&) = delete;
+  GlyphRasterizer(GlyphRasterizer&&) = delete;
+  GlyphRasterizer& operator=(GlyphRasterizer&&) = delete;
+
+  // Queues `code_point`. The caller asks once per code point; a second
+  // request renders it a second time.
+  void Request(char32_t code_point);
+
+  // The glyphs rendered since the last call, without waiting.
+  [[nodiscard]] std::vector<RasterizedGlyph> TakeFinished();
+
+  // Blocks until every requested glyph is rendered, then takes them all.
+  [[nodiscard]] std::vector<RasterizedGlyph> WaitForAll();
+
+  // The rendering itself: loads `code_point` unhinted into `face` and renders
+  // its distance field. Throws std::runtime_error when FreeType fails.
+  [[nodiscard]] static RasterizedGlyph Rasterize(FT_Face face,
+                                                 char32_t code_point);
+
+ private:
+  void Work(const FreeTypeFace& face);
+
+  std::function<void()> on_finished_;
+  std::vector<std::unique_ptr<FreeTypeFace>> faces_;
+
+  std::mutex mutex_;
+  std::condition_variable work_queued_;
+  std::condition_variable work_done_;
+  std::deque<char32_t> queue_;
+  std::size_t in_flight_{0};
+  std::vector<RasterizedGlyph> finished_;
+  bool stopping_{false};
+
+  // Last, so the workers start after, and are joined before, everything they
+  // use.
+  std::vector<std::thread> workers_;
+};
+
+#endif  // GLYPH_RASTERIZER_HPP
@@ -2,14 +2,32 @@
 
 #include <epoxy/gl.h>
 
+#include <algorithm>
+#include <array>
+#include <filesystem>
 #include <functional>
+#include <glm/ext/matrix_float4x4.hpp>
+#include <glm/ext/vector_float4.hpp>
+#include <glm/matrix.hpp>
+#include <limits>
 #include <optional>
 #include <string>
 
 #include "mvp_matrices.hpp"
+#include "rect.hpp"
 #include "scene.hpp"
 #include "shaders.hpp"
 
+GraphicsEngine::GraphicsEngine(
+    const std::optional<std::filesystem::path>& shader_cache_directory)
+    : shaders_(shader_cache_directory) {}
+
+glm::vec4 GraphicsEngine::ClearColorRgba() {
+  return {static_cast<float>(kClearColor.r()),
+          static_cast<float>(kClearColor.g()),
+          static_cast<float>(kClearColor.b()), 1.0F};
+}
+
 void GraphicsEngine::Render() {
   glClearColor(static_cast<GLfloat>(kClearColor.r()),
                static_cast<GLfloat>(kClearColor.g()),
@@ -18,18 +36,47 @@ void GraphicsEngine::Render() {
 
   // The per-node model matrix is applied by each Shape during the scene-graph
   // traversal below.
-  shaders_.SetCameraUniforms(mvp_);
+  shaders_.BeginFrame(mvp_);
 
   if (scene_.has_value()) {
-    scene_->get().Draw();
+    last_cull_stats_ = scene_->get().Draw(VisibleRegion());
   }
+  shaders_.EndFrame();
 }
 
 void GraphicsEngine::SetMVP(const MVP& new_mvp) { mvp_ = new_mvp; }
 
 void GraphicsEngine::SetScene(Scene& scene) { scene_ = std::ref(scene); }
 
+std::optional<std::reference_wrapper<Scene>> GraphicsEngine::GetScene() const {
+  return scene_;
+}
+
 std::optional<std::reference_wrapper<Shader>> GraphicsEngine::SearchShader(
     const std::string& search_name) {
   return shaders_.SearchShader(search_name);
 }
+
+Scene::CullStats GraphicsEngine::LastCullStats() const {
+  return last_cull_stats_;
+}
+
+RectF GraphicsEngine::VisibleRegion() const {
+  const glm::mat4 clip_to_world =
+      glm::inverse(mvp_.GetProjection() * mvp_.GetView());
+  const std::array<glm::vec4, 4> clip_corners = {
+      glm::vec4(-1.0F, -1.0F, 0.0F, 1.0F), glm::vec4(1.0F, -1.0F, 0.0F, 1.0F),
+      glm::vec4(-1.0F, 1.0F, 0.0F, 1.0F), glm::vec4(1.0F, 1.0F, 0.0F, 1.0F)};
+  float min_x = std::numeric_limits<float>::max();
+  float min_y = std::numeric_limits<float>::max();
+  float max_x = std::numeric_limits<float>::lowest();
+  float max_y = std::numeric_limits<float>::lowest();
+  for (const auto& corner : clip_corners) {
+    const glm::vec4 world = clip_to_world * corner;
+    min_x = std::min(min_x, world.x / world.w);
+    min_y = std::min(min_y, world.y / world.w);
+    max_x = std::max(max_x, world.x / world.w);
+    max_y = std::max(max_y, world.y / world.w);
+  }
+  return RectF(min_x, max_x, min_y, max_y);
+}
@@ -1,12 +1,15 @@
 #ifndef GRAPHICS_ENGINE_HPP
 #define GRAPHICS_ENGINE_HPP
 
+#include <filesystem>
 #include <functional>
+#include <glm/vec4.hpp>
 #include <optional>
 #include <string>
 #include <tinycolormap.hpp>
 
 #include "mvp_matrices.hpp"
+#include "rect.hpp"
 #include "scene.hpp"
 #include "shaders.hpp"
 
@@ -15,6 +18,15 @@ class GraphicsEngine {
   // Background fill of the GL framebuffer: a dark grey.
   static constexpr tinycolormap::Color kClearColor{0.2};
 
+  // kClearColor, opaque, as the exports that paint without GL take it.
+  [[nodiscard]] static glm::vec4 ClearColorRgba();
+
+  // Builds the shaders, keeping their linked programs in
+  // `shader_cache_directory` between starts when there is one. GL: the
+  // context must be current.
+  explicit GraphicsEngine(
+      const std::optional<std::filesystem::path>& shader_cache_directory);
+
   void Render();
 
   void SetMVP(const MVP& new_mvp);
@@ -26,12 +38,25 @@ class GraphicsEngine {
   // member would say nothing about ownership either way.
   void SetScene(Scene& scene);
 
+  // The scene SetScene lent, for the software export, which paints it without
+  // going through Render().
+  [[nodiscard]] std::optional<std::reference_wrapper<Scene>> GetScene() const;
+
   std::optional<std::reference_wrapper<Shader>> SearchShader(
       const std::string& search_name);
 
+  // What the last Render() drew and culled; zero before the first frame with
+  // a scene. The debug frame line reports it.
+  [[nodiscard]] Scene::CullStats LastCullStats() const;
+
  private:
+  // The part of the world the current view shows: the clip-space square
+  // taken back through the inverse of projection * view.
+  [[nodiscard]] RectF VisibleRegion() const;
+
   MVP mvp_;
   Shaders shaders_;
   std::optional<std::reference_wrapper<Scene>> scene_;
+  Scene::CullStats last_cull_stats_;
 };
 #endif  // GRAPHICS_ENGINE_HPP
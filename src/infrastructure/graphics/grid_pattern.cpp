@@ -0,0 +1,78 @@
+#include "grid_pattern.hpp"
+
+#include <cmath>
+#include <glm/ext/vector_float2.hpp>
+#include <glm/ext/vector_float3.hpp>
+#include <glm/ext/vector_float4.hpp>
+
+#include "rect.hpp"
+
+namespace grid_pattern {
+
+int CellCount(const Pattern& pattern, const CellRow& row) {
+  return static_cast<int>(std::lround(row.cells.Width() / pattern.cell_width));
+}
+
+bool IsDrawn(const Pattern& pattern, const CellRow& row, int cell) {
+  const int remainder =
+      (((cell - row.phase) % pattern.period) + pattern.period) %
+      pattern.period;
+  const bool on_phase = remainder == 0;
+  return on_phase == (pattern.selection == CellSelection::kOnPhase);
+}
+
+glm::vec4 Composite(const glm::vec4& under, const glm::vec4& over) {
+  const float alpha = over.a + (under.a * (1.0F - over.a));
+  if (alpha <= 0.0F) {
+    return glm::vec4(0.0F);
+  }
+  const glm::vec3 premultiplied =
+      (glm::vec3(over) * over.a) +
+      (glm::vec3(under) * under.a * (1.0F - over.a));
+  return {premultiplied / alpha, alpha};
+}
+
+glm::vec4 SampleColor(const Pattern& pattern, const CellRow& row,
+                      glm::vec2 point) {
+  const CellStyle& style = pattern.style;
+  const float half_line = style.line_width * 0.5F;
+  const float left = row.cells.Left();
+  const float bottom = row.cells.Bottom();
+  const float top = row.cells.Top();
+
+  glm::vec4 color(0.0F);
+  if (point.y < bottom - half_line || point.y >= top + half_line) {
+    return color;
+  }
+  const bool inside_vertically =
+      point.y >= bottom + half_line && point.y < top - half_line;
+
+  // The cells whose outline may reach `point` — a wide line overlaps more
+  // than the direct neighbours — plus one on either side, so a division that
+  // rounds the other way than the sums below cannot drop a cell. The sums
+  // decide.
+  const int first = static_cast<int>(std::floor(
+                        (point.x - left - half_line) / pattern.cell_width)) -
+                    1;
+  const int last = static_cast<int>(std::floor(
+                       (point.x - left + half_line) / pattern.cell_width)) +
+                   1;
+  const int count = CellCount(pattern, row);
+  for (int cell = first; cell <= last; ++cell) {
+    if (cell < 0 || cell >= count || !IsDrawn(pattern, row, cell)) {
+      continue;
+    }
+    const float cell_left =
+        left + (static_cast<float>(cell) * pattern.cell_width);
+    const float cell_right = cell_left + pattern.cell_width;
+    if (point.x < cell_left - half_line || point.x >= cell_right + half_line) {
+      continue;
+    }
+    const bool inside = inside_vertically && point.x >= cell_left + half_line &&
+                        point.x < cell_right - half_line;
+    color = Composite(color, inside ? style.fill_color : style.outline_color);
+  }
+  return color;
+}
+
+}  // namespace grid_pattern
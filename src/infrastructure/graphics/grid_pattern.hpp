@@ -0,0 +1,69 @@
+#ifndef GRID_PATTERN_HPP
+#define GRID_PATTERN_HPP
+
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include "rect.hpp"
+
+// The rules GridShape's fragment shader paints by, in C++ and without GL. A
+// row of equal cells, each drawn the way BoxesShape draws a rectangle — fill
+// inside, outline straddling the edges — but only the cells a periodic
+// selection picks: every `period`-th from `phase` on, or every other one. The
+// calendar draws its day cells as the off-phase and its Sunday cells as the
+// on-phase cells of one year row each.
+//
+// grid_fragment_shader.glsl implements SampleColor line by line. This twin is
+// what the tests hold against the rectangles the grid replaced; a change to
+// either wants the same change in the other.
+namespace grid_pattern {
+
+enum class CellSelection : std::uint8_t {
+  // Every cell except those at phase + k * period.
+  kOffPhase,
+  // Exactly the cells at phase + k * period.
+  kOnPhase,
+};
+
+struct CellStyle {
+  float line_width;
+  glm::vec4 outline_color;
+  glm::vec4 fill_color;
+};
+
+struct Pattern {
+  float cell_width;
+  int period;
+  CellSelection selection;
+  CellStyle style;
+};
+
+// One row: the cells span `cells` from left to right, cell_width each; the
+// first on-phase cell is the one at index `phase`.
+struct CellRow {
+  RectF cells;
+  int phase;
+};
+
+[[nodiscard]] int CellCount(const Pattern& pattern, const CellRow& row);
+
+[[nodiscard]] bool IsDrawn(const Pattern& pattern, const CellRow& row,
+                           int cell);
+
+// `over` composited on top of `under`, both straight (not premultiplied)
+// alpha — what two draws in a row leave under the renderer's blend function,
+// folded into one colour so a single fragment can stand for both.
+[[nodiscard]] glm::vec4 Composite(const glm::vec4& under,
+                                  const glm::vec4& over);
+
+// The colour the drawn cells leave at `point`, in the row's space: their
+// fills and outlines composited in cell order, as the rectangle draws used to
+// stack them where neighbouring outlines overlap. Zero alpha where no drawn
+// cell reaches.
+[[nodiscard]] glm::vec4 SampleColor(const Pattern& pattern, const CellRow& row,
+                                    glm::vec2 point);
+
+}  // namespace grid_pattern
+
+#endif  // GRID_PATTERN_HPP
@@ -0,0 +1,84 @@
+#include "grid_shape.hpp"
+
+#include <epoxy/gl.h>
+
+#include <algorithm>
+#include <glm/ext/matrix_float4x4.hpp>
+#include <glm/ext/vector_float4.hpp>
+#include <span>
+#include <vector>
+
+#include "drawable.hpp"
+#include "frame_uniforms.hpp"
+#include "grid_pattern.hpp"
+#include "rect.hpp"
+#include "shaders.hpp"
+#include "shapes.hpp"
+#include "shapes_base.hpp"
+#include "vertex_objects.hpp"
+
+GridShape::GridShape(Shader& shader_in) : Shape(shader_in) {
+  UsePerInstanceAttributes();
+}
+
+DrawableKind GridShape::Kind() const { return DrawableKind::kGrid; }
+
+void GridShape::SetShape(const std::vector<grid_pattern::CellRow>& rows,
+                         const grid_pattern::Pattern& pattern) {
+  rows_ = rows;
+  pattern_ = pattern;
+
+  std::vector<glm::vec4> edges;
+  std::vector<float> phases;
+  edges.reserve(rows.size());
+  phases.reserve(rows.size());
+  for (const auto& row : rows) {
+    edges.emplace_back(row.cells.Left(), row.cells.Right(), row.cells.Bottom(),
+                       row.cells.Top());
+    phases.push_back(static_cast<float>(row.phase));
+  }
+  SetBuffer("edges", std::span<const glm::vec4>(edges));
+  SetBuffer("phase", std::span<const float>(phases));
+
+  if (rows.empty()) {
+    SetLocalBounds({});
+    return;
+  }
+  // The union of the rows, grown by half the line width like BoxesShape's —
+  // the outlines straddle the outer edges.
+  const float half_line = pattern.style.line_width * 0.5F;
+  float left = rows.front().cells.Left();
+  float right = rows.front().cells.Right();
+  float bottom = rows.front().cells.Bottom();
+  float top = rows.front().cells.Top();
+  for (const auto& row : rows) {
+    left = std::min(left, row.cells.Left());
+    right = std::max(right, row.cells.Right());
+    bottom = std::min(bottom, row.cells.Bottom());
+    top = std::max(top, row.cells.Top());
+  }
+  SetLocalBounds({left - half_line, right + half_line, bottom - half_line,
+                  top + half_line});
+}
+
+void GridShape::Draw(const glm::mat4& model) const {
+  DrawRecord record(model);
+  record.color = pattern_.style.fill_color;
+  record.outline_color = pattern_.style.outline_color;
+  record.pattern = glm::vec4(
+      pattern_.cell_width, static_cast<float>(pattern_.period),
+      pattern_.selection == grid_pattern::CellSelection::kOnPhase ? 1.0F : 0.0F,
+      pattern_.style.line_width);
+  GetShader().UseProgram(record);
+
+  VaoRef().Bind();
+  glDrawArraysInstanced(GL_TRIANGLES, 0, static_cast<GLsizei>(kVerticesPerQuad),
+                        VertexCount());
+  VertexArrayObject::Unbind();
+}
+
+const std::vector<grid_pattern::CellRow>& GridShape::Rows() const {
+  return rows_;
+}
+
+const grid_pattern::Pattern& GridShape::GetPattern() const { return pattern_; }
@@ -0,0 +1,44 @@
+#ifndef GRID_SHAPE_HPP
+#define GRID_SHAPE_HPP
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+#include <vector>
+
+#include "drawable.hpp"
+#include "grid_pattern.hpp"
+#include "shaders.hpp"
+#include "shapes_base.hpp"
+
+// Rows of equal cells, each row one quad: the cell edges, fills and outlines
+// get made per fragment (grid_fragment_shader.glsl, after
+// grid_pattern::SampleColor) instead of per rectangle on the CPU. A decade of
+// day cells used to be some 3650 rectangles of thirty vertices each; it is ten
+// rows now, one record of five floats apiece.
+//
+// Which cells of a row get drawn is a periodic selection (see
+// grid_pattern::Pattern), so two grid shapes over the same rows split them
+// between two styles — the calendar's weekdays and Sundays.
+class GridShape : public Shape {
+ public:
+  explicit GridShape(Shader& shader_in);
+
+  [[nodiscard]] DrawableKind Kind() const override;
+
+  void SetShape(const std::vector<grid_pattern::CellRow>& rows,
+                const grid_pattern::Pattern& pattern);
+
+  void Draw(const glm::mat4& model) const override;
+
+  // The rows and the pattern of the last SetShape, for the software export,
+  // which paints the drawn cells as rectangles.
+  [[nodiscard]] const std::vector<grid_pattern::CellRow>& Rows() const;
+
+  [[nodiscard]] const grid_pattern::Pattern& GetPattern() const;
+
+ private:
+  std::vector<grid_pattern::CellRow> rows_;
+  grid_pattern::Pattern pattern_{};
+};
+
+#endif  // GRID_SHAPE_HPP
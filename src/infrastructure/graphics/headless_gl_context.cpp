@@ -0,0 +1,109 @@
+#include "headless_gl_context.hpp"
+
+#include <epoxy/egl.h>
+
+#include <array>
+#include <ios>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+[[noreturn]] void ThrowEglError(const std::string& step) {
+  std::ostringstream message;
+  message << "Headless OpenGL: " << step << " failed (EGL error 0x" << std::hex
+          << eglGetError() << ")";
+  throw std::runtime_error(message.str());
+}
+
+}  // namespace
+
+HeadlessGlContext::HeadlessGlContext(int major, int minor)
+    : display_(OpenDisplay()) {
+  // The constructor body may throw after the display got initialised; the
+  // destructor would not run then, so the release is in every failure path.
+  try {
+    if (eglBindAPI(EGL_OPENGL_API) == EGL_FALSE) {
+      ThrowEglError("eglBindAPI(EGL_OPENGL_API)");
+    }
+    if (!epoxy_has_egl_extension(display_, "EGL_KHR_surfaceless_context")) {
+      throw std::runtime_error(
+          "Headless OpenGL: the EGL display offers no surfaceless contexts");
+    }
+
+    const std::array<EGLint, 7> context_attributes = {
+        EGL_CONTEXT_MAJOR_VERSION,
+        major,
+        EGL_CONTEXT_MINOR_VERSION,
+        minor,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK,
+        EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE};
+    context_ = eglCreateContext(display_, ChooseConfig(), EGL_NO_CONTEXT,
+                                context_attributes.data());
+    if (context_ == EGL_NO_CONTEXT) {
+      ThrowEglError("creating an OpenGL " + std::to_string(major) + "." +
+                    std::to_string(minor) + " core context");
+    }
+    MakeCurrent();
+  } catch (...) {
+    if (context_ != EGL_NO_CONTEXT) {
+      eglDestroyContext(display_, context_);
+    }
+    eglTerminate(display_);
+    throw;
+  }
+}
+
+HeadlessGlContext::~HeadlessGlContext() {
+  eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+  eglDestroyContext(display_, context_);
+  eglTerminate(display_);
+}
+
+void HeadlessGlContext::MakeCurrent() const {
+  if (eglGetCurrentContext() == context_) {
+    return;
+  }
+  if (eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, context_) ==
+      EGL_FALSE) {
+    ThrowEglError("eglMakeCurrent");
+  }
+}
+
+EGLDisplay HeadlessGlContext::OpenDisplay() {
+  EGLDisplay display = EGL_NO_DISPLAY;
+  // Client extensions are asked of EGL_NO_DISPLAY; an EGL 1.4 client without
+  // them answers nullptr, which epoxy takes as "not offered".
+  if (epoxy_has_egl_extension(EGL_NO_DISPLAY,
+                              "EGL_MESA_platform_surfaceless")) {
+    display = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA,
+                                       EGL_DEFAULT_DISPLAY, nullptr);
+  }
+  if (display == EGL_NO_DISPLAY) {
+    display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+  }
+  if (display == EGL_NO_DISPLAY) {
+    ThrowEglError("opening an EGL display");
+  }
+  if (eglInitialize(display, nullptr, nullptr) == EGL_FALSE) {
+    ThrowEglError("eglInitialize");
+  }
+  return display;
+}
+
+EGLConfig HeadlessGlContext::ChooseConfig() const {
+  // No surface gets created, so the config is about the context alone: any
+  // surface type will do, which a mask of 0 says.
+  const std::array<EGLint, 5> attributes = {
+      EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_SURFACE_TYPE, 0, EGL_NONE};
+  EGLConfig config = nullptr;
+  EGLint count = 0;
+  if (eglChooseConfig(display_, attributes.data(), &config, 1, &count) ==
+          EGL_FALSE ||
+      count == 0) {
+    ThrowEglError("choosing an EGL config for desktop OpenGL");
+  }
+  return config;
+}
@@ -0,0 +1,45 @@
+#ifndef HEADLESS_GL_CONTEXT_HPP
+#define HEADLESS_GL_CONTEXT_HPP
+
+#include <epoxy/egl.h>
+
+// An OpenGL core context with no window, no display server and no surface:
+// EGL on Mesa's surfaceless platform, or on the default display where a
+// driver offers no such platform. Everything the export draws goes into
+// framebuffer objects of its own, so the context never needs a default
+// framebuffer — EGL_KHR_surfaceless_context lets it be current without one.
+//
+// libepoxy dispatches the GL calls, as it does for the window's context; it
+// asks which kind of context is current and resolves through EGL here.
+//
+// Sources:
+// - EGL_MESA_platform_surfaceless
+//   (https://registry.khronos.org/EGL/extensions/MESA/EGL_MESA_platform_surfaceless.txt)
+// - EGL_KHR_surfaceless_context
+//   (https://registry.khronos.org/EGL/extensions/KHR/EGL_KHR_surfaceless_context.txt)
+class HeadlessGlContext {
+ public:
+  // Creates a `major`.`minor` core profile context and makes it current.
+  // Throws std::runtime_error naming the step that failed.
+  HeadlessGlContext(int major, int minor);
+
+  ~HeadlessGlContext();
+
+  HeadlessGlContext(const HeadlessGlContext&) = delete;
+  HeadlessGlContext& operator=(const HeadlessGlContext&) = delete;
+  HeadlessGlContext(HeadlessGlContext&&) = delete;
+  HeadlessGlContext& operator=(HeadlessGlContext&&) = delete;
+
+  void MakeCurrent() const;
+
+ private:
+  // The surfaceless display when the client offers it, the default one else.
+  [[nodiscard]] static EGLDisplay OpenDisplay();
+
+  [[nodiscard]] EGLConfig ChooseConfig() const;
+
+  EGLDisplay display_{EGL_NO_DISPLAY};
+  EGLContext context_{EGL_NO_CONTEXT};
+};
+
+#endif  // HEADLESS_GL_CONTEXT_HPP
@@ -0,0 +1,73 @@
+#ifndef LRU_CACHE_HPP
+#define LRU_CACHE_HPP
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+// A map holding at most `capacity` entries that, when full, drops the one used
+// least recently — the bound on Font's cache of laid-out text, kept apart from
+// FreeType and GL so it can be tested.
+//
+// Entries live in a list ordered by use, most recent first; the hash map finds
+// an entry's list node. Both Find and Insert move the entry to the front, so
+// the labels a calendar redraws at every rebuild stay while one-off strings
+// (a title typed character by character) age out.
+//
+// A pointer or reference handed out stays valid until that entry is evicted
+// or the cache cleared: list nodes do not move when others come and go.
+template <typename Key, typename Value>
+class LruCache {
+ public:
+  explicit LruCache(std::size_t capacity) : capacity_(capacity) {}
+
+  // The entry for `key`, now the most recent, or nullptr.
+  [[nodiscard]] const Value* Find(const Key& key) {
+    const auto found = index_.find(key);
+    if (found == index_.end()) {
+      return nullptr;
+    }
+    entries_.splice(entries_.begin(), entries_, found->second);
+    return &found->second->second;
+  }
+
+  // Stores `value` under `key`, replacing an entry already there, and evicts
+  // the least recent entry when that leaves the cache over capacity. A cache
+  // of capacity 0 still answers with the value, but holds it only until the
+  // next insertion.
+  const Value& Insert(const Key& key, Value value) {
+    const auto found = index_.find(key);
+    if (found != index_.end()) {
+      found->second->second = std::move(value);
+      entries_.splice(entries_.begin(), entries_, found->second);
+      return entries_.front().second;
+    }
+
+    entries_.emplace_front(key, std::move(value));
+    index_.emplace(key, entries_.begin());
+    while (entries_.size() > capacity_ && entries_.size() > 1) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+    return entries_.front().second;
+  }
+
+  void Clear() {
+    index_.clear();
+    entries_.clear();
+  }
+
+  [[nodiscard]] std::size_t Size() const { return entries_.size(); }
+
+  [[nodiscard]] std::size_t Capacity() const { return capacity_; }
+
+ private:
+  using Entry = std::pair<Key, Value>;
+
+  std::size_t capacity_;
+  std::list<Entry> entries_;
+  std::unordered_map<Key, typename std::list<Entry>::iterator> index_;
+};
+
+#endif  // LRU_CACHE_HPP
@@ -0,0 +1,419 @@
+#include "png_strip_encoder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include <zlib.h>
+}
+
+namespace png_io {
+namespace {
+
+constexpr std::size_t kBytesPerPixel = 4;
+// Deflate looks back at most this far, so no dictionary needs more.
+constexpr std::size_t kWindowBytes = std::size_t{1} << 15U;
+constexpr int kWindowBits = 15;
+constexpr int kMemoryLevel = 8;
+
+// The filter type byte that opens each filtered row.
+enum class FilterType : unsigned char {
+  kNone = 0,
+  kSub = 1,
+  kUp = 2,
+  kAverage = 3,
+  kPaeth = 4,
+};
+
+unsigned char PaethPredictor(int left, int above, int upper_left) {
+  const int estimate = left + above - upper_left;
+  const int to_left = std::abs(estimate - left);
+  const int to_above = std::abs(estimate - above);
+  const int to_upper_left = std::abs(estimate - upper_left);
+  if (to_left <= to_above && to_left <= to_upper_left) {
+    return static_cast<unsigned char>(left);
+  }
+  if (to_above <= to_upper_left) {
+    return static_cast<unsigned char>(above);
+  }
+  return static_cast<unsigned char>(upper_left);
+}
+
+// Writes the filter byte and the filtered `row` into `out`, one byte longer
+// than the row; `above` is the unfiltered row above, zeros for the first. The
+// switch stays outside the loops, which the adaptive filter runs five times a
+// row.
+void FilterRow(FilterType type, std::span<const unsigned char> row,
+               std::span<const unsigned char> above,
+               std::span<unsigned char> out) {
+  out[0] = static_cast<unsigned char>(type);
+  const std::span<unsigned char> bytes = out.subspan(1);
+  const std::size_t size = row.size();
+  // The first pixel has nothing to its left; the predictors read zeros there.
+  const std::size_t first = std::min(kBytesPerPixel, size);
+  switch (type) {
+    case FilterType::kNone:
+      std::ranges::copy(row, bytes.begin());
+      break;
+    case FilterType::kSub:
+      std::ranges::copy(row.first(first), bytes.begin());
+      for (std::size_t index = first; index < size; ++index) {
+        bytes[index] = static_cast<unsigned char>(
+            row[index] - row[index - kBytesPerPixel]);
+      }
+      break;
+    case FilterType::kUp:
+      for (std::size_t index = 0; index < size; ++index) {
+        bytes[index] = static_cast<unsigned char>(row[index] - above[index]);
+      }
+      break;
+    case FilterType::kAverage:
+      for (std::size_t index = 0; index < first; ++index) {
+        bytes[index] =
+            static_cast<unsigned char>(row[index] - (above[index] / 2));
+      }
+      for (std::size_t index = first; index < size; ++index) {
+        const int left = row[index - kBytesPerPixel];
+        bytes[index] = static_cast<unsigned char>(
+            row[index] - ((left + above[index]) / 2));
+      }
+      break;
+    case FilterType::kPaeth:
+      // With left and upper left zero, Paeth predicts the byte above.
+      for (std::size_t index = 0; index < first; ++index) {
+        bytes[index] = static_cast<unsigned char>(row[index] - above[index]);
+      }
+      for (std::size_t index = first; index < size; ++index) {
+        bytes[index] = static_cast<unsigned char>(
+            row[index] - PaethPredictor(row[index - kBytesPerPixel],
+                                        above[index],
+                                        above[index - kBytesPerPixel]));
+      }
+      break;
+  }
+}
+
+// libpng's measure of how well a filtered row will compress: the sum of its
+// bytes read as signed values, smaller being better. Counting stops once the
+// sum passes `limit`, the best a filter tried before reached.
+std::size_t SignedSum(std::span<const unsigned char> filtered,
+                      std::size_t limit) {
+  std::size_t sum = 0;
+  for (const unsigned char byte : filtered.subspan(1)) {
+    sum += static_cast<std::size_t>(std::abs(static_cast<signed char>(byte)));
+    if (sum > limit) {
+      break;
+    }
+  }
+  return sum;
+}
+
+void AppendBigEndian(std::uint32_t value, std::vector<unsigned char>& out) {
+  constexpr unsigned kByteBits = 8;
+  for (unsigned shift = 3 * kByteBits;; shift -= kByteBits) {
+    out.push_back(static_cast<unsigned char>(value >> shift));
+    if (shift == 0) {
+      break;
+    }
+  }
+}
+
+// The zlib header for deflate with a 32 KiB window; the level hint is what
+// zlib itself would write for `level`.
+std::array<unsigned char, 2> ZlibHeader(int level) {
+  constexpr unsigned kMethodAndWindow = 0x78;
+  constexpr unsigned kCheckModulus = 31;
+  constexpr unsigned kLevelShift = 6;
+  constexpr int kFastest = 2;
+  constexpr int kDefault = 6;
+  unsigned level_hint = 3;
+  if (level < kFastest) {
+    level_hint = 0;
+  } else if (level < kDefault) {
+    level_hint = 1;
+  } else if (level == kDefault || level == Z_DEFAULT_COMPRESSION) {
+    level_hint = 2;
+  }
+  unsigned flags = level_hint << kLevelShift;
+  flags += kCheckModulus - (((kMethodAndWindow << 8U) + flags) % kCheckModulus);
+  return {static_cast<unsigned char>(kMethodAndWindow),
+          static_cast<unsigned char>(flags)};
+}
+
+unsigned WorkerCount() {
+  return std::max(1U, std::thread::hardware_concurrency());
+}
+
+}  // namespace
+
+std::optional<PngFilter> FilterFromName(std::string_view name) {
+  constexpr std::array<std::pair<std::string_view, PngFilter>, 6> kNames{{
+      {"none", PngFilter::kNone},
+      {"sub", PngFilter::kSub},
+      {"up", PngFilter::kUp},
+      {"average", PngFilter::kAverage},
+      {"paeth", PngFilter::kPaeth},
+      {"adaptive", PngFilter::kAdaptive},
+  }};
+  const auto* const found = std::ranges::find(
+      kNames, name, &std::pair<std::string_view, PngFilter>::first);
+  if (found == kNames.end()) {
+    return std::nullopt;
+  }
+  return found->second;
+}
+
+StripEncoder::StripEncoder(std::size_t row_bytes, EncodeOptions options)
+    : row_bytes_(row_bytes),
+      options_(options),
+      strip_rows_(std::max<std::size_t>(1, options.strip_bytes /
+                                               (row_bytes + 1))),
+      previous_row_(row_bytes, 0) {
+  const unsigned count =
+      options.workers == 0 ? WorkerCount() : options.workers;
+  if (count == 1) {
+    return;
+  }
+  for (unsigned index = 0; index < count; ++index) {
+    workers_.emplace_back([this] { Work(); });
+  }
+}
+
+StripEncoder::~StripEncoder() {
+  {
+    const std::scoped_lock lock(mutex_);
+    stopping_ = true;
+  }
+  work_queued_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+void StripEncoder::Encode(std::span<unsigned char* const> rows, bool last,
+                          std::vector<unsigned char>& out) {
+  const std::size_t filtered_row_bytes = row_bytes_ + 1;
+  std::size_t strip_count = (rows.size() + strip_rows_ - 1) / strip_rows_;
+  if (strip_count == 0 && !last) {
+    return;
+  }
+  // An image ends with a final block even when no rows are left to carry.
+  strip_count = std::max<std::size_t>(strip_count, 1);
+
+  filtered_.resize(rows.size() * filtered_row_bytes);
+  RunTasks(strip_count, [this, rows](std::size_t strip) {
+    const std::size_t first = strip * strip_rows_;
+    FilterStrip(rows, first, std::min(strip_rows_, rows.size() - first));
+  });
+
+  strip_output_.resize(strip_count);
+  strip_checksums_.resize(strip_count);
+  const std::size_t strip_bytes = strip_rows_ * filtered_row_bytes;
+  RunTasks(strip_count, [this, strip_count, strip_bytes, last](
+                            std::size_t strip) {
+    const std::size_t first_byte = strip * strip_bytes;
+    DeflateStrip(strip, first_byte,
+                 std::min(strip_bytes, filtered_.size() - first_byte),
+                 last && strip == strip_count - 1);
+  });
+
+  if (!header_written_) {
+    const auto header = ZlibHeader(options_.compression_level);
+    out.insert(out.end(), header.begin(), header.end());
+    header_written_ = true;
+  }
+  for (std::size_t strip = 0; strip < strip_count; ++strip) {
+    out.insert(out.end(), strip_output_[strip].begin(),
+               strip_output_[strip].end());
+    const std::size_t first_byte = strip * strip_bytes;
+    const std::size_t byte_count =
+        std::min(strip_bytes, filtered_.size() - first_byte);
+    checksum_ = static_cast<std::uint32_t>(
+        adler32_combine(checksum_, strip_checksums_[strip],
+                        static_cast<z_off_t>(byte_count)));
+  }
+  if (last) {
+    AppendBigEndian(checksum_, out);
+  }
+
+  if (!rows.empty()) {
+    const std::span<const unsigned char> bottom(rows.back(), row_bytes_);
+    std::ranges::copy(bottom, previous_row_.begin());
+  }
+  // The next strip's dictionary: the newest filtered bytes, older ones first.
+  const std::size_t kept = std::min(filtered_.size(), kWindowBytes);
+  window_.insert(window_.end(),
+                 filtered_.end() - static_cast<std::ptrdiff_t>(kept),
+                 filtered_.end());
+  if (window_.size() > kWindowBytes) {
+    window_.erase(window_.begin(),
+                  window_.end() - static_cast<std::ptrdiff_t>(kWindowBytes));
+  }
+}
+
+void StripEncoder::RunTasks(std::size_t count,
+                            const std::function<void(std::size_t)>& task) {
+  if (workers_.empty()) {
+    for (std::size_t index = 0; index < count; ++index) {
+      task(index);
+    }
+    return;
+  }
+  std::unique_lock lock(mutex_);
+  task_ = &task;
+  task_count_ = count;
+  next_task_ = 0;
+  tasks_done_ = 0;
+  failure_ = nullptr;
+  work_queued_.notify_all();
+  work_done_.wait(lock, [this] { return tasks_done_ == task_count_; });
+  task_ = nullptr;
+  task_count_ = 0;
+  next_task_ = 0;
+  if (failure_) {
+    std::rethrow_exception(std::exchange(failure_, nullptr));
+  }
+}
+
+void StripEncoder::Work() {
+  std::unique_lock lock(mutex_);
+  while (true) {
+    work_queued_.wait(
+        lock, [this] { return stopping_ || next_task_ < task_count_; });
+    if (stopping_) {
+      return;
+    }
+    const std::size_t index = next_task_++;
+    const auto* const task = task_;
+    lock.unlock();
+    std::exception_ptr failure;
+    try {
+      (*task)(index);
+    } catch (...) {
+      failure = std::current_exception();
+    }
+    lock.lock();
+    if (failure && !failure_) {
+      failure_ = failure;
+    }
+    if (++tasks_done_ == task_count_) {
+      work_done_.notify_all();
+    }
+  }
+}
+
+void StripEncoder::FilterStrip(std::span<unsigned char* const> rows,
+                               std::size_t first, std::size_t count) {
+  constexpr std::array<FilterType, 5> kAllTypes = {
+      FilterType::kNone, FilterType::kSub, FilterType::kUp,
+      FilterType::kAverage, FilterType::kPaeth};
+  const std::size_t filtered_row_bytes = row_bytes_ + 1;
+  std::vector<unsigned char> candidate(filtered_row_bytes);
+
+  for (std::size_t row = first; row < first + count; ++row) {
+    const std::span<const unsigned char> pixels(rows[row], row_bytes_);
+    const std::span<const unsigned char> above =
+        row == 0 ? std::span<const unsigned char>(previous_row_)
+                 : std::span<const unsigned char>(rows[row - 1], row_bytes_);
+    const std::span<unsigned char> out(&filtered_[row * filtered_row_bytes],
+                                       filtered_row_bytes);
+
+    if (options_.filter != PngFilter::kAdaptive) {
+      FilterRow(static_cast<FilterType>(options_.filter), pixels, above, out);
+      continue;
+    }
+    std::size_t best_sum = std::numeric_limits<std::size_t>::max();
+    for (const FilterType type : kAllTypes) {
+      FilterRow(type, pixels, above, candidate);
+      const std::size_t sum = SignedSum(candidate, best_sum);
+      if (sum < best_sum) {
+        best_sum = sum;
+        std::ranges::copy(candidate, out.begin());
+      }
+    }
+  }
+}
+
+void StripEncoder::DeflateStrip(std::size_t strip, std::size_t first_byte,
+                                std::size_t byte_count, bool finish) {
+  const std::span<unsigned char> input =
+      std::span(filtered_).subspan(first_byte, byte_count);
+  strip_checksums_[strip] = static_cast<std::uint32_t>(
+      adler32(adler32(0, nullptr, 0), input.data(),
+              static_cast<uInt>(input.size())));
+
+  // The dictionary is whatever precedes the strip: the strips before it in
+  // this call, or the window carried from the calls before.
+  std::vector<unsigned char> dictionary;
+  if (first_byte >= kWindowBytes) {
+    dictionary.assign(filtered_.begin() + static_cast<std::ptrdiff_t>(
+                                              first_byte - kWindowBytes),
+                      filtered_.begin() +
+                          static_cast<std::ptrdiff_t>(first_byte));
+  } else {
+    const std::size_t from_window =
+        std::min(window_.size(), kWindowBytes - first_byte);
+    dictionary.assign(window_.end() - static_cast<std::ptrdiff_t>(from_window),
+                      window_.end());
+    dictionary.insert(dictionary.end(), filtered_.begin(),
+                      filtered_.begin() +
+                          static_cast<std::ptrdiff_t>(first_byte));
+  }
+
+  z_stream stream{};
+  if (deflateInit2(&stream, options_.compression_level, Z_DEFLATED,
+                   -kWindowBits, kMemoryLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw std::runtime_error("deflateInit2 failed for level " +
+                             std::to_string(options_.compression_level));
+  }
+  if (!dictionary.empty()) {
+    (void)deflateSetDictionary(&stream, dictionary.data(),
+                               static_cast<uInt>(dictionary.size()));
+  }
+
+  std::vector<unsigned char>& output = strip_output_[strip];
+  // uLong is std::size_t on LP64, where a cast would be a same-type one.
+  const uLong input_size = input.size();
+  output.resize(deflateBound(&stream, input_size));
+  stream.next_in = input.data();
+  stream.avail_in = static_cast<uInt>(input.size());
+  // The bound holds for Z_FINISH; a sync flush may want a few bytes more, and
+  // zlib says so by filling the output to the last byte.
+  const int flush = finish ? Z_FINISH : Z_SYNC_FLUSH;
+  std::size_t written = 0;
+  int status = Z_OK;
+  while (true) {
+    stream.next_out = &output[written];
+    stream.avail_out = static_cast<uInt>(output.size() - written);
+    status = deflate(&stream, flush);
+    written = output.size() - stream.avail_out;
+    const bool done = finish ? status == Z_STREAM_END : stream.avail_out != 0;
+    if (done || (status != Z_OK && status != Z_BUF_ERROR)) {
+      break;
+    }
+    output.resize(output.size() * 2);
+  }
+  (void)deflateEnd(&stream);
+  if (status != (finish ? Z_STREAM_END : Z_OK) || stream.avail_in != 0) {
+    throw std::runtime_error("deflate failed on a strip of " +
+                             std::to_string(input.size()) + " bytes");
+  }
+  output.resize(written);
+}
+
+}  // namespace png_io
@@ -0,0 +1,127 @@
+#ifndef PNG_STRIP_ENCODER_HPP
+#define PNG_STRIP_ENCODER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace png_io {
+
+// The PNG row filters, plus libpng's heuristic of trying all five on each row
+// and keeping the one whose bytes sum smallest as signed values.
+enum class PngFilter : std::uint8_t {
+  kNone,
+  kSub,
+  kUp,
+  kAverage,
+  kPaeth,
+  kAdaptive,
+};
+
+// "none", "sub", "up", "average", "paeth" or "adaptive"; nullopt otherwise.
+[[nodiscard]] std::optional<PngFilter> FilterFromName(std::string_view name);
+
+struct EncodeOptions {
+  // zlib's 0 (stored) to 9 (smallest); 6 is what zlib and libpng default to.
+  int compression_level{6};
+  PngFilter filter{PngFilter::kAdaptive};
+  // Filtered bytes per strip, the unit one worker deflates. Smaller strips
+  // spread better over the cores and cost a few bytes each in flush markers.
+  std::size_t strip_bytes{std::size_t{1} << 20U};
+  // Threads the strips are spread over; 0 is one per core. At 1 the encoder
+  // starts none and works on the caller's thread — for images of a strip or
+  // two encoded many side by side, the tiles of a pyramid, where a pool each
+  // would cost more to start than it saves.
+  unsigned workers{0};
+};
+
+// Filters and deflates RGBA8 rows into a PNG's zlib stream on a pool of
+// worker threads — deflate is most of an export's wall time, and libpng runs
+// it on one thread row after row.
+//
+// Each Encode splits its rows into horizontal strips and runs two parallel
+// passes: one filters every strip (a row's filter reads the row above, which
+// the rows are there for), the next deflates every strip into a raw deflate
+// stream of its own, primed with the 32 KiB of filtered bytes that precede
+// the strip so it compresses as well as one long stream would. A strip ends
+// on a sync flush, which closes it at a byte boundary; the last strip of the
+// image ends the stream instead. Joined behind the two-byte zlib header and
+// followed by the Adler-32 of all filtered bytes — combined strip by strip —
+// the pieces form one valid zlib stream, the way pigz assembles its output.
+//
+// Calls to Encode continue each other: the row above the first row, the
+// dictionary window and the checksum carry over.
+class StripEncoder {
+ public:
+  StripEncoder(std::size_t row_bytes, EncodeOptions options);
+
+  // Joins the workers.
+  ~StripEncoder();
+
+  StripEncoder(const StripEncoder&) = delete;
+  StripEncoder& operator=(const StripEncoder&) = delete;
+  StripEncoder(StripEncoder&&) = delete;
+  StripEncoder& operator=(StripEncoder&&) = delete;
+
+  // Appends to `out` the zlib bytes for `rows`, each `row_bytes` long and
+  // following the rows encoded before; `last` closes the stream. Throws
+  // std::runtime_error when zlib fails.
+  void Encode(std::span<unsigned char* const> rows, bool last,
+              std::vector<unsigned char>& out);
+
+ private:
+  // Runs task(0) ... task(count - 1) on the workers and waits for all of
+  // them; rethrows the first exception a task threw.
+  void RunTasks(std::size_t count,
+                const std::function<void(std::size_t)>& task);
+
+  void Work();
+
+  void FilterStrip(std::span<unsigned char* const> rows, std::size_t first,
+                   std::size_t count);
+
+  void DeflateStrip(std::size_t strip, std::size_t first_byte,
+                    std::size_t byte_count, bool finish);
+
+  std::size_t row_bytes_;
+  EncodeOptions options_;
+  std::size_t strip_rows_;
+
+  // The rows of the current Encode, filtered, and per strip the deflated
+  // bytes and the Adler-32 of its filtered bytes.
+  std::vector<unsigned char> filtered_;
+  std::vector<std::vector<unsigned char>> strip_output_;
+  std::vector<std::uint32_t> strip_checksums_;
+
+  // What carries from one Encode to the next.
+  std::vector<unsigned char> previous_row_;
+  std::vector<unsigned char> window_;
+  std::uint32_t checksum_{1};
+  bool header_written_{false};
+
+  std::mutex mutex_;
+  std::condition_variable work_queued_;
+  std::condition_variable work_done_;
+  const std::function<void(std::size_t)>* task_{nullptr};
+  std::size_t task_count_{0};
+  std::size_t next_task_{0};
+  std::size_t tasks_done_{0};
+  std::exception_ptr failure_;
+  bool stopping_{false};
+
+  // Last, so the workers start after, and are joined before, everything they
+  // use.
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace png_io
+
+#endif  // PNG_STRIP_ENCODER_HPP
@@ -1,9 +1,19 @@
 #include "png_writer.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
+#include <fstream>
 #include <gsl/pointers>
+#include <iostream>
 #include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <vector>
 
 extern "C" {
@@ -13,6 +23,8 @@ extern "C" {
 #include <stdlib.h>
 }
 
+#include "png_strip_encoder.hpp"
+
 namespace png_io {
 namespace {
 
@@ -38,6 +50,22 @@ using UniqueFile = std::unique_ptr<std::FILE, FileCloser>;
   return file;
 }
 
+constexpr std::array<unsigned char, 8> kSignature = {0x89, 'P',  'N',  'G',
+                                                     '\r', '\n', 0x1A, '\n'};
+// A tEXt chunk larger than this is no key of ours; ReadPngText skips it
+// rather than allocate whatever a broken length claims.
+constexpr std::uint32_t kMaxTextChunk = std::uint32_t{1} << 16U;
+
+// A chunk's length, big-endian as PNG stores every number.
+std::uint32_t ReadLength(const std::array<unsigned char, 8>& header) {
+  constexpr unsigned kBitsPerByte = 8;
+  std::uint32_t length = 0;
+  for (std::size_t byte = 0; byte < 4; ++byte) {
+    length = (length << kBitsPerByte) | header.at(byte);
+  }
+  return length;
+}
+
 }  // namespace
 
 bool FitsPngLimits(std::size_t width, std::size_t height) {
@@ -53,61 +81,183 @@ bool FitsPngLimits(std::size_t width, std::size_t height) {
          width <= max_width_by_address;
 }
 
-bool WriteRgbaPng(const char* file_name, std::vector<unsigned char>& pixels,
-                  PngImageSize size) {
-  // see https://sourceforge.net/p/libpng/code/ci/master/tree/example.c#l739
+// The libpng state of one file. Each member that calls into libpng sets its
+// own jump target and answers false when libpng jumped there.
+struct PngRowWriter::Stream {
+  Stream() = default;
 
-  const UniqueFile file(OpenForWrite(file_name));
-  if (!file) {
-    return false;
+  ~Stream() {
+    if (png != nullptr) {
+      png_destroy_write_struct(&png, info != nullptr ? &info : nullptr);
+    }
   }
 
-  png_structp png =
-      png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
-  if (png == nullptr) {
-    return false;
+  Stream(const Stream&) = delete;
+  Stream& operator=(const Stream&) = delete;
+  Stream(Stream&&) = delete;
+  Stream& operator=(Stream&&) = delete;
+
+  // see https://sourceforge.net/p/libpng/code/ci/master/tree/example.c#l739
+  bool Begin(PngImageSize size) {
+    png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr,
+                                  nullptr);
+    if (png == nullptr) {
+      return false;
+    }
+    info = png_create_info_struct(png);
+    if (info == nullptr) {
+      return false;
+    }
+
+    // The one construct libpng's contract forces on us and that has no
+    // in-code fix: its default error handler longjmps back here. Suppression
+    // is scoped to exactly these two checks (see AGENTS.md, "Warnings, the
+    // clang-tidy and the sanitizer gate").
+    // NOLINTNEXTLINE(cert-err52-cpp,modernize-avoid-setjmp-longjmp)
+    if (setjmp(png_jmpbuf(png)) != 0) {
+      return false;
+    }
+
+    png_init_io(png, file.get());
+
+    constexpr int kBitDepth = 8;  // bits per RGBA channel
+    png_set_IHDR(png, info, static_cast<png_uint_32>(size.width),
+                 static_cast<png_uint_32>(size.height), kBitDepth,
+                 PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE,
+                 PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+    png_write_info(png, info);
+    return true;
   }
 
-  png_infop info = png_create_info_struct(png);
-  if (info == nullptr) {
-    png_destroy_write_struct(&png, nullptr);
-    return false;
+  bool WriteChunk(const char* name, std::span<const unsigned char> data) {
+    // NOLINTNEXTLINE(cert-err52-cpp,modernize-avoid-setjmp-longjmp)
+    if (setjmp(png_jmpbuf(png)) != 0) {
+      return false;
+    }
+    // The chunk name as libpng takes it: four ASCII bytes.
+    png_write_chunk(png, reinterpret_cast<png_const_bytep>(name), data.data(),
+                    data.size());
+    return true;
   }
 
-  // Built before the setjmp: row pointers into `pixels`, indexed (not pointer
-  // arithmetic) so the bounds-safety check is satisfied and the vector's
-  // destructor is never skipped by a longjmp.
-  std::vector<png_bytep> row_pointers(size.height);
-  for (std::size_t row = 0; row < size.height; ++row) {
-    row_pointers[row] = &pixels[row * size.width * kBytesPerPixel];
+  UniqueFile file;
+  png_structp png{nullptr};
+  png_infop info{nullptr};
+};
+
+PngRowWriter::PngRowWriter(const std::string& file_name, PngImageSize size,
+                           EncodeOptions options,
+                           const std::vector<PngText>& text)
+    : file_name_(file_name), size_(size), stream_(std::make_unique<Stream>()) {
+  stream_->file.reset(OpenForWrite(file_name_.c_str()));
+  if (!stream_->file) {
+    stream_.reset();
+    return;
+  }
+  remove_file_ = true;
+  if (!stream_->Begin(size_)) {
+    stream_.reset();
+    return;
+  }
+  for (const PngText& entry : text) {
+    std::vector<unsigned char> data(entry.keyword.begin(),
+                                    entry.keyword.end());
+    data.push_back(0);
+    data.insert(data.end(), entry.text.begin(), entry.text.end());
+    if (!stream_->WriteChunk("tEXt", data)) {
+      stream_.reset();
+      return;
+    }
   }
+  encoder_.emplace(size_.width * kBytesPerPixel, options);
+}
 
-  // The one construct libpng's contract forces on us and that has no in-code
-  // fix: its default error handler longjmps back here. Suppression is scoped
-  // to exactly these two checks (see AGENTS.md, "Warnings, the clang-tidy and
-  // the sanitizer gate").
-  // NOLINTNEXTLINE(cert-err52-cpp,modernize-avoid-setjmp-longjmp)
-  if (setjmp(png_jmpbuf(png)) != 0) {
-    png_destroy_write_struct(&png, &info);
-    return false;
+PngRowWriter::~PngRowWriter() {
+  stream_.reset();
+  if (remove_file_) {
+    (void)std::remove(file_name_.c_str());
   }
+}
 
-  png_init_io(png, file.get());
+bool PngRowWriter::Good() const { return stream_ != nullptr; }
 
-  constexpr int kBitDepth = 8;  // bits per RGBA channel
-  png_set_IHDR(png, info, static_cast<png_uint_32>(size.width),
-               static_cast<png_uint_32>(size.height), kBitDepth,
-               PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE,
-               PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
-  png_write_info(png, info);
+bool PngRowWriter::WriteRows(std::span<unsigned char*> rows) {
+  if (!Good() || rows.size() > size_.height - rows_written_) {
+    return false;
+  }
+  const bool last = rows_written_ + rows.size() == size_.height;
+  encoded_.clear();
+  try {
+    encoder_->Encode(rows, last, encoded_);
+  } catch (const std::runtime_error& error) {
+    std::cerr << "PNG encoding failed: " << error.what() << '\n';
+    stream_.reset();
+    return false;
+  }
+  if (!WriteData(encoded_)) {
+    stream_.reset();
+    return false;
+  }
+  rows_written_ += rows.size();
+  return true;
+}
 
-  for (std::size_t row = 0; row < size.height; ++row) {
-    png_write_rows(png, &row_pointers[row], 1);
+bool PngRowWriter::Finish() {
+  if (!Good() || rows_written_ != size_.height) {
+    return false;
   }
+  const bool ended = stream_->WriteChunk("IEND", {});
+  stream_.reset();
+  remove_file_ = !ended;
+  return ended;
+}
 
-  png_write_end(png, info);
-  png_destroy_write_struct(&png, &info);
+bool PngRowWriter::WriteData(std::span<const unsigned char> data) {
+  // A chunk's length field stops at 2^31 - 1; a gigabyte a chunk is plenty.
+  constexpr std::size_t kMaxChunkBytes = std::size_t{1} << 30U;
+  while (!data.empty()) {
+    const std::size_t length = std::min(data.size(), kMaxChunkBytes);
+    if (!stream_->WriteChunk("IDAT", data.first(length))) {
+      return false;
+    }
+    data = data.subspan(length);
+  }
   return true;
 }
 
+std::optional<std::string> ReadPngText(const std::string& file_name,
+                                       std::string_view keyword) {
+  std::ifstream file(file_name, std::ios::binary);
+  std::array<unsigned char, kSignature.size()> signature{};
+  if (!file.read(reinterpret_cast<char*>(signature.data()), signature.size()) ||
+      signature != kSignature) {
+    return std::nullopt;
+  }
+  // Length and type of each chunk, then its data and a CRC, up to the image
+  // data: the writer puts its text ahead of that.
+  std::array<unsigned char, 8> header{};
+  while (file.read(reinterpret_cast<char*>(header.data()), header.size())) {
+    const std::uint32_t length = ReadLength(header);
+    const std::string_view type(reinterpret_cast<const char*>(&header[4]), 4);
+    if (type == "IDAT" || type == "IEND") {
+      return std::nullopt;
+    }
+    if (type != "tEXt" || length > kMaxTextChunk) {
+      file.seekg(std::streamoff{length} + 4, std::ios::cur);
+      continue;
+    }
+    std::string data(length, '\0');
+    if (!file.read(data.data(), length)) {
+      return std::nullopt;
+    }
+    file.seekg(4, std::ios::cur);
+    const std::size_t separator = data.find('\0');
+    if (separator != std::string::npos &&
+        std::string_view(data).substr(0, separator) == keyword) {
+      return data.substr(separator + 1);
+    }
+  }
+  return std::nullopt;
+}
+
 }  // namespace png_io
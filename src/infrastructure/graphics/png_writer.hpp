@@ -2,18 +2,26 @@
 #define PNG_WRITER_HPP
 
 #include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
 #include <vector>
 
-// Infrastructure: writes RGBA8 pixel buffers to PNG files via libpng.
+#include "png_strip_encoder.hpp"
+
+// Infrastructure: writes RGBA8 pixel rows to PNG files via libpng.
 //
 // All of libpng's C API lives behind this component — the header names none of
 // it, so no consumer sees png.h. libpng reports fatal errors through
 // setjmp/longjmp, and a longjmp does *not* run C++ destructors as it unwinds —
 // per [csetjmp] it is undefined behaviour if the jump would skip a non-trivial
 // destructor. The unit respects that by constructing every object with a
-// non-trivial destructor (the FILE owner, the row-pointer vector) *before* the
-// setjmp, so the jump can never bypass their cleanup. Raw stdio ownership is
-// expressed with gsl::owner so the static analysis can verify it.
+// non-trivial destructor *before* the setjmp, so the jump can never bypass
+// their cleanup, and by giving every member that calls into libpng a setjmp of
+// its own: a jump may only land in a frame that is still live. Raw stdio
+// ownership is expressed with gsl::owner so the static analysis can verify it.
 namespace png_io {
 
 struct PngImageSize {
@@ -23,14 +31,76 @@ struct PngImageSize {
 
 inline constexpr std::size_t kBytesPerPixel = 4;
 
+// A tEXt chunk: a keyword of 1 to 79 Latin-1 characters and its text, neither
+// holding a zero byte.
+struct PngText {
+  std::string keyword;
+  std::string text;
+};
+
 // True if a width x height RGBA image stays within PNG's format and addressing
 // limits. Anything larger cannot be written and must be rejected by the caller.
 [[nodiscard]] bool FitsPngLimits(std::size_t width, std::size_t height);
 
-// Writes the RGBA8 `pixels` (row-major, top-left origin) to `file_name`.
-// Returns false if the file cannot be opened or libpng signals an error.
-bool WriteRgbaPng(const char* file_name, std::vector<unsigned char>& pixels,
-                  PngImageSize size);
+// Writes a PNG a few rows at a time, top row first, so the caller never has to
+// hold more of the image than the rows it is handing over. The page export
+// feeds it one band of tiles after another; the whole picture never exists in
+// memory at once.
+//
+// libpng writes the signature and the header chunks; the image data comes
+// from a StripEncoder, which filters and deflates on all cores, and goes out
+// as raw IDAT chunks.
+//
+// The header goes out on construction. Should that, or any later WriteRows,
+// fail, the writer is spent: every further call returns false. A writer
+// destroyed before a successful Finish removes its file, so an export that
+// broke off halfway leaves nothing truncated behind.
+class PngRowWriter {
+ public:
+  // `text` goes out as tEXt chunks right behind the header, ahead of the
+  // image data, where ReadPngText finds it without reading the pixels.
+  PngRowWriter(const std::string& file_name, PngImageSize size,
+               EncodeOptions options = {},
+               const std::vector<PngText>& text = {});
+
+  ~PngRowWriter();
+
+  PngRowWriter(const PngRowWriter&) = delete;
+  PngRowWriter& operator=(const PngRowWriter&) = delete;
+  PngRowWriter(PngRowWriter&&) = delete;
+  PngRowWriter& operator=(PngRowWriter&&) = delete;
+
+  // False once the file could not be opened or libpng signalled an error, and
+  // after Finish.
+  [[nodiscard]] bool Good() const;
+
+  // Appends `rows`, each `width` RGBA8 pixels, below those written so far.
+  bool WriteRows(std::span<unsigned char*> rows);
+
+  // Writes the trailer and closes the file. True when all `height` rows made
+  // it in and nothing failed on the way.
+  bool Finish();
+
+ private:
+  struct Stream;
+
+  // Writes `data` as IDAT chunks.
+  bool WriteData(std::span<const unsigned char> data);
+
+  std::string file_name_;
+  PngImageSize size_;
+  std::size_t rows_written_{0};
+  std::unique_ptr<Stream> stream_;
+  std::optional<StripEncoder> encoder_;
+  std::vector<unsigned char> encoded_;
+  bool remove_file_{false};
+};
+
+// The text of the first tEXt chunk named `keyword` in the PNG `file_name`,
+// looked for ahead of the image data alone. nullopt when the file is missing,
+// no PNG, or has no such chunk there.
+[[nodiscard]] std::optional<std::string> ReadPngText(
+    const std::string& file_name, std::string_view keyword);
 
 }  // namespace png_io
 
@@ -0,0 +1,168 @@
+#include "program_binary_cache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "../../common/fnv_hash.hpp"
+
+namespace {
+
+constexpr std::array<std::uint8_t, 4> kMagic = {'D', 'C', 'P', 'B'};
+// Raised whenever the layout below changes; older files then read as misses.
+constexpr std::uint32_t kFileVersion = 1;
+// Magic, version, key, binary format, byte count.
+constexpr std::size_t kHeaderSize = 4 + 4 + 8 + 4 + 4;
+
+constexpr unsigned kBitsPerByte = 8;
+constexpr std::uint8_t kByteMask = 0xFF;
+
+// Little endian, whatever the host, so a file reads the same everywhere.
+template <typename Integer>
+void Append(std::vector<std::uint8_t>& out, Integer value) {
+  for (std::size_t byte = 0; byte < sizeof(Integer); ++byte) {
+    out.push_back(
+        static_cast<std::uint8_t>((value >> (byte * kBitsPerByte)) &
+                                  kByteMask));
+  }
+}
+
+template <typename Integer>
+Integer Read(std::span<const std::uint8_t> bytes, std::size_t offset) {
+  Integer value = 0;
+  for (std::size_t byte = 0; byte < sizeof(Integer); ++byte) {
+    value |= static_cast<Integer>(bytes[offset + byte])
+             << (byte * kBitsPerByte);
+  }
+  return value;
+}
+
+}  // namespace
+
+ProgramBinaryCache::ProgramBinaryCache(
+    std::optional<std::filesystem::path> directory)
+    : directory_(std::move(directory)) {}
+
+std::uint64_t ProgramBinaryCache::Key(std::string_view driver,
+                                      std::string_view vertex_source,
+                                      std::string_view fragment_source) {
+  std::uint64_t hash = fnv_hash::kOffsetBasis;
+  hash = fnv_hash::AddField(hash, driver);
+  hash = fnv_hash::AddField(hash, vertex_source);
+  hash = fnv_hash::AddField(hash, fragment_source);
+  return hash;
+}
+
+std::optional<ProgramBinaryCache::Binary> ProgramBinaryCache::Load(
+    const std::string& name, std::uint64_t key) const {
+  if (!directory_.has_value()) {
+    return std::nullopt;
+  }
+  std::ifstream file(FilePath(name), std::ios_base::binary);
+  if (!file) {
+    return std::nullopt;
+  }
+  const std::vector<std::uint8_t> contents(
+      (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  return Decode(contents, key);
+}
+
+void ProgramBinaryCache::Store(const std::string& name, std::uint64_t key,
+                               const Binary& binary) const {
+  if (!directory_.has_value()) {
+    return;
+  }
+  std::error_code error;
+  std::filesystem::create_directories(*directory_, error);
+  if (error) {
+    std::cerr << "shader cache: cannot create " << *directory_ << ": "
+              << error.message() << '\n';
+    return;
+  }
+
+  // Written beside the target and renamed over it, so a second instance
+  // starting meanwhile reads the old file or the new one, never half of one.
+  const std::filesystem::path target = FilePath(name);
+  std::filesystem::path partial = target;
+  partial += ".partial";
+  const std::vector<std::uint8_t> contents = Encode(key, binary);
+  {
+    std::ofstream file(partial, std::ios_base::binary | std::ios_base::trunc);
+    file.write(reinterpret_cast<const char*>(contents.data()),
+               static_cast<std::streamsize>(contents.size()));
+    if (!file) {
+      std::cerr << "shader cache: cannot write " << partial << '\n';
+      return;
+    }
+  }
+  std::filesystem::rename(partial, target, error);
+  if (error) {
+    std::cerr << "shader cache: cannot write " << target << ": "
+              << error.message() << '\n';
+    std::filesystem::remove(partial, error);
+  }
+}
+
+std::vector<std::uint8_t> ProgramBinaryCache::Encode(std::uint64_t key,
+                                                     const Binary& binary) {
+  std::vector<std::uint8_t> out;
+  out.reserve(kHeaderSize + binary.bytes.size());
+  out.insert(out.end(), kMagic.begin(), kMagic.end());
+  Append(out, kFileVersion);
+  Append(out, key);
+  Append(out, binary.format);
+  Append(out, static_cast<std::uint32_t>(binary.bytes.size()));
+  out.insert(out.end(), binary.bytes.begin(), binary.bytes.end());
+  return out;
+}
+
+std::optional<ProgramBinaryCache::Binary> ProgramBinaryCache::Decode(
+    std::span<const std::uint8_t> file, std::uint64_t key) {
+  if (file.size() < kHeaderSize ||
+      !std::equal(kMagic.begin(), kMagic.end(), file.begin())) {
+    return std::nullopt;
+  }
+  std::size_t offset = kMagic.size();
+  const auto version = Read<std::uint32_t>(file, offset);
+  offset += sizeof(std::uint32_t);
+  const auto stored_key = Read<std::uint64_t>(file, offset);
+  offset += sizeof(std::uint64_t);
+  const auto format = Read<std::uint32_t>(file, offset);
+  offset += sizeof(std::uint32_t);
+  const auto length = Read<std::uint32_t>(file, offset);
+  offset += sizeof(std::uint32_t);
+
+  if (version != kFileVersion || stored_key != key ||
+      file.size() - offset != length) {
+    return std::nullopt;
+  }
+  const auto tail = file.subspan(offset);
+  return Binary{.format = format,
+                .bytes = std::vector<std::uint8_t>(tail.begin(), tail.end())};
+}
+
+std::filesystem::path ProgramBinaryCache::FilePath(
+    const std::string& name) const {
+  // "Font Shader" becomes "font_shader.bin".
+  std::string file_name;
+  for (const char character : name) {
+    file_name += std::isalnum(static_cast<unsigned char>(character)) != 0
+                     ? static_cast<char>(std::tolower(
+                           static_cast<unsigned char>(character)))
+                     : '_';
+  }
+  return *directory_ / (file_name + ".bin");
+}
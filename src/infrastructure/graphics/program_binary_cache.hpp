@@ -0,0 +1,67 @@
+#ifndef PROGRAM_BINARY_CACHE_HPP
+#define PROGRAM_BINARY_CACHE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Linked shader programs on disk, as glGetProgramBinary hands them out, so a
+// start can skip compiling and linking — the slow part of bringing the canvas
+// up under a software rasteriser.
+//
+// A binary is only good for the driver that produced it and the sources it
+// was built from. Each file therefore carries a key, a hash over the driver's
+// vendor, renderer and version strings and over both sources; a file whose key
+// differs is ignored, and overwritten after the program is compiled anew. The
+// driver may still refuse a binary whose key matches (after an update that
+// kept the version string); Shader falls back to compiling then as well.
+//
+// Everything here is GL-free — the binary format travels as a plain number —
+// so the file handling can be tested without a context. A cache made without
+// a directory holds nothing and stores nothing.
+class ProgramBinaryCache {
+ public:
+  struct Binary {
+    // The GLenum glGetProgramBinary reports alongside the bytes.
+    std::uint32_t format{0};
+    std::vector<std::uint8_t> bytes;
+  };
+
+  explicit ProgramBinaryCache(std::optional<std::filesystem::path> directory);
+
+  // 64-bit FNV-1a over the driver description and the two sources, each
+  // closed by a zero byte so that moving text from one field to the next
+  // changes the key.
+  [[nodiscard]] static std::uint64_t Key(std::string_view driver,
+                                         std::string_view vertex_source,
+                                         std::string_view fragment_source);
+
+  // The binary stored for program `name` under `key`, or nullopt when there
+  // is none, it is unreadable or it was stored under another key.
+  [[nodiscard]] std::optional<Binary> Load(const std::string& name,
+                                           std::uint64_t key) const;
+
+  // Stores `binary` for program `name` under `key`. A cache that cannot be
+  // written is no fault — the next start compiles again — so a failure is
+  // reported on stderr and otherwise ignored.
+  void Store(const std::string& name, std::uint64_t key,
+             const Binary& binary) const;
+
+  // The file format: a magic, a format version, the key, the binary format
+  // and the bytes. Exposed for the tests.
+  [[nodiscard]] static std::vector<std::uint8_t> Encode(std::uint64_t key,
+                                                        const Binary& binary);
+  [[nodiscard]] static std::optional<Binary> Decode(
+      std::span<const std::uint8_t> file, std::uint64_t key);
+
+ private:
+  [[nodiscard]] std::filesystem::path FilePath(const std::string& name) const;
+
+  std::optional<std::filesystem::path> directory_;
+};
+
+#endif  // PROGRAM_BINARY_CACHE_HPP
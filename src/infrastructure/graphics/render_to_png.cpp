@@ -3,23 +3,127 @@
 #include <epoxy/gl.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <future>
 #include <glm/ext/matrix_clip_space.hpp>
 #include <glm/ext/matrix_float4x4.hpp>
 #include <glm/ext/matrix_transform.hpp>
 #include <glm/ext/vector_float3.hpp>
+#include <glm/ext/vector_float4.hpp>
 #include <iostream>
 #include <limits>
+#include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
 #include "../../common/debug_log.hpp"
 #include "graphics_engine.hpp"
 #include "mvp_matrices.hpp"
+#include "png_strip_encoder.hpp"
 #include "png_writer.hpp"
 #include "rect.hpp"
 #include "render_to_texture.hpp"
+#include "software_page.hpp"
+#include "software_raster.hpp"
+#include "tile_budget.hpp"
+#include "tile_pyramid.hpp"
+#include "tile_readback.hpp"
+
+namespace {
+
+// GL_TIME_ELAPSED queries for the stages of a band's tiles. They are read
+// after the band has drained, when the GPU is past them and reading them
+// stalls nothing.
+class ElapsedQueries {
+ public:
+  explicit ElapsedQueries(size_t count) : names_(count) {
+    glGenQueries(static_cast<GLsizei>(names_.size()), names_.data());
+  }
+
+  ~ElapsedQueries() {
+    glDeleteQueries(static_cast<GLsizei>(names_.size()), names_.data());
+  }
+
+  ElapsedQueries(const ElapsedQueries&) = delete;
+  ElapsedQueries& operator=(const ElapsedQueries&) = delete;
+  ElapsedQueries(ElapsedQueries&&) = delete;
+  ElapsedQueries& operator=(ElapsedQueries&&) = delete;
+
+  void Begin(size_t index) const {
+    glBeginQuery(GL_TIME_ELAPSED, names_.at(index));
+  }
+
+  static void End() { glEndQuery(GL_TIME_ELAPSED); }
+
+  [[nodiscard]] std::chrono::nanoseconds Elapsed(size_t index) const {
+    GLuint64 nanoseconds = 0;
+    glGetQueryObjectui64v(names_.at(index), GL_QUERY_RESULT, &nanoseconds);
+    return std::chrono::nanoseconds(nanoseconds);
+  }
+
+ private:
+  std::vector<GLuint> names_;
+};
+
+// Set once at start-up by SetExportGpuBudget, read by every export after.
+std::atomic<size_t>& ExportGpuBudget() {
+  static std::atomic<size_t> budget{tile_budget::kDefaultBudgetBytes};
+  return budget;
+}
+
+// The tile side for `msaa_samples` under this driver's limits and the budget.
+// Never 0, which the tile grid divides by: without a context the limits read
+// 0, and the framebuffer built later is what reports the failure.
+size_t ExportTileSize(int msaa_samples) {
+  return std::max<size_t>(
+      1, tile_budget::ChooseTileSize(QueryTileLimits(), msaa_samples,
+                                     ExportGpuBudget().load()));
+}
+
+// The page's pixel size at `dpi`, unless it bursts size_t or the PNG limits.
+std::optional<ImageSize> PageImageSize(const RectF& ortho_region, float dpi) {
+  const float dots_per_millimeter =
+      render_to_png_detail::DotsPerInchToDotsPerMillimeter(dpi);
+  const float width_pixels =
+      std::round(ortho_region.Width() * dots_per_millimeter);
+  const float height_pixels =
+      std::round(ortho_region.Height() * dots_per_millimeter);
+  if (!render_to_png_detail::FitsSizeT(width_pixels) ||
+      !render_to_png_detail::FitsSizeT(height_pixels)) {
+    return std::nullopt;
+  }
+  const ImageSize size{.width = static_cast<size_t>(width_pixels),
+                       .height = static_cast<size_t>(height_pixels)};
+  if (!png_io::FitsPngLimits(size.width, size.height)) {
+    return std::nullopt;
+  }
+  return size;
+}
+
+// The engine's scene painted by software_page into `sink`, for the kCpu
+// renderer. Without a scene the GL path clears and draws nothing; so does this.
+bool RenderOnCpu(GraphicsEngine& graphics_engine, const RectF& ortho_region,
+                 size_t image_width, size_t image_height,
+                 const ImageComposer::BandSink& sink) {
+  const glm::vec4 background = GraphicsEngine::ClearColorRgba();
+  const auto scene = graphics_engine.GetScene();
+  return scene.has_value()
+             ? software_page::RenderScene(scene->get(), ortho_region,
+                                          image_width, image_height,
+                                          background, sink)
+             : software_raster::RenderImage({}, background, image_width,
+                                            image_height,
+                                            software_page::kBandRows, sink);
+}
+
+}  // namespace
 
 ImageComposer::ImageComposer(ImageSize image_size, const RectF& ortho_region_in,
                              GraphicsEngine& graphics_engine_in,
@@ -29,7 +133,7 @@ ImageComposer::ImageComposer(ImageSize image_size, const RectF& ortho_region_in,
       ortho_region_(ortho_region_in),
       graphics_engine_(graphics_engine_in),
       bytes_per_pixel_(kBytesPerPixel),
-      tile_size_(kMaxTileSize),
+      tile_size_(ExportTileSize(msaa_samples_in)),
       msaa_samples_(msaa_samples_in) {
   CalculatePixelRemainders();
   CalculateTileOrthoSize();
@@ -37,22 +141,86 @@ ImageComposer::ImageComposer(ImageSize image_size, const RectF& ortho_region_in,
   CalculateTileGrid();
 
   ConfigureTiles();
-  RenderTiles();
-  if (!rendered_) {
-    return;
-  }
-  ComposeTiles();
-  VerticalFlip();
 }
 
-bool ImageComposer::Rendered() const { return rendered_; }
+ImageComposer::Outcome ImageComposer::Render(const BandSink& sink) {
+  MVP mvp;
+  mvp.SetView(glm::translate(glm::mat4(1.0F), glm::vec3(0.0F, 0.0F, 0.0F)));
+  stage_times_ = StageTimes{};
+
+  const size_t row_bytes = width_ * bytes_per_pixel_;
+  const size_t band_bytes = row_bytes * std::min(height_, tile_size_);
+  // One band encodes while the next renders into the other.
+  std::array<std::vector<unsigned char>, 2> bands{
+      std::vector<unsigned char>(band_bytes),
+      std::vector<unsigned char>(band_bytes)};
+  std::array<std::vector<unsigned char*>, 2> band_rows;
+  // Sized for the largest tile; the smaller ones of the last column and row
+  // take its corner.
+  RenderToTexture target(static_cast<GLsizei>(std::min(width_, tile_size_)),
+                         static_cast<GLsizei>(std::min(height_, tile_size_)),
+                         msaa_samples_);
+  // Without a complete framebuffer the render goes nowhere and the read-back
+  // hands back tiles of zeros — a black page, silently. The caller has to
+  // hear about it instead of writing the file.
+  if (!target.Valid()) {
+    return Outcome::kTargetFailed;
+  }
+  if (decade_debug::LogEnabled()) {
+    std::cout << "--dump-png: " << tile_columns_ << " x " << tile_rows_
+              << " tiles of up to " << tile_size_ << " px, "
+              << target.Samples() << " samples per pixel (asked for "
+              << msaa_samples_ << ")\n";
+  }
+  TileReadback readback;
+  // Declared after the bands: should the render stop early, the destructor
+  // joins the encoder before the band it reads goes away.
+  std::future<bool> encoded;
+
+  size_t current = 0;
+  // Grid row 0 lies at the bottom of the ortho region, the image starts at
+  // the top.
+  for (size_t row = tile_rows_; row-- > 0; current = 1 - current) {
+    std::vector<unsigned char>& band = bands.at(current);
+    if (!RenderBand(row, mvp, target, band, readback)) {
+      return Outcome::kTargetFailed;
+    }
+    // The band above has to be out before this one may follow it.
+    if (encoded.valid() && !encoded.get()) {
+      return Outcome::kSinkFailed;
+    }
+
+    // GL hands the rows over bottom first; pointing at them in reverse is
+    // the whole vertical flip.
+    const auto band_height =
+        static_cast<size_t>(TileAt(0, row).pixel_dimensions[1]);
+    std::vector<unsigned char*>& rows = band_rows.at(current);
+    rows.resize(band_height);
+    for (size_t band_row = 0; band_row < band_height; ++band_row) {
+      rows[band_row] = &band[(band_height - 1 - band_row) * row_bytes];
+    }
+    encoded = std::async(std::launch::async, [this, &sink, &rows] {
+      const auto started = std::chrono::steady_clock::now();
+      const bool accepted = sink(rows);
+      stage_times_.encode +=
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - started);
+      return accepted;
+    });
+  }
+  const bool written = !encoded.valid() || encoded.get();
+
+  stage_times_.readback = readback.Elapsed();
+  if (decade_debug::LogEnabled()) {
+    LogStageTimes();
+  }
+  return written ? Outcome::kRendered : Outcome::kSinkFailed;
+}
 
 ImageTile& ImageComposer::TileAt(size_t column, size_t row) {
   return tiles_[column + (row * tile_columns_)];
 }
 
-std::vector<unsigned char> ImageComposer::CopyImage() const { return image_; }
-
 size_t ImageComposer::TileCount() const { return tiles_.size(); }
 
 size_t ImageComposer::TileColumns() const { return tile_columns_; }
@@ -146,97 +314,64 @@ void ImageComposer::ConfigureTiles() {
   }
 }
 
-void ImageComposer::RenderTiles() {
-  MVP mvp;
-  mvp.SetView(glm::translate(glm::mat4(1.0F), glm::vec3(0.0F, 0.0F, 0.0F)));
-
-  for (size_t row = 0; row < TileRows(); ++row) {
-    for (size_t column = 0; column < TileColumns(); ++column) {
-      auto& tile = TileAt(column, row);
-
-      RenderToTexture render_texture(tile.pixel_dimensions[0],
-                                     tile.pixel_dimensions[1], msaa_samples_);
-      // Without a complete framebuffer the render goes nowhere and the
-      // read-back hands back a tile of zeros — a black page, silently. The
-      // caller has to hear about it instead of writing the file.
-      if (!render_texture.Valid()) {
-        rendered_ = false;
-        return;
-      }
-      if (decade_debug::LogEnabled() && row == 0 && column == 0) {
-        std::cout << "--dump-png: " << render_texture.Samples()
-                  << " samples per pixel (asked for " << msaa_samples_ << ")\n";
-      }
-
-      render_texture.BeginRender();
-      mvp.SetProjection(
-          glm::ortho(tile.ortho_region.Left(), tile.ortho_region.Right(),
-                     tile.ortho_region.Bottom(), tile.ortho_region.Top()));
+bool ImageComposer::RenderBand(size_t row, MVP& mvp, RenderToTexture& target,
+                               std::span<unsigned char> band,
+                               TileReadback& readback) {
+  // Two per tile, render and resolve, read once the band has drained.
+  std::optional<ElapsedQueries> queries;
+  if (decade_debug::LogEnabled()) {
+    queries.emplace(2 * TileColumns());
+  }
 
-      graphics_engine_.SetMVP(mvp);
-      graphics_engine_.Render();
+  size_t band_x = 0;
+  for (size_t column = 0; column < TileColumns(); ++column) {
+    const auto& tile = TileAt(column, row);
 
-      render_texture.EndRender();
+    target.BeginRender(tile.pixel_dimensions[0], tile.pixel_dimensions[1]);
+    mvp.SetProjection(
+        glm::ortho(tile.ortho_region.Left(), tile.ortho_region.Right(),
+                   tile.ortho_region.Bottom(), tile.ortho_region.Top()));
 
-      tile.pixels = render_texture.CopyImage();
+    graphics_engine_.SetMVP(mvp);
+    if (queries.has_value()) {
+      queries->Begin(2 * column);
+    }
+    graphics_engine_.Render();
+    if (queries.has_value()) {
+      queries->End();
+      queries->Begin((2 * column) + 1);
+    }
+    target.EndRender();
+    if (queries.has_value()) {
+      queries->End();
     }
-  }
-}
-
-void ImageComposer::ComposeTiles() {
-  image_.resize(bytes_per_pixel_ * width_ * height_);
 
-  size_t dest_x = 0;
-  size_t dest_y = 0;
+    readback.Queue(target.TextureName(), tile.pixel_dimensions[0],
+                   tile.pixel_dimensions[1],
+                   band.subspan(band_x * bytes_per_pixel_),
+                   static_cast<GLsizei>(width_));
+    band_x += static_cast<size_t>(tile.pixel_dimensions[0]);
+  }
+  readback.Drain();
 
-  for (size_t row = 0; row < TileRows(); ++row) {
+  if (queries.has_value()) {
     for (size_t column = 0; column < TileColumns(); ++column) {
-      auto& tile = TileAt(column, row);
-
-      const size_t dest_offset =
-          (dest_y * width_ * bytes_per_pixel_) + (dest_x * bytes_per_pixel_);
-
-      const auto tile_pixel_height =
-          static_cast<size_t>(tile.pixel_dimensions[1]);
-      for (size_t tile_row = 0; tile_row < tile_pixel_height; ++tile_row) {
-        const size_t tile_row_bytes =
-            static_cast<size_t>(tile.pixel_dimensions[0]) * bytes_per_pixel_;
-        const size_t src_begin = tile_row * tile_row_bytes;
-        const size_t src_end = src_begin + tile_row_bytes;
-
-        const auto dest_row_offset = static_cast<std::ptrdiff_t>(
-            dest_offset + (tile_row * width_ * bytes_per_pixel_));
-        const auto src_begin_offset = static_cast<std::ptrdiff_t>(src_begin);
-        const auto src_end_offset = static_cast<std::ptrdiff_t>(src_end);
-
-        std::copy(tile.pixels.cbegin() + src_begin_offset,
-                  tile.pixels.cbegin() + src_end_offset,
-                  image_.begin() + dest_row_offset);
-      }
-
-      dest_x += static_cast<std::size_t>(tile.pixel_dimensions[0]);
+      stage_times_.render += queries->Elapsed(2 * column);
+      stage_times_.resolve += queries->Elapsed((2 * column) + 1);
     }
-
-    auto& first_tile_in_row = TileAt(0, row);
-    dest_x = 0;
-    dest_y += static_cast<std::size_t>(first_tile_in_row.pixel_dimensions[1]);
   }
+  return true;
 }
 
-void ImageComposer::VerticalFlip() {
-  const std::vector<unsigned char> image_copy(image_);
-
-  for (size_t row = 0; row < height_; ++row) {
-    const size_t row_size = width_ * bytes_per_pixel_;
-    const size_t row_begin = row * row_size;
-    const size_t row_end = row_begin + row_size;
-
-    const auto row_begin_offset = static_cast<std::ptrdiff_t>(row_begin);
-    const auto row_end_offset = static_cast<std::ptrdiff_t>(row_end);
-    std::copy(image_copy.cbegin() + row_begin_offset,
-              image_copy.cbegin() + row_end_offset,
-              image_.end() - row_end_offset);
-  }
+void ImageComposer::LogStageTimes() const {
+  const auto millis = [](std::chrono::nanoseconds time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+  };
+  std::cout << "--dump-png: render " << millis(stage_times_.render)
+            << " ms, resolve " << millis(stage_times_.resolve)
+            << " ms (GPU); readback " << millis(stage_times_.readback)
+            << " ms, encode " << millis(stage_times_.encode)
+            << " ms (CPU, overlapping the render)\n";
 }
 
 namespace render_to_png_detail {
@@ -254,37 +389,132 @@ bool FitsSizeT(float value) {
 
 }  // namespace render_to_png_detail
 
-void WritePageToPng(const std::string& file_path, const RectF& ortho_region,
+void SetExportGpuBudget(size_t bytes) { ExportGpuBudget().store(bytes); }
+
+bool WritePageToPng(const std::string& file_path, const RectF& ortho_region,
                     float dpi, GraphicsEngine& graphics_engine,
-                    int msaa_samples) {
-  const float dots_per_millimeter =
-      render_to_png_detail::DotsPerInchToDotsPerMillimeter(dpi);
-  const float width_pixels =
-      std::round(ortho_region.Width() * dots_per_millimeter);
-  const float height_pixels =
-      std::round(ortho_region.Height() * dots_per_millimeter);
-  if (!render_to_png_detail::FitsSizeT(width_pixels) ||
-      !render_to_png_detail::FitsSizeT(height_pixels)) {
-    return;
+                    int msaa_samples, const png_io::EncodeOptions& encoding,
+                    software_raster::PageRenderer renderer,
+                    const std::vector<png_io::PngText>& text) {
+  const std::optional<ImageSize> image_size =
+      PageImageSize(ortho_region, dpi);
+  if (!image_size) {
+    return false;
+  }
+  const size_t image_width = image_size->width;
+  const size_t image_height = image_size->height;
+
+  png_io::PngRowWriter writer(
+      file_path,
+      png_io::PngImageSize{.width = image_width, .height = image_height},
+      encoding, text);
+  if (!writer.Good()) {
+    std::cerr << "--dump-png: cannot write " << file_path << '\n';
+    return false;
   }
 
-  const auto image_width = static_cast<size_t>(width_pixels);
-  const auto image_height = static_cast<size_t>(height_pixels);
-
-  if (!png_io::FitsPngLimits(image_width, image_height)) {
-    return;
+  const auto sink = [&writer](std::span<unsigned char*> rows) {
+    return writer.WriteRows(rows);
+  };
+  if (renderer == software_raster::PageRenderer::kCpu) {
+    const bool rendered = RenderOnCpu(graphics_engine, ortho_region,
+                                      image_width, image_height, sink);
+    if (!rendered || !writer.Finish()) {
+      std::cerr << "--dump-png: writing " << file_path
+                << " failed; nothing written\n";
+      return false;
+    }
+    return true;
   }
 
-  const ImageComposer composer(
+  ImageComposer composer(
       ImageSize{.width = image_width, .height = image_height}, ortho_region,
       graphics_engine, msaa_samples);
-  if (!composer.Rendered()) {
+  const ImageComposer::Outcome outcome = composer.Render(sink);
+  if (outcome == ImageComposer::Outcome::kTargetFailed) {
     std::cerr << "--dump-png: the off-screen framebuffer would not come up; "
                  "nothing written\n";
-    return;
+    return false;
+  }
+  if (outcome == ImageComposer::Outcome::kSinkFailed || !writer.Finish()) {
+    std::cerr << "--dump-png: writing " << file_path
+              << " failed; nothing written\n";
+    return false;
+  }
+  return true;
+}
+
+bool WritePageToDzi(const std::string& file_path, const RectF& ortho_region,
+                    float dpi, GraphicsEngine& graphics_engine,
+                    int msaa_samples, const png_io::EncodeOptions& encoding,
+                    software_raster::PageRenderer renderer) {
+  const std::optional<ImageSize> image_size =
+      PageImageSize(ortho_region, dpi);
+  if (!image_size) {
+    return false;
+  }
+  const auto started = std::chrono::steady_clock::now();
+  const std::filesystem::path descriptor_path(file_path);
+  const std::filesystem::path tiles_directory =
+      tile_pyramid::TilesDirectory(descriptor_path);
+  size_t tiles_written = 0;
+  const std::vector<tile_pyramid::Level> levels =
+      tile_pyramid::Levels(image_size->width, image_size->height);
+  for (const tile_pyramid::Level& level : levels) {
+    tile_pyramid::TileCutter cutter(level, tiles_directory, encoding);
+    if (!cutter.Good()) {
+      return false;
+    }
+    const auto sink = [&cutter](std::span<unsigned char*> rows) {
+      return cutter.AddRows(rows);
+    };
+    // Each level is rendered at its own size, so the small levels are drawn
+    // crisp rather than shrunk out of the large ones. The engine and its
+    // context stay the same from level to level.
+    bool rendered = false;
+    if (renderer == software_raster::PageRenderer::kCpu) {
+      rendered = RenderOnCpu(graphics_engine, ortho_region, level.width,
+                             level.height, sink);
+    } else {
+      ImageComposer composer(
+          ImageSize{.width = level.width, .height = level.height},
+          ortho_region, graphics_engine, msaa_samples);
+      const ImageComposer::Outcome outcome = composer.Render(sink);
+      if (outcome == ImageComposer::Outcome::kTargetFailed) {
+        std::cerr << "--dump-dzi: the off-screen framebuffer would not come "
+                     "up; no descriptor written\n";
+        return false;
+      }
+      rendered = outcome == ImageComposer::Outcome::kRendered;
+    }
+    if (!rendered || !cutter.Finish()) {
+      std::cerr << "--dump-dzi: level " << level.index << " of " << file_path
+                << " failed; no descriptor written\n";
+      return false;
+    }
+    tiles_written += cutter.TilesWritten();
+  }
+
+  // Last, so a pyramid that broke off halfway has no descriptor pointing at
+  // it.
+  std::ofstream descriptor(descriptor_path);
+  if (!descriptor) {
+    std::cerr << "--dump-dzi: cannot write " << file_path << '\n';
+    return false;
+  }
+  descriptor << tile_pyramid::Descriptor(image_size->width,
+                                         image_size->height);
+  if (!descriptor.flush()) {
+    std::cerr << "--dump-dzi: writing " << file_path << " failed\n";
+    return false;
+  }
+  if (decade_debug::LogEnabled()) {
+    std::cout << "--dump-dzi: " << levels.size() << " levels, "
+              << tiles_written << " tiles in "
+              << std::chrono::duration<double, std::milli>(
+                     std::chrono::steady_clock::now() - started)
+                     .count()
+              << " ms\n";
   }
-  auto pixels = composer.CopyImage();
-  png_io::WriteRgbaPng(
-      file_path.c_str(), pixels,
-      png_io::PngImageSize{.width = image_width, .height = image_height});
+  return true;
 }
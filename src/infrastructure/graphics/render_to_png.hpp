@@ -4,18 +4,28 @@
 #include <epoxy/gl.h>
 
 #include <array>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
 #include <string>
 #include <vector>
 
 #include "graphics_engine.hpp"
+#include "mvp_matrices.hpp"
+#include "png_strip_encoder.hpp"
+#include "png_writer.hpp"
 #include "rect.hpp"
+#include "render_to_texture.hpp"
+#include "software_raster.hpp"
+#include "tile_readback.hpp"
 
 // One tile of the final image. The full picture is rendered in pieces because
-// a single FBO/texture is capped at kMaxTileSize (4096) per side; a 200-dpi
-// page easily exceeds that. `pixel_dimensions` is the tile's {width, height} in
-// pixels, `ortho_region` the slice of the orthographic world it maps to,
-// `pixels` the rendered RGBA bytes.
+// a texture is capped per side by the driver and a multisampled one costs its
+// samples' worth of memory (tile_budget.hpp); a 200-dpi page exceeds both.
+// `pixel_dimensions` is the tile's {width, height} in pixels, `ortho_region`
+// the slice of the orthographic world it maps to.
 //
 // On MSAA at the seams (a question worth recording): the tiles do *not* overlap
 // and they must not. Each tile covers an integer-pixel region whose projection
@@ -30,7 +40,6 @@
 struct ImageTile {
   std::array<GLsizei, 2> pixel_dimensions{0, 0};  // {width, height} in pixels
   RectF ortho_region;                             // world-space slice it maps
-  std::vector<unsigned char> pixels;              // rendered RGBA bytes
 };
 
 struct ImageSize {
@@ -38,22 +47,46 @@ struct ImageSize {
   size_t height{0};
 };
 
-// Renders a large orthographic scene into a grid of tiles and composes them
-// into a single top-left-origin RGBA image. The grid has `tile_columns` x
-// `tile_rows` tiles; every tile is kMaxTileSize wide/high except the last
-// column/row, which hold the leftover ("remainder") pixels.
+// Renders a large orthographic scene into a grid of tiles and streams it out
+// as a top-left-origin RGBA image. The grid has `tile_columns` x `tile_rows`
+// tiles; every tile is the chosen tile size wide/high except the last
+// column/row, which hold the leftover ("remainder") pixels. The size comes
+// from the driver's limits and the export's GPU memory budget
+// (SetExportGpuBudget), and one framebuffer set of that size serves every tile
+// of the render.
+//
+// The image leaves one band — a row of tiles — at a time, top band first. Peak
+// memory is thus two bands, image width x tile height each, however large the
+// page: a 600-dpi A0 poster would need gigabytes held whole. Each tile is read
+// back into its place in the band, and the band's rows are passed on in
+// reverse, which turns GL's bottom-up rows into the image's top-down ones
+// without a copy.
+//
+// The stages overlap. A tile's readback goes through a TileReadback, so the
+// GPU renders the next tile while the last one travels to the CPU, and a
+// finished band is encoded on a worker thread while the next one renders into
+// the other band buffer. Under --debug-log the composer reports the time each
+// stage took: render and resolve as the GPU measured them, readback and
+// encode as the CPU waited on them.
 class ImageComposer {
  public:
+  // Takes one band's rows, top row first, each `width` RGBA pixels. They are
+  // valid only during the call. Answering false stops the render. Called on a
+  // worker thread, one band after the other, never two at once.
+  using BandSink = std::function<bool(std::span<unsigned char*> rows)>;
+
   ImageComposer(ImageSize image_size, const RectF& ortho_region_in,
                 GraphicsEngine& graphics_engine_in, int msaa_samples_in);
 
-  // False when a tile's framebuffer would not come up. The composed image is
-  // then empty, and nothing may get written out of it.
-  [[nodiscard]] bool Rendered() const;
+  // How a render ended, and which stage stopped it: the tile's framebuffer
+  // that would not come up, or the sink that turned a band down.
+  enum class Outcome : std::uint8_t { kRendered, kTargetFailed, kSinkFailed };
 
-  ImageTile& TileAt(size_t column, size_t row);
+  // Renders the bands top to bottom into `sink`. Unless kRendered, nothing
+  // further is rendered, and the caller must not keep what it got.
+  [[nodiscard]] Outcome Render(const BandSink& sink);
 
-  [[nodiscard]] std::vector<unsigned char> CopyImage() const;
+  ImageTile& TileAt(size_t column, size_t row);
 
   [[nodiscard]] size_t TileCount() const;
 
@@ -62,6 +95,13 @@ class ImageComposer {
   [[nodiscard]] size_t TileRows() const;
 
  private:
+  struct StageTimes {
+    std::chrono::nanoseconds render{0};
+    std::chrono::nanoseconds resolve{0};
+    std::chrono::nanoseconds readback{0};
+    std::chrono::nanoseconds encode{0};
+  };
+
   void CalculatePixelRemainders();
 
   void CalculateTileOrthoSize();
@@ -72,11 +112,13 @@ class ImageComposer {
 
   void ConfigureTiles();
 
-  void RenderTiles();
-
-  void ComposeTiles();
+  // Renders the tiles of grid row `row` (0 at the bottom of the ortho region)
+  // through `target` into `band`, whose rows are the image's width apart.
+  [[nodiscard]] bool RenderBand(size_t row, MVP& mvp, RenderToTexture& target,
+                                std::span<unsigned char> band,
+                                TileReadback& readback);
 
-  void VerticalFlip();
+  void LogStageTimes() const;
 
   size_t width_{0};
   size_t height_{0};
@@ -90,7 +132,6 @@ class ImageComposer {
   GraphicsEngine& graphics_engine_;
 
   size_t bytes_per_pixel_{0};
-  std::vector<unsigned char> image_;
 
   size_t tile_size_{0};
   size_t width_remainder_{0};
@@ -100,10 +141,9 @@ class ImageComposer {
   float remainder_ortho_width_{0.0F};
   float remainder_ortho_height_{0.0F};
   int msaa_samples_;
-  bool rendered_{true};
+  StageTimes stage_times_;
 
   static constexpr size_t kBytesPerPixel = 4;
-  static constexpr size_t kMaxTileSize = 4096;
 };
 
 namespace render_to_png_detail {
@@ -123,11 +163,38 @@ namespace render_to_png_detail {
 
 }  // namespace render_to_png_detail
 
+// The GPU memory a page export's tile may take, tile_budget::
+// kDefaultBudgetBytes unless set otherwise. Process-wide, set once at start
+// from --export-gpu-budget.
+void SetExportGpuBudget(size_t bytes);
+
 // Draws the calendar page as a PNG at the wanted resolution. It converts the
 // page's millimetre extent into a pixel size through the dpi, has ImageComposer
-// render it in tiles and png_io write it. It does nothing when the image size
-// bursts the PNG limits.
-void WritePageToPng(const std::string& file_path, const RectF& ortho_region,
+// render it band by band and png_io write each band as it comes. It does
+// nothing when the image size bursts the PNG limits, and leaves no file behind
+// when the render or the write fails halfway; it answers false then.
+// `encoding` sets the compression level and row filter. With `renderer` kCpu
+// the engine's scene is painted by software_page instead, into the same
+// writer; `msaa_samples` does not apply there, the CPU computes coverage.
+// `text` goes into the file as tEXt chunks.
+bool WritePageToPng(const std::string& file_path, const RectF& ortho_region,
+                    float dpi, GraphicsEngine& graphics_engine,
+                    int msaa_samples,
+                    const png_io::EncodeOptions& encoding = {},
+                    software_raster::PageRenderer renderer =
+                        software_raster::PageRenderer::kGl,
+                    const std::vector<png_io::PngText>& text = {});
+
+// Draws the calendar page as a Deep Zoom pyramid (tile_pyramid.hpp): the
+// descriptor at `file_path`, the tiles beside it. `dpi` sets the largest
+// level; every level below is rendered afresh at its own size, through the
+// same engine, and cut into tiles as its bands come. The descriptor is written
+// last and only when every tile was, so a failed export leaves none behind.
+// The other parameters are WritePageToPng's.
+bool WritePageToDzi(const std::string& file_path, const RectF& ortho_region,
                     float dpi, GraphicsEngine& graphics_engine,
-                    int msaa_samples);
+                    int msaa_samples,
+                    const png_io::EncodeOptions& encoding = {},
+                    software_raster::PageRenderer renderer =
+                        software_raster::PageRenderer::kGl);
 #endif  // RENDER_TO_PNG_HPP
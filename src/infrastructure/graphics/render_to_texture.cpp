@@ -6,7 +6,8 @@
 #include <array>
 #include <cstddef>
 #include <memory>
-#include <vector>
+
+#include "tile_budget.hpp"
 
 ScopedFramebufferBinding::ScopedFramebufferBinding() {
   GLint bound = 0;
@@ -18,12 +19,6 @@ ScopedFramebufferBinding::~ScopedFramebufferBinding() {
   glBindFramebuffer(GL_FRAMEBUFFER, previous_);
 }
 
-RenderBuffer::RenderBuffer() { glGenRenderbuffers(1, &name_); }
-
-RenderBuffer::~RenderBuffer() { glDeleteRenderbuffers(1, &name_); }
-
-GLuint RenderBuffer::Name() const { return name_; }
-
 FrameBuffer::FrameBuffer(GLsizei width, GLsizei height, GLsizei samples,
                          bool msaa) {
   const ScopedFramebufferBinding restore_binding;
@@ -35,13 +30,7 @@ FrameBuffer::FrameBuffer(GLsizei width, GLsizei height, GLsizei samples,
                  GL_UNSIGNED_BYTE, nullptr);
     glBindTexture(GL_TEXTURE_2D, 0);
 
-    glBindRenderbuffer(GL_RENDERBUFFER, render_buffer_.Name());
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
-    glBindRenderbuffer(GL_RENDERBUFFER, 0);
-
     glBindFramebuffer(GL_FRAMEBUFFER, name_);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
-                              GL_RENDERBUFFER, render_buffer_.Name());
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
                            texture_.Name(), 0);
   }
@@ -52,16 +41,9 @@ FrameBuffer::FrameBuffer(GLsizei width, GLsizei height, GLsizei samples,
                             height, GL_TRUE);
     glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
 
-    glBindRenderbuffer(GL_RENDERBUFFER, render_buffer_.Name());
-    glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples,
-                                     GL_DEPTH_COMPONENT24, width, height);
-    glBindRenderbuffer(GL_RENDERBUFFER, 0);
-
     glBindFramebuffer(GL_FRAMEBUFFER, name_);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
                            GL_TEXTURE_2D_MULTISAMPLE, texture_.Name(), 0);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
-                              GL_RENDERBUFFER, render_buffer_.Name());
   }
 }
 
@@ -80,18 +62,37 @@ GLuint FrameBuffer::TextureName() const { return texture_.Name(); }
 GLsizei MaxUsableSamples() {
   GLint max_samples = 0;
   GLint max_color_samples = 0;
-  GLint max_depth_samples = 0;
   glGetIntegerv(GL_MAX_SAMPLES, &max_samples);
   glGetIntegerv(GL_MAX_COLOR_TEXTURE_SAMPLES, &max_color_samples);
-  glGetIntegerv(GL_MAX_DEPTH_TEXTURE_SAMPLES, &max_depth_samples);
-  return std::min({max_samples, max_color_samples, max_depth_samples});
+  return std::min(max_samples, max_color_samples);
+}
+
+GLsizei UsableSamples(GLsizei wanted) {
+  return std::max(std::min(wanted, MaxUsableSamples()), 1);
+}
+
+tile_budget::TileLimits QueryTileLimits() {
+  GLint max_texture_size = 0;
+  GLint max_renderbuffer_size = 0;
+  std::array<GLint, 2> max_viewport{};
+  glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+  glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &max_renderbuffer_size);
+  glGetIntegerv(GL_MAX_VIEWPORT_DIMS, max_viewport.data());
+  const auto size = [](GLint value) {
+    return static_cast<std::size_t>(std::max(value, 0));
+  };
+  return tile_budget::TileLimits{
+      .max_texture_size = size(max_texture_size),
+      .max_renderbuffer_size = size(max_renderbuffer_size),
+      .max_viewport_size = size(std::min(max_viewport[0], max_viewport[1])),
+      .max_samples = std::max(MaxUsableSamples(), 1)};
 }
 
 RenderToTexture::RenderToTexture(GLsizei width_in, GLsizei height_in,
                                  GLsizei samples_in)
     : width_(width_in),
       height_(height_in),
-      samples_(std::min(samples_in, MaxUsableSamples())),
+      samples_(UsableSamples(samples_in)),
       multisampled_(samples_ > 1),
       output_frame_buffer_(width_in, height_in, samples_, false) {
   if (multisampled_) {
@@ -112,7 +113,9 @@ GLsizei RenderToTexture::Samples() const {
   return multisampled_ ? samples_ : 1;
 }
 
-void RenderToTexture::BeginRender() {
+void RenderToTexture::BeginRender(GLsizei width, GLsizei height) {
+  render_width_ = std::min(width, width_);
+  render_height_ = std::min(height, height_);
   std::array<GLint, 4> viewport{};
   glGetIntegerv(GL_VIEWPORT, viewport.data());
 
@@ -126,7 +129,7 @@ void RenderToTexture::BeginRender() {
   const GLuint render_target = multisampled_ ? multisample_frame_buffer_->Name()
                                              : output_frame_buffer_.Name();
   glBindFramebuffer(GL_FRAMEBUFFER, render_target);
-  glViewport(0, 0, width_, height_);
+  glViewport(0, 0, render_width_, render_height_);
 }
 
 void RenderToTexture::EndRender() {
@@ -136,23 +139,15 @@ void RenderToTexture::EndRender() {
   if (multisampled_) {
     glBindFramebuffer(GL_READ_FRAMEBUFFER, multisample_frame_buffer_->Name());
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, output_frame_buffer_.Name());
-    glBlitFramebuffer(0, 0, width_, height_, 0, 0, width_, height_,
-                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBlitFramebuffer(0, 0, render_width_, render_height_, 0, 0,
+                      render_width_, render_height_, GL_COLOR_BUFFER_BIT,
+                      GL_NEAREST);
   }
   glBindFramebuffer(GL_FRAMEBUFFER, previous_framebuffer_);
 
   glViewport(0, 0, previous_viewport_width_, previous_viewport_height_);
 }
 
-std::vector<unsigned char> RenderToTexture::CopyImage() {
-  const size_t image_size = static_cast<size_t>(width_) *
-                            static_cast<size_t>(height_) *
-                            static_cast<size_t>(bytes_per_pixel_);
-  image_.resize(image_size);
-
-  glBindTexture(GL_TEXTURE_2D, output_frame_buffer_.TextureName());
-  glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, image_.data());
-  glBindTexture(GL_TEXTURE_2D, 0);
-
-  return image_;
+GLuint RenderToTexture::TextureName() const {
+  return output_frame_buffer_.TextureName();
 }
@@ -4,9 +4,9 @@
 #include <epoxy/gl.h>
 
 #include <memory>
-#include <vector>
 
 #include "texture_object.hpp"
+#include "tile_budget.hpp"
 
 // Restores the framebuffer that was bound on entry. Unbinding to 0 instead
 // would be a guess about who owns the screen: 0 is the window's back buffer
@@ -28,27 +28,14 @@ class ScopedFramebufferBinding {
   GLuint previous_{0};
 };
 
-// Owns a single OpenGL renderbuffer handle. Non-copyable/non-movable because
-// the destructor deletes the handle — a copy would delete it twice.
-class RenderBuffer {
- public:
-  RenderBuffer();
-
-  ~RenderBuffer();
-
-  RenderBuffer(const RenderBuffer&) = delete;
-  RenderBuffer& operator=(const RenderBuffer&) = delete;
-  RenderBuffer(RenderBuffer&&) = delete;
-  RenderBuffer& operator=(RenderBuffer&&) = delete;
-
-  [[nodiscard]] GLuint Name() const;
-
- private:
-  GLuint name_{0};
-};
-
-// Owns a single OpenGL framebuffer plus its colour texture and depth
-// renderbuffer. Non-copyable/non-movable for the same reason as RenderBuffer.
+// Owns a single OpenGL framebuffer plus its colour texture. Non-copyable and
+// non-movable because the destructor deletes the handle — a copy would delete
+// it twice.
+//
+// No depth attachment: the page is flat, drawn in layer order, and the depth
+// test the canvas enables passes everywhere on a framebuffer without depth —
+// so the export draws as the CPU renderer does, by order alone. A depth
+// buffer would cost as much as the colour texture again, per sample.
 class FrameBuffer {
  public:
   FrameBuffer(GLsizei width, GLsizei height, GLsizei samples, bool msaa);
@@ -69,11 +56,10 @@ class FrameBuffer {
  private:
   GLuint name_{0};
   Texture texture_;
-  RenderBuffer render_buffer_;
 };
 
-// What this implementation can actually multisample, for an RGBA colour texture
-// with a depth renderbuffer beside it. Asking for more is not a warning but a
+// What this implementation can actually multisample, for an RGBA colour
+// texture. Asking for more is not a warning but a
 // failure: glTexImage2DMultisample raises GL_INVALID_VALUE past GL_MAX_SAMPLES
 // and GL_INVALID_OPERATION past GL_MAX_COLOR_TEXTURE_SAMPLES, the texture never
 // comes into being, the framebuffer stays incomplete — and everything drawn
@@ -81,12 +67,23 @@ class FrameBuffer {
 // produced a black page under llvmpipe, whose ceiling is 8 (#49).
 [[nodiscard]] GLsizei MaxUsableSamples();
 
-// Renders into an off-screen framebuffer and reads the result back as RGBA
-// bytes. With multisampling (samples > 1) it renders into a dedicated MSAA
+// The samples a render asking for `wanted` runs with here, before any
+// fallback: capped at MaxUsableSamples, and at least one.
+[[nodiscard]] GLsizei UsableSamples(GLsizei wanted);
+
+// The driver's ceilings for an export tile, read from the current context.
+[[nodiscard]] tile_budget::TileLimits QueryTileLimits();
+
+// Renders into an off-screen framebuffer whose texture holds the result as
+// RGBA bytes. With multisampling (samples > 1) it renders into a dedicated MSAA
 // framebuffer and resolves it into the readable output buffer; without it,
 // rendering goes straight into the output buffer and the extra MSAA buffer is
 // never allocated.
 //
+// One of these serves every tile of an export: made at the largest tile's
+// size, it renders a smaller one into its bottom-left corner, and resolves and
+// hands out that corner alone.
+//
 // The wanted sample count is a wish, not a demand: it gets capped at what the
 // driver offers, and should the MSAA framebuffer still not come up, the render
 // falls back to a single sample. A page without antialiasing beats a black one.
@@ -103,17 +100,26 @@ class RenderToTexture {
   // fallback — not what the caller asked for.
   [[nodiscard]] GLsizei Samples() const;
 
-  void BeginRender();
+  // Renders into the bottom-left `width` x `height` pixels, at most the size
+  // it was made with.
+  void BeginRender(GLsizei width, GLsizei height);
 
+  // Resolves what BeginRender's region received.
   void EndRender();
 
-  std::vector<unsigned char> CopyImage();
+  // The single-sample texture holding the rendered (and resolved) RGBA image,
+  // for a TileReadback to read. A read queued on it outlives this object
+  // safely: GL deletes the texture only once the commands using it are done.
+  [[nodiscard]] GLuint TextureName() const;
 
  private:
   static constexpr GLsizei kBytesPerPixel = 4;
 
   GLsizei width_;
   GLsizei height_;
+  // The region of the render under way.
+  GLsizei render_width_{0};
+  GLsizei render_height_{0};
   GLsizei samples_;
   bool multisampled_;
 
@@ -124,9 +130,6 @@ class RenderToTexture {
   GLint previous_viewport_height_{0};
   GLuint previous_framebuffer_{0};
 
-  GLsizei bytes_per_pixel_{kBytesPerPixel};
-  std::vector<unsigned char> image_;
-
   bool valid_{false};
 };
 #endif  // RENDER_TO_TEXTURE_HPP
@@ -1,9 +1,12 @@
 #include "scene.hpp"
 
-#include <glm/ext/matrix_float4x4.hpp>
+#include <cstddef>
 #include <memory>
+#include <vector>
 
+#include "rect.hpp"
 #include "scene_graph.hpp"
+#include "spatial_grid.hpp"
 
 Scene::Scene() : root_(std::make_unique<SceneNode>(kRootName)) {}
 
@@ -11,4 +14,53 @@ SceneNode& Scene::Root() { return *root_; }
 
 const SceneNode& Scene::Root() const { return *root_; }
 
-void Scene::Draw(const glm::mat4& parent_world) { root_->Draw(parent_world); }
+Scene::CullStats Scene::Draw(const RectF& view) {
+  if (!collected_) {
+    Collect();
+  }
+
+  CullStats stats{.drawn = 0, .culled = empty_count_};
+  for (const LayerIndex& layer : layers_) {
+    layer.grid.Query(view, visible_);
+    for (const std::size_t id : visible_) {
+      const SceneNode::DrawCall& draw_call = layer.calls[id];
+      draw_call.shape->Draw(draw_call.world);
+    }
+    stats.drawn += visible_.size();
+    stats.culled += layer.calls.size() - visible_.size();
+  }
+  return stats;
+}
+
+void Scene::Invalidate() {
+  collected_ = false;
+  layers_.clear();
+  empty_count_ = 0;
+}
+
+void Scene::Collect() {
+  layers_.clear();
+  empty_count_ = 0;
+
+  // The list arrives sorted by layer, so a layer is one contiguous run.
+  for (SceneNode::DrawCall& draw_call : root_->CollectDrawCalls()) {
+    if (!draw_call.world_bounds.has_value()) {
+      ++empty_count_;
+      continue;
+    }
+    if (layers_.empty() ||
+        layers_.back().calls.back().layer != draw_call.layer) {
+      layers_.emplace_back();
+    }
+    layers_.back().calls.push_back(draw_call);
+  }
+  std::vector<RectF> bounds;
+  for (LayerIndex& layer : layers_) {
+    bounds.clear();
+    for (const SceneNode::DrawCall& draw_call : layer.calls) {
+      bounds.push_back(*draw_call.world_bounds);
+    }
+    layer.grid = SpatialGrid(bounds);
+  }
+  collected_ = true;
+}
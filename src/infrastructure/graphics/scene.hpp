@@ -1,10 +1,13 @@
 #ifndef SCENE_HPP
 #define SCENE_HPP
 
-#include <glm/mat4x4.hpp>
+#include <cstddef>
 #include <memory>
+#include <vector>
 
+#include "rect.hpp"
 #include "scene_graph.hpp"
+#include "spatial_grid.hpp"
 
 // Infrastructure: the single owner (SSOT) of the render scene graph's root.
 //
@@ -19,23 +22,59 @@
 // It deliberately exposes the node directly (rather than wrapping every
 // SceneNode operation) so it stays a thin ownership boundary, not a second API
 // surface over the scene graph.
+//
+// It also keeps what drawing needs between rebuilds: the painter-ordered draw
+// list and, per layer, a SpatialGrid over the shapes' world bounds. A frame
+// asks the grids for the shapes the view touches and draws only those, so
+// zoomed into one month the cost follows what is on screen, not the page.
+// Neither the list nor the grids notice the graph changing under them —
+// whoever changes geometry or transforms calls Invalidate(), and the next
+// Draw() collects afresh.
 class Scene {
  public:
+  // What the last Draw() did with the shapes: painted, or skipped for lying
+  // outside the view (shapes without geometry count as skipped).
+  struct CullStats {
+    std::size_t drawn{0};
+    std::size_t culled{0};
+  };
+
   Scene();
 
   [[nodiscard]] SceneNode& Root();
   [[nodiscard]] const SceneNode& Root() const;
 
-  // Renders the whole graph. Painter-order layering is handled inside
-  // SceneNode::Draw; this is just the entry point the engine calls per frame.
-  void Draw(const glm::mat4& parent_world = glm::mat4(1.0F));
+  // Renders the shapes whose world bounds touch `view` (the visible part of
+  // the page in world space), layer by layer in painter's order — the order
+  // SceneNode::Draw paints the whole graph in.
+  CullStats Draw(const RectF& view);
+
+  // Drops the draw list and the grids; the next Draw() rebuilds them from the
+  // graph. Call after every change to the graph's geometry or transforms.
+  void Invalidate();
 
  private:
+  // One draw layer's shapes with geometry, in painter's order, and the grid
+  // over their world bounds (grid ids index `calls`).
+  struct LayerIndex {
+    std::vector<SceneNode::DrawCall> calls;
+    SpatialGrid grid;
+  };
+
+  void Collect();
+
   static constexpr const char* kRootName = "root";
   // Sole ownership: the children below the root remain shared_ptr (co-owned by
   // their parent and the builder's named-node members), but the root itself has
   // exactly one owner — this Scene.
   std::unique_ptr<SceneNode> root_;
+  bool collected_{false};
+  std::vector<LayerIndex> layers_;
+  // Shapes left out of every grid for lacking geometry; each Draw() counts
+  // them culled.
+  std::size_t empty_count_{0};
+  // The ids one layer's query returns; kept to spare the per-frame allocation.
+  std::vector<std::size_t> visible_;
 };
 
 #endif  // SCENE_HPP
@@ -63,40 +63,29 @@ const std::string& SceneNode::GetStyleId() const { return style_id_; }
 
 std::optional<RectF> SceneNode::WorldBounds(
     const glm::mat4& parent_world) const {
-  float min_x = std::numeric_limits<float>::max();
-  float min_y = std::numeric_limits<float>::max();
-  float max_x = std::numeric_limits<float>::lowest();
-  float max_y = std::numeric_limits<float>::lowest();
-  bool found = false;
+  std::optional<RectF> result;
 
   VisitDepthFirst(*this, parent_world,
                   [&](const SceneNode& node, const glm::mat4& world) {
                     if (node.shape_ == nullptr) {
                       return;
                     }
-                    const RectF& bounds = node.shape_->LocalBounds();
-                    if (bounds.Width() <= 0.0F && bounds.Height() <= 0.0F) {
+                    const std::optional<RectF> bounds =
+                        TransformBounds(node.shape_->LocalBounds(), world);
+                    if (!bounds.has_value()) {
                       return;
                     }
-                    const std::array<glm::vec4, 4> corners = {
-                        glm::vec4(bounds.Left(), bounds.Bottom(), 0.0F, 1.0F),
-                        glm::vec4(bounds.Right(), bounds.Bottom(), 0.0F, 1.0F),
-                        glm::vec4(bounds.Left(), bounds.Top(), 0.0F, 1.0F),
-                        glm::vec4(bounds.Right(), bounds.Top(), 0.0F, 1.0F)};
-                    for (const auto& corner : corners) {
-                      const glm::vec4 world_corner = world * corner;
-                      min_x = std::min(min_x, world_corner.x);
-                      min_y = std::min(min_y, world_corner.y);
-                      max_x = std::max(max_x, world_corner.x);
-                      max_y = std::max(max_y, world_corner.y);
+                    if (!result.has_value()) {
+                      result = bounds;
+                      return;
                     }
-                    found = true;
+                    result = RectF(std::min(result->Left(), bounds->Left()),
+                                   std::max(result->Right(), bounds->Right()),
+                                   std::min(result->Bottom(), bounds->Bottom()),
+                                   std::max(result->Top(), bounds->Top()));
                   });
 
-  if (!found) {
-    return std::nullopt;
-  }
-  return RectF(min_x, max_x, min_y, max_y);
+  return result;
 }
 
 void SceneNode::SetModelMatrix(const glm::mat4& matrix) {
@@ -110,11 +99,13 @@ void SceneNode::SetDrawLayer(int layer) { draw_layer_ = layer; }
 int SceneNode::GetDrawLayer() const { return draw_layer_; }
 
 void SceneNode::Draw(const glm::mat4& parent_world) {
-  struct DrawCall {
-    Drawable* shape;
-    glm::mat4 world;
-    int layer;
-  };
+  for (const auto& draw_call : CollectDrawCalls(parent_world)) {
+    draw_call.shape->Draw(draw_call.world);
+  }
+}
+
+std::vector<SceneNode::DrawCall> SceneNode::CollectDrawCalls(
+    const glm::mat4& parent_world) {
   std::vector<DrawCall> draw_calls;
 
   VisitDepthFirst(*this, parent_world,
@@ -122,19 +113,43 @@ void SceneNode::Draw(const glm::mat4& parent_world) {
                     if (node.shape_ == nullptr) {
                       return;
                     }
-                    draw_calls.push_back({.shape = node.shape_.get(),
-                                          .world = world,
-                                          .layer = node.draw_layer_});
+                    draw_calls.push_back(
+                        {.shape = node.shape_.get(),
+                         .world = world,
+                         .layer = node.draw_layer_,
+                         .world_bounds = TransformBounds(
+                             node.shape_->LocalBounds(), world)});
                   });
 
   std::ranges::stable_sort(draw_calls,
                            [](const DrawCall& lhs, const DrawCall& rhs) {
                              return lhs.layer < rhs.layer;
                            });
+  return draw_calls;
+}
 
-  for (const auto& draw_call : draw_calls) {
-    draw_call.shape->Draw(draw_call.world);
+std::optional<RectF> TransformBounds(const RectF& local,
+                                     const glm::mat4& world) {
+  if (local.Width() <= 0.0F && local.Height() <= 0.0F) {
+    return std::nullopt;
   }
+  const std::array<glm::vec4, 4> corners = {
+      glm::vec4(local.Left(), local.Bottom(), 0.0F, 1.0F),
+      glm::vec4(local.Right(), local.Bottom(), 0.0F, 1.0F),
+      glm::vec4(local.Left(), local.Top(), 0.0F, 1.0F),
+      glm::vec4(local.Right(), local.Top(), 0.0F, 1.0F)};
+  float min_x = std::numeric_limits<float>::max();
+  float min_y = std::numeric_limits<float>::max();
+  float max_x = std::numeric_limits<float>::lowest();
+  float max_y = std::numeric_limits<float>::lowest();
+  for (const auto& corner : corners) {
+    const glm::vec4 world_corner = world * corner;
+    min_x = std::min(min_x, world_corner.x);
+    min_y = std::min(min_y, world_corner.y);
+    max_x = std::max(max_x, world_corner.x);
+    max_y = std::max(max_y, world_corner.y);
+  }
+  return RectF(min_x, max_x, min_y, max_y);
 }
 
 std::optional<std::string> FindNodePath(const SceneNode& root,
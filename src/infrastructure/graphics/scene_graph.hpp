@@ -14,6 +14,17 @@
 
 class SceneNode {
  public:
+  // One shape of the subtree, placed: what Draw() paints and in which layer,
+  // under the world transform the walk accumulated, and where that puts it on
+  // the page. `world_bounds` is nullopt for a shape without geometry (a
+  // zero-extent local box).
+  struct DrawCall {
+    Drawable* shape;
+    glm::mat4 world;
+    int layer;
+    std::optional<RectF> world_bounds;
+  };
+
   SceneNode();
 
   explicit SceneNode(const std::string& name);
@@ -85,6 +96,12 @@ class SceneNode {
   // traversal order.
   void Draw(const glm::mat4& parent_world = glm::mat4(1.0F));
 
+  // The first phase of Draw() on its own: the subtree's shapes in the order
+  // Draw() paints them, layer by layer. Scene keeps this list between rebuilds
+  // and culls it against the view instead of walking the tree every frame.
+  [[nodiscard]] std::vector<DrawCall> CollectDrawCalls(
+      const glm::mat4& parent_world = glm::mat4(1.0F));
+
  private:
   // The one depth-first walk both traversals above run (#35): they accumulate
   // the world matrix identically and differ only in what they collect. The
@@ -92,10 +109,10 @@ class SceneNode {
   // before its children.
   //
   // `Node` deduces the constness from the caller, so WorldBounds gets a const
-  // walk and Draw a mutable one out of the same body. Children go onto the
-  // stack back to front, because it pops from the back: pushed in order, the
-  // last child would come off first and end up painted underneath its earlier
-  // siblings (#29).
+  // walk and CollectDrawCalls a mutable one out of the same body. Children go
+  // onto the stack back to front, because it pops from the back: pushed in
+  // order, the last child would come off first and end up painted underneath
+  // its earlier siblings (#29).
   template <typename Node, typename Visit>
   static void VisitDepthFirst(Node& root, const glm::mat4& parent_world,
                               Visit visit) {
@@ -126,6 +143,12 @@ class SceneNode {
   int draw_layer_{0};
 };
 
+// The world-space axis-aligned box around `local` under `world`: the box of
+// its four transformed corners. nullopt when `local` has no extent, the same
+// test WorldBounds() skips geometry-less shapes by.
+[[nodiscard]] std::optional<RectF> TransformBounds(const RectF& local,
+                                                   const glm::mat4& world);
+
 // The path "root/.../name" to a node of the tree, or empty when it does not lie
 // in it. The counterpart to resolving a path: the same notation the scene tree
 // panel and the selection highlight use.
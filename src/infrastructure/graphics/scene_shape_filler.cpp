@@ -3,18 +3,37 @@
 #include <glm/ext/vector_float3.hpp>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "child_pool.hpp"
 #include "font.hpp"
+#include "shape_node.hpp"
+#include "text_batch.hpp"
 
 namespace scene_shapes {
 
 void SetCenteredText(TextChildPool& pool, const std::string& name,
                      const std::string& text, const glm::vec3& center,
                      float size, const std::shared_ptr<Font>& font) {
-  FontShape& shape = pool.Next(name).shape;
-  shape.SetFont(font);
-  shape.SetShapeCentered(text, center, size);
+  TextLabel& label = pool.Next(name).shape;
+  label.SetFont(font);
+  label.SetShapeCentered(text, center, size);
+}
+
+void CommitTextBatch(const ShapeNode<TextBatchShape>& batch) {
+  std::vector<const TextLabel*> labels;
+  labels.reserve(batch.Node()->GetChildren().size());
+  for (const auto& child : batch.Node()->GetChildren()) {
+    labels.push_back(static_cast<const TextLabel*>(child->GetShape()));
+  }
+  batch.Shape().SetLabels(labels);
+}
+
+void RelayoutTextBatch(const ShapeNode<TextBatchShape>& batch) {
+  for (const auto& child : batch.Node()->GetChildren()) {
+    static_cast<TextLabel*>(child->GetShape())->Relayout();
+  }
+  CommitTextBatch(batch);
 }
 
 }  // namespace scene_shapes
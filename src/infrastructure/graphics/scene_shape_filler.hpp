@@ -12,6 +12,7 @@
 #include "shaders.hpp"
 #include "shape_node.hpp"
 #include "shapes.hpp"
+#include "text_batch.hpp"
 
 // Infrastructure: generic, domain-free helpers for the two scene-node
 // construction shapes that recur across the calendar's section builders —
@@ -35,15 +36,23 @@ inline void FillRectangles(const ShapeNode<BoxesShape>& node,
   shape.SetColors(outline_color, fill_color);
 }
 
-// A pool of centred text children. Sets the next child to `text`, centred at
-// `center` with font height `size`, and keeps the node it already had —
-// including its GL buffers. The label groups all share this shape.
-using TextChildPool = ShapeChildPool<FontShape>;
+// A pool of centred text labels under a TextBatchShape node. Sets the next
+// child to `text`, centred at `center` with font height `size`, and keeps the
+// node it already had. The label groups all share this shape.
+using TextChildPool = ShapeChildPool<TextLabel>;
 
 void SetCenteredText(TextChildPool& pool, const std::string& name,
                      const std::string& text, const glm::vec3& center,
                      float size, const std::shared_ptr<Font>& font);
 
+// Hands the labels under `batch` — all its children, as the text pool made
+// them — to its TextBatchShape. Once per rebuild, after the pool is done.
+void CommitTextBatch(const ShapeNode<TextBatchShape>& batch);
+
+// Lays every label under `batch` out again in place and commits the batch:
+// the glyph quads change, the labels and their places do not.
+void RelayoutTextBatch(const ShapeNode<TextBatchShape>& batch);
+
 }  // namespace scene_shapes
 
 #endif  // SCENE_SHAPE_FILLER_HPP
@@ -0,0 +1,164 @@
+#include "scene_walk.hpp"
+
+#include <cstddef>
+#include <glm/ext/matrix_float4x4.hpp>
+#include <glm/ext/vector_float2.hpp>
+#include <glm/ext/vector_float4.hpp>
+#include <span>
+
+#include "drawable.hpp"
+#include "grid_pattern.hpp"
+#include "grid_shape.hpp"
+#include "rect.hpp"
+#include "scene.hpp"
+#include "scene_graph.hpp"
+#include "shapes.hpp"
+#include "text_batch.hpp"
+#include "text_layout.hpp"
+
+namespace scene_walk {
+namespace {
+
+// A rectangle the way the rectangles shader draws it: the fill inside, the
+// outline straddling the edges by half its width.
+void PaintBox(const Mapping& mapping, Painter& painter,
+              const glm::mat4& world, const glm::vec4& edges,
+              float line_width, const glm::vec4& outline_color,
+              const glm::vec4& fill_color) {
+  const float half_line = line_width * 0.5F;
+  const TargetBox outer = mapping.ToTarget(
+      world, edges + glm::vec4(-half_line, half_line, -half_line, half_line));
+  const TargetBox inner = mapping.ToTarget(
+      world, edges + glm::vec4(half_line, -half_line, half_line, -half_line));
+  if (fill_color.a > 0.0F) {
+    painter.Rectangle(inner, fill_color);
+  }
+  if (outline_color.a > 0.0F && half_line > 0.0F) {
+    painter.Frame(outer, inner, outline_color);
+  }
+}
+
+void PaintBoxes(const Mapping& mapping, Painter& painter,
+                const glm::mat4& world, const BoxesShape& boxes) {
+  const auto edges = boxes.Edges();
+  const auto line_widths = boxes.LineWidths();
+  const auto outline_colors = boxes.OutlineColors();
+  const auto fill_colors = boxes.FillColors();
+  for (std::size_t index = 0; index < edges.size(); ++index) {
+    PaintBox(mapping, painter, world, edges[index], line_widths[index],
+             outline_colors[index], fill_colors[index]);
+  }
+}
+
+void PaintGrid(const Mapping& mapping, Painter& painter,
+               const glm::mat4& world, const GridShape& grid) {
+  const grid_pattern::Pattern& pattern = grid.GetPattern();
+  for (const grid_pattern::CellRow& row : grid.Rows()) {
+    const int count = grid_pattern::CellCount(pattern, row);
+    for (int cell = 0; cell < count; ++cell) {
+      if (!grid_pattern::IsDrawn(pattern, row, cell)) {
+        continue;
+      }
+      const float left =
+          row.cells.Left() + (static_cast<float>(cell) * pattern.cell_width);
+      PaintBox(mapping, painter, world,
+               glm::vec4(left, left + pattern.cell_width, row.cells.Bottom(),
+                         row.cells.Top()),
+               pattern.style.line_width, pattern.style.outline_color,
+               pattern.style.fill_color);
+    }
+  }
+}
+
+void Paint(const Mapping& mapping, Painter& painter,
+           const SceneNode::DrawCall& draw_call) {
+  const glm::mat4& world = draw_call.world;
+  switch (draw_call.shape->Kind()) {
+    case DrawableKind::kFill: {
+      const auto& fill = static_cast<const FillShape&>(*draw_call.shape);
+      const RectF& box = fill.LocalBounds();
+      painter.Rectangle(
+          mapping.ToTarget(world, glm::vec4(box.Left(), box.Right(),
+                                            box.Bottom(), box.Top())),
+          fill.Color());
+      break;
+    }
+    case DrawableKind::kBoxes:
+      PaintBoxes(mapping, painter, world,
+                 static_cast<const BoxesShape&>(*draw_call.shape));
+      break;
+    case DrawableKind::kGrid:
+      PaintGrid(mapping, painter, world,
+                static_cast<const GridShape&>(*draw_call.shape));
+      break;
+    case DrawableKind::kText: {
+      const auto& text = static_cast<const FontShape&>(*draw_call.shape);
+      if (text.GetFont() != nullptr) {
+        const TextRun& run = text.Run();
+        const PlacedText placed{.text = text.Text(),
+                                .origin = run.origin,
+                                .size = text.FontSize(),
+                                .color = text.Color()};
+        painter.Text(TextDraw{.world = world,
+                              .font = *text.GetFont(),
+                              .positions = run.positions,
+                              .texels = run.texture_positions,
+                              .colors = {},
+                              .tint = text.Color(),
+                              .texts = std::span(&placed, 1)});
+      }
+      break;
+    }
+    case DrawableKind::kTextBatch: {
+      const auto& batch = static_cast<const TextBatchShape&>(*draw_call.shape);
+      if (batch.GetFont() != nullptr) {
+        painter.Text(TextDraw{.world = world,
+                              .font = *batch.GetFont(),
+                              .positions = batch.Positions(),
+                              .texels = batch.TexturePositions(),
+                              .colors = batch.Colors(),
+                              .tint = glm::vec4(1.0F),
+                              .texts = batch.Texts()});
+      }
+      break;
+    }
+    // A label's glyphs are in its batch; what is none of the calendar's
+    // shapes has nothing to paint.
+    case DrawableKind::kTextLabel:
+    case DrawableKind::kNone:
+      break;
+  }
+}
+
+}  // namespace
+
+Mapping::Mapping(const RectF& ortho_region, float width, float height)
+    : ortho_region_(ortho_region),
+      scale_(width / ortho_region.Width(), height / ortho_region.Height()) {}
+
+glm::vec2 Mapping::ToTarget(const glm::mat4& world, float x, float y) const {
+  const glm::vec4 point = world * glm::vec4(x, y, 0.0F, 1.0F);
+  return {(point.x - ortho_region_.Left()) * scale_.x,
+          (ortho_region_.Top() - point.y) * scale_.y};
+}
+
+TargetBox Mapping::ToTarget(const glm::mat4& world,
+                            const glm::vec4& edges) const {
+  const glm::vec2 bottom_left = ToTarget(world, edges.x, edges.z);
+  const glm::vec2 top_right = ToTarget(world, edges.y, edges.w);
+  return {.left = bottom_left.x,
+          .top = top_right.y,
+          .right = top_right.x,
+          .bottom = bottom_left.y};
+}
+
+void Walk(Scene& scene, const Mapping& mapping, Painter& painter) {
+  for (const SceneNode::DrawCall& draw_call : scene.Root().CollectDrawCalls()) {
+    // Scene::Draw leaves out draw calls without bounds as well.
+    if (draw_call.world_bounds.has_value()) {
+      Paint(mapping, painter, draw_call);
+    }
+  }
+}
+
+}  // namespace scene_walk
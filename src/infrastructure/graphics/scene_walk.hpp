@@ -0,0 +1,96 @@
+#ifndef SCENE_WALK_HPP
+#define SCENE_WALK_HPP
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <span>
+
+#include "font.hpp"
+#include "rect.hpp"
+#include "scene.hpp"
+#include "text_layout.hpp"
+
+// The scene as the exports that do not go through GL see it: its draw calls
+// in the order Scene::Draw paints them, each shape broken into what its
+// shader would have drawn, on a target with y running down — the image
+// software_page rasterizes, the page vector_scene writes.
+//
+// A FillShape is one rectangle; a BoxesShape a fill and an outline frame per
+// rectangle; a GridShape the same for every cell its pattern draws, in cell
+// order, which composites to what grid_pattern::SampleColor gives. A FontShape
+// or TextBatchShape is handed over whole, as quads and as text, for the
+// painter to take what it draws. Text labels draw nothing of their own, as on
+// the GPU.
+//
+// The world transforms the calendar's nodes carry are translations; the
+// corners of a box and the origin of a text are taken through them and the
+// box stays axis-aligned.
+namespace scene_walk {
+
+// An area of the target: x to the right from its left edge, y down from its
+// top edge. An inverted box — the fill of a rectangle narrower than its
+// outline — stays inverted, and the painters leave it out.
+struct TargetBox {
+  float left;
+  float top;
+  float right;
+  float bottom;
+};
+
+// `ortho_region` spread across a `width` x `height` target.
+class Mapping {
+ public:
+  Mapping(const RectF& ortho_region, float width, float height);
+
+  [[nodiscard]] glm::vec2 ToTarget(const glm::mat4& world, float x,
+                                   float y) const;
+
+  // `edges` as left, right, bottom, top.
+  [[nodiscard]] TargetBox ToTarget(const glm::mat4& world,
+                                   const glm::vec4& edges) const;
+
+  // Target units per world unit, along x and along y.
+  [[nodiscard]] const glm::vec2& Scale() const { return scale_; }
+
+ private:
+  RectF ortho_region_;
+  glm::vec2 scale_;
+};
+
+// One text draw: its quads as the font shader takes them — `colors` a colour
+// per vertex, or nothing for white, `tint` multiplying it as the shader
+// multiplies the draw's colour in — and the same labels as text.
+struct TextDraw {
+  const glm::mat4& world;
+  const Font& font;
+  std::span<const glm::vec3> positions;
+  std::span<const glm::vec2> texels;
+  std::span<const glm::vec4> colors;
+  glm::vec4 tint;
+  std::span<const PlacedText> texts;
+};
+
+// What a shape is painted as, in target units.
+class Painter {
+ public:
+  Painter() = default;
+  Painter(const Painter&) = delete;
+  Painter& operator=(const Painter&) = delete;
+  Painter(Painter&&) = delete;
+  Painter& operator=(Painter&&) = delete;
+  virtual ~Painter() = default;
+
+  virtual void Rectangle(const TargetBox& box, const glm::vec4& color) = 0;
+  virtual void Frame(const TargetBox& outer, const TargetBox& inner,
+                     const glm::vec4& color) = 0;
+  virtual void Text(const TextDraw& text) = 0;
+};
+
+// Hands every draw call of `scene` to `painter`, mapped by `mapping`.
+void Walk(Scene& scene, const Mapping& mapping, Painter& painter);
+
+}  // namespace scene_walk
+
+#endif  // SCENE_WALK_HPP
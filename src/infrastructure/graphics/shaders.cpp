@@ -4,13 +4,14 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <filesystem>
 #include <functional>
-#include <glm/ext/matrix_float4x4.hpp>
-#include <glm/ext/vector_float4.hpp>
-#include <glm/gtc/type_ptr.hpp>
 #include <iostream>
 #include <optional>
+#include <ratio>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -18,12 +19,48 @@
 
 #include "../../common/debug_log.hpp"
 #include "../../common/embedded_resources.hpp"
+#include "frame_uniforms.hpp"
 #include "mvp_matrices.hpp"
+#include "program_binary_cache.hpp"
 #include "shaders_info.hpp"
 
-Shader::Shader(const ShaderSources& sources, std::string name_in)
-    : name_(std::move(name_in)) {
-  CompileProgram(sources);
+namespace {
+
+// What a program binary depends on besides its sources.
+std::string DriverDescription() {
+  std::string description;
+  for (const GLenum name :
+       std::array<GLenum, 3>{GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+    const auto* value = glGetString(name);
+    if (value != nullptr) {
+      description += reinterpret_cast<const char*>(value);
+    }
+    description += '\n';
+  }
+  return description;
+}
+
+// A driver may support program binaries and offer no format to store them in;
+// Mesa does so with its own shader cache switched off.
+bool SupportsProgramBinaries() {
+  GLint format_count = 0;
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+  return format_count > 0;
+}
+
+}  // namespace
+
+Shader::Shader(const ShaderSources& sources, std::string name_in,
+               const ProgramBinaryCache& cache, const std::string& driver,
+               FrameUniforms& frame_uniforms)
+    : name_(std::move(name_in)), frame_uniforms_(frame_uniforms) {
+  const std::uint64_t key =
+      ProgramBinaryCache::Key(driver, sources.vertex, sources.fragment);
+  from_cache_ = LoadProgram(cache.Load(name_, key));
+  if (!from_cache_) {
+    CompileProgram(sources);
+    StoreProgram(cache, key);
+  }
 
   shader_info_.SetProgram(program_);
 }
@@ -32,17 +69,11 @@ GLuint Shader::GetProgram() const { return program_; }
 
 std::string Shader::GetName() const { return name_; }
 
-void Shader::UseProgram() const { glUseProgram(program_); }
-
-void Shader::SetUniform(const std::string& uniform_name,
-                        const glm::mat4& matrix) const {
-  glUniformMatrix4fv(UniformLocation(uniform_name), 1, GL_FALSE,
-                     glm::value_ptr(matrix));
-}
+bool Shader::FromCache() const { return from_cache_; }
 
-void Shader::SetUniform(const std::string& uniform_name,
-                        const glm::vec4& vector) const {
-  glUniform4fv(UniformLocation(uniform_name), 1, glm::value_ptr(vector));
+void Shader::UseProgram(const DrawRecord& record) const {
+  glUseProgram(program_);
+  frame_uniforms_.SetDrawRecord(record);
 }
 
 void Shader::PrintShaderInfo() const {
@@ -61,17 +92,6 @@ const std::vector<ShaderInfo>& Shader::GetShaderAttributesInfos() const {
   return shader_info_.GetAttributesInfos();
 }
 
-GLint Shader::UniformLocation(const std::string& uniform_name) const {
-  auto found = uniform_locations_.find(uniform_name);
-  if (found == uniform_locations_.end()) {
-    found = uniform_locations_
-                .emplace(uniform_name,
-                         glGetUniformLocation(program_, uniform_name.c_str()))
-                .first;
-  }
-  return found->second;
-}
-
 void Shader::CompileProgram(const ShaderSources& sources) {
   // The stage travels into the message: the driver reports a line and a
   // column but no file, so without it a failure names no source at all.
@@ -84,8 +104,51 @@ void Shader::CompileProgram(const ShaderSources& sources) {
   LinkShaders(handles);
 }
 
+bool Shader::LoadProgram(
+    const std::optional<ProgramBinaryCache::Binary>& binary) {
+  if (!binary.has_value()) {
+    return false;
+  }
+  program_ = glCreateProgram();
+  glProgramBinary(program_, static_cast<GLenum>(binary->format),
+                  binary->bytes.data(),
+                  static_cast<GLsizei>(binary->bytes.size()));
+
+  // A driver refuses a binary through the link status, without an error.
+  GLint status = 0;
+  glGetProgramiv(program_, GL_LINK_STATUS, &status);
+  if (status == GL_FALSE) {
+    glDeleteProgram(program_);
+    program_ = 0;
+    if (decade_debug::LogEnabled()) {
+      std::cout << "cached program of " << name_
+                << " refused by the driver, compiling\n";
+    }
+    return false;
+  }
+  return true;
+}
+
+void Shader::StoreProgram(const ProgramBinaryCache& cache,
+                          std::uint64_t key) const {
+  GLint length = 0;
+  glGetProgramiv(program_, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+  ProgramBinaryCache::Binary binary;
+  binary.bytes.resize(static_cast<std::size_t>(length));
+  GLenum format = 0;
+  glGetProgramBinary(program_, length, nullptr, &format, binary.bytes.data());
+  binary.format = format;
+  cache.Store(name_, key, binary);
+}
+
 void Shader::LinkShaders(const ShaderHandles& handles) {
   program_ = glCreateProgram();
+  // Without the hint a driver may hand out no binary, or one that needs the
+  // shaders recompiled when it is loaded.
+  glProgramParameteri(program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
   glAttachShader(program_, handles.vertex);
   glAttachShader(program_, handles.fragment);
@@ -158,7 +221,12 @@ GLuint Shader::CompileShader(const std::string& source, GLenum shader_type,
   return shader;
 }
 
-Shaders::Shaders() {
+Shaders::Shaders(const std::optional<std::filesystem::path>& cache_directory) {
+  const auto started = std::chrono::steady_clock::now();
+  const ProgramBinaryCache cache(
+      SupportsProgramBinaries() ? cache_directory : std::nullopt);
+  const std::string driver = DriverDescription();
+
   // The Lambert shaders (diffuse lighting per fragment) used to be embedded
   // beside these and never loaded — they belong to the 3D path the calendar
   // does not use. With #embed, a file nobody names simply does not travel
@@ -167,17 +235,31 @@ Shaders::Shaders() {
       Shader::ShaderSources{
           .vertex = std::string(resources::kSimpleVertexShader),
           .fragment = std::string(resources::kSimpleFragmentShader)},
-      "Simple Shader");
+      "Simple Shader", cache, driver, frame_uniforms_);
   shaders_.emplace_back(
       Shader::ShaderSources{
           .vertex = std::string(resources::kRectanglesVertexShader),
           .fragment = std::string(resources::kRectanglesFragmentShader)},
-      "Rectangles Shader");
+      "Rectangles Shader", cache, driver, frame_uniforms_);
+  shaders_.emplace_back(
+      Shader::ShaderSources{
+          .vertex = std::string(resources::kGridVertexShader),
+          .fragment = std::string(resources::kGridFragmentShader)},
+      "Grid Shader", cache, driver, frame_uniforms_);
   shaders_.emplace_back(
       Shader::ShaderSources{
           .vertex = std::string(resources::kFontVertexShader),
           .fragment = std::string(resources::kFontFragmentShader)},
-      "Font Shader");
+      "Font Shader", cache, driver, frame_uniforms_);
+
+  if (decade_debug::LogEnabled()) {
+    const auto elapsed = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - started);
+    const auto cached = std::ranges::count_if(
+        shaders_, [](const Shader& shader) { return shader.FromCache(); });
+    std::cout << "shader setup " << elapsed.count() << " ms, " << cached
+              << " of " << shaders_.size() << " programs from the cache\n";
+  }
   PrintInfo();
 }
 
@@ -190,13 +272,9 @@ void Shaders::PrintInfo() const {
   }
 }
 
-void Shaders::SetCameraUniforms(const MVP& mvp) {
-  for (const auto& shader : shaders_) {
-    shader.UseProgram();
-    shader.SetUniform("projection", mvp.GetProjection());
-    shader.SetUniform("view", mvp.GetView());
-  }
-}
+void Shaders::BeginFrame(const MVP& mvp) { frame_uniforms_.BeginFrame(mvp); }
+
+void Shaders::EndFrame() { frame_uniforms_.EndFrame(); }
 
 std::optional<std::reference_wrapper<Shader>> Shaders::SearchShader(
     const std::string& search_name) {
@@ -4,15 +4,16 @@
 #include <epoxy/gl.h>
 
 #include <cstddef>
+#include <cstdint>
+#include <filesystem>
 #include <functional>
-#include <glm/mat4x4.hpp>
-#include <glm/vec4.hpp>
 #include <optional>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
+#include "frame_uniforms.hpp"
 #include "mvp_matrices.hpp"
+#include "program_binary_cache.hpp"
 #include "shaders_info.hpp"
 
 class Shader {
@@ -22,19 +23,25 @@ class Shader {
     std::string fragment;
   };
 
-  explicit Shader(const ShaderSources& sources, std::string name_in);
+  // Takes the linked program out of `cache` when it holds one for these
+  // sources and this `driver`; compiles and links otherwise, and stores the
+  // result there for the next start.
+  // The program reads the camera and its draw records out of
+  // `frame_uniforms`.
+  Shader(const ShaderSources& sources, std::string name_in,
+         const ProgramBinaryCache& cache, const std::string& driver,
+         FrameUniforms& frame_uniforms);
 
   [[nodiscard]] GLuint GetProgram() const;
 
   [[nodiscard]] std::string GetName() const;
 
-  void UseProgram() const;
+  // Whether the program came out of the binary cache — for the debug log.
+  [[nodiscard]] bool FromCache() const;
 
-  void SetUniform(const std::string& uniform_name,
-                  const glm::mat4& matrix) const;
-
-  void SetUniform(const std::string& uniform_name,
-                  const glm::vec4& vector) const;
+  // Makes the program current for one draw whose per-draw inputs `record`
+  // holds.
+  void UseProgram(const DrawRecord& record) const;
 
   void PrintShaderInfo() const;
 
@@ -48,13 +55,14 @@ class Shader {
     GLuint fragment;
   };
 
-  // Uniform locations are stable after linking; the cache spares the
-  // glGetUniformLocation string lookup that would otherwise fall due per shape
-  // and frame.
-  GLint UniformLocation(const std::string& uniform_name) const;
-
   void CompileProgram(const ShaderSources& sources);
 
+  // Hands a cached binary to the driver. False when there is none or the
+  // driver refuses it; no program is left behind then.
+  bool LoadProgram(const std::optional<ProgramBinaryCache::Binary>& binary);
+
+  void StoreProgram(const ProgramBinaryCache& cache, std::uint64_t key) const;
+
   void LinkShaders(const ShaderHandles& handles);
 
   static GLuint CompileShader(const std::string& source, GLenum shader_type,
@@ -62,23 +70,28 @@ class Shader {
 
   GLuint program_{0};
   std::string name_;
+  bool from_cache_{false};
   ShaderInfos shader_info_;
-  mutable std::unordered_map<std::string, GLint> uniform_locations_;
+  FrameUniforms& frame_uniforms_;
 };
 
 class Shaders {
  public:
-  Shaders();
+  // `cache_directory` is where linked programs are kept between starts;
+  // without one every start compiles. GL: the context must be current.
+  explicit Shaders(const std::optional<std::filesystem::path>& cache_directory);
 
   // Every shader with its attributes and uniforms — diagnosis, so it hangs on
   // --debug-log. One guard for the whole chain: PrintShaderInfo and the
   // ShaderInfo printers below it have no other caller.
   void PrintInfo() const;
 
-  // Projection and view are frame-global, so they are set for all shaders at
-  // once. The iteration lives here, with the shaders, rather than at the one
-  // caller that would otherwise need an index into them.
-  void SetCameraUniforms(const MVP& mvp);
+  // Projection and view are frame-global: one uniform block every shader
+  // reads, written at the start of the frame. The frame's draw records follow
+  // until EndFrame.
+  void BeginFrame(const MVP& mvp);
+
+  void EndFrame();
 
   // A reference_wrapper and not a pointer: the optional already carries the
   // absence, so a pointer inside it would be nullable twice over.
@@ -86,6 +99,8 @@ class Shaders {
       const std::string& search_name);
 
  private:
+  // Declared first: every Shader refers to it.
+  FrameUniforms frame_uniforms_;
   std::vector<Shader> shaders_;
 };
 #endif  // SHADERS_HPP
@@ -160,6 +160,12 @@ void ShaderInfos::GatherAttributesInfo() {
                       max_attrib_name_length, &written, &size, &type,
                       attrib_name.data());
     const GLint location = glGetAttribLocation(program_, attrib_name.data());
+    // Some drivers list the built-in inputs a shader reads — gl_VertexID,
+    // gl_InstanceID — among the active attributes, at location -1. No buffer
+    // feeds them, so they are no attribute a shape could set.
+    if (location < 0) {
+      continue;
+    }
 
     attribute_infos_.emplace_back(
         ShaderInfo::InfoType::ActiveAttribute,
@@ -8,9 +8,12 @@
 #include <glm/ext/vector_float3.hpp>
 #include <glm/ext/vector_float4.hpp>
 #include <span>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "drawable.hpp"
+#include "frame_uniforms.hpp"
 #include "rect.hpp"
 #include "shaders.hpp"
 #include "shapes_base.hpp"
@@ -38,29 +41,39 @@ void FillShape::SetShape(const RectF& rectangle) {
 
 void FillShape::SetColor(const glm::vec4& new_color) { color_ = new_color; }
 
+const glm::vec4& FillShape::Color() const { return color_; }
+
 void FillShape::Draw(const glm::mat4& model) const {
-  GetShader().UseProgram();
-  GetShader().SetUniform("model", model);
-  GetShader().SetUniform("color", color_);
+  DrawRecord record(model);
+  record.color = color_;
+  GetShader().UseProgram(record);
 
   VaoRef().Bind();
   glDrawArrays(GL_TRIANGLES, 0, VertexCount());
   VertexArrayObject::Unbind();
 }
 
-BoxesShape::BoxesShape(Shader& shader_in) : Shape(shader_in) {}
+BoxesShape::BoxesShape(Shader& shader_in) : Shape(shader_in) {
+  UsePerInstanceAttributes();
+}
 
 DrawableKind BoxesShape::Kind() const { return DrawableKind::kBoxes; }
 
 void BoxesShape::SetShape(const std::vector<RectF>& rectangles,
                           float line_width) {
-  vertices_.resize(rectangles.size() * kVerticesPerRectangle);
-
-  for (size_t index = 0; index < rectangles.size(); ++index) {
-    SetRectangleShape(index, rectangles[index], line_width);
+  edges_.clear();
+  edges_.reserve(rectangles.size());
+  for (const auto& rectangle : rectangles) {
+    edges_.emplace_back(rectangle.Left(), rectangle.Right(), rectangle.Bottom(),
+                        rectangle.Top());
   }
+  line_widths_.assign(rectangles.size(), line_width);
+  outline_colors_.assign(rectangles.size(), outline_color_);
+  fill_colors_.assign(rectangles.size(), fill_color_);
 
-  SetBuffer("position", std::span<const glm::vec3>(vertices_));
+  SetBuffer("edges", std::span<const glm::vec4>(edges_));
+  SetBuffer("line_width", std::span<const float>(line_widths_));
+  UploadColors();
   SetLocalBounds(UnionBounds(rectangles, line_width));
 }
 
@@ -72,17 +85,48 @@ void BoxesShape::SetColors(const glm::vec4& outline_color,
                            const glm::vec4& fill_color) {
   outline_color_ = outline_color;
   fill_color_ = fill_color;
+  std::ranges::fill(outline_colors_, outline_color_);
+  std::ranges::fill(fill_colors_, fill_color_);
+  UploadColors();
 }
 
-void BoxesShape::Draw(const glm::mat4& model) const {
-  GetShader().UseProgram();
-  GetShader().SetUniform("model", model);
+void BoxesShape::SetRectangleColors(size_t index,
+                                    const glm::vec4& outline_color,
+                                    const glm::vec4& fill_color) {
+  if (index >= RectangleCount()) {
+    throw std::out_of_range("rectangle " + std::to_string(index) +
+                            " of a shape holding " +
+                            std::to_string(RectangleCount()));
+  }
+  outline_colors_[index] = outline_color;
+  fill_colors_[index] = fill_color;
+  PatchBuffer("outline_color", index,
+              std::span<const glm::vec4>(outline_colors_).subspan(index, 1));
+  PatchBuffer("fill_color", index,
+              std::span<const glm::vec4>(fill_colors_).subspan(index, 1));
+}
+
+size_t BoxesShape::RectangleCount() const { return edges_.size(); }
+
+std::span<const glm::vec4> BoxesShape::Edges() const { return edges_; }
 
-  GetShader().SetUniform("outline_color", outline_color_);
-  GetShader().SetUniform("fill_color", fill_color_);
+std::span<const float> BoxesShape::LineWidths() const { return line_widths_; }
+
+std::span<const glm::vec4> BoxesShape::OutlineColors() const {
+  return outline_colors_;
+}
+
+std::span<const glm::vec4> BoxesShape::FillColors() const {
+  return fill_colors_;
+}
+
+void BoxesShape::Draw(const glm::mat4& model) const {
+  GetShader().UseProgram(DrawRecord(model));
 
   VaoRef().Bind();
-  glDrawArrays(GL_TRIANGLES, 0, VertexCount());
+  glDrawArraysInstanced(GL_TRIANGLES, 0,
+                        static_cast<GLsizei>(kVerticesPerRectangle),
+                        VertexCount());
   VertexArrayObject::Unbind();
 }
 
@@ -106,47 +150,7 @@ RectF BoxesShape::UnionBounds(const std::vector<RectF>& rectangles,
           top + half_line};
 }
 
-void BoxesShape::SetRectangleShape(size_t index, const RectF& rectangle,
-                                   float line_width) {
-  const float half_line_thickness = line_width * 0.5F;
-
-  const RectF inrectangle =
-      rectangle.Reduce(RectF(half_line_thickness, half_line_thickness,
-                             half_line_thickness, half_line_thickness));
-  const RectF outrectangle =
-      rectangle.Expand(RectF(half_line_thickness, half_line_thickness,
-                             half_line_thickness, half_line_thickness));
-
-  const size_t offset = index * kVerticesPerRectangle;
-
-  // fill
-  SetRectangle(offset, inrectangle.LeftBottom(), inrectangle.RightBottom(),
-               inrectangle.LeftTop(), inrectangle.RightTop());
-  // top outline
-  SetRectangle(offset + kVerticesPerQuad, inrectangle.LeftTop(),
-               inrectangle.RightTop(), outrectangle.LeftTop(),
-               outrectangle.RightTop());
-  // bottom outline
-  SetRectangle(offset + (kVerticesPerQuad * 2), outrectangle.LeftBottom(),
-               outrectangle.RightBottom(), inrectangle.LeftBottom(),
-               inrectangle.RightBottom());
-  // left outline
-  SetRectangle(offset + (kVerticesPerQuad * 3), outrectangle.LeftBottom(),
-               inrectangle.LeftBottom(), outrectangle.LeftTop(),
-               inrectangle.LeftTop());
-  // right outline
-  SetRectangle(offset + (kVerticesPerQuad * 4), inrectangle.RightBottom(),
-               outrectangle.RightBottom(), inrectangle.RightTop(),
-               outrectangle.RightTop());
-}
-
-void BoxesShape::SetRectangle(size_t offset, const glm::vec3& point0,
-                              const glm::vec3& point1, const glm::vec3& point2,
-                              const glm::vec3& point3) {
-  vertices_[offset + 0] = point0;
-  vertices_[offset + 1] = point1;
-  vertices_[offset + 2] = point2;
-  vertices_[offset + 3] = point3;
-  vertices_[offset + 4] = point2;
-  vertices_[offset + (kVerticesPerQuad - 1)] = point1;
+void BoxesShape::UploadColors() {
+  SetBuffer("outline_color", std::span<const glm::vec4>(outline_colors_));
+  SetBuffer("fill_color", std::span<const glm::vec4>(fill_colors_));
 }
@@ -3,8 +3,8 @@
 
 #include <cstddef>
 #include <glm/mat4x4.hpp>
-#include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
+#include <span>
 #include <vector>
 
 #include "drawable.hpp"
@@ -27,6 +27,9 @@ class FillShape : public Shape {
 
   void SetColor(const glm::vec4& new_color);
 
+  // The rectangle is LocalBounds(); this its colour, for the software export.
+  [[nodiscard]] const glm::vec4& Color() const;
+
   void Draw(const glm::mat4& model) const override;
 
  private:
@@ -36,6 +39,17 @@ class FillShape : public Shape {
 // Many axis-aligned rectangles at once, each with an outline of a given width
 // around its fill — the two carry colours of their own. One draw call for all
 // of them, which is why the whole set travels together.
+//
+// The CPU sends one record per rectangle — its edges, its line width and its
+// two colours — and the vertex shader makes the fill and the four outline
+// strips out of it (gl_VertexID picks the corner, the instance the record).
+// Thirty vertices of 12 bytes each used to be computed and uploaded per
+// rectangle, for every day cell of a decade.
+//
+// Each rectangle can carry a colour pair of its own: SetColors paints the whole
+// set, SetRectangleColors repaints one rectangle in place. The latter is what
+// the hover goes through — the set stays uploaded, only the rectangle's two
+// colours travel.
 class BoxesShape : public Shape {
  public:
   explicit BoxesShape(Shader& shader_in);
@@ -46,10 +60,29 @@ class BoxesShape : public Shape {
 
   void SetShape(const RectF& rectangle, float line_width);
 
-  // Outline and fill, named instead of sitting as a pair in a vector: the
-  // shader knows exactly these two uniforms.
+  // Outline and fill, named instead of sitting as a pair in a vector, for every
+  // rectangle of the set — including those a later SetShape brings along.
   void SetColors(const glm::vec4& outline_color, const glm::vec4& fill_color);
 
+  // Outline and fill of the rectangle at `index` alone, patched into the
+  // uploaded colours without touching the geometry. The next SetShape or
+  // SetColors returns the rectangle to the colours of the set. Throws for an
+  // index past the rectangles of the last SetShape.
+  void SetRectangleColors(size_t index, const glm::vec4& outline_color,
+                          const glm::vec4& fill_color);
+
+  [[nodiscard]] size_t RectangleCount() const;
+
+  // The records as the vertex shader reads them, one entry per rectangle —
+  // for the software export, which paints the same geometry on the CPU.
+  [[nodiscard]] std::span<const glm::vec4> Edges() const;
+
+  [[nodiscard]] std::span<const float> LineWidths() const;
+
+  [[nodiscard]] std::span<const glm::vec4> OutlineColors() const;
+
+  [[nodiscard]] std::span<const glm::vec4> FillColors() const;
+
   void Draw(const glm::mat4& model) const override;
 
  private:
@@ -58,19 +91,20 @@ class BoxesShape : public Shape {
   static RectF UnionBounds(const std::vector<RectF>& rectangles,
                            float line_width);
 
-  void SetRectangleShape(size_t index, const RectF& rectangle,
-                         float line_width);
-
-  void SetRectangle(size_t offset, const glm::vec3& point0,
-                    const glm::vec3& point1, const glm::vec3& point2,
-                    const glm::vec3& point3);
+  void UploadColors();
 
-  // The fill plus four outline strips per rectangle.
+  // The fill plus four outline strips per rectangle, as the vertex shader
+  // emits them.
   static constexpr size_t kQuadsPerRectangle = 5;
   static constexpr size_t kVerticesPerRectangle =
       kVerticesPerQuad * kQuadsPerRectangle;
 
-  std::vector<glm::vec3> vertices_;
+  // Per rectangle: left, right, bottom, top — the order of RectF's
+  // constructor, and the order the shader reads them in.
+  std::vector<glm::vec4> edges_;
+  std::vector<float> line_widths_;
+  std::vector<glm::vec4> outline_colors_;
+  std::vector<glm::vec4> fill_colors_;
   glm::vec4 outline_color_{0.0F, 0.0F, 0.0F, 1.0F};
   glm::vec4 fill_color_{0.0F, 0.0F, 0.0F, 1.0F};
 };
@@ -4,10 +4,12 @@
 
 #include <cstddef>
 #include <glm/ext/matrix_float4x4.hpp>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 
+#include "frame_uniforms.hpp"
 #include "rect.hpp"
 #include "shaders.hpp"
 #include "shaders_info.hpp"
@@ -21,8 +23,7 @@ void Shape::Hide() {
 }
 
 void Shape::Draw(const glm::mat4& model) const {
-  shader_.UseProgram();
-  shader_.SetUniform("model", model);
+  shader_.UseProgram(DrawRecord(model));
   vao_.Bind();
   glDrawArrays(GL_TRIANGLES, 0, number_vertices_);
   VertexArrayObject::Unbind();
@@ -30,6 +31,8 @@ void Shape::Draw(const glm::mat4& model) const {
 
 const RectF& Shape::LocalBounds() const { return local_bounds_; }
 
+std::size_t Shape::BufferWrites() const { return buffer_writes_; }
+
 GLsizei Shape::VertexCount() const { return number_vertices_; }
 
 Shader& Shape::GetShader() const { return shader_; }
@@ -38,6 +41,12 @@ const VertexArrayObject& Shape::VaoRef() const { return vao_; }
 
 void Shape::SetLocalBounds(const RectF& bounds) { local_bounds_ = bounds; }
 
+void Shape::UsePerInstanceAttributes() {
+  for (std::size_t index = 0; index < buffers_.size(); ++index) {
+    glVertexArrayBindingDivisor(vao_.Name(), static_cast<GLuint>(index), 1);
+  }
+}
+
 std::size_t Shape::BufferIndexFor(std::string_view attribute_name,
                                   std::size_t vertex_size) const {
   for (std::size_t index = 0; index < attributes_infos_.size(); ++index) {
@@ -60,10 +69,33 @@ std::size_t Shape::BufferIndexFor(std::string_view attribute_name,
                            std::string(attribute_name) + "'");
 }
 
+void Shape::WriteBuffer(std::size_t index, std::span<const std::byte> bytes) {
+  PersistentVertexBuffer& buffer = buffers_[index];
+  buffer.Write(bytes);
+  ++buffer_writes_;
+  glVertexArrayVertexBuffer(
+      vao_.Name(), static_cast<GLuint>(index), buffer.Name(), buffer.Offset(),
+      static_cast<GLsizei>(attributes_infos_[index].GetTypeSize()));
+}
+
+void Shape::PatchBufferBytes(std::string_view attribute_name,
+                             std::size_t index, std::size_t offset,
+                             std::span<const std::byte> bytes) {
+  PersistentVertexBuffer& buffer = buffers_[index];
+  if (offset + bytes.size() > buffer.Size()) {
+    throw std::runtime_error(
+        "patch of attribute '" + std::string(attribute_name) + "' in shader '" +
+        shader_.GetName() + "' covers bytes " + std::to_string(offset) +
+        " to " + std::to_string(offset + bytes.size()) +
+        ", but the buffer holds " + std::to_string(buffer.Size()));
+  }
+  buffer.Patch(offset, bytes);
+}
+
 void Shape::SetUpBuffers() {
   attributes_infos_ = shader_.GetShaderAttributesInfos();
 
-  vbos_.resize(attributes_infos_.size());
+  buffers_.resize(attributes_infos_.size());
 
   for (std::size_t index = 0; index < attributes_infos_.size(); ++index) {
     const ShaderInfo& attribute_info = attributes_infos_[index];
@@ -76,10 +108,12 @@ void Shape::SetUpBuffers() {
     }
 
     // Each attribute owns a buffer of its own, tightly packed — hence the
-    // element size as the stride and no offset anywhere. The three calls split
-    // what glVertexAttribPointer once welded together: what an element looks
-    // like, which binding point feeds the attribute, and what sits on that
-    // point. None of them reads a bound buffer, so nothing gets bound here.
+    // element size as the stride and no offset within an element. The calls
+    // split what glVertexAttribPointer once welded together: what an element
+    // looks like and which binding point feeds the attribute get set here for
+    // good; what sits on that point gets set by each WriteBuffer, since every
+    // write lands in another region of the buffer. None of them reads a bound
+    // buffer, so nothing gets bound here.
     const GLuint vertex_array = vao_.Name();
     const auto location = static_cast<GLuint>(attribute_info.GetLocation());
     const auto binding_index = static_cast<GLuint>(index);
@@ -90,10 +124,6 @@ void Shape::SetUpBuffers() {
 
     glVertexArrayAttribBinding(vertex_array, location, binding_index);
 
-    glVertexArrayVertexBuffer(
-        vertex_array, binding_index, vbos_[index].Name(), 0,
-        static_cast<GLsizei>(attribute_info.GetTypeSize()));
-
     glEnableVertexArrayAttrib(vertex_array, location);
   }
 }
@@ -24,18 +24,33 @@ class Shape : public Drawable {
 
   // The vertices arrive as one span rather than as a pointer beside a count,
   // so the two cannot disagree at a call site. The attribute is addressed by
-  // the name it carries in the shader, the way SetUniform addresses a uniform:
-  // the layout comes out of the linked program, and a position in that list
-  // shifts as soon as the driver drops an attribute the shader never reads.
+  // the name it carries in the shader: the layout comes out of the linked
+  // program, and a position in that list shifts as soon as the driver drops an
+  // attribute the shader never reads.
+  //
+  // The bytes go straight into mapped memory (PersistentVertexBuffer); no
+  // upload call reaches the driver, and storage gets allocated only when a set
+  // outgrows everything this shape held before.
   template <typename Vertex>
   void SetBuffer(std::string_view attribute_name,
                  std::span<const Vertex> vertices) {
     const std::size_t index = BufferIndexFor(attribute_name, sizeof(Vertex));
     number_vertices_ = static_cast<GLsizei>(vertices.size());
+    WriteBuffer(index, std::as_bytes(vertices));
+  }
 
-    glNamedBufferData(vbos_[index].Name(),
-                      static_cast<GLsizeiptr>(vertices.size_bytes()),
-                      vertices.data(), GL_DYNAMIC_DRAW);
+  // Overwrites `vertices.size()` vertices of one attribute from `first` on and
+  // leaves the rest of the buffer — and every other attribute — alone. The
+  // path of the interactive highlights: a hover recolours one rectangle of a
+  // shape by sending its few bytes instead of rebuilding the shape. A range
+  // past the end of what SetBuffer wrote throws, where the write would land in
+  // memory no draw reads.
+  template <typename Vertex>
+  void PatchBuffer(std::string_view attribute_name, std::size_t first,
+                   std::span<const Vertex> vertices) {
+    const std::size_t index = BufferIndexFor(attribute_name, sizeof(Vertex));
+    PatchBufferBytes(attribute_name, index, first * sizeof(Vertex),
+                     std::as_bytes(vertices));
   }
 
   // Draws nothing until the next SetShape refills the geometry. Says what a
@@ -49,12 +64,23 @@ class Shape : public Drawable {
   // queries (the scene-tree selection highlight) without exposing the buffers.
   [[nodiscard]] const RectF& LocalBounds() const override;
 
+  // How many attribute writes SetBuffer has made; PatchBuffer makes none. A
+  // rebuild that left the shape standing leaves the count where it was.
+  [[nodiscard]] std::size_t BufferWrites() const;
+
  protected:
+  // What the last SetBuffer held: vertices, or instance records after
+  // UsePerInstanceAttributes.
   [[nodiscard]] GLsizei VertexCount() const;
   [[nodiscard]] Shader& GetShader() const;
   [[nodiscard]] const VertexArrayObject& VaoRef() const;
   void SetLocalBounds(const RectF& bounds);
 
+  // Advances every attribute once per instance rather than once per vertex: the
+  // buffers then hold one record per instance, and the vertex shader makes the
+  // geometry out of gl_VertexID. Such a shape draws itself instanced.
+  void UsePerInstanceAttributes();
+
  private:
   // The buffer feeding `attribute_name`, with the vertex type checked against
   // what the shader declares. Both failures throw and name the shader: an
@@ -63,14 +89,22 @@ class Shape : public Drawable {
   [[nodiscard]] std::size_t BufferIndexFor(std::string_view attribute_name,
                                            std::size_t vertex_size) const;
 
+  // Writes the attribute's buffer and points the vertex array at the region
+  // the bytes landed in.
+  void WriteBuffer(std::size_t index, std::span<const std::byte> bytes);
+
+  void PatchBufferBytes(std::string_view attribute_name, std::size_t index,
+                        std::size_t offset, std::span<const std::byte> bytes);
+
   void SetUpBuffers();
 
   Shader& shader_;
   GLsizei number_vertices_{0};
   VertexArrayObject vao_;
-  std::vector<VertexBufferObject> vbos_;
+  std::vector<PersistentVertexBuffer> buffers_;
   std::vector<ShaderInfo> attributes_infos_;
   RectF local_bounds_;
+  std::size_t buffer_writes_{0};
 };
 
 #endif  // SHAPES_BASE_HPP
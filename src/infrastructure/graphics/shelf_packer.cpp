@@ -0,0 +1,53 @@
+#include "shelf_packer.hpp"
+
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+ShelfPacker::ShelfPacker(int width, int height)
+    : width_(width), height_(height) {}
+
+std::optional<ShelfPacker::Slot> ShelfPacker::Insert(int width, int height) {
+  if (width > width_) {
+    throw std::invalid_argument("ShelfPacker: rectangle of width " +
+                                std::to_string(width) +
+                                " exceeds the area width " +
+                                std::to_string(width_));
+  }
+
+  for (Shelf& shelf : shelves_) {
+    const bool fits = height <= shelf.height &&
+                      static_cast<float>(height) >=
+                          static_cast<float>(shelf.height) * kMaxWaste &&
+                      shelf.used_width + width <= width_;
+    if (fits) {
+      const Slot slot{.x = shelf.used_width, .y = shelf.y};
+      shelf.used_width += width;
+      return slot;
+    }
+  }
+
+  const int top = UsedHeight();
+  if (top + height > height_) {
+    return std::nullopt;
+  }
+  shelves_.push_back({.y = top, .height = height, .used_width = width});
+  return Slot{.x = 0, .y = top};
+}
+
+void ShelfPacker::Grow(int height) {
+  if (height > height_) {
+    height_ = height;
+  }
+}
+
+int ShelfPacker::Width() const { return width_; }
+
+int ShelfPacker::Height() const { return height_; }
+
+int ShelfPacker::UsedHeight() const {
+  if (shelves_.empty()) {
+    return 0;
+  }
+  return shelves_.back().y + shelves_.back().height;
+}
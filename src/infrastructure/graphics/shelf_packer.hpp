@@ -0,0 +1,60 @@
+#ifndef SHELF_PACKER_HPP
+#define SHELF_PACKER_HPP
+
+#include <optional>
+#include <vector>
+
+// Places rectangles into a fixed-width area that only grows in height — the
+// bookkeeping behind the glyph atlas, kept apart from GL so it can be tested.
+//
+// Shelf packing: the area is cut into horizontal shelves stacked bottom-up
+// (in texel rows), each as tall as the first rectangle that opened it. A
+// rectangle goes onto the lowest shelf that has width left and is at least as
+// tall, but not more than kMaxWaste taller, so short glyphs (dots, commas) do
+// not claim the tall shelves of capitals; failing that it opens a shelf of its
+// own above the last. Glyphs of one font at one pixel size vary little in
+// height, which is what makes this simple scheme pack well.
+//
+// When no shelf takes a rectangle and no room is left above them, Insert
+// answers nullopt and the owner grows the area (Grow) and asks again. Placed
+// rectangles never move, so growing keeps every earlier answer valid.
+class ShelfPacker {
+ public:
+  struct Slot {
+    int x;
+    int y;
+  };
+
+  // A shelf takes rectangles down to this fraction of its own height.
+  static constexpr float kMaxWaste = 0.7F;
+
+  ShelfPacker(int width, int height);
+
+  // Reserves a `width` x `height` rectangle and returns its lower-left texel,
+  // or nullopt when the area is full. Throws std::invalid_argument for a
+  // rectangle wider than the area, which no growth could ever take.
+  [[nodiscard]] std::optional<Slot> Insert(int width, int height);
+
+  // Extends the area upwards to `height`; smaller values are ignored.
+  void Grow(int height);
+
+  [[nodiscard]] int Width() const;
+
+  [[nodiscard]] int Height() const;
+
+  // The rows taken by shelves so far.
+  [[nodiscard]] int UsedHeight() const;
+
+ private:
+  struct Shelf {
+    int y;
+    int height;
+    int used_width;
+  };
+
+  int width_;
+  int height_;
+  std::vector<Shelf> shelves_;
+};
+
+#endif  // SHELF_PACKER_HPP
@@ -0,0 +1,142 @@
+#include "software_page.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <glm/ext/vector_float2.hpp>
+#include <glm/ext/vector_float3.hpp>
+#include <glm/ext/vector_float4.hpp>
+#include <iostream>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "../../common/debug_log.hpp"
+#include "font.hpp"
+#include "glyph_atlas.hpp"
+#include "rect.hpp"
+#include "scene.hpp"
+#include "scene_walk.hpp"
+#include "shapes.hpp"
+#include "software_raster.hpp"
+
+namespace software_page {
+namespace {
+
+using software_raster::DistanceField;
+using software_raster::PixelBox;
+using software_raster::Primitive;
+
+// Of a glyph's six vertices (text_layout::Shape), the one at the quad's bottom
+// left and the one at its top right.
+constexpr std::size_t kBottomLeftVertex = 1;
+constexpr std::size_t kTopRightVertex = 5;
+
+// The scene's draw calls as software_raster primitives in image pixels.
+class PrimitiveList : public scene_walk::Painter {
+ public:
+  explicit PrimitiveList(const scene_walk::Mapping& mapping)
+      : mapping_(mapping) {}
+
+  void Rectangle(const scene_walk::TargetBox& box,
+                 const glm::vec4& color) override {
+    primitives_.push_back(software_raster::Rectangle(ToPixels(box), color));
+  }
+
+  void Frame(const scene_walk::TargetBox& outer,
+             const scene_walk::TargetBox& inner,
+             const glm::vec4& color) override {
+    primitives_.push_back(
+        software_raster::Frame(ToPixels(outer), ToPixels(inner), color));
+  }
+
+  // One glyph per quad, sampling the CPU copy of the font's atlas.
+  void Text(const scene_walk::TextDraw& text) override {
+    const DistanceField& field = FieldOf(text.font);
+    const std::span<const glm::vec3> positions = text.positions;
+    for (std::size_t base = 0; base + kVerticesPerQuad <= positions.size();
+         base += kVerticesPerQuad) {
+      const glm::vec3& bottom_left = positions[base + kBottomLeftVertex];
+      const glm::vec3& top_right = positions[base + kTopRightVertex];
+      const PixelBox quad = ToPixels(mapping_.ToTarget(
+          text.world, glm::vec4(bottom_left.x, top_right.x, bottom_left.y,
+                                top_right.y)));
+      // Blank glyphs, the space among them, have a quad of no size.
+      if (!(quad.right > quad.left) || !(quad.bottom > quad.top)) {
+        continue;
+      }
+      const glm::vec4 color =
+          text.colors.empty()
+              ? text.tint
+              : text.tint * text.colors[base + kBottomLeftVertex];
+      if (color.a <= 0.0F) {
+        continue;
+      }
+      const glm::vec2& texel_bottom_left =
+          text.texels[base + kBottomLeftVertex];
+      const glm::vec2& texel_top_right = text.texels[base + kTopRightVertex];
+      primitives_.push_back(software_raster::Glyph(
+          quad,
+          glm::vec4(texel_bottom_left.x, texel_top_right.y,
+                    texel_top_right.x, texel_bottom_left.y),
+          field, color));
+    }
+  }
+
+  [[nodiscard]] std::span<const Primitive> Primitives() const {
+    return primitives_;
+  }
+
+ private:
+  [[nodiscard]] static PixelBox ToPixels(const scene_walk::TargetBox& box) {
+    return {.left = box.left,
+            .top = box.top,
+            .right = box.right,
+            .bottom = box.bottom};
+  }
+
+  // The atlas of `font` as a field, made once per font and kept in a
+  // node-based map, so the primitives can point at it.
+  const DistanceField& FieldOf(const Font& font) {
+    const auto found = fields_.find(&font);
+    if (found != fields_.end()) {
+      return found->second;
+    }
+    const GlyphAtlas& atlas = font.Atlas();
+    return fields_
+        .emplace(&font, DistanceField{.texels = atlas.Texels(),
+                                      .width = GlyphAtlas::kWidth,
+                                      .height = atlas.Height()})
+        .first->second;
+  }
+
+  scene_walk::Mapping mapping_;
+  std::vector<Primitive> primitives_;
+  std::unordered_map<const Font*, DistanceField> fields_;
+};
+
+}  // namespace
+
+bool RenderScene(Scene& scene, const RectF& ortho_region, std::size_t width,
+                 std::size_t height, const glm::vec4& background,
+                 const software_raster::BandSink& sink) {
+  const auto started = std::chrono::steady_clock::now();
+  const scene_walk::Mapping mapping(ortho_region, static_cast<float>(width),
+                                    static_cast<float>(height));
+  PrimitiveList primitives(mapping);
+  scene_walk::Walk(scene, mapping, primitives);
+
+  const bool rendered =
+      software_raster::RenderImage(primitives.Primitives(), background, width,
+                                   height, kBandRows, sink);
+  if (decade_debug::LogEnabled()) {
+    std::cout << "--dump-png: " << primitives.Primitives().size()
+              << " primitives rasterized and encoded on the CPU in "
+              << std::chrono::duration<double, std::milli>(
+                     std::chrono::steady_clock::now() - started)
+                     .count()
+              << " ms\n";
+  }
+  return rendered;
+}
+
+}  // namespace software_page
@@ -0,0 +1,36 @@
+#ifndef SOFTWARE_PAGE_HPP
+#define SOFTWARE_PAGE_HPP
+
+#include <cstddef>
+#include <glm/vec4.hpp>
+
+#include "rect.hpp"
+#include "scene.hpp"
+#include "software_raster.hpp"
+
+// The page export on the CPU: the scene, as GraphicsEngine would draw it,
+// handed to software_raster instead of to GL.
+//
+// scene_walk breaks the scene into the rectangles and frames its shaders
+// would draw, in the order they draw them; text becomes one glyph per quad,
+// sampling the CPU copy of its font's atlas.
+//
+// Reading the shapes needs no GL call, but the shapes themselves were built
+// in a context — the scene has to stand, as for the GL export.
+namespace software_page {
+
+// Rows a band holds: small enough that every core gets bands of a page, large
+// enough that a band's pass over the primitives is worth it.
+inline constexpr std::size_t kBandRows = 64;
+
+// Paints `scene` over `background`, with `ortho_region` spread across a
+// `width` x `height` image, and hands it to `sink` band by band, top first.
+// False when the sink turned a band down.
+[[nodiscard]] bool RenderScene(Scene& scene, const RectF& ortho_region,
+                               std::size_t width, std::size_t height,
+                               const glm::vec4& background,
+                               const software_raster::BandSink& sink);
+
+}  // namespace software_page
+
+#endif  // SOFTWARE_PAGE_HPP
@@ -0,0 +1,327 @@
+#include "software_raster.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <glm/ext/vector_float3.hpp>
+#include <glm/ext/vector_float4.hpp>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace software_raster {
+namespace {
+
+constexpr std::size_t kBytesPerPixel = 4;
+constexpr float kHalf = 0.5F;
+constexpr float kChannelMax = 255.0F;
+// The font shader's floor under fwidth, against a division by zero where the
+// field is flat.
+constexpr float kMinimumPixelDistance = 1.0e-5F;
+
+// The band a RasterizeRows call paints: `rows` rows of `width` pixels from
+// image row `first_row` on, as straight-alpha colours.
+struct Band {
+  std::span<glm::vec4> pixels;
+  std::size_t width;
+  std::size_t first_row;
+  std::size_t rows;
+
+  [[nodiscard]] glm::vec4& At(std::size_t column, std::size_t row) const {
+    return pixels[((row - first_row) * width) + column];
+  }
+};
+
+// Pixel indices [begin, end) within [first, last).
+struct PixelRange {
+  std::size_t begin;
+  std::size_t end;
+};
+
+// The pixels the span [low, high) touches at all.
+PixelRange TouchedPixels(float low, float high, std::size_t first,
+                         std::size_t last) {
+  const float begin = std::max(std::floor(low), static_cast<float>(first));
+  const float end = std::min(std::ceil(high), static_cast<float>(last));
+  // Also false for NaN edges.
+  if (!(begin < end)) {
+    return {.begin = first, .end = first};
+  }
+  return {.begin = static_cast<std::size_t>(begin),
+          .end = static_cast<std::size_t>(end)};
+}
+
+// The pixels whose centre lies in [low, high) — what GL rasterizes of a
+// triangle edge without multisampling.
+PixelRange CentredPixels(float low, float high, std::size_t first,
+                         std::size_t last) {
+  return TouchedPixels(std::ceil(low - kHalf), std::ceil(high - kHalf), first,
+                       last);
+}
+
+// GL's blend as the renderer sets it: the colour by source alpha, the alpha
+// by one and one minus source alpha.
+void Blend(glm::vec4& pixel, const glm::vec4& color, float coverage) {
+  const float alpha = color.a * coverage;
+  const float rest = 1.0F - alpha;
+  pixel = glm::vec4((glm::vec3(color) * alpha) + (glm::vec3(pixel) * rest),
+                    alpha + (pixel.a * rest));
+}
+
+float BoxCoverage(const PixelBox& box, std::size_t column, std::size_t row) {
+  return Overlap(box.left, box.right, static_cast<float>(column)) *
+         Overlap(box.top, box.bottom, static_cast<float>(row));
+}
+
+void PaintRectangle(const Band& band, const Primitive& rectangle) {
+  const PixelBox& box = rectangle.box;
+  const PixelRange columns =
+      TouchedPixels(box.left, box.right, 0, band.width);
+  const PixelRange rows = TouchedPixels(box.top, box.bottom, band.first_row,
+                                        band.first_row + band.rows);
+  for (std::size_t row = rows.begin; row < rows.end; ++row) {
+    for (std::size_t column = columns.begin; column < columns.end; ++column) {
+      Blend(band.At(column, row), rectangle.color,
+            BoxCoverage(box, column, row));
+    }
+  }
+}
+
+void PaintFrame(const Band& band, const Primitive& frame) {
+  const PixelBox& box = frame.box;
+  const PixelRange columns =
+      TouchedPixels(box.left, box.right, 0, band.width);
+  const PixelRange rows = TouchedPixels(box.top, box.bottom, band.first_row,
+                                        band.first_row + band.rows);
+  for (std::size_t row = rows.begin; row < rows.end; ++row) {
+    for (std::size_t column = columns.begin; column < columns.end; ++column) {
+      // The hole lies within the frame, so what it covers of the pixel is
+      // part of what the outer edge covers.
+      const float coverage = BoxCoverage(box, column, row) -
+                             BoxCoverage(frame.hole, column, row);
+      if (coverage > 0.0F) {
+        Blend(band.At(column, row), frame.color, coverage);
+      }
+    }
+  }
+}
+
+void PaintGlyph(const Band& band, const Primitive& glyph) {
+  const PixelBox& quad = glyph.box;
+  const float quad_width = quad.right - quad.left;
+  const float quad_height = quad.bottom - quad.top;
+  if (glyph.field == nullptr || !(quad_width > 0.0F) ||
+      !(quad_height > 0.0F)) {
+    return;
+  }
+  // Texels per pixel, which is also the step to the neighbouring pixel's
+  // sample.
+  const float step_u = (glyph.texels.z - glyph.texels.x) / quad_width;
+  const float step_v = (glyph.texels.w - glyph.texels.y) / quad_height;
+  const auto distance = [&glyph](float u, float v) {
+    return SampleField(*glyph.field, u, v) - kHalf;
+  };
+
+  const PixelRange columns =
+      CentredPixels(quad.left, quad.right, 0, band.width);
+  const PixelRange rows = CentredPixels(quad.top, quad.bottom, band.first_row,
+                                        band.first_row + band.rows);
+  for (std::size_t row = rows.begin; row < rows.end; ++row) {
+    const float v = glyph.texels.y +
+                    ((static_cast<float>(row) + kHalf - quad.top) * step_v);
+    for (std::size_t column = columns.begin; column < columns.end; ++column) {
+      const float u =
+          glyph.texels.x +
+          ((static_cast<float>(column) + kHalf - quad.left) * step_u);
+      const float here = distance(u, v);
+      const float pixel =
+          std::max(std::abs(distance(u + step_u, v) - here) +
+                       std::abs(distance(u, v + step_v) - here),
+                   kMinimumPixelDistance);
+      const float coverage = std::clamp((here / pixel) + kHalf, 0.0F, 1.0F);
+      if (coverage > 0.0F) {
+        Blend(band.At(column, row), glyph.color, coverage);
+      }
+    }
+  }
+}
+
+unsigned char ToChannel(float value) {
+  return static_cast<unsigned char>(
+      std::lround(std::clamp(value, 0.0F, 1.0F) * kChannelMax));
+}
+
+unsigned WorkerCount() {
+  return std::max(1U, std::thread::hardware_concurrency());
+}
+
+}  // namespace
+
+std::optional<PageRenderer> PageRendererFromName(std::string_view name) {
+  constexpr std::array<std::pair<std::string_view, PageRenderer>, 2> kNames{{
+      {"gl", PageRenderer::kGl},
+      {"cpu", PageRenderer::kCpu},
+  }};
+  const auto* const found = std::ranges::find(
+      kNames, name, &std::pair<std::string_view, PageRenderer>::first);
+  if (found == kNames.end()) {
+    return std::nullopt;
+  }
+  return found->second;
+}
+
+Primitive Rectangle(const PixelBox& box, const glm::vec4& color) {
+  return {.kind = PrimitiveKind::kRectangle, .box = box, .color = color};
+}
+
+Primitive Frame(const PixelBox& outer, const PixelBox& inner,
+                const glm::vec4& color) {
+  return {.kind = PrimitiveKind::kFrame,
+          .box = outer,
+          .hole = inner,
+          .color = color};
+}
+
+Primitive Glyph(const PixelBox& quad, const glm::vec4& texels,
+                const DistanceField& field, const glm::vec4& color) {
+  return {.kind = PrimitiveKind::kGlyph,
+          .box = quad,
+          .texels = texels,
+          .color = color,
+          .field = &field};
+}
+
+float Overlap(float low, float high, float pixel) {
+  return std::clamp(std::min(high, pixel + 1.0F) - std::max(low, pixel), 0.0F,
+                    1.0F);
+}
+
+float SampleField(const DistanceField& field, float u, float v) {
+  if (field.width <= 0 || field.height <= 0) {
+    return 0.0F;
+  }
+  const float x = u - kHalf;
+  const float y = v - kHalf;
+  const float left = std::floor(x);
+  const float top = std::floor(y);
+  const float along_x = x - left;
+  const float along_y = y - top;
+  // Clamped as floats first: the cast of a value out of int's range is
+  // undefined.
+  const auto clamped = [](float value, int size) {
+    return static_cast<int>(
+        std::clamp(value, 0.0F, static_cast<float>(size - 1)));
+  };
+  const int x0 = clamped(left, field.width);
+  const int x1 = clamped(left + 1.0F, field.width);
+  const int y0 = clamped(top, field.height);
+  const int y1 = clamped(top + 1.0F, field.height);
+  const auto texel = [&field](int column, int row) {
+    return static_cast<float>(
+               field.texels[(static_cast<std::size_t>(row) *
+                             static_cast<std::size_t>(field.width)) +
+                            static_cast<std::size_t>(column)]) /
+           kChannelMax;
+  };
+  const float upper =
+      texel(x0, y0) + ((texel(x1, y0) - texel(x0, y0)) * along_x);
+  const float lower =
+      texel(x0, y1) + ((texel(x1, y1) - texel(x0, y1)) * along_x);
+  return upper + ((lower - upper) * along_y);
+}
+
+void RasterizeRows(std::span<const Primitive> primitives,
+                   const glm::vec4& background, std::size_t width,
+                   std::size_t first_row, std::span<unsigned char*> rows) {
+  std::vector<glm::vec4> pixels(width * rows.size(), background);
+  const Band band{.pixels = pixels,
+                  .width = width,
+                  .first_row = first_row,
+                  .rows = rows.size()};
+  const auto band_top = static_cast<float>(first_row);
+  const auto band_bottom = static_cast<float>(first_row + rows.size());
+
+  for (const Primitive& primitive : primitives) {
+    if (primitive.box.bottom <= band_top || primitive.box.top >= band_bottom) {
+      continue;
+    }
+    switch (primitive.kind) {
+      case PrimitiveKind::kRectangle:
+        PaintRectangle(band, primitive);
+        break;
+      case PrimitiveKind::kFrame:
+        PaintFrame(band, primitive);
+        break;
+      case PrimitiveKind::kGlyph:
+        PaintGlyph(band, primitive);
+        break;
+    }
+  }
+
+  for (std::size_t row = 0; row < rows.size(); ++row) {
+    unsigned char* bytes = rows[row];
+    for (std::size_t column = 0; column < width; ++column) {
+      const glm::vec4& pixel = pixels[(row * width) + column];
+      unsigned char* out = bytes + (column * kBytesPerPixel);
+      out[0] = ToChannel(pixel.r);
+      out[1] = ToChannel(pixel.g);
+      out[2] = ToChannel(pixel.b);
+      out[3] = ToChannel(pixel.a);
+    }
+  }
+}
+
+bool RenderImage(std::span<const Primitive> primitives,
+                 const glm::vec4& background, std::size_t width,
+                 std::size_t height, std::size_t band_rows,
+                 const BandSink& sink) {
+  const std::size_t rows_per_band = std::max<std::size_t>(1, band_rows);
+  const std::size_t band_count = (height + rows_per_band - 1) / rows_per_band;
+  const std::size_t workers = std::min<std::size_t>(
+      WorkerCount(), std::max<std::size_t>(1, band_count));
+  const std::size_t row_bytes = width * kBytesPerPixel;
+
+  std::vector<std::vector<unsigned char>> buffers(
+      workers, std::vector<unsigned char>(row_bytes * rows_per_band));
+  std::vector<std::vector<unsigned char*>> band_pointers(workers);
+
+  // A round rasterizes one band per worker; the bands then go to the sink in
+  // order while nothing writes them.
+  for (std::size_t first_band = 0; first_band < band_count;
+       first_band += workers) {
+    const std::size_t round = std::min(workers, band_count - first_band);
+    std::vector<std::future<void>> rasterized;
+    rasterized.reserve(round);
+    for (std::size_t slot = 0; slot < round; ++slot) {
+      const std::size_t first_row = (first_band + slot) * rows_per_band;
+      const std::size_t rows = std::min(rows_per_band, height - first_row);
+      std::vector<unsigned char*>& pointers = band_pointers[slot];
+      pointers.resize(rows);
+      for (std::size_t row = 0; row < rows; ++row) {
+        pointers[row] = &buffers[slot][row * row_bytes];
+      }
+      rasterized.push_back(std::async(
+          std::launch::async, [&primitives, &background, &pointers, width,
+                               first_row] {
+            RasterizeRows(primitives, background, width, first_row, pointers);
+          }));
+    }
+    for (std::future<void>& band : rasterized) {
+      band.get();
+    }
+    for (std::size_t slot = 0; slot < round; ++slot) {
+      if (!sink(band_pointers[slot])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace software_raster
@@ -0,0 +1,120 @@
+#ifndef SOFTWARE_RASTER_HPP
+#define SOFTWARE_RASTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <glm/vec4.hpp>
+#include <optional>
+#include <span>
+#include <string_view>
+
+// A rasterizer on the CPU for what the calendar draws: axis-aligned rectangles
+// and distance-field glyphs. It paints the page image of an export without an
+// OpenGL driver underneath; in a container that driver is llvmpipe, which runs
+// the whole GL pipeline in software to draw the same rectangles and glyphs.
+//
+// The scene reaches it as a flat list of primitives in painter's order, in
+// image pixels (software_page.hpp makes that list). It does what the GL path
+// does, in the same order and with the same blend function, but computes the
+// anti-aliasing where the GL path samples it:
+//
+// - A rectangle covers each pixel by the area it overlaps, which for an
+//   axis-aligned box is the product of its overlap along x and along y — the
+//   value an MSAA resolve approaches with more and more samples.
+// - A frame — a box's outline, the four mitred strips together — is the
+//   outer rectangle less the inner one, which it covers exactly.
+// - A glyph samples its distance field as the font shader does: bilinear, the
+//   field's 0.5 on the outline, ramped over one pixel by the field's change
+//   to the neighbouring pixels (the shader's fwidth).
+//
+// The image is rasterized in bands of rows, a band per worker at a time; each
+// band paints every primitive that reaches into it. Nothing is shared between
+// bands but the primitives, which nobody writes while the bands run.
+namespace software_raster {
+
+// Which rasterizer draws an exported page: the GL pipeline the window draws
+// with, or this one.
+enum class PageRenderer : std::uint8_t {
+  kGl,
+  kCpu,
+};
+
+// "gl" or "cpu"; nullopt otherwise.
+[[nodiscard]] std::optional<PageRenderer> PageRendererFromName(
+    std::string_view name);
+
+// An area in image pixels: x to the right, y down from the image's top edge,
+// the pixel (i, j) spanning [i, i + 1) x [j, j + 1). The edges are fractional.
+struct PixelBox {
+  float left;
+  float top;
+  float right;
+  float bottom;
+};
+
+// An 8-bit distance field, `width` x `height` texels, rows `width` apart —
+// the CPU copy of a font's glyph atlas (GlyphAtlas::Texels).
+struct DistanceField {
+  std::span<const std::uint8_t> texels;
+  int width;
+  int height;
+};
+
+enum class PrimitiveKind : std::uint8_t {
+  kRectangle,
+  kFrame,
+  kGlyph,
+};
+
+// One thing to paint, in straight (not premultiplied) `color`. `box` is the
+// rectangle, the frame's outer edge or the glyph's quad; `hole` the frame's
+// inner edge. A glyph's `texels` are the atlas texel coordinates at the
+// quad's left, top, right and bottom edge, read from `field`.
+struct Primitive {
+  PrimitiveKind kind{PrimitiveKind::kRectangle};
+  PixelBox box{};
+  PixelBox hole{};
+  glm::vec4 texels{0.0F};
+  glm::vec4 color{0.0F};
+  const DistanceField* field{nullptr};
+};
+
+[[nodiscard]] Primitive Rectangle(const PixelBox& box, const glm::vec4& color);
+
+[[nodiscard]] Primitive Frame(const PixelBox& outer, const PixelBox& inner,
+                              const glm::vec4& color);
+
+[[nodiscard]] Primitive Glyph(const PixelBox& quad, const glm::vec4& texels,
+                              const DistanceField& field,
+                              const glm::vec4& color);
+
+// The fraction of the pixel span [pixel, pixel + 1) that [low, high) covers.
+[[nodiscard]] float Overlap(float low, float high, float pixel);
+
+// The field at texel position (`u`, `v`), filtered as GL_LINEAR with
+// GL_CLAMP_TO_EDGE filters it: texel centres at half-integers. 0 to 1.
+[[nodiscard]] float SampleField(const DistanceField& field, float u, float v);
+
+// Paints `primitives` in order over `background` into the image rows
+// `first_row` onwards, one row per entry of `rows`, each `width` RGBA8 pixels.
+void RasterizeRows(std::span<const Primitive> primitives,
+                   const glm::vec4& background, std::size_t width,
+                   std::size_t first_row, std::span<unsigned char*> rows);
+
+// Takes one band's rows, top row first, each `width` RGBA pixels; valid only
+// during the call. Answering false stops the render. Called on the thread
+// that called RenderImage, one band after the other.
+using BandSink = std::function<bool(std::span<unsigned char*> rows)>;
+
+// Rasterizes a `width` x `height` image band by band on every core and hands
+// the bands to `sink` top to bottom. Peak memory is one band of `band_rows`
+// rows per worker. False when the sink turned a band down.
+[[nodiscard]] bool RenderImage(std::span<const Primitive> primitives,
+                               const glm::vec4& background, std::size_t width,
+                               std::size_t height, std::size_t band_rows,
+                               const BandSink& sink);
+
+}  // namespace software_raster
+
+#endif  // SOFTWARE_RASTER_HPP
@@ -0,0 +1,131 @@
+#include "spatial_grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "rect.hpp"
+
+namespace {
+
+bool Touches(const RectF& lhs, const RectF& rhs) {
+  return lhs.Left() <= rhs.Right() && rhs.Left() <= lhs.Right() &&
+         lhs.Bottom() <= rhs.Top() && rhs.Bottom() <= lhs.Top();
+}
+
+// The cell along one axis `value` falls into, clamped to [0, count).
+int CellIndex(float value, float origin, float cell_size, int count) {
+  if (cell_size <= 0.0F) {
+    return 0;
+  }
+  const auto index =
+      static_cast<int>(std::floor((value - origin) / cell_size));
+  return std::clamp(index, 0, count - 1);
+}
+
+}  // namespace
+
+SpatialGrid::SpatialGrid(std::span<const RectF> bounds)
+    : bounds_(bounds.begin(), bounds.end()) {
+  if (bounds_.empty()) {
+    return;
+  }
+
+  float left = bounds_.front().Left();
+  float right = bounds_.front().Right();
+  float bottom = bounds_.front().Bottom();
+  float top = bounds_.front().Top();
+  for (const RectF& box : bounds_) {
+    left = std::min(left, box.Left());
+    right = std::max(right, box.Right());
+    bottom = std::min(bottom, box.Bottom());
+    top = std::max(top, box.Top());
+  }
+  extent_ = RectF(left, right, bottom, top);
+
+  const auto per_axis = static_cast<int>(
+      std::ceil(std::sqrt(static_cast<double>(bounds_.size()))));
+  columns_ = std::clamp(per_axis, 1, kMaxCellsPerAxis);
+  rows_ = columns_;
+  cell_width_ = extent_.Width() / static_cast<float>(columns_);
+  cell_height_ = extent_.Height() / static_cast<float>(rows_);
+
+  // Two passes over the boxes: count what each cell receives, then file the
+  // ids at the offsets the counts give.
+  const auto cell_count = static_cast<std::size_t>(columns_ * rows_);
+  cell_starts_.assign(cell_count + 1, 0);
+  for (const RectF& box : bounds_) {
+    const CellRange range = CellsCovering(box);
+    for (int row = range.first_row; row <= range.last_row; ++row) {
+      for (int column = range.first_column; column <= range.last_column;
+           ++column) {
+        ++cell_starts_[static_cast<std::size_t>((row * columns_) + column) +
+                       1];
+      }
+    }
+  }
+  for (std::size_t cell = 0; cell < cell_count; ++cell) {
+    cell_starts_[cell + 1] += cell_starts_[cell];
+  }
+
+  cell_ids_.resize(cell_starts_.back());
+  std::vector<std::size_t> fill(cell_starts_.begin(), cell_starts_.end() - 1);
+  for (std::size_t id = 0; id < bounds_.size(); ++id) {
+    const CellRange range = CellsCovering(bounds_[id]);
+    for (int row = range.first_row; row <= range.last_row; ++row) {
+      for (int column = range.first_column; column <= range.last_column;
+           ++column) {
+        const auto cell = static_cast<std::size_t>((row * columns_) + column);
+        cell_ids_[fill[cell]++] = id;
+      }
+    }
+  }
+}
+
+void SpatialGrid::Query(const RectF& region,
+                        std::vector<std::size_t>& hits) const {
+  hits.clear();
+  if (bounds_.empty()) {
+    return;
+  }
+
+  const CellRange range = CellsCovering(region);
+  for (int row = range.first_row; row <= range.last_row; ++row) {
+    for (int column = range.first_column; column <= range.last_column;
+         ++column) {
+      const auto cell = static_cast<std::size_t>((row * columns_) + column);
+      for (std::size_t slot = cell_starts_[cell];
+           slot < cell_starts_[cell + 1]; ++slot) {
+        const std::size_t id = cell_ids_[slot];
+        if (Touches(bounds_[id], region)) {
+          hits.push_back(id);
+        }
+      }
+    }
+  }
+
+  // A box spanning several cells was met once per cell.
+  std::ranges::sort(hits);
+  const auto duplicates = std::ranges::unique(hits);
+  hits.erase(duplicates.begin(), duplicates.end());
+}
+
+std::size_t SpatialGrid::Size() const { return bounds_.size(); }
+
+SpatialGrid::CellRange SpatialGrid::CellsCovering(const RectF& box) const {
+  if (!Touches(box, extent_)) {
+    return {.first_column = 0, .last_column = -1, .first_row = 0,
+            .last_row = -1};
+  }
+  return {
+      .first_column =
+          CellIndex(box.Left(), extent_.Left(), cell_width_, columns_),
+      .last_column =
+          CellIndex(box.Right(), extent_.Left(), cell_width_, columns_),
+      .first_row = CellIndex(box.Bottom(), extent_.Bottom(), cell_height_,
+                             rows_),
+      .last_row = CellIndex(box.Top(), extent_.Bottom(), cell_height_, rows_),
+  };
+}
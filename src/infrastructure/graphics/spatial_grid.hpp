@@ -0,0 +1,64 @@
+#ifndef SPATIAL_GRID_HPP
+#define SPATIAL_GRID_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "rect.hpp"
+
+// A uniform grid over a fixed set of boxes, answering "which of them touch
+// this region" without looking at every one. Scene builds one per draw layer
+// whenever the graph is rebuilt, and asks it once a frame for the boxes the
+// view overlaps: zoomed into one month, the query walks the few cells under
+// the view instead of the whole page.
+//
+// The grid spans the union of the boxes and has about sqrt(n) cells a side
+// (never more than kMaxCellsPerAxis), so a cell holds a handful of boxes when
+// they are spread over the page, as the calendar's are. A box is filed under
+// every cell it covers; the page background lands in all of them, which is the
+// price of keeping the structure flat.
+//
+// The ids are the boxes' positions in the span given to the constructor, and
+// a query hands them back ascending — for Scene, that is painter's order
+// within the layer. Edges count as touching: a box that merely borders the
+// region is reported.
+class SpatialGrid {
+ public:
+  static constexpr int kMaxCellsPerAxis = 64;
+
+  SpatialGrid() = default;
+
+  explicit SpatialGrid(std::span<const RectF> bounds);
+
+  // Replaces `hits` with the ids of every box that touches `region`,
+  // ascending and each once.
+  void Query(const RectF& region, std::vector<std::size_t>& hits) const;
+
+  [[nodiscard]] std::size_t Size() const;
+
+ private:
+  struct CellRange {
+    int first_column;
+    int last_column;
+    int first_row;
+    int last_row;
+  };
+
+  // The cells `box` covers, clamped to the grid. Empty (first > last) when the
+  // box lies wholly outside it.
+  [[nodiscard]] CellRange CellsCovering(const RectF& box) const;
+
+  std::vector<RectF> bounds_;
+  RectF extent_;
+  int columns_{0};
+  int rows_{0};
+  float cell_width_{0.0F};
+  float cell_height_{0.0F};
+  // The cells' id lists back to back, row-major: cell c holds the ids from
+  // cell_ids_[cell_starts_[c]] up to cell_ids_[cell_starts_[c + 1]].
+  std::vector<std::size_t> cell_starts_;
+  std::vector<std::size_t> cell_ids_;
+};
+
+#endif  // SPATIAL_GRID_HPP
@@ -0,0 +1,110 @@
+#include "text_batch.hpp"
+
+#include <epoxy/gl.h>
+
+#include <glm/ext/matrix_float4x4.hpp>
+#include <glm/ext/vector_float2.hpp>
+#include <glm/ext/vector_float3.hpp>
+#include <glm/ext/vector_float4.hpp>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+
+#include "drawable.hpp"
+#include "font.hpp"
+#include "frame_uniforms.hpp"
+#include "rect.hpp"
+#include "shaders.hpp"
+#include "shapes_base.hpp"
+#include "text_layout.hpp"
+#include "vertex_objects.hpp"
+
+void TextLabel::Draw(const glm::mat4& /*model*/) const {}
+
+const RectF& TextLabel::LocalBounds() const { return run_.bounds; }
+
+DrawableKind TextLabel::Kind() const { return DrawableKind::kTextLabel; }
+
+void TextLabel::SetFont(std::shared_ptr<Font> font_ptr) {
+  font_ = std::move(font_ptr);
+}
+
+const std::shared_ptr<Font>& TextLabel::GetFont() const { return font_; }
+
+void TextLabel::SetColor(const glm::vec4& new_color) { color_ = new_color; }
+
+const glm::vec4& TextLabel::Color() const { return color_; }
+
+void TextLabel::SetShapeCentered(const std::string& text,
+                                 const glm::vec3& center, float size) {
+  text_ = text;
+  font_size_ = size;
+  run_ = font_->LayoutCentered(text, center, size);
+}
+
+void TextLabel::Relayout() {
+  if (font_ != nullptr) {
+    run_ = font_->Layout(text_, run_.origin, font_size_);
+  }
+}
+
+const std::string& TextLabel::Text() const { return text_; }
+
+float TextLabel::FontSize() const { return font_size_; }
+
+const TextRun& TextLabel::Run() const { return run_; }
+
+TextBatchShape::TextBatchShape(Shader& shader_in) : Shape(shader_in) {}
+
+DrawableKind TextBatchShape::Kind() const { return DrawableKind::kTextBatch; }
+
+void TextBatchShape::SetLabels(std::span<const TextLabel* const> labels) {
+  stream_ = text_layout::TextStream{};
+  font_ = labels.empty() ? nullptr : labels.front()->GetFont();
+  for (const TextLabel* const label : labels) {
+    text_layout::Append(stream_, label->Run(), label->Text(),
+                        label->FontSize(), label->Color());
+  }
+
+  SetBuffer("position", std::span<const glm::vec3>(stream_.positions));
+  SetBuffer("texture_coord",
+            std::span<const glm::vec2>(stream_.texture_positions));
+  SetBuffer("color", std::span<const glm::vec4>(stream_.colors));
+  SetLocalBounds(stream_.bounds);
+}
+
+void TextBatchShape::Draw(const glm::mat4& model) const {
+  if (font_ == nullptr || VertexCount() == 0) {
+    return;
+  }
+  // White: each label's colour travels in its vertices.
+  GetShader().UseProgram(DrawRecord(model));
+
+  VaoRef().Bind();
+
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, font_->AtlasTexture());
+  glDrawArrays(GL_TRIANGLES, 0, VertexCount());
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  VertexArrayObject::Unbind();
+}
+
+const std::shared_ptr<Font>& TextBatchShape::GetFont() const { return font_; }
+
+std::span<const glm::vec3> TextBatchShape::Positions() const {
+  return stream_.positions;
+}
+
+std::span<const glm::vec2> TextBatchShape::TexturePositions() const {
+  return stream_.texture_positions;
+}
+
+std::span<const glm::vec4> TextBatchShape::Colors() const {
+  return stream_.colors;
+}
+
+std::span<const PlacedText> TextBatchShape::Texts() const {
+  return stream_.texts;
+}
@@ -0,0 +1,109 @@
+#ifndef TEXT_BATCH_HPP
+#define TEXT_BATCH_HPP
+
+#include <epoxy/gl.h>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "drawable.hpp"
+#include "font.hpp"
+#include "rect.hpp"
+#include "shaders.hpp"
+#include "shapes_base.hpp"
+#include "text_layout.hpp"
+
+// The text of a label layer — the month names, the year numbers, the bar and
+// total labels — drawn as one vertex stream in one call.
+//
+// Each label stays a node of its own, so the scene tree lists it, the
+// selection overlay covers it and the snapshot reports its text. But the node
+// carries a TextLabel, which holds its laid-out glyph quads on the CPU and
+// draws nothing; the layer's container node carries the TextBatchShape, which
+// gathers the quads of all its labels (CommitTextBatch) and draws them with
+// each label's colour in its vertices. All glyphs of a font share the atlas
+// texture, so nothing else changes between labels that a draw call would have
+// to.
+//
+// The labels' coordinates are taken in the container's space: they hang
+// directly under it and carry no transform of their own, as the label pools
+// make them.
+
+class TextLabel : public Drawable {
+ public:
+  TextLabel() = default;
+
+  // Nothing: the batch of the parent node draws this label.
+  void Draw(const glm::mat4& model) const override;
+
+  [[nodiscard]] const RectF& LocalBounds() const override;
+
+  [[nodiscard]] DrawableKind Kind() const override;
+
+  void SetFont(std::shared_ptr<Font> font_ptr);
+
+  [[nodiscard]] const std::shared_ptr<Font>& GetFont() const;
+
+  void SetColor(const glm::vec4& new_color);
+
+  [[nodiscard]] const glm::vec4& Color() const;
+
+  void SetShapeCentered(const std::string& text, const glm::vec3& center,
+                        float size);
+
+  // Lays the text out again where it stands, for glyphs that arrived since.
+  // Their advances were right from the start, so the place holds.
+  void Relayout();
+
+  // As FontShape reports them, for the scene snapshot.
+  [[nodiscard]] const std::string& Text() const;
+
+  [[nodiscard]] float FontSize() const;
+
+  [[nodiscard]] const TextRun& Run() const;
+
+ private:
+  std::shared_ptr<Font> font_;
+  glm::vec4 color_{0.0F, 0.0F, 0.0F, 1.0F};
+  std::string text_;
+  float font_size_{0.0F};
+  TextRun run_;
+};
+
+class TextBatchShape : public Shape {
+ public:
+  explicit TextBatchShape(Shader& shader_in);
+
+  [[nodiscard]] DrawableKind Kind() const override;
+
+  // Replaces the stream by the quads of `labels`, in order. They share one
+  // font — the one the first label names; the batch binds its atlas.
+  void SetLabels(std::span<const TextLabel* const> labels);
+
+  void Draw(const glm::mat4& model) const override;
+
+  // The stream as uploaded, for the software export: six vertices a glyph,
+  // each with its atlas texel and its label's colour.
+  [[nodiscard]] const std::shared_ptr<Font>& GetFont() const;
+
+  [[nodiscard]] std::span<const glm::vec3> Positions() const;
+
+  [[nodiscard]] std::span<const glm::vec2> TexturePositions() const;
+
+  [[nodiscard]] std::span<const glm::vec4> Colors() const;
+
+  // The labels of the stream, in order, for the vector export.
+  [[nodiscard]] std::span<const PlacedText> Texts() const;
+
+ private:
+  std::shared_ptr<Font> font_;
+  text_layout::TextStream stream_;
+};
+
+#endif  // TEXT_BATCH_HPP
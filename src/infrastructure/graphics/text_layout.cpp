@@ -0,0 +1,136 @@
+#include "text_layout.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <glm/ext/vector_float2.hpp>
+#include <glm/ext/vector_float3.hpp>
+#include <glm/ext/vector_float4.hpp>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "glyph_atlas.hpp"
+#include "glyph_rasterizer.hpp"
+#include "rect.hpp"
+
+namespace text_layout {
+
+ShapedText Shape(std::span<const char32_t> code_points,
+                 const LetterOf& letter_of) {
+  const std::size_t glyph_count = code_points.size();
+  ShapedText shaped;
+  TextRun& run = shaped.run;
+  run.positions.resize(glyph_count * kVerticesPerGlyph);
+  run.texture_positions.resize(glyph_count * kVerticesPerGlyph);
+
+  float current_x = 0.0F;
+
+  // The bounds follow the outlines, not the quads: those carry the field's
+  // spread around the glyph, which is no part of the text's extent.
+  float left = std::numeric_limits<float>::max();
+  float right = std::numeric_limits<float>::lowest();
+  float bottom = std::numeric_limits<float>::max();
+  float top = std::numeric_limits<float>::lowest();
+
+  for (std::size_t index = 0; index < glyph_count; ++index) {
+    const Letter& letter = letter_of(code_points[index]);
+
+    const float xpos = current_x + letter.quad_bearing[0];
+    const float ypos = -(letter.quad_size[1] - letter.quad_bearing[1]);
+
+    const float width = letter.quad_size[0];
+    const float height = letter.quad_size[1];
+
+    const auto base = index * kVerticesPerGlyph;
+    std::vector<glm::vec3>& positions = run.positions;
+    positions[base + 0] = glm::vec3(xpos, ypos + height, 0.0F);
+    positions[base + 1] = glm::vec3(xpos, ypos, 0.0F);
+    positions[base + 2] = glm::vec3(xpos + width, ypos, 0.0F);
+    positions[base + 3] = glm::vec3(xpos, ypos + height, 0.0F);
+    positions[base + 4] = glm::vec3(xpos + width, ypos, 0.0F);
+    const auto last = base + (kVerticesPerGlyph - 1);
+    positions[last] = glm::vec3(xpos + width, ypos + height, 0.0F);
+
+    // Texel coordinates, first field row at the quad's top.
+    const GlyphAtlas::Region& region = letter.atlas_region;
+    const auto texel_left = static_cast<float>(region.x);
+    const auto texel_right = static_cast<float>(region.x + region.width);
+    const auto texel_top = static_cast<float>(region.y);
+    const auto texel_bottom = static_cast<float>(region.y + region.height);
+    std::vector<glm::vec2>& texels = run.texture_positions;
+    texels[base + 0] = glm::vec2(texel_left, texel_top);
+    texels[base + 1] = glm::vec2(texel_left, texel_bottom);
+    texels[base + 2] = glm::vec2(texel_right, texel_bottom);
+    texels[base + 3] = glm::vec2(texel_left, texel_top);
+    texels[base + 4] = glm::vec2(texel_right, texel_bottom);
+    texels[last] = glm::vec2(texel_right, texel_top);
+
+    if (letter.size[0] > 0.0F || letter.size[1] > 0.0F) {
+      const float outline_left = current_x + letter.bearing[0];
+      const float outline_top = letter.bearing[1];
+      left = std::min(left, outline_left);
+      right = std::max(right, outline_left + letter.size[0]);
+      bottom = std::min(bottom, outline_top - letter.size[1]);
+      top = std::max(top, outline_top);
+    }
+
+    current_x += letter.advance;
+  }
+
+  shaped.width = current_x;
+  shaped.has_outline = left <= right;
+  if (shaped.has_outline) {
+    run.bounds = RectF(left, right, bottom, top);
+  }
+  return shaped;
+}
+
+TextRun Place(const ShapedText& shaped, const glm::vec3& position,
+              float size) {
+  TextRun run;
+  run.positions.reserve(shaped.run.positions.size());
+  for (const glm::vec3& vertex : shaped.run.positions) {
+    run.positions.push_back(
+        glm::vec3(position[0] + (vertex[0] * size),
+                  position[1] + (vertex[1] * size), position[2]));
+  }
+  run.texture_positions = shaped.run.texture_positions;
+  run.origin = position;
+
+  if (shaped.has_outline) {
+    const RectF& em = shaped.run.bounds;
+    run.bounds = RectF(position[0] + (em.Left() * size),
+                       position[0] + (em.Right() * size),
+                       position[1] + (em.Bottom() * size),
+                       position[1] + (em.Top() * size));
+  }
+  return run;
+}
+
+void Append(TextStream& stream, const TextRun& run, const std::string& text,
+            float size, const glm::vec4& color) {
+  stream.positions.insert(stream.positions.end(), run.positions.begin(),
+                          run.positions.end());
+  stream.texture_positions.insert(stream.texture_positions.end(),
+                                  run.texture_positions.begin(),
+                                  run.texture_positions.end());
+  stream.colors.insert(stream.colors.end(), run.positions.size(), color);
+  stream.texts.push_back(PlacedText{
+      .text = text, .origin = run.origin, .size = size, .color = color});
+
+  if (run.bounds.Width() <= 0.0F && run.bounds.Height() <= 0.0F) {
+    return;
+  }
+  if (!stream.bounded) {
+    stream.bounds = run.bounds;
+    stream.bounded = true;
+    return;
+  }
+  stream.bounds = RectF(std::min(stream.bounds.Left(), run.bounds.Left()),
+                        std::max(stream.bounds.Right(), run.bounds.Right()),
+                        std::min(stream.bounds.Bottom(), run.bounds.Bottom()),
+                        std::max(stream.bounds.Top(), run.bounds.Top()));
+}
+
+}  // namespace text_layout
@@ -0,0 +1,83 @@
+#ifndef TEXT_LAYOUT_HPP
+#define TEXT_LAYOUT_HPP
+
+#include <cstddef>
+#include <functional>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "glyph_rasterizer.hpp"
+#include "rect.hpp"
+
+// One line of text laid out for drawing: six vertices a glyph, positions in
+// the text's own space and texel coordinates into the font's atlas. `bounds`
+// is the box of the glyph outlines — zero-extent for blank text — and not of
+// the quads, which carry the distance field's spread around each glyph.
+// `origin` is where the baseline starts, for the vector export, which sets
+// the text itself rather than its quads.
+struct TextRun {
+  std::vector<glm::vec3> positions;
+  std::vector<glm::vec2> texture_positions;
+  RectF bounds;
+  glm::vec3 origin{0.0F};
+};
+
+// A label of the batch as text rather than quads: the string, where its
+// baseline starts, its em size and colour — what the vector export sets.
+struct PlacedText {
+  std::string text;
+  glm::vec3 origin;
+  float size;
+  glm::vec4 color;
+};
+
+// The arithmetic of text layout, apart from FreeType and GL: Font hands in
+// its letters, TextBatchShape uploads the stream. Kept apart so layout and
+// batching can be checked with made-up metrics.
+namespace text_layout {
+
+inline constexpr std::size_t kVerticesPerGlyph = 6;
+
+// A text at em size 1, pen starting at the origin — what Font caches per
+// string — plus what the measuring functions read off it.
+struct ShapedText {
+  TextRun run;
+  float width{0.0F};
+  // False for blank text, whose run bounds are a placeholder.
+  bool has_outline{false};
+};
+
+// The letter of a code point, as Font::GetLetter answers.
+using LetterOf = std::function<const Letter&(char32_t)>;
+
+// Lays `code_points` out one advance after the other.
+[[nodiscard]] ShapedText Shape(std::span<const char32_t> code_points,
+                               const LetterOf& letter_of);
+
+// `shaped` with its baseline starting at `position`, at em size `size`.
+[[nodiscard]] TextRun Place(const ShapedText& shaped,
+                            const glm::vec3& position, float size);
+
+// The vertex stream of a label layer: the labels' runs one after the other,
+// each vertex carrying its label's colour, and the labels as text.
+struct TextStream {
+  std::vector<glm::vec3> positions;
+  std::vector<glm::vec2> texture_positions;
+  std::vector<glm::vec4> colors;
+  std::vector<PlacedText> texts;
+  // The union of the labels' outline boxes; blank labels add nothing.
+  RectF bounds;
+  bool bounded{false};
+};
+
+// Appends one label, laid out as `run`, to the end of `stream`.
+void Append(TextStream& stream, const TextRun& run, const std::string& text,
+            float size, const glm::vec4& color);
+
+}  // namespace text_layout
+
+#endif  // TEXT_LAYOUT_HPP
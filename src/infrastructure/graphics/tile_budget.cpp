@@ -0,0 +1,46 @@
+#include "tile_budget.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace tile_budget {
+namespace {
+
+constexpr std::size_t kBytesPerPixel = 4;
+
+}  // namespace
+
+std::size_t TileBytes(std::size_t side, int samples) {
+  // The multisampled texture and the resolved one; a single-sample render
+  // goes straight into the latter.
+  const auto textures =
+      samples > 1 ? static_cast<std::size_t>(samples) + 1 : std::size_t{1};
+  return side * side * kBytesPerPixel * textures;
+}
+
+std::size_t ChooseTileSize(const TileLimits& limits, int samples,
+                           std::size_t budget_bytes) {
+  const std::size_t ceiling =
+      std::min({limits.max_texture_size, limits.max_renderbuffer_size,
+                limits.max_viewport_size});
+  if (ceiling == 0) {
+    return 0;
+  }
+  const int usable_samples =
+      std::max(1, std::min(samples, limits.max_samples));
+  const std::size_t pixel_bytes = TileBytes(1, usable_samples);
+  auto side = static_cast<std::size_t>(std::sqrt(
+      static_cast<double>(budget_bytes) / static_cast<double>(pixel_bytes)));
+  // The square root of a double may land one above the exact answer.
+  while (side > 0 && TileBytes(side, usable_samples) > budget_bytes) {
+    --side;
+  }
+  side = std::min(side, ceiling);
+  if (side >= kGranularity) {
+    side -= side % kGranularity;
+  }
+  return std::max(side, std::min(kGranularity, ceiling));
+}
+
+}  // namespace tile_budget
@@ -0,0 +1,47 @@
+#ifndef TILE_BUDGET_HPP
+#define TILE_BUDGET_HPP
+
+#include <cstddef>
+
+// How large the tiles of the page export may be. A tile is rendered into a
+// multisampled RGBA8 colour texture and resolved into a single-sample one, so
+// it costs 4 bytes per pixel per sample plus 4 for the resolve — at 16
+// samples, 68 bytes a pixel, over a gigabyte for a 4096-pixel tile. The side
+// is therefore chosen from a memory budget rather than fixed, and capped at
+// what the driver accepts for a texture, a renderbuffer and a viewport.
+//
+// GL-free: the limits come in as numbers (QueryTileLimits in
+// render_to_texture.hpp reads them from the context), so the choice can be
+// tested without one.
+namespace tile_budget {
+
+// The driver's ceilings, as GL reports them.
+struct TileLimits {
+  std::size_t max_texture_size{0};
+  std::size_t max_renderbuffer_size{0};
+  std::size_t max_viewport_size{0};
+  // What a colour texture can be multisampled with.
+  int max_samples{1};
+};
+
+// 512 MiB: at 16 samples a tile of 2560 pixels, at llvmpipe's 8 one of 3840.
+inline constexpr std::size_t kDefaultBudgetBytes = std::size_t{512} << 20U;
+
+// Tile sides are multiples of this where the budget allows, so the grid stays
+// regular and the remainder tile small.
+inline constexpr std::size_t kGranularity = 256;
+
+// The bytes a `side` x `side` tile takes on the GPU at `samples`.
+[[nodiscard]] std::size_t TileBytes(std::size_t side, int samples);
+
+// The largest tile side that fits `budget_bytes` at `samples` (capped at
+// `limits.max_samples`, as the render caps it) and every limit, rounded down
+// to kGranularity. Never below kGranularity or the smallest limit, whichever
+// is less: a budget too small for one tile still gets one.
+[[nodiscard]] std::size_t ChooseTileSize(const TileLimits& limits,
+                                         int samples,
+                                         std::size_t budget_bytes);
+
+}  // namespace tile_budget
+
+#endif  // TILE_BUDGET_HPP
@@ -0,0 +1,172 @@
+#include "tile_pyramid.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "png_strip_encoder.hpp"
+#include "png_writer.hpp"
+
+namespace tile_pyramid {
+namespace {
+
+std::size_t CeilDivide(std::size_t value, std::size_t divisor) {
+  return (value + divisor - 1) / divisor;
+}
+
+std::size_t WorkerCount() {
+  return std::max(1U, std::thread::hardware_concurrency());
+}
+
+}  // namespace
+
+std::vector<Level> Levels(std::size_t width, std::size_t height,
+                          std::size_t tile_size) {
+  std::vector<Level> levels;
+  if (width == 0 || height == 0 || tile_size == 0) {
+    return levels;
+  }
+  // From the full image down to one pixel, then turned round.
+  std::size_t level_width = width;
+  std::size_t level_height = height;
+  while (true) {
+    levels.push_back(Level{.width = level_width,
+                           .height = level_height,
+                           .columns = CeilDivide(level_width, tile_size),
+                           .rows = CeilDivide(level_height, tile_size)});
+    if (level_width == 1 && level_height == 1) {
+      break;
+    }
+    level_width = CeilDivide(level_width, 2);
+    level_height = CeilDivide(level_height, 2);
+  }
+  std::ranges::reverse(levels);
+  for (std::size_t index = 0; index < levels.size(); ++index) {
+    levels[index].index = index;
+  }
+  return levels;
+}
+
+std::string Descriptor(std::size_t width, std::size_t height,
+                       std::size_t tile_size) {
+  return "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+         "<Image xmlns=\"http://schemas.microsoft.com/deepzoom/2008\" "
+         "Format=\"png\" Overlap=\"0\" TileSize=\"" +
+         std::to_string(tile_size) + "\">\n  <Size Width=\"" +
+         std::to_string(width) + "\" Height=\"" + std::to_string(height) +
+         "\"/>\n</Image>\n";
+}
+
+std::filesystem::path TilesDirectory(
+    const std::filesystem::path& descriptor_path) {
+  std::filesystem::path directory = descriptor_path;
+  directory.replace_filename(descriptor_path.stem().string() + "_files");
+  return directory;
+}
+
+TileCutter::TileCutter(const Level& level,
+                       const std::filesystem::path& tiles_directory,
+                       const png_io::EncodeOptions& encoding,
+                       std::size_t tile_size)
+    : level_(level),
+      directory_(tiles_directory / std::to_string(level.index)),
+      encoding_(encoding),
+      tile_size_(tile_size),
+      row_bytes_(level.width * png_io::kBytesPerPixel),
+      gathered_(row_bytes_ * std::min(level.height, tile_size)) {
+  encoding_.workers = 1;
+  std::error_code error;
+  std::filesystem::create_directories(directory_, error);
+  good_ = !error;
+  if (error) {
+    std::cerr << "--dump-dzi: cannot create " << directory_.string() << ": "
+              << error.message() << '\n';
+  }
+}
+
+bool TileCutter::Good() const { return good_; }
+
+bool TileCutter::AddRows(std::span<unsigned char*> rows) {
+  for (unsigned char* row : rows) {
+    if (!good_) {
+      return false;
+    }
+    std::copy_n(row, row_bytes_, &gathered_[gathered_rows_ * row_bytes_]);
+    ++gathered_rows_;
+    const std::size_t tile_height =
+        std::min(tile_size_, level_.height - (tile_row_ * tile_size_));
+    if (gathered_rows_ == tile_height) {
+      good_ = WriteTileRow();
+    }
+  }
+  return good_;
+}
+
+bool TileCutter::Finish() {
+  return good_ && gathered_rows_ == 0 && tile_row_ == level_.rows;
+}
+
+std::size_t TileCutter::TilesWritten() const { return tiles_written_; }
+
+bool TileCutter::WriteTileRow() {
+  // Each worker takes the next tile not yet taken until none is left.
+  std::atomic<std::size_t> next_column{0};
+  std::atomic<std::size_t> written{0};
+  const auto work = [this, &next_column, &written] {
+    for (std::size_t column = next_column++; column < level_.columns;
+         column = next_column++) {
+      if (WriteTile(column)) {
+        ++written;
+      }
+    }
+  };
+  const std::size_t workers = std::min(WorkerCount(), level_.columns);
+  std::vector<std::future<void>> running;
+  running.reserve(workers);
+  for (std::size_t worker = 1; worker < workers; ++worker) {
+    running.push_back(std::async(std::launch::async, work));
+  }
+  work();
+  for (std::future<void>& worker : running) {
+    worker.get();
+  }
+
+  tiles_written_ += written;
+  gathered_rows_ = 0;
+  ++tile_row_;
+  return written == level_.columns;
+}
+
+// The workers share gathered_ but only read it: the writer writes nothing into
+// the rows it is handed.
+bool TileCutter::WriteTile(std::size_t column) {
+  const std::size_t left = column * tile_size_;
+  const std::size_t tile_width = std::min(tile_size_, level_.width - left);
+  std::vector<unsigned char*> rows(gathered_rows_);
+  for (std::size_t row = 0; row < gathered_rows_; ++row) {
+    rows[row] =
+        &gathered_[(row * row_bytes_) + (left * png_io::kBytesPerPixel)];
+  }
+  const std::filesystem::path path =
+      directory_ /
+      (std::to_string(column) + "_" + std::to_string(tile_row_) + ".png");
+  png_io::PngRowWriter writer(
+      path.string(),
+      png_io::PngImageSize{.width = tile_width, .height = gathered_rows_},
+      encoding_);
+  if (!writer.WriteRows(rows) || !writer.Finish()) {
+    std::cerr << "--dump-dzi: cannot write " << path.string() << '\n';
+    return false;
+  }
+  return true;
+}
+
+}  // namespace tile_pyramid
@@ -0,0 +1,96 @@
+#ifndef TILE_PYRAMID_HPP
+#define TILE_PYRAMID_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "png_strip_encoder.hpp"
+
+// The page as a Deep Zoom (DZI) image pyramid, the layout tiled viewers such
+// as OpenSeadragon load: a descriptor `name.dzi` and beside it a directory
+// `name_files` with one directory per level, `0` the single pixel and the
+// last level the full image, each holding that level's tiles as
+// `<column>_<row>.png`. Every level is half the size of the one above it,
+// rounded up, and cut into kTileSize squares from the top left; the last
+// column and row hold what is left over. Tiles do not overlap.
+//
+// What lives here is GL-free: the geometry of the levels, the descriptor and
+// the TileCutter, which turns a level's rows into tile files. WritePageToDzi
+// (render_to_png.hpp) renders each level at its own resolution — not scaled
+// down from the level above — and feeds the rows in.
+namespace tile_pyramid {
+
+// The side of a tile in pixels, the size DZI viewers default to.
+inline constexpr std::size_t kTileSize = 256;
+
+struct Level {
+  std::size_t index{0};
+  std::size_t width{0};
+  std::size_t height{0};
+  std::size_t columns{0};
+  std::size_t rows{0};
+};
+
+// The levels of a `width` x `height` image, level 0 (1 x 1) first. Empty for
+// an empty image.
+[[nodiscard]] std::vector<Level> Levels(std::size_t width, std::size_t height,
+                                        std::size_t tile_size = kTileSize);
+
+// The XML of the descriptor for a `width` x `height` image of PNG tiles.
+[[nodiscard]] std::string Descriptor(std::size_t width, std::size_t height,
+                                     std::size_t tile_size = kTileSize);
+
+// `name_files` beside `descriptor_path` (`name.dzi`).
+[[nodiscard]] std::filesystem::path TilesDirectory(
+    const std::filesystem::path& descriptor_path);
+
+// Cuts one level into its tile files as its rows arrive, top row first and
+// any number at a time: a row of tiles is gathered and then encoded, each tile
+// its own PNG, on every core at once. A tile is small enough that its
+// encoder gets no pool of its own (EncodeOptions::workers = 1); the tiles
+// side by side are the parallelism.
+class TileCutter {
+ public:
+  // Creates the level's directory under `tiles_directory`; Good() tells
+  // whether that worked.
+  TileCutter(const Level& level, const std::filesystem::path& tiles_directory,
+             const png_io::EncodeOptions& encoding,
+             std::size_t tile_size = kTileSize);
+
+  [[nodiscard]] bool Good() const;
+
+  // Takes the next `rows`, each the level's width in RGBA8 pixels. False once
+  // a tile could not be written, and for every call after.
+  bool AddRows(std::span<unsigned char*> rows);
+
+  // True when every row came in and every tile was written.
+  [[nodiscard]] bool Finish();
+
+  [[nodiscard]] std::size_t TilesWritten() const;
+
+ private:
+  // Encodes the gathered row of tiles and starts the next one.
+  bool WriteTileRow();
+
+  // Writes tile `column` of the gathered row.
+  [[nodiscard]] bool WriteTile(std::size_t column);
+
+  Level level_;
+  std::filesystem::path directory_;
+  png_io::EncodeOptions encoding_;
+  std::size_t tile_size_;
+  std::size_t row_bytes_;
+  // One row of tiles, the level's width by up to tile_size_ rows.
+  std::vector<unsigned char> gathered_;
+  std::size_t gathered_rows_{0};
+  std::size_t tile_row_{0};
+  std::size_t tiles_written_{0};
+  bool good_{false};
+};
+
+}  // namespace tile_pyramid
+
+#endif  // TILE_PYRAMID_HPP
@@ -0,0 +1,118 @@
+#include "tile_readback.hpp"
+
+#include <epoxy/gl.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr std::size_t kBytesPerPixel = 4;
+
+}  // namespace
+
+TileReadback::TileReadback() {
+  for (Slot& slot : slots_) {
+    glCreateBuffers(1, &slot.buffer);
+  }
+}
+
+TileReadback::~TileReadback() {
+  for (Slot& slot : slots_) {
+    glDeleteSync(slot.fence);
+    glDeleteBuffers(1, &slot.buffer);
+  }
+}
+
+void TileReadback::Queue(GLuint texture, GLsizei width, GLsizei height,
+                         std::span<unsigned char> destination,
+                         GLsizei row_pixels) {
+  Slot& slot = slots_.at(next_slot_);
+  next_slot_ = (next_slot_ + 1) % kSlotCount;
+  Deliver(slot);
+  if (width <= 0 || height <= 0 || row_pixels < width) {
+    return;
+  }
+
+  slot.row_bytes = static_cast<std::size_t>(width) * kBytesPerPixel;
+  slot.destination_stride =
+      static_cast<std::size_t>(row_pixels) * kBytesPerPixel;
+  slot.rows = static_cast<std::size_t>(height);
+  // Delivery copies row by row; a destination too short for the tile would
+  // be overrun, not truncated.
+  const std::size_t needed =
+      ((slot.rows - 1) * slot.destination_stride) + slot.row_bytes;
+  if (destination.size() < needed) {
+    throw std::invalid_argument("tile readback: destination of " +
+                                std::to_string(destination.size()) +
+                                " bytes, the tile needs " +
+                                std::to_string(needed));
+  }
+  slot.destination = destination;
+
+  const std::size_t bytes = slot.row_bytes * slot.rows;
+  if (slot.capacity < bytes) {
+    glNamedBufferData(slot.buffer, static_cast<GLsizeiptr>(bytes), nullptr,
+                      GL_STREAM_READ);
+    slot.capacity = bytes;
+  }
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+  // With a pack buffer bound, the pointer is an offset into it. The tile is
+  // the texture's bottom-left corner, which is all of it but for the last
+  // column and row of a grid.
+  glGetTextureSubImage(texture, 0, 0, 0, 0, width, height, 1, GL_RGBA,
+                       GL_UNSIGNED_BYTE, static_cast<GLsizei>(bytes), nullptr);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void TileReadback::Drain() {
+  for (std::size_t offset = 0; offset < kSlotCount; ++offset) {
+    Deliver(slots_.at((next_slot_ + offset) % kSlotCount));
+  }
+}
+
+std::chrono::nanoseconds TileReadback::Elapsed() const { return elapsed_; }
+
+void TileReadback::Deliver(Slot& slot) {
+  if (slot.fence == nullptr) {
+    return;
+  }
+  const auto started = std::chrono::steady_clock::now();
+
+  // As FrameUniforms: a GPU that takes longer than a second per round for a
+  // tile is hung.
+  constexpr GLuint64 kWaitNanoseconds = 1'000'000'000;
+  GLenum status = GL_TIMEOUT_EXPIRED;
+  while (status == GL_TIMEOUT_EXPIRED) {
+    status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                              kWaitNanoseconds);
+  }
+  glDeleteSync(slot.fence);
+  slot.fence = nullptr;
+
+  const std::size_t bytes = slot.row_bytes * slot.rows;
+  const auto* mapped = static_cast<const unsigned char*>(glMapNamedBufferRange(
+      slot.buffer, 0, static_cast<GLsizeiptr>(bytes), GL_MAP_READ_BIT));
+  if (mapped == nullptr) {
+    throw std::runtime_error("mapping a tile readback buffer of " +
+                             std::to_string(bytes) + " bytes failed");
+  }
+  const std::span<const unsigned char> source(mapped, bytes);
+  for (std::size_t row = 0; row < slot.rows; ++row) {
+    const auto tile_row = source.subspan(row * slot.row_bytes, slot.row_bytes);
+    std::ranges::copy(tile_row, slot.destination
+                                    .subspan(row * slot.destination_stride)
+                                    .begin());
+  }
+  glUnmapNamedBuffer(slot.buffer);
+  slot.destination = {};
+
+  elapsed_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - started);
+}
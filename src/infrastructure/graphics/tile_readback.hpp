@@ -0,0 +1,74 @@
+#ifndef TILE_READBACK_HPP
+#define TILE_READBACK_HPP
+
+#include <epoxy/gl.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <span>
+
+// Reads rendered tiles back through a ring of pixel pack buffers, so the GPU
+// renders the next tile while the last one is still on its way to the CPU.
+//
+// Queue issues the read of a texture into a pack buffer and fences it; the
+// call returns at once. The bytes reach their destination when the tile's
+// slot comes round again or at Drain: the read is waited for, the buffer
+// mapped and its rows copied to where the caller asked. Before, every tile
+// was read with a plain glGetTexImage, which stalls the CPU until the GPU has
+// rendered, resolved and handed over that tile, and leaves the GPU idle while
+// the CPU carries on.
+//
+// kSlotCount tiles are in flight at most. Two suffice: by the time the third
+// tile is queued, the GPU has had the second tile's draws to get the first
+// one's read done.
+//
+// GL: construct, use and destroy with the context current.
+class TileReadback {
+ public:
+  TileReadback();
+
+  ~TileReadback();
+
+  TileReadback(const TileReadback&) = delete;
+  TileReadback& operator=(const TileReadback&) = delete;
+  TileReadback(TileReadback&&) = delete;
+  TileReadback& operator=(TileReadback&&) = delete;
+
+  // Queues the read of the bottom-left `width` x `height` of the RGBA8
+  // `texture`, which may be larger, into `destination`, whose rows lie
+  // `row_pixels` pixels apart; rows come bottom first, as GL stores them.
+  // `destination` must stay alive until the tile is delivered — at the latest
+  // by Drain. Completes the oldest queued tile when its slot is needed.
+  void Queue(GLuint texture, GLsizei width, GLsizei height,
+             std::span<unsigned char> destination, GLsizei row_pixels);
+
+  // Delivers every queued tile.
+  void Drain();
+
+  // Time spent waiting for reads and copying them out, for the debug log.
+  [[nodiscard]] std::chrono::nanoseconds Elapsed() const;
+
+ private:
+  struct Slot {
+    GLuint buffer{0};
+    std::size_t capacity{0};
+    GLsync fence{nullptr};
+    std::span<unsigned char> destination;
+    std::size_t row_bytes{0};
+    std::size_t destination_stride{0};
+    std::size_t rows{0};
+  };
+
+  // Waits for the slot's read, copies it to its destination and frees the
+  // slot.
+  void Deliver(Slot& slot);
+
+  static constexpr std::size_t kSlotCount = 2;
+
+  std::array<Slot, kSlotCount> slots_{};
+  std::size_t next_slot_{0};
+  std::chrono::nanoseconds elapsed_{0};
+};
+
+#endif  // TILE_READBACK_HPP
@@ -11,6 +11,7 @@
 //   - normalizer2.h — icu::Normalizer2 (NFC)
 //   - brkiter.h     — icu::BreakIterator (grapheme clusters)
 //   - locid.h       — icu::Locale
+//   - uchar.h       — character properties (NFC quick check, combining class)
 //
 // The export pragmas say that this is the entry point: whoever includes this
 // header has included the ICU headers below, and the include check asks for no
@@ -19,6 +20,7 @@
 #include <unicode/locid.h>        // IWYU pragma: export
 #include <unicode/normalizer2.h>  // IWYU pragma: export
 #include <unicode/stringpiece.h>  // IWYU pragma: export
+#include <unicode/uchar.h>        // IWYU pragma: export
 #include <unicode/umachine.h>     // IWYU pragma: export
 #include <unicode/unistr.h>       // IWYU pragma: export
 #include <unicode/utypes.h>       // IWYU pragma: export
@@ -1,29 +1,152 @@
 #include "utf8_codec.hpp"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "unicode.hpp"
 
-void AppendCodePoints(const icu::UnicodeString& text, std::int32_t begin,
-                      std::int32_t end, std::vector<char32_t>& out) {
-  constexpr UChar32 kBmpMax = 0xFFFF;
-  for (std::int32_t index = begin; index < end;) {
-    const UChar32 code_point = text.char32At(index);
-    index += (code_point > kBmpMax) ? 2 : 1;
-    out.push_back(static_cast<char32_t>(code_point));
+namespace {
+
+constexpr char32_t kReplacement = 0xFFFD;
+// Below the first combining mark every code point is its own NFC form and
+// composes with nothing before it.
+constexpr char32_t kFirstCombiningMark = 0x300;
+constexpr unsigned char kAsciiEnd = 0x80;
+
+// Bytes from `begin` on that are ASCII, up to the first that is not.
+std::size_t AsciiRun(std::string_view text, std::size_t begin) {
+  std::size_t index = begin;
+#if defined(__SSE2__)
+  constexpr std::size_t kLanes = 16;
+  for (; index + kLanes <= text.size(); index += kLanes) {
+    const __m128i bytes = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(text.data() + index));
+    // One bit per lane, set where the byte's high bit is.
+    const auto high_bits = static_cast<unsigned>(_mm_movemask_epi8(bytes));
+    if (high_bits != 0) {
+      return index + static_cast<std::size_t>(std::countr_zero(high_bits)) -
+             begin;
+    }
+  }
+#endif
+  constexpr std::size_t kWord = sizeof(std::uint64_t);
+  constexpr std::uint64_t kHighBits = 0x8080808080808080ULL;
+  for (; index + kWord <= text.size(); index += kWord) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, text.data() + index, kWord);
+    if ((word & kHighBits) != 0) {
+      break;
+    }
   }
+  while (index < text.size() &&
+         static_cast<unsigned char>(text[index]) < kAsciiEnd) {
+    ++index;
+  }
+  return index - begin;
 }
 
-std::vector<char32_t> DecodeUtf8(const std::string& text) {
-  std::vector<char32_t> code_points;
-  if (text.empty()) {
-    return code_points;
+// The range the second byte of a sequence may take, by lead byte — Unicode's
+// table of well-formed UTF-8 (Table 3-7). The narrow ranges exclude overlong
+// forms, surrogates and code points past U+10FFFF.
+struct SequenceRule {
+  std::size_t length;
+  unsigned char second_low;
+  unsigned char second_high;
+};
+
+constexpr unsigned char kTrailLow = 0x80;
+constexpr unsigned char kTrailHigh = 0xBF;
+
+SequenceRule RuleFor(unsigned char lead) {
+  if (lead >= 0xC2 && lead <= 0xDF) {
+    return {.length = 2, .second_low = kTrailLow, .second_high = kTrailHigh};
+  }
+  if (lead == 0xE0) {
+    return {.length = 3, .second_low = 0xA0, .second_high = kTrailHigh};
+  }
+  if (lead == 0xED) {
+    return {.length = 3, .second_low = kTrailLow, .second_high = 0x9F};
+  }
+  if (lead >= 0xE1 && lead <= 0xEF) {
+    return {.length = 3, .second_low = kTrailLow, .second_high = kTrailHigh};
+  }
+  if (lead == 0xF0) {
+    return {.length = 4, .second_low = 0x90, .second_high = kTrailHigh};
+  }
+  if (lead >= 0xF1 && lead <= 0xF3) {
+    return {.length = 4, .second_low = kTrailLow, .second_high = kTrailHigh};
   }
+  if (lead == 0xF4) {
+    return {.length = 4, .second_low = kTrailLow, .second_high = 0x8F};
+  }
+  // A trail byte out of place, or a lead no well-formed text contains.
+  return {.length = 0, .second_low = 0, .second_high = 0};
+}
 
+// Decodes the multi-byte sequence at `index` into `out` and returns the index
+// behind it. An ill-formed sequence yields one U+FFFD for its maximal subpart:
+// the lead and the trail bytes that were still valid, never the byte that
+// broke it, which starts the next sequence.
+template <typename CodePoints>
+std::size_t DecodeSequence(std::string_view text, std::size_t index,
+                           CodePoints& out) {
+  constexpr unsigned kTrailBits = 6;
+  constexpr unsigned char kTrailMask = 0x3F;
+  constexpr std::array<unsigned char, 5> kLeadMask = {0, 0, 0x1F, 0x0F, 0x07};
+
+  const auto lead = static_cast<unsigned char>(text[index]);
+  const SequenceRule rule = RuleFor(lead);
+  if (rule.length == 0) {
+    out.push_back(kReplacement);
+    return index + 1;
+  }
+
+  auto code_point = static_cast<char32_t>(lead & kLeadMask.at(rule.length));
+  std::size_t next = index + 1;
+  for (std::size_t trail = 1; trail < rule.length; ++trail, ++next) {
+    const unsigned char low = trail == 1 ? rule.second_low : kTrailLow;
+    const unsigned char high = trail == 1 ? rule.second_high : kTrailHigh;
+    if (next >= text.size()) {
+      out.push_back(kReplacement);
+      return next;
+    }
+    const auto byte = static_cast<unsigned char>(text[next]);
+    if (byte < low || byte > high) {
+      out.push_back(kReplacement);
+      return next;
+    }
+    code_point = (code_point << kTrailBits) | (byte & kTrailMask);
+  }
+  out.push_back(code_point);
+  return next;
+}
+
+// Whether NFC leaves the code point as it is and nothing composes onto it
+// from before: quick check "yes" and combining class 0.
+bool IsNfcStable(char32_t code_point) {
+  if (code_point < kFirstCombiningMark) {
+    return true;
+  }
+  const auto value = static_cast<UChar32>(code_point);
+  return u_getIntPropertyValue(value, UCHAR_NFC_QUICK_CHECK) == UNORM_YES &&
+         u_getCombiningClass(value) == 0;
+}
+
+// The full ICU path, for text that needs normalising: UTF-16, NFC, and the
+// code points cluster by cluster.
+void DecodeWithIcu(std::string_view text, std::vector<char32_t>& out) {
   const icu::UnicodeString utf16 = icu::UnicodeString::fromUTF8(
       icu::StringPiece(text.data(), static_cast<std::int32_t>(text.size())));
 
@@ -37,15 +160,15 @@ std::vector<char32_t> DecodeUtf8(const std::string& text) {
     normalized = utf16;  // fall back to the unnormalised text
   }
 
-  code_points.reserve(static_cast<std::size_t>(normalized.countChar32()));
+  out.reserve(static_cast<std::size_t>(normalized.countChar32()));
 
   status = U_ZERO_ERROR;
   const std::unique_ptr<icu::BreakIterator> grapheme_breaks(
       icu::BreakIterator::createCharacterInstance(icu::Locale::getRoot(),
                                                   status));
   if (U_FAILURE(status) != 0 || !grapheme_breaks) {
-    AppendCodePoints(normalized, 0, normalized.length(), code_points);
-    return code_points;
+    AppendCodePoints(normalized, 0, normalized.length(), out);
+    return;
   }
 
   grapheme_breaks->setText(normalized);
@@ -53,9 +176,56 @@ std::vector<char32_t> DecodeUtf8(const std::string& text) {
   for (std::int32_t end = grapheme_breaks->next();
        end != icu::BreakIterator::DONE;
        start = end, end = grapheme_breaks->next()) {
-    AppendCodePoints(normalized, start, end, code_points);
+    AppendCodePoints(normalized, start, end, out);
+  }
+}
+
+// The decoder proper, for either kind of code point buffer.
+template <typename CodePoints>
+void DecodeInto(std::string_view text, CodePoints& out) {
+  out.clear();
+  std::size_t index = 0;
+  while (index < text.size()) {
+    const std::size_t ascii = AsciiRun(text, index);
+    const auto* const run =
+        reinterpret_cast<const unsigned char*>(text.data() + index);
+    out.insert(out.end(), run, run + ascii);
+    index += ascii;
+    if (index < text.size()) {
+      index = DecodeSequence(text, index, out);
+    }
   }
 
+  if (!std::ranges::all_of(out, IsNfcStable)) {
+    std::vector<char32_t> normalized;
+    DecodeWithIcu(text, normalized);
+    out.assign(normalized.begin(), normalized.end());
+  }
+}
+
+}  // namespace
+
+void AppendCodePoints(const icu::UnicodeString& text, std::int32_t begin,
+                      std::int32_t end, std::vector<char32_t>& out) {
+  constexpr UChar32 kBmpMax = 0xFFFF;
+  for (std::int32_t index = begin; index < end;) {
+    const UChar32 code_point = text.char32At(index);
+    index += (code_point > kBmpMax) ? 2 : 1;
+    out.push_back(static_cast<char32_t>(code_point));
+  }
+}
+
+void DecodeUtf8Into(std::string_view text, std::vector<char32_t>& out) {
+  DecodeInto(text, out);
+}
+
+void DecodeUtf8Into(std::string_view text, std::u32string& out) {
+  DecodeInto(text, out);
+}
+
+std::vector<char32_t> DecodeUtf8(const std::string& text) {
+  std::vector<char32_t> code_points;
+  DecodeUtf8Into(text, code_points);
   return code_points;
 }
 
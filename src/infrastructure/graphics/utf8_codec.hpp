@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "unicode.hpp"
@@ -10,7 +11,8 @@
 // Infrastructure: the conversion between UTF-8 and code points, in one place.
 // Two sides need it: the text renderer, which fetches a glyph per code point,
 // and the text editor, which computes in code points (an umlaut = one step).
-// ICU carries the Unicode work.
+// ICU carries the Unicode work that needs tables; the byte decoding is done
+// here.
 
 // Append the code points of the half-open UTF-16 range [begin, end) of an
 // ICU string to out. char32At returns the full code point at a unit index; a
@@ -18,22 +20,33 @@
 void AppendCodePoints(const icu::UnicodeString& text, std::int32_t begin,
                       std::int32_t end, std::vector<char32_t>& out);
 
-// Decode UTF-8 into a sequence of Unicode code points ready for glyph lookup.
+// Decode UTF-8 into a sequence of Unicode code points ready for glyph lookup,
+// replacing `out`'s contents and keeping its capacity, so a caller decoding
+// label after label allocates once.
 //
 // Strings reaching the renderer are UTF-8 (strftime month names, which carry
-// accents in many locales, or user-entered title text). ICU does the heavy
-// lifting:
-//   1. fromUTF8 turns the bytes into a UTF-16 string, replacing malformed
-//      sequences with U+FFFD instead of producing stray glyphs.
+// accents in many locales, or user-entered title text). Two stages:
+//   1. The bytes are decoded and validated here. Runs of ASCII — nearly all of
+//      a calendar's text — are found 16 bytes at a time (SSE2, or 8 at a time
+//      in a 64-bit word elsewhere) and widened without per-byte decisions.
+//      Each maximal ill-formed subsequence becomes one U+FFFD, the policy ICU
+//      follows, instead of producing stray glyphs.
 //   2. NFC normalisation folds a base letter plus a combining mark (e + ◌́)
 //      into its precomposed form (é) where one exists, so it renders as a
-//      single glyph — FreeType has no shaping engine of its own.
-//   3. A grapheme BreakIterator walks user-perceived characters; the code
-//      points of each cluster are emitted in order. Code points that have no
-//      precomposed form (and full complex-script shaping, e.g. Arabic/Indic)
-//      would need HarfBuzz and are out of scope; they fall back to per-code
-//      point glyphs, and a code point absent from the face renders as the
-//      font's .notdef glyph.
+//      single glyph — FreeType has no shaping engine of its own. Text whose
+//      every code point passes NFC's quick check with combining class 0 is
+//      normalised already and left alone; only text with combining marks or
+//      the like goes through ICU (UTF-16, Normalizer2, a grapheme walk).
+//      Code points that have no precomposed form (and full complex-script
+//      shaping, e.g. Arabic/Indic) would need HarfBuzz and are out of scope;
+//      they fall back to per-code point glyphs, and a code point absent from
+//      the face renders as the font's .notdef glyph.
+void DecodeUtf8Into(std::string_view text, std::vector<char32_t>& out);
+
+// The same into the string type the text editor computes in.
+void DecodeUtf8Into(std::string_view text, std::u32string& out);
+
+// The same into a new vector.
 [[nodiscard]] std::vector<char32_t> DecodeUtf8(const std::string& text);
 
 // The counterpart to DecodeUtf8 for the way back: the text editor computes in
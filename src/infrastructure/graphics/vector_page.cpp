@@ -0,0 +1,217 @@
+#include "vector_page.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <glm/ext/vector_float2.hpp>
+#include <glm/ext/vector_float4.hpp>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace vector_page {
+namespace {
+
+// Thousandths of a millimetre: far below what a printer resolves, and a
+// page's numbers stay short.
+constexpr int kDecimals = 3;
+constexpr float kChannelMax = 255.0F;
+
+// `value` in fixed notation without trailing zeros. std::to_chars, unlike a
+// stream, ignores the locale — a decimal comma would break the document.
+std::string Number(float value) {
+  std::array<char, 32> buffer{};
+  const auto [end, error] =
+      std::to_chars(buffer.data(), buffer.data() + buffer.size(), value,
+                    std::chars_format::fixed, kDecimals);
+  if (error != std::errc()) {
+    return "0";
+  }
+  std::string number(buffer.data(), end);
+  number.erase(number.find_last_not_of('0') + 1);
+  if (number.back() == '.') {
+    number.pop_back();
+  }
+  return number == "-0" ? "0" : number;
+}
+
+int Channel(float value) {
+  return static_cast<int>(
+      std::lround(std::clamp(value, 0.0F, 1.0F) * kChannelMax));
+}
+
+// The fill attributes of `color`: the colour as #rrggbb, and its alpha where
+// it is not opaque.
+void WriteFill(const glm::vec4& color, std::ostream& out) {
+  constexpr std::string_view kDigits = "0123456789abcdef";
+  constexpr std::size_t kNibble = 16;
+  out << " fill=\"#";
+  for (const float channel : {color.r, color.g, color.b}) {
+    const auto value = static_cast<std::size_t>(Channel(channel));
+    out << kDigits[value / kNibble] << kDigits[value % kNibble];
+  }
+  out << '"';
+  if (Channel(color.a) < static_cast<int>(kChannelMax)) {
+    out << " fill-opacity=\"" << Number(std::clamp(color.a, 0.0F, 1.0F))
+        << '"';
+  }
+}
+
+void WriteRectangle(const PageBox& box, const glm::vec4& color,
+                    std::ostream& out) {
+  out << "<rect x=\"" << Number(box.left) << "\" y=\"" << Number(box.top)
+      << "\" width=\"" << Number(box.right - box.left) << "\" height=\""
+      << Number(box.bottom - box.top) << '"';
+  WriteFill(color, out);
+  out << "/>\n";
+}
+
+void WriteOutline(const PageBox& box, std::ostream& out) {
+  out << 'M' << Number(box.left) << ' ' << Number(box.top) << 'H'
+      << Number(box.right) << 'V' << Number(box.bottom) << 'H'
+      << Number(box.left) << 'Z';
+}
+
+// The box less its hole, as one path the even-odd rule cuts the hole from.
+// A hole of no size — an outline wider than its box — leaves the box whole.
+void WriteFrame(const Item& frame, std::ostream& out) {
+  if (IsEmpty(frame.hole)) {
+    WriteRectangle(frame.box, frame.color, out);
+    return;
+  }
+  out << "<path d=\"";
+  WriteOutline(frame.box, out);
+  WriteOutline(frame.hole, out);
+  out << "\" fill-rule=\"evenodd\"";
+  WriteFill(frame.color, out);
+  out << "/>\n";
+}
+
+void WriteText(const Page& page, const Item& text, std::ostream& out) {
+  out << "<text x=\"" << Number(text.origin.x) << "\" y=\""
+      << Number(text.origin.y) << "\" font-size=\"" << Number(text.size)
+      << '"';
+  if (text.font < page.fonts.size()) {
+    out << " font-family=\"'" << EscapeXml(page.fonts[text.font].family)
+        << "', sans-serif\"";
+  }
+  WriteFill(text.color, out);
+  out << " xml:space=\"preserve\">" << EscapeXml(text.text) << "</text>\n";
+}
+
+}  // namespace
+
+bool IsEmpty(const PageBox& box) {
+  return !(box.right > box.left) || !(box.bottom > box.top);
+}
+
+Item Rectangle(const PageBox& box, const glm::vec4& color) {
+  Item rectangle;
+  rectangle.kind = ItemKind::kRectangle;
+  rectangle.box = box;
+  rectangle.color = color;
+  return rectangle;
+}
+
+Item Frame(const PageBox& outer, const PageBox& inner,
+           const glm::vec4& color) {
+  Item frame;
+  frame.kind = ItemKind::kFrame;
+  frame.box = outer;
+  frame.hole = inner;
+  frame.color = color;
+  return frame;
+}
+
+Item Text(std::string text, const glm::vec2& origin, float size,
+          std::size_t font, const glm::vec4& color) {
+  Item line;
+  line.kind = ItemKind::kText;
+  line.text = std::move(text);
+  line.origin = origin;
+  line.size = size;
+  line.font = font;
+  line.color = color;
+  return line;
+}
+
+std::string EscapeXml(const std::string& text) {
+  std::string escaped;
+  escaped.reserve(text.size());
+  for (const char character : text) {
+    switch (character) {
+      case '&':
+        escaped += "&amp;";
+        break;
+      case '<':
+        escaped += "&lt;";
+        break;
+      case '>':
+        escaped += "&gt;";
+        break;
+      case '"':
+        escaped += "&quot;";
+        break;
+      case '\'':
+        escaped += "&apos;";
+        break;
+      default:
+        escaped += character;
+        break;
+    }
+  }
+  return escaped;
+}
+
+void WriteSvg(const Page& page, std::ostream& out) {
+  out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+      << "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" width=\""
+      << Number(page.width) << "mm\" height=\"" << Number(page.height)
+      << "mm\" viewBox=\"0 0 " << Number(page.width) << ' '
+      << Number(page.height) << "\">\n";
+  for (const Item& item : page.items) {
+    if (item.color.a <= 0.0F) {
+      continue;
+    }
+    switch (item.kind) {
+      case ItemKind::kRectangle:
+        if (!IsEmpty(item.box)) {
+          WriteRectangle(item.box, item.color, out);
+        }
+        break;
+      case ItemKind::kFrame:
+        if (!IsEmpty(item.box)) {
+          WriteFrame(item, out);
+        }
+        break;
+      case ItemKind::kText:
+        if (!item.text.empty() && item.size > 0.0F) {
+          WriteText(page, item, out);
+        }
+        break;
+    }
+  }
+  out << "</svg>\n";
+}
+
+std::optional<std::string> WriteSvgFile(const Page& page,
+                                        const std::string& file_path) {
+  std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    return "Cannot open file for writing: " + file_path;
+  }
+  WriteSvg(page, file);
+  file.close();
+  if (!file) {
+    return "Writing to " + file_path + " failed.";
+  }
+  return std::nullopt;
+}
+
+}  // namespace vector_page
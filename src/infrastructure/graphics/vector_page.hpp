@@ -0,0 +1,91 @@
+#ifndef VECTOR_PAGE_HPP
+#define VECTOR_PAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// The calendar page as vector graphics: what the scene draws, in the order it
+// draws it, as rectangles, outline frames and lines of text in page
+// millimetres. The PNG export's cost grows with the square of the dpi; this
+// stays the size of the scene, and a printer or viewer rasterizes it at
+// whatever resolution it has.
+//
+// vector_scene.hpp fills it from the scene, WriteSvg below and the PDF writer
+// of the presentation layer (pdf_page_writer.hpp) write it out. It holds no GL
+// and no Qt, so the writing is testable on its own.
+namespace vector_page {
+
+// An area on the page in millimetres: x to the right from the page's left
+// edge, y down from its top edge — the orientation SVG and PDF painters share.
+struct PageBox {
+  float left;
+  float top;
+  float right;
+  float bottom;
+};
+
+// A font the page's text is set in: the family to name, and the file the
+// scene rendered its glyphs from, for a writer that embeds it.
+struct PageFont {
+  std::string family;
+  std::string file_path;
+};
+
+enum class ItemKind : std::uint8_t {
+  kRectangle,
+  kFrame,
+  kText,
+};
+
+// One thing to draw, in straight (not premultiplied) `color`. A rectangle
+// fills `box`; a frame fills `box` less `hole` — a box's outline, its four
+// mitred strips as one area. Text starts its baseline at `origin`, `size`
+// millimetres to the em, in the page's font number `font`.
+struct Item {
+  ItemKind kind{ItemKind::kRectangle};
+  PageBox box{};
+  PageBox hole{};
+  glm::vec4 color{0.0F};
+  std::string text;
+  glm::vec2 origin{0.0F, 0.0F};
+  float size{0.0F};
+  std::size_t font{0};
+};
+
+struct Page {
+  float width{0.0F};
+  float height{0.0F};
+  std::vector<PageFont> fonts;
+  std::vector<Item> items;
+};
+
+// A box of no area — an inverted one included — which the writers leave out.
+[[nodiscard]] bool IsEmpty(const PageBox& box);
+
+[[nodiscard]] Item Rectangle(const PageBox& box, const glm::vec4& color);
+
+[[nodiscard]] Item Frame(const PageBox& outer, const PageBox& inner,
+                         const glm::vec4& color);
+
+[[nodiscard]] Item Text(std::string text, const glm::vec2& origin, float size,
+                        std::size_t font, const glm::vec4& color);
+
+// Writes `page` as an SVG document, one millimetre to the user unit.
+void WriteSvg(const Page& page, std::ostream& out);
+
+// The same into a file; the error message when it cannot be written.
+[[nodiscard]] std::optional<std::string> WriteSvgFile(
+    const Page& page, const std::string& file_path);
+
+// `text` with the characters XML reserves escaped.
+[[nodiscard]] std::string EscapeXml(const std::string& text);
+
+}  // namespace vector_page
+
+#endif  // VECTOR_PAGE_HPP
@@ -0,0 +1,119 @@
+#include "vector_scene.hpp"
+
+#include <cstddef>
+#include <glm/ext/vector_float4.hpp>
+#include <unordered_map>
+#include <utility>
+
+#include "font.hpp"
+#include "graphics_engine.hpp"
+#include "rect.hpp"
+#include "scene.hpp"
+#include "scene_walk.hpp"
+#include "text_layout.hpp"
+#include "vector_page.hpp"
+
+namespace vector_scene {
+namespace {
+
+using vector_page::PageBox;
+
+// The scene's draw calls as page items in millimetres.
+class ItemList : public scene_walk::Painter {
+ public:
+  ItemList(const scene_walk::Mapping& mapping, float page_width,
+           float page_height)
+      : mapping_(mapping) {
+    page_.width = page_width;
+    page_.height = page_height;
+  }
+
+  void AddBackground(const glm::vec4& color) {
+    page_.items.push_back(vector_page::Rectangle(
+        PageBox{.left = 0.0F,
+                .top = 0.0F,
+                .right = page_.width,
+                .bottom = page_.height},
+        color));
+  }
+
+  void Rectangle(const scene_walk::TargetBox& box,
+                 const glm::vec4& color) override {
+    page_.items.push_back(vector_page::Rectangle(ToPage(box), color));
+  }
+
+  void Frame(const scene_walk::TargetBox& outer,
+             const scene_walk::TargetBox& inner,
+             const glm::vec4& color) override {
+    page_.items.push_back(
+        vector_page::Frame(ToPage(outer), ToPage(inner), color));
+  }
+
+  // The labels as text, not as the quads of the atlas.
+  void Text(const scene_walk::TextDraw& text) override {
+    for (const PlacedText& label : text.texts) {
+      if (label.text.empty() || label.color.a <= 0.0F) {
+        continue;
+      }
+      page_.items.push_back(vector_page::Text(
+          label.text,
+          mapping_.ToTarget(text.world, label.origin.x, label.origin.y),
+          label.size * mapping_.Scale().y, FontIndex(text.font),
+          label.color));
+    }
+  }
+
+  [[nodiscard]] vector_page::Page TakePage() { return std::move(page_); }
+
+ private:
+  [[nodiscard]] static PageBox ToPage(const scene_walk::TargetBox& box) {
+    return {.left = box.left,
+            .top = box.top,
+            .right = box.right,
+            .bottom = box.bottom};
+  }
+
+  // The page's number for `font`, listing it on first use.
+  std::size_t FontIndex(const Font& font) {
+    const auto [found, inserted] =
+        font_indices_.emplace(&font, page_.fonts.size());
+    if (inserted) {
+      page_.fonts.push_back(vector_page::PageFont{
+          .family = font.FamilyName(), .file_path = font.FilePath()});
+    }
+    return found->second;
+  }
+
+  scene_walk::Mapping mapping_;
+  vector_page::Page page_;
+  std::unordered_map<const Font*, std::size_t> font_indices_;
+};
+
+}  // namespace
+
+vector_page::Page BuildPage(Scene& scene, const RectF& ortho_region,
+                            float page_width, float page_height,
+                            const glm::vec4& background) {
+  const scene_walk::Mapping mapping(ortho_region, page_width, page_height);
+  ItemList items(mapping, page_width, page_height);
+  items.AddBackground(background);
+  scene_walk::Walk(scene, mapping, items);
+  return items.TakePage();
+}
+
+vector_page::Page BuildPage(const GraphicsEngine& engine,
+                            const RectF& page_size) {
+  const glm::vec4 background = GraphicsEngine::ClearColorRgba();
+  const auto scene = engine.GetScene();
+  if (!scene.has_value()) {
+    ItemList items(
+        scene_walk::Mapping(page_size, page_size.Width(), page_size.Height()),
+        page_size.Width(), page_size.Height());
+    items.AddBackground(background);
+    return items.TakePage();
+  }
+  return BuildPage(scene->get(), page_size, page_size.Width(),
+                   page_size.Height(), background);
+}
+
+}  // namespace vector_scene
@@ -0,0 +1,33 @@
+#ifndef VECTOR_SCENE_HPP
+#define VECTOR_SCENE_HPP
+
+#include <glm/vec4.hpp>
+
+#include "graphics_engine.hpp"
+#include "rect.hpp"
+#include "scene.hpp"
+#include "vector_page.hpp"
+
+// The scene as a vector_page::Page — the vector export's counterpart of
+// software_page, painting what scene_walk breaks the scene into. Text is kept
+// as text — a FontShape's line and every label of a TextBatchShape, at its
+// baseline origin and em size, in its font — rather than as the quads of the
+// atlas, so a viewer sets it at any size.
+namespace vector_scene {
+
+// `scene` with `ortho_region` spread across a `page_width` x `page_height`
+// millimetre page over `background`.
+[[nodiscard]] vector_page::Page BuildPage(Scene& scene,
+                                          const RectF& ortho_region,
+                                          float page_width, float page_height,
+                                          const glm::vec4& background);
+
+// The page the export draws: the engine's scene over its clear colour, with
+// the `page_size` region one to one in millimetres — what WritePageToPng
+// renders, as vectors. Just the ground while the engine has no scene.
+[[nodiscard]] vector_page::Page BuildPage(const GraphicsEngine& engine,
+                                          const RectF& page_size);
+
+}  // namespace vector_scene
+
+#endif  // VECTOR_SCENE_HPP
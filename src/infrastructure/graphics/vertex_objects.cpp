@@ -2,6 +2,12 @@
 
 #include <epoxy/gl.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
 #include <utility>
 
 VertexArrayObject::VertexArrayObject() { glCreateVertexArrays(1, &name_); }
@@ -28,22 +34,115 @@ void VertexArrayObject::Unbind() { glBindVertexArray(0); }
 
 GLuint VertexArrayObject::Name() const { return name_; }
 
-VertexBufferObject::VertexBufferObject() { glCreateBuffers(1, &name_); }
+PersistentVertexBuffer::~PersistentVertexBuffer() { Release(); }
 
-VertexBufferObject::~VertexBufferObject() { glDeleteBuffers(1, &name_); }
+PersistentVertexBuffer::PersistentVertexBuffer(
+    PersistentVertexBuffer&& other) noexcept
+    : name_(std::exchange(other.name_, 0)),
+      mapped_(std::exchange(other.mapped_, nullptr)),
+      region_capacity_(std::exchange(other.region_capacity_, 0)),
+      current_region_(std::exchange(other.current_region_, 0)),
+      size_(std::exchange(other.size_, 0)),
+      fences_(std::exchange(other.fences_, {})) {}
 
-VertexBufferObject::VertexBufferObject(VertexBufferObject&& other) noexcept
-    : name_(std::exchange(other.name_, 0)) {}
-
-VertexBufferObject& VertexBufferObject::operator=(
-    VertexBufferObject&& other) noexcept {
+PersistentVertexBuffer& PersistentVertexBuffer::operator=(
+    PersistentVertexBuffer&& other) noexcept {
   if (this != &other) {
-    if (name_ != 0) {
-      glDeleteBuffers(1, &name_);
-    }
+    Release();
     name_ = std::exchange(other.name_, 0);
+    mapped_ = std::exchange(other.mapped_, nullptr);
+    region_capacity_ = std::exchange(other.region_capacity_, 0);
+    current_region_ = std::exchange(other.current_region_, 0);
+    size_ = std::exchange(other.size_, 0);
+    fences_ = std::exchange(other.fences_, {});
   }
   return *this;
 }
 
-GLuint VertexBufferObject::Name() const { return name_; }
+void PersistentVertexBuffer::Write(std::span<const std::byte> bytes) {
+  size_ = bytes.size();
+  if (bytes.empty()) {
+    return;
+  }
+  if (bytes.size() > region_capacity_) {
+    Grow(bytes.size());
+  } else {
+    // Everything issued so far may read the region being left; the fence
+    // covers all of it. GL deletes a fence nobody waited on without fuss.
+    glDeleteSync(fences_.at(current_region_));
+    fences_.at(current_region_) =
+        glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    current_region_ = (current_region_ + 1) % kRegionCount;
+    WaitForRegion(current_region_);
+  }
+  std::memcpy(mapped_ + Offset(), bytes.data(), bytes.size());
+}
+
+void PersistentVertexBuffer::Patch(std::size_t offset,
+                                   std::span<const std::byte> bytes) {
+  if (bytes.empty()) {
+    return;
+  }
+  std::memcpy(mapped_ + Offset() + offset, bytes.data(), bytes.size());
+}
+
+GLuint PersistentVertexBuffer::Name() const { return name_; }
+
+GLintptr PersistentVertexBuffer::Offset() const {
+  return static_cast<GLintptr>(current_region_ * region_capacity_);
+}
+
+std::size_t PersistentVertexBuffer::Size() const { return size_; }
+
+void PersistentVertexBuffer::Release() noexcept {
+  for (GLsync& fence : fences_) {
+    glDeleteSync(fence);
+    fence = nullptr;
+  }
+  if (name_ != 0) {
+    // Deleting a mapped buffer unmaps it.
+    glDeleteBuffers(1, &name_);
+    name_ = 0;
+  }
+  mapped_ = nullptr;
+}
+
+void PersistentVertexBuffer::Grow(std::size_t required) {
+  Release();
+
+  std::size_t capacity = std::max(region_capacity_ * 2, kRegionAlignment);
+  while (capacity < required) {
+    capacity *= 2;
+  }
+  region_capacity_ = capacity;
+  current_region_ = 0;
+
+  constexpr GLbitfield kFlags =
+      GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  const auto total = static_cast<GLsizeiptr>(region_capacity_ * kRegionCount);
+  glCreateBuffers(1, &name_);
+  glNamedBufferStorage(name_, total, nullptr, kFlags);
+  mapped_ = static_cast<std::byte*>(
+      glMapNamedBufferRange(name_, 0, total, kFlags));
+  if (mapped_ == nullptr) {
+    throw std::runtime_error("mapping a vertex buffer of " +
+                             std::to_string(total) + " bytes failed");
+  }
+}
+
+void PersistentVertexBuffer::WaitForRegion(std::size_t region) {
+  GLsync& fence = fences_.at(region);
+  if (fence == nullptr) {
+    return;
+  }
+  // One second per round: a GPU that takes longer for a frame is hung, and
+  // writing into memory it still reads would only add a glitch to the hang.
+  constexpr GLuint64 kWaitNanoseconds = 1'000'000'000;
+  GLenum status = GL_TIMEOUT_EXPIRED;
+  while (status == GL_TIMEOUT_EXPIRED) {
+    status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                              kWaitNanoseconds);
+  }
+  glDeleteSync(fence);
+  fence = nullptr;
+}
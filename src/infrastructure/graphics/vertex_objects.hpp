@@ -3,8 +3,12 @@
 
 #include <epoxy/gl.h>
 
-// RAII around the two GL object names a vertex array needs. Both get created
-// the direct-state-access way (`glCreate*` rather than `glGen*`), which is what
+#include <array>
+#include <cstddef>
+#include <span>
+
+// RAII around the two GL objects a vertex array needs. Both get created the
+// direct-state-access way (`glCreate*` rather than `glGen*`), which is what
 // lets every call configuring them take the name as a parameter.
 class VertexArrayObject {
  public:
@@ -30,25 +34,76 @@ class VertexArrayObject {
   GLuint name_{0};
 };
 
-// No Bind of its own: the format, the vertex buffer binding and the upload all
-// name the buffer directly, so a GL_ARRAY_BUFFER binding would be ceremony that
-// changes nothing.
-class VertexBufferObject {
+// The storage behind one vertex attribute: immutable (`glNamedBufferStorage`),
+// mapped once for the buffer's whole life and written through that pointer.
+// GL_DYNAMIC_DRAW storage used to be re-specified by every SetShape — each
+// rebuild and each keystroke in the title had the driver allocate afresh.
+//
+// The storage is split into kRegionCount equal regions used in turn. A write
+// goes into the next region while the GPU may still read the current one, and
+// a fence set on leaving a region says when the GPU is done with it; by the
+// time the ring comes round again that fence has long signalled, so a rebuild
+// does not wait on the GPU. The regions grow — all of them, by doubling —
+// only when a write does not fit any more, and never shrink: a calendar
+// rebuilt with the same span writes the same sizes again and again.
+//
+// No Bind of its own: the vertex array names the buffer and the current
+// region's offset directly (glVertexArrayVertexBuffer), which is why both
+// change after a Write and the shape has to re-point its binding.
+class PersistentVertexBuffer {
  public:
-  VertexBufferObject();
+  PersistentVertexBuffer() = default;
+
+  ~PersistentVertexBuffer();
+
+  PersistentVertexBuffer(const PersistentVertexBuffer&) = delete;
+  PersistentVertexBuffer& operator=(const PersistentVertexBuffer&) = delete;
 
-  ~VertexBufferObject();
+  PersistentVertexBuffer(PersistentVertexBuffer&& other) noexcept;
+  PersistentVertexBuffer& operator=(PersistentVertexBuffer&& other) noexcept;
 
-  VertexBufferObject(const VertexBufferObject&) = delete;
-  VertexBufferObject& operator=(const VertexBufferObject&) = delete;
+  // Copies `bytes` into the next free region, which becomes the current one.
+  void Write(std::span<const std::byte> bytes);
 
-  VertexBufferObject(VertexBufferObject&& other) noexcept;
-  VertexBufferObject& operator=(VertexBufferObject&& other) noexcept;
+  // Overwrites part of the current region, starting `offset` bytes into it.
+  // The GPU may still read that region for a frame in flight, so a frame
+  // drawn meanwhile may show the old bytes or the new; for a highlight colour
+  // that is the one frame it would have lagged anyway. The caller checks the
+  // range against Size().
+  void Patch(std::size_t offset, std::span<const std::byte> bytes);
 
+  // Zero until the first non-empty Write.
   [[nodiscard]] GLuint Name() const;
 
+  // Where the current region starts, for the vertex array binding.
+  [[nodiscard]] GLintptr Offset() const;
+
+  // Bytes the last Write put into the current region.
+  [[nodiscard]] std::size_t Size() const;
+
  private:
+  void Release() noexcept;
+
+  // Replaces the storage with one whose regions hold at least `required`
+  // bytes. Deleting the old buffer is safe with draws still in flight: GL
+  // keeps the storage alive until they are done.
+  void Grow(std::size_t required);
+
+  // Blocks until the GPU has finished the commands fenced for `region`, which
+  // it normally has — the ring is kRegionCount writes deep.
+  void WaitForRegion(std::size_t region);
+
+  static constexpr std::size_t kRegionCount = 3;
+  // Regions start at a multiple of this, so each starts where any attribute
+  // type is aligned; also the smallest region a buffer gets.
+  static constexpr std::size_t kRegionAlignment = 256;
+
   GLuint name_{0};
+  std::byte* mapped_{nullptr};
+  std::size_t region_capacity_{0};
+  std::size_t current_region_{0};
+  std::size_t size_{0};
+  std::array<GLsync, kRegionCount> fences_{};
 };
 
 #endif  // VERTEX_OBJECTS_HPP
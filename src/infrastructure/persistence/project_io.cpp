@@ -6,6 +6,8 @@
 #include <exception>
 #include <fstream>
 #include <optional>
+#include <ostream>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -73,6 +75,36 @@ std::optional<std::string> LoadProjectXml(
   return std::nullopt;
 }
 
+namespace {
+
+// The project into `stream`; throws what the archive throws. The archive
+// destructor writes the XML closing — hence the scope of its own, which ends
+// before the caller looks at the stream. The stores carry no serialisation code
+// themselves; what gets persisted are their domain values.
+void WriteProjectXml(std::ostream& stream,
+                     const DateGroupStore& date_groups_store,
+                     const DateEntryStore& date_entry_store,
+                     const PageSetupStore& page_setup_store,
+                     const TitleConfigStore& title_config_store,
+                     const ShapeConfigurationStore& shape_configuration_store,
+                     const CalendarConfigStore& calendar_configuration_store) {
+  boost::archive::xml_oarchive oarchive(stream);
+  oarchive << boost::serialization::make_nvp("date_groups",
+                                             date_groups_store.Get().Items());
+  oarchive << boost::serialization::make_nvp("date_entries",
+                                             date_entry_store.Get().Items());
+  oarchive << boost::serialization::make_nvp("page_setup",
+                                             page_setup_store.Get());
+  oarchive << boost::serialization::make_nvp("title_config",
+                                             title_config_store.Get());
+  oarchive << boost::serialization::make_nvp("shape_config",
+                                             shape_configuration_store.Get());
+  oarchive << boost::serialization::make_nvp(
+      "calendar_config", calendar_configuration_store.Get());
+}
+
+}  // namespace
+
 std::optional<std::string> SaveProjectXml(
     const std::string& file_path, const DateGroupStore& date_groups_store,
     const DateEntryStore& date_entry_store,
@@ -86,22 +118,9 @@ std::optional<std::string> SaveProjectXml(
   }
 
   try {
-    // The archive destructor writes the XML closing — hence the scope of its
-    // own before the stream check. The stores carry no serialisation code
-    // themselves; what gets persisted are their domain values.
-    boost::archive::xml_oarchive oarchive(filestream);
-    oarchive << boost::serialization::make_nvp("date_groups",
-                                               date_groups_store.Get().Items());
-    oarchive << boost::serialization::make_nvp("date_entries",
-                                               date_entry_store.Get().Items());
-    oarchive << boost::serialization::make_nvp("page_setup",
-                                               page_setup_store.Get());
-    oarchive << boost::serialization::make_nvp("title_config",
-                                               title_config_store.Get());
-    oarchive << boost::serialization::make_nvp("shape_config",
-                                               shape_configuration_store.Get());
-    oarchive << boost::serialization::make_nvp(
-        "calendar_config", calendar_configuration_store.Get());
+    WriteProjectXml(filestream, date_groups_store, date_entry_store,
+                    page_setup_store, title_config_store,
+                    shape_configuration_store, calendar_configuration_store);
   } catch (const std::exception& write_error) {
     return "Saving the project file failed: " + std::string(write_error.what());
   }
@@ -113,4 +132,22 @@ std::optional<std::string> SaveProjectXml(
   return std::nullopt;
 }
 
+std::string ProjectXml(
+    const DateGroupStore& date_groups_store,
+    const DateEntryStore& date_entry_store,
+    const PageSetupStore& page_setup_store,
+    const TitleConfigStore& title_config_store,
+    const ShapeConfigurationStore& shape_configuration_store,
+    const CalendarConfigStore& calendar_configuration_store) {
+  std::ostringstream stream;
+  try {
+    WriteProjectXml(stream, date_groups_store, date_entry_store,
+                    page_setup_store, title_config_store,
+                    shape_configuration_store, calendar_configuration_store);
+  } catch (const std::exception&) {
+    return {};
+  }
+  return stream.str();
+}
+
 }  // namespace persistence
@@ -34,6 +34,17 @@ namespace persistence {
     const ShapeConfigurationStore& shape_configuration_store,
     const CalendarConfigStore& calendar_configuration_store);
 
+// The project exactly as SaveProjectXml writes it, as a string: the canonical
+// form of the state, which the export cache hashes. Empty when the archive
+// throws, which a well-formed store never makes it do.
+[[nodiscard]] std::string ProjectXml(
+    const DateGroupStore& date_groups_store,
+    const DateEntryStore& date_entry_store,
+    const PageSetupStore& page_setup_store,
+    const TitleConfigStore& title_config_store,
+    const ShapeConfigurationStore& shape_configuration_store,
+    const CalendarConfigStore& calendar_configuration_store);
+
 }  // namespace persistence
 
 #endif  // PROJECT_IO_HPP
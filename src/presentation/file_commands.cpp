@@ -8,7 +8,9 @@
 #include <string>
 
 #include "../application/project_document.hpp"
+#include "../infrastructure/graphics/vector_page.hpp"
 #include "main_frame.hpp"
+#include "pdf_page_writer.hpp"
 
 FileCommands::FileCommands(MainFrame& frame,
                            application::ProjectDocument& document)
@@ -34,6 +36,12 @@ void FileCommands::Execute(FileCommand command) {
     case FileCommand::kExportPng:
       ExportPng();
       break;
+    case FileCommand::kExportSvg:
+      ExportSvg();
+      break;
+    case FileCommand::kExportPdf:
+      ExportPdf();
+      break;
   }
 }
 
@@ -82,7 +90,27 @@ void FileCommands::ExportPng() {
   if (file_path.empty()) {
     return;
   }
-  frame_.Canvas().SavePNG(file_path);
+  if (!frame_.Canvas().SavePNG(file_path)) {
+    Report("Export PNG file", "Could not write " + file_path);
+  }
+}
+
+void FileCommands::ExportSvg() {
+  const std::string file_path = AskSavePath("Export SVG file", kSvgFile);
+  if (file_path.empty()) {
+    return;
+  }
+  Report("Export SVG file", vector_page::WriteSvgFile(
+                                frame_.Canvas().VectorPage(), file_path));
+}
+
+void FileCommands::ExportPdf() {
+  const std::string file_path = AskSavePath("Export PDF file", kPdfFile);
+  if (file_path.empty()) {
+    return;
+  }
+  Report("Export PDF file", pdf_page_writer::WritePdfFile(
+                                frame_.Canvas().VectorPage(), file_path));
 }
 
 std::string FileCommands::AskOpenPath(const QString& title,
@@ -39,6 +39,10 @@ class FileCommands {
       .filter = "CSV and TXT files (*.csv *.txt)", .extension = "csv"};
   static constexpr FileType kPngFile{.filter = "PNG files (*.png)",
                                      .extension = "png"};
+  static constexpr FileType kSvgFile{.filter = "SVG files (*.svg)",
+                                     .extension = "svg"};
+  static constexpr FileType kPdfFile{.filter = "PDF files (*.pdf)",
+                                     .extension = "pdf"};
 
   void OpenXml();
 
@@ -53,6 +57,11 @@ class FileCommands {
 
   void ExportPng();
 
+  // The page as vectors, which no dpi applies to.
+  void ExportSvg();
+
+  void ExportPdf();
+
   // An empty return value means: cancelled.
   [[nodiscard]] std::string AskOpenPath(const QString& title,
                                         const QString& filter);
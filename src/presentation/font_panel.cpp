@@ -10,13 +10,14 @@
 #include <QtWidgets/QHBoxLayout>
 #include <QtWidgets/QPushButton>
 #include <QtWidgets/QWidget>
-#include <cstring>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "../common/debug_log.hpp"
 #include "../domain/font_config.hpp"
+#include "../infrastructure/graphics/font_match.hpp"
 #include "make_owned.hpp"
 
 FontPanel::FontPanel(QWidget* parent)
@@ -74,63 +75,21 @@ void FontPanel::ProcessFontData() {
               << "\t font_weight: " << static_cast<int>(font_.weight()) << '\n';
   }
 
-  FcPattern* pattern = FcPatternCreate();
-  if (pattern == nullptr) {
-    std::cerr << "ProcessFontData: FcPatternCreate failed\n";
-    return;
-  }
-  const std::string face_name_utf8 = face_name.toStdString();
-  FcPatternAddString(pattern, FC_FAMILY,
-                     reinterpret_cast<const FcChar8*>(face_name_utf8.c_str()));
-
-  // FC_SIZE is a double according to fontconfig.h (the point size); an
-  // integer here would be a type break that fontconfig matches worse in
-  // silence. For scalable fonts the size chooses no other file anyway — it
-  // stands in the pattern so that size-specific cuts (bitmap fonts, optical
-  // grades) resolve correctly.
-  FcPatternAddDouble(pattern, FC_SIZE, point_size);
-
-  // As a double, so an interpolated value survives instead of being cut
-  // back onto a step.
-  FcPatternAddDouble(pattern, FC_WEIGHT, FcWeightFromQtWeight(font_.weight()));
-  FcPatternAddInteger(pattern, FC_SLANT, FcSlantFromQtStyle(font_.style()));
-
-  // The mandatory prelude to FcFontMatch: FcConfigSubstitute applies the
-  // rules of the system configuration (aliases such as "sans-serif"),
-  // FcDefaultSubstitute fills in the underspecified and converts the point
-  // size into a pixel size. Without both, fontconfig matches wrongly
-  // according to the manual. https://man.archlinux.org/man/FcFontMatch.3.en
-  FcConfigSubstitute(fc_config_.get(), pattern, FcMatchPattern);
-  FcDefaultSubstitute(pattern);
-
-  FcResult result = FcResultNoMatch;
-  FcPattern* match = FcFontMatch(fc_config_.get(), pattern, &result);
-  if (match == nullptr) {
-    std::cerr << "ProcessFontData: no matching font found\n";
-    FcPatternDestroy(pattern);
-    return;
-  }
-
-  // https://fontconfig.pages.freedesktop.org/fontconfig/fontconfig-devel/fcpatternget.html
-  FcChar8* fc_filepath = nullptr;
-  FcResult const fc_result =
-      FcPatternGetString(match, FC_FILE, 0, &fc_filepath);
-  if (fc_result != FcResultMatch || fc_filepath == nullptr) {
-    std::cerr << "ProcessFontData: matched font has no file path\n";
-    FcPatternDestroy(match);
-    FcPatternDestroy(pattern);
+  const std::optional<std::string> file_path =
+      MatchFontFile(fc_config_.get(),
+                    {.family = face_name.toStdString(),
+                     .point_size = point_size,
+                     .weight = FcWeightFromQtWeight(font_.weight()),
+                     .slant = FcSlantFromQtStyle(font_.style())});
+  if (!file_path) {
     return;
   }
 
-  const size_t length = strlen(reinterpret_cast<const char*>(fc_filepath));
-  font_config_.SetFilePath(std::string(fc_filepath, fc_filepath + length));
+  font_config_.SetFilePath(*file_path);
   font_config_.SetSizePoints(static_cast<float>(point_size));
   if (decade_debug::LogEnabled()) {
     std::cout << "font_filepath: " << font_config_.FilePath() << '\n';
   }
-
-  FcPatternDestroy(match);
-  FcPatternDestroy(pattern);
 }
 
 void FontPanel::ChooseFont() {
@@ -2,7 +2,9 @@
 
 #include <epoxy/gl.h>
 
+#include <QtCore/QMetaObject>
 #include <QtCore/QPoint>
+#include <QtCore/QStandardPaths>
 #include <QtCore/QString>
 #include <QtCore/Qt>
 #include <QtGui/QClipboard>
@@ -18,11 +20,13 @@
 #include <chrono>
 #include <cmath>
 #include <exception>
+#include <filesystem>
 #include <functional>
 #include <glm/ext/vector_float2.hpp>
 #include <glm/ext/vector_int2.hpp>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -38,6 +42,11 @@
 #include "../infrastructure/graphics/projection.hpp"
 #include "../infrastructure/graphics/rect.hpp"
 #include "../infrastructure/graphics/render_to_png.hpp"
+#include "../infrastructure/graphics/render_to_texture.hpp"
+#include "../infrastructure/graphics/scene.hpp"
+#include "../infrastructure/graphics/software_raster.hpp"
+#include "../infrastructure/graphics/vector_page.hpp"
+#include "../infrastructure/graphics/vector_scene.hpp"
 #include "mouse_interaction.hpp"
 
 QSurfaceFormat GLCanvas::SurfaceFormat() {
@@ -86,6 +95,10 @@ bool GLCanvas::HasEngine() const { return graphics_engine_ != nullptr; }
 
 void GLCanvas::MakeGraphicsCurrent() { makeCurrent(); }
 
+void GLCanvas::PostToGraphicsThread(std::function<void()> task) {
+  QMetaObject::invokeMethod(this, std::move(task), Qt::QueuedConnection);
+}
+
 void GLCanvas::SetPointerMoveCallback(std::function<void(glm::vec2)> callback) {
   on_pointer_move_ = std::move(callback);
 }
@@ -112,6 +125,10 @@ void GLCanvas::SetSelectedTextSource(std::function<std::string()> source) {
   selected_text_ = std::move(source);
 }
 
+void GLCanvas::SetExportPreparation(std::function<void()> prepare) {
+  prepare_export_ = std::move(prepare);
+}
+
 void GLCanvas::ReceivePageSetup(const PageSetupConfig& page_setup_config) {
   page_size_ = PageRect(page_setup_config);
   if (decade_debug::LogEnabled()) {
@@ -140,10 +157,41 @@ void GLCanvas::Repaint() { update(); }
 
 double GLCanvas::CurrentFps() const { return frame_stats_.Fps(); }
 
-void GLCanvas::SavePNG(const std::string& file_path, int dpi) {
+bool GLCanvas::SavePNG(const std::string& file_path, int dpi,
+                       const png_io::EncodeOptions& encoding,
+                       software_raster::PageRenderer renderer,
+                       const std::vector<png_io::PngText>& text) {
+  if (prepare_export_) {
+    prepare_export_();
+  }
+  makeCurrent();
+  return WritePageToPng(file_path, page_size_, static_cast<float>(dpi),
+                        *graphics_engine_, kExportMsaaSamples, encoding,
+                        renderer, text);
+}
+
+bool GLCanvas::SaveDeepZoom(const std::string& file_path, int dpi,
+                            const png_io::EncodeOptions& encoding,
+                            software_raster::PageRenderer renderer) {
+  if (prepare_export_) {
+    prepare_export_();
+  }
+  makeCurrent();
+  return WritePageToDzi(file_path, page_size_, static_cast<float>(dpi),
+                        *graphics_engine_, kExportMsaaSamples, encoding,
+                        renderer);
+}
+
+int GLCanvas::ExportSamples() {
   makeCurrent();
-  WritePageToPng(file_path, page_size_, static_cast<float>(dpi),
-                 *graphics_engine_, kExportMsaaSamples);
+  return UsableSamples(kExportMsaaSamples);
+}
+
+vector_page::Page GLCanvas::VectorPage() {
+  if (prepare_export_) {
+    prepare_export_();
+  }
+  return vector_scene::BuildPage(*graphics_engine_, page_size_);
 }
 
 QImage GLCanvas::CaptureImage() { return grabFramebuffer(); }
@@ -166,7 +214,8 @@ void GLCanvas::initializeGL() {
 
   ApplyInitialGlState();
   try {
-    graphics_engine_ = std::make_unique<GraphicsEngine>();
+    graphics_engine_ =
+        std::make_unique<GraphicsEngine>(ShaderCacheDirectory());
   } catch (const std::exception& error) {
     graphics_engine_.reset();
     ReportFailure(error.what());
@@ -330,6 +379,15 @@ std::string GLCanvas::DescribeDriver() {
          DriverString(GL_VENDOR) + "\nGL_RENDERER " + DriverString(GL_RENDERER);
 }
 
+std::optional<std::filesystem::path> GLCanvas::ShaderCacheDirectory() {
+  const QString cache =
+      QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  if (cache.isEmpty()) {
+    return std::nullopt;
+  }
+  return std::filesystem::path(cache.toStdString()) / "shaders";
+}
+
 std::string GLCanvas::DriverString(GLenum name) {
   const auto* value = glGetString(name);
   if (value == nullptr) {
@@ -402,7 +460,13 @@ void GLCanvas::LogFrameStats(FrameStats::Clock::time_point now) {
   }
   last_fps_log_ = now;
   std::cout << "FPS: " << frame_stats_.Fps() << " (render "
-            << frame_stats_.LastRenderMillis() << " ms)\n";
+            << frame_stats_.LastRenderMillis() << " ms";
+  if (graphics_engine_) {
+    const Scene::CullStats cull_stats = graphics_engine_->LastCullStats();
+    std::cout << ", drawn " << cull_stats.drawn << ", culled "
+              << cull_stats.culled;
+  }
+  std::cout << ")\n";
 }
 
 glm::ivec2 GLCanvas::PhysicalPosition(const QPointF& position) const {
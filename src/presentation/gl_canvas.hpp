@@ -7,6 +7,7 @@
 // those, so a header that reaches Qt first breaks the build.
 #include <epoxy/gl.h>
 
+#include <QtCore/QMetaObject>
 #include <QtCore/QString>
 #include <QtGui/QClipboard>
 #include <QtGui/QGuiApplication>
@@ -22,12 +23,15 @@
 #include <chrono>
 #include <cmath>
 #include <exception>
+#include <filesystem>
 #include <functional>
 #include <glm/vec2.hpp>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "../application/calendar/text_input_event.hpp"
 #include "../application/render_surface.hpp"
@@ -39,9 +43,13 @@
 #include "../infrastructure/graphics/mvp_matrices.hpp"
 #include "../infrastructure/graphics/page_geometry.hpp"
 #include "../infrastructure/graphics/pan_zoom_camera.hpp"
+#include "../infrastructure/graphics/png_strip_encoder.hpp"
+#include "../infrastructure/graphics/png_writer.hpp"
 #include "../infrastructure/graphics/projection.hpp"
 #include "../infrastructure/graphics/rect.hpp"
 #include "../infrastructure/graphics/render_to_png.hpp"
+#include "../infrastructure/graphics/software_raster.hpp"
+#include "../infrastructure/graphics/vector_page.hpp"
 #include "mouse_interaction.hpp"
 
 // The drawing window: it owns the rendering engine, the view (projection,
@@ -73,6 +81,20 @@ class GLCanvas : public QOpenGLWidget, public application::RenderSurface {
   // https://doc.qt.io/qt-6/qopenglwidget.html#details
   [[nodiscard]] static QSurfaceFormat SurfaceFormat();
 
+  // How initializeGL sets a fresh context up. HeadlessCanvas takes the same
+  // steps, so its export matches the one from the window.
+
+  // Valid with a current context alone; without one glGetString returns
+  // nullptr, hence the fallback instead of a cast into the void.
+  [[nodiscard]] static std::string DescribeDriver();
+
+  // Where the linked shader programs are kept between starts: "shaders" in
+  // the user's cache directory, none when the platform names no such place.
+  [[nodiscard]] static std::optional<std::filesystem::path>
+  ShaderCacheDirectory();
+
+  static void ApplyInitialGlState();
+
   explicit GLCanvas(QWidget* parent);
 
   // The engine owns GL objects, and deleting one without a current context is
@@ -111,6 +133,10 @@ class GLCanvas : public QOpenGLWidget, public application::RenderSurface {
   // callback, which is exactly where the first scene gets built.
   void MakeGraphicsCurrent() override;
 
+  // Queued as an event on the canvas, so the task runs on the GUI thread, the
+  // one owning the context, and is dropped with the canvas.
+  void PostToGraphicsThread(std::function<void()> task) override;
+
   // Called on every mouse movement with the pointer in page space, so an
   // interaction controller can hit-test on it. The binder sets it.
   void SetPointerMoveCallback(std::function<void(glm::vec2)> callback);
@@ -130,6 +156,10 @@ class GLCanvas : public QOpenGLWidget, public application::RenderSurface {
 
   void SetSelectedTextSource(std::function<std::string()> source);
 
+  // Runs at the start of every export, so the drawing is complete first — the
+  // glyphs still being rendered, above all.
+  void SetExportPreparation(std::function<void()> prepare);
+
   void ReceivePageSetup(const PageSetupConfig& page_setup_config);
 
   // Refits projection and zoom bounds to the current window and page size and
@@ -149,7 +179,29 @@ class GLCanvas : public QOpenGLWidget, public application::RenderSurface {
 
   // The off-screen framebuffers of the export come into being in this context,
   // so it has to be current — this runs outside the rendering callbacks.
-  void SavePNG(const std::string& file_path, int dpi = kExportPngDpi);
+  // False when no image got written. `text` goes into the file as tEXt chunks.
+  [[nodiscard]] bool SavePNG(const std::string& file_path,
+                             int dpi = kExportPngDpi,
+                             const png_io::EncodeOptions& encoding = {},
+                             software_raster::PageRenderer renderer =
+                                 software_raster::PageRenderer::kGl,
+                             const std::vector<png_io::PngText>& text = {});
+
+  // The page as a Deep Zoom pyramid, `file_path` the descriptor, `dpi` the
+  // resolution of the largest level; as SavePNG otherwise.
+  [[nodiscard]] bool SaveDeepZoom(const std::string& file_path,
+                                  int dpi = kExportPngDpi,
+                                  const png_io::EncodeOptions& encoding = {},
+                                  software_raster::PageRenderer renderer =
+                                      software_raster::PageRenderer::kGl);
+
+  // The samples SavePNG really renders with: kExportMsaaSamples, capped at
+  // what this context's driver multisamples. Makes the context current.
+  [[nodiscard]] int ExportSamples();
+
+  // The page as the PNG export would draw it, as vector items for the SVG and
+  // PDF export: the preparation runs first, so every glyph stands.
+  [[nodiscard]] vector_page::Page VectorPage();
 
   // The rendered canvas content as an image with its origin top left, so it can
   // be mounted into a whole-window screenshot: the widget capture does not see
@@ -204,14 +256,8 @@ class GLCanvas : public QOpenGLWidget, public application::RenderSurface {
 
   [[nodiscard]] static std::string NoContextMessage();
 
-  // Valid with a current context alone; without one glGetString returns
-  // nullptr, hence the fallback instead of a cast into the void.
-  [[nodiscard]] static std::string DescribeDriver();
-
   [[nodiscard]] static std::string DriverString(GLenum name);
 
-  static void ApplyInitialGlState();
-
   // The window size in device pixels — more than the logical one on HiDPI
   // displays, and the size of the framebuffer QOpenGLWidget renders into.
   [[nodiscard]] FramebufferSize CurrentFramebufferSize() const;
@@ -257,6 +303,7 @@ class GLCanvas : public QOpenGLWidget, public application::RenderSurface {
   std::function<void(const TextInputEvent&)> on_text_input_;
   std::function<bool()> is_editing_;
   std::function<std::string()> selected_text_;
+  std::function<void()> prepare_export_;
 
   MouseInteraction mouse_interaction_;
   PanZoomCamera camera_;
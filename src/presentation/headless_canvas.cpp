@@ -0,0 +1,93 @@
+#include "headless_canvas.hpp"
+
+#include <epoxy/gl.h>
+
+#include <QtCore/QMetaObject>
+#include <QtCore/Qt>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "../common/debug_log.hpp"
+#include "../domain/page_setup_config.hpp"
+#include "../infrastructure/graphics/graphics_engine.hpp"
+#include "../infrastructure/graphics/page_geometry.hpp"
+#include "../infrastructure/graphics/render_to_png.hpp"
+#include "../infrastructure/graphics/render_to_texture.hpp"
+#include "../infrastructure/graphics/software_raster.hpp"
+#include "../infrastructure/graphics/vector_page.hpp"
+#include "../infrastructure/graphics/vector_scene.hpp"
+#include "gl_canvas.hpp"
+
+HeadlessCanvas::HeadlessCanvas()
+    : context_(GLCanvas::kRequiredGlMajor, GLCanvas::kRequiredGlMinor) {
+  if (decade_debug::LogEnabled()) {
+    std::cout << "Headless OpenGL ready, version: "
+              << GLCanvas::DescribeDriver() << '\n';
+  }
+  GLCanvas::ApplyInitialGlState();
+  graphics_engine_ =
+      std::make_unique<GraphicsEngine>(GLCanvas::ShaderCacheDirectory());
+}
+
+HeadlessCanvas::~HeadlessCanvas() {
+  context_.MakeCurrent();
+  graphics_engine_.reset();
+}
+
+GraphicsEngine& HeadlessCanvas::Engine() { return *graphics_engine_; }
+
+void HeadlessCanvas::MakeGraphicsCurrent() { context_.MakeCurrent(); }
+
+void HeadlessCanvas::PostToGraphicsThread(std::function<void()> task) {
+  QMetaObject::invokeMethod(&task_scope_, std::move(task),
+                            Qt::QueuedConnection);
+}
+
+void HeadlessCanvas::ReceivePageSetup(
+    const PageSetupConfig& page_setup_config) {
+  page_size_ = PageRect(page_setup_config);
+}
+
+void HeadlessCanvas::SetExportPreparation(std::function<void()> prepare) {
+  prepare_export_ = std::move(prepare);
+}
+
+bool HeadlessCanvas::SavePNG(const std::string& file_path, int dpi,
+                             const png_io::EncodeOptions& encoding,
+                             software_raster::PageRenderer renderer,
+                             const std::vector<png_io::PngText>& text) {
+  if (prepare_export_) {
+    prepare_export_();
+  }
+  context_.MakeCurrent();
+  return WritePageToPng(file_path, page_size_, static_cast<float>(dpi),
+                        *graphics_engine_, GLCanvas::kExportMsaaSamples,
+                        encoding, renderer, text);
+}
+
+bool HeadlessCanvas::SaveDeepZoom(const std::string& file_path, int dpi,
+                                  const png_io::EncodeOptions& encoding,
+                                  software_raster::PageRenderer renderer) {
+  if (prepare_export_) {
+    prepare_export_();
+  }
+  context_.MakeCurrent();
+  return WritePageToDzi(file_path, page_size_, static_cast<float>(dpi),
+                        *graphics_engine_, GLCanvas::kExportMsaaSamples,
+                        encoding, renderer);
+}
+
+int HeadlessCanvas::ExportSamples() {
+  context_.MakeCurrent();
+  return UsableSamples(GLCanvas::kExportMsaaSamples);
+}
+
+vector_page::Page HeadlessCanvas::VectorPage() {
+  if (prepare_export_) {
+    prepare_export_();
+  }
+  return vector_scene::BuildPage(*graphics_engine_, page_size_);
+}
@@ -0,0 +1,89 @@
+#ifndef HEADLESS_CANVAS_HPP
+#define HEADLESS_CANVAS_HPP
+
+// libepoxy first, for the reason gl_canvas.hpp gives.
+#include <epoxy/gl.h>
+
+#include <QtCore/QObject>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../application/render_surface.hpp"
+#include "../domain/page_setup_config.hpp"
+#include "../infrastructure/graphics/graphics_engine.hpp"
+#include "../infrastructure/graphics/headless_gl_context.hpp"
+#include "../infrastructure/graphics/png_strip_encoder.hpp"
+#include "../infrastructure/graphics/png_writer.hpp"
+#include "../infrastructure/graphics/rect.hpp"
+#include "../infrastructure/graphics/software_raster.hpp"
+#include "../infrastructure/graphics/vector_page.hpp"
+
+// The render surface of a --headless run: the export half of GLCanvas with
+// neither a window nor a widget behind it. It owns a HeadlessGlContext and the
+// rendering engine on it, takes the page size the way the canvas does and
+// writes the page image through the same WritePageToPng — so the image comes
+// out as the window's would, without a display server, a platform plugin or a
+// single QWidget.
+//
+// Nothing is ever shown, so a refresh or repaint has nothing to do.
+class HeadlessCanvas : public application::RenderSurface {
+ public:
+  // Creates the context and the engine on it. Throws std::runtime_error when
+  // there is no OpenGL 4.6 core context to be had or a shader will not build.
+  HeadlessCanvas();
+
+  // The engine owns GL objects and goes while its context is current.
+  ~HeadlessCanvas() override;
+
+  HeadlessCanvas(const HeadlessCanvas&) = delete;
+  HeadlessCanvas& operator=(const HeadlessCanvas&) = delete;
+  HeadlessCanvas(HeadlessCanvas&&) = delete;
+  HeadlessCanvas& operator=(HeadlessCanvas&&) = delete;
+
+  [[nodiscard]] GraphicsEngine& Engine();
+
+  void RefreshView() override {}
+
+  void Repaint() override {}
+
+  void MakeGraphicsCurrent() override;
+
+  // Queued on the Qt event queue of the thread that made the canvas. A run
+  // that never spins the loop drops what stayed queued; the export prepares
+  // itself by finishing the glyphs instead (SetExportPreparation).
+  void PostToGraphicsThread(std::function<void()> task) override;
+
+  void ReceivePageSetup(const PageSetupConfig& page_setup_config);
+
+  // As GLCanvas::SetExportPreparation.
+  void SetExportPreparation(std::function<void()> prepare);
+
+  // As GLCanvas::SavePNG, at GLCanvas::kExportMsaaSamples.
+  [[nodiscard]] bool SavePNG(const std::string& file_path, int dpi,
+                             const png_io::EncodeOptions& encoding,
+                             software_raster::PageRenderer renderer,
+                             const std::vector<png_io::PngText>& text);
+
+  // As GLCanvas::SaveDeepZoom, at GLCanvas::kExportMsaaSamples.
+  [[nodiscard]] bool SaveDeepZoom(const std::string& file_path, int dpi,
+                                  const png_io::EncodeOptions& encoding,
+                                  software_raster::PageRenderer renderer);
+
+  // As GLCanvas::ExportSamples.
+  [[nodiscard]] int ExportSamples();
+
+  // As GLCanvas::VectorPage.
+  [[nodiscard]] vector_page::Page VectorPage();
+
+ private:
+  HeadlessGlContext context_;
+  std::unique_ptr<GraphicsEngine> graphics_engine_;
+  RectF page_size_;
+  std::function<void()> prepare_export_;
+  // The receiver of the posted tasks; they go with it.
+  QObject task_scope_;
+};
+
+#endif  // HEADLESS_CANVAS_HPP
@@ -167,6 +167,8 @@ void MainFrame::InitMenu() {
   ConnectFileCommand(actions.import_csv, FileCommand::kImportCsv);
   ConnectFileCommand(actions.export_csv, FileCommand::kExportCsv);
   ConnectFileCommand(actions.export_png, FileCommand::kExportPng);
+  ConnectFileCommand(actions.export_svg, FileCommand::kExportSvg);
+  ConnectFileCommand(actions.export_pdf, FileCommand::kExportPdf);
 
   connect(actions.quit, &QAction::triggered, this, [this]() { close(); });
   connect(actions.license_info, &QAction::triggered, this, [this]() {
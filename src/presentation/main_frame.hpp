@@ -39,6 +39,8 @@ enum class FileCommand : std::uint8_t {
   kImportCsv,
   kExportCsv,
   kExportPng,
+  kExportSvg,
+  kExportPdf,
 };
 
 // The main window: it builds the layout, owns panels, canvas and menu and
@@ -25,6 +25,8 @@ void MainMenu::AttachTo(QMainWindow& window) {
   actions_.export_csv = file_menu->addAction("&Export csv...");
   file_menu->addSeparator();
   actions_.export_png = file_menu->addAction(ExportPngLabel());
+  actions_.export_svg = file_menu->addAction("Export s&vg...");
+  actions_.export_pdf = file_menu->addAction("Export &pdf...");
   file_menu->addSeparator();
   actions_.quit = file_menu->addAction("E&xit");
   actions_.quit->setShortcut(QKeySequence::Quit);
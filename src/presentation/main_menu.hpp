@@ -19,6 +19,8 @@ struct MainMenuActions {
   QPointer<QAction> import_csv;
   QPointer<QAction> export_csv;
   QPointer<QAction> export_png;
+  QPointer<QAction> export_svg;
+  QPointer<QAction> export_pdf;
   QPointer<QAction> quit;
   QPointer<QAction> license_info;
 };
@@ -53,10 +53,25 @@ PageSetupPanel::PageSetupPanel(QWidget* parent) : QWidget(parent) {
 }
 
 void PageSetupPanel::SendPageSetup() {
+  emit PageSetupEdited(ToPageSetupConfig(page_layout_));
+}
+
+PageSetupConfig PageSetupPanel::DefaultPageSetup() {
+  return ToPageSetupConfig(DefaultPageLayout());
+}
+
+QPageLayout PageSetupPanel::DefaultPageLayout() {
+  return {QPageSize(QPageSize::A4), QPageLayout::Landscape,
+          QMarginsF(kPageMarginMm, kPageMarginMm, kPageMarginMm, kPageMarginMm),
+          QPageLayout::Millimeter};
+}
+
+PageSetupConfig PageSetupPanel::ToPageSetupConfig(
+    const QPageLayout& page_layout) {
   PageSetupConfig page_setup_config;
 
-  const QSizeF paper = PaperSizeMillimetres();
-  const bool landscape = IsLandscape();
+  const QSizeF paper = page_layout.pageSize().size(QPageSize::Millimeter);
+  const bool landscape = page_layout.orientation() == QPageLayout::Landscape;
 
   page_setup_config.SetOrientation(landscape ? kLandscape : kPortrait);
   page_setup_config.SetSize(
@@ -65,12 +80,11 @@ void PageSetupPanel::SendPageSetup() {
                 : std::array<float, 2>{static_cast<float>(paper.width()),
                                        static_cast<float>(paper.height())});
 
-  const QMarginsF margins = page_layout_.margins(QPageLayout::Millimeter);
+  const QMarginsF margins = page_layout.margins(QPageLayout::Millimeter);
   page_setup_config.SetMargins(
       {static_cast<float>(margins.left()), static_cast<float>(margins.bottom()),
        static_cast<float>(margins.right()), static_cast<float>(margins.top())});
-
-  emit PageSetupEdited(page_setup_config);
+  return page_setup_config;
 }
 
 void PageSetupPanel::ReceivePageSetup(
@@ -31,6 +31,10 @@ class PageSetupPanel : public QWidget {
 
   void SendDefaultValues();
 
+  // What SendDefaultValues sends: A4 landscape with kPageMarginMm all round.
+  // A --headless run starts from it, there being no panel to send it.
+  [[nodiscard]] static PageSetupConfig DefaultPageSetup();
+
  signals:
   void PageSetupEdited(const PageSetupConfig& page_setup_config);
 
@@ -46,6 +50,13 @@ class PageSetupPanel : public QWidget {
   static constexpr double kMaxPageSizeMm = 2000.0;
   static constexpr qreal kPageMarginMm = 15.0;
 
+  [[nodiscard]] static QPageLayout DefaultPageLayout();
+
+  // The page as the domain counts it: width and height as it lies, margins
+  // left, bottom, right, top.
+  [[nodiscard]] static PageSetupConfig ToPageSetupConfig(
+      const QPageLayout& page_layout);
+
   [[nodiscard]] bool IsLandscape() const;
 
   // QPageSize always reports the paper in portrait; the orientation is a
@@ -63,10 +74,7 @@ class PageSetupPanel : public QWidget {
 
   void OnSpinChanged();
 
-  QPageLayout page_layout_{
-      QPageSize(QPageSize::A4), QPageLayout::Landscape,
-      QMarginsF(kPageMarginMm, kPageMarginMm, kPageMarginMm, kPageMarginMm),
-      QPageLayout::Millimeter};
+  QPageLayout page_layout_{DefaultPageLayout()};
 
   QPointer<QDoubleSpinBox> page_width_spin_;
   QPointer<QDoubleSpinBox> page_height_spin_;
@@ -0,0 +1,177 @@
+#include "pdf_page_writer.hpp"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QMarginsF>
+#include <QtCore/QPointF>
+#include <QtCore/QRectF>
+#include <QtCore/QSizeF>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/Qt>
+#include <QtGui/QColor>
+#include <QtGui/QFont>
+#include <QtGui/QFontDatabase>
+#include <QtGui/QGuiApplication>
+#include <QtGui/QPageLayout>
+#include <QtGui/QPageSize>
+#include <QtGui/QPainter>
+#include <QtGui/QPainterPath>
+#include <QtGui/QPdfWriter>
+#include <cstddef>
+#include <glm/ext/vector_float4.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../infrastructure/graphics/vector_page.hpp"
+
+namespace pdf_page_writer {
+namespace {
+
+using vector_page::Item;
+using vector_page::ItemKind;
+using vector_page::PageBox;
+
+// The resolution of the PDF's coordinate space. Nothing is rasterized; it
+// only grids the coordinates, finer than any printer.
+constexpr int kResolution = 1200;
+constexpr double kMillimetresPerInch = 25.4;
+// QFont takes integer pixel sizes; the text is set at this size to the em
+// and scaled down to its own, so no size is rounded.
+constexpr int kReferencePixelSize = 1000;
+
+QColor ToQColor(const glm::vec4& color) {
+  return QColor::fromRgbF(color.r, color.g, color.b, color.a);
+}
+
+QRectF ToQRect(const PageBox& box) {
+  return {QPointF(box.left, box.top), QPointF(box.right, box.bottom)};
+}
+
+// The page's fonts for the painter, registered from their files; a font
+// whose file does not load falls back to its family name.
+class PageFonts {
+ public:
+  explicit PageFonts(const std::vector<vector_page::PageFont>& fonts) {
+    fonts_.reserve(fonts.size());
+    for (const vector_page::PageFont& page_font : fonts) {
+      const int id = QFontDatabase::addApplicationFont(
+          QString::fromStdString(page_font.file_path));
+      QString family = QString::fromStdString(page_font.family);
+      if (id >= 0) {
+        ids_.push_back(id);
+        const QStringList families =
+            QFontDatabase::applicationFontFamilies(id);
+        if (!families.isEmpty()) {
+          family = families.front();
+        }
+      }
+      QFont font(family);
+      font.setPixelSize(kReferencePixelSize);
+      font.setKerning(false);
+      fonts_.push_back(font);
+    }
+  }
+
+  ~PageFonts() {
+    for (const int id : ids_) {
+      QFontDatabase::removeApplicationFont(id);
+    }
+  }
+
+  PageFonts(const PageFonts&) = delete;
+  PageFonts& operator=(const PageFonts&) = delete;
+  PageFonts(PageFonts&&) = delete;
+  PageFonts& operator=(PageFonts&&) = delete;
+
+  [[nodiscard]] QFont At(std::size_t index) const {
+    return index < fonts_.size() ? fonts_[index] : QFont();
+  }
+
+ private:
+  std::vector<int> ids_;
+  std::vector<QFont> fonts_;
+};
+
+void PaintFrame(QPainter& painter, const Item& frame) {
+  if (vector_page::IsEmpty(frame.hole)) {
+    painter.fillRect(ToQRect(frame.box), ToQColor(frame.color));
+    return;
+  }
+  QPainterPath path;
+  path.setFillRule(Qt::OddEvenFill);
+  path.addRect(ToQRect(frame.box));
+  path.addRect(ToQRect(frame.hole));
+  painter.fillPath(path, ToQColor(frame.color));
+}
+
+void PaintText(QPainter& painter, const PageFonts& fonts, const Item& text) {
+  const double scale = text.size / kReferencePixelSize;
+  painter.save();
+  painter.translate(text.origin.x, text.origin.y);
+  painter.scale(scale, scale);
+  painter.setFont(fonts.At(text.font));
+  painter.setPen(ToQColor(text.color));
+  painter.drawText(QPointF(0.0, 0.0), QString::fromStdString(text.text));
+  painter.restore();
+}
+
+}  // namespace
+
+std::optional<std::string> WritePdfFile(const vector_page::Page& page,
+                                        const std::string& file_path) {
+  if (qobject_cast<QGuiApplication*>(QCoreApplication::instance()) ==
+      nullptr) {
+    return "The PDF export needs the window's application (no --headless); "
+           "write SVG instead: " +
+           file_path;
+  }
+
+  QPdfWriter writer(QString::fromStdString(file_path));
+  writer.setCreator(QCoreApplication::applicationName());
+  writer.setResolution(kResolution);
+  writer.setPageLayout(QPageLayout(
+      QPageSize(QSizeF(page.width, page.height), QPageSize::Millimeter),
+      QPageLayout::Portrait, QMarginsF(), QPageLayout::Millimeter));
+
+  const PageFonts fonts(page.fonts);
+  QPainter painter;
+  if (!painter.begin(&writer)) {
+    return "Cannot open file for writing: " + file_path;
+  }
+  // From here on, page millimetres.
+  const double device_per_millimetre = kResolution / kMillimetresPerInch;
+  painter.scale(device_per_millimetre, device_per_millimetre);
+  painter.setRenderHint(QPainter::Antialiasing);
+  painter.setPen(Qt::NoPen);
+
+  for (const Item& item : page.items) {
+    if (item.color.a <= 0.0F) {
+      continue;
+    }
+    switch (item.kind) {
+      case ItemKind::kRectangle:
+        if (!vector_page::IsEmpty(item.box)) {
+          painter.fillRect(ToQRect(item.box), ToQColor(item.color));
+        }
+        break;
+      case ItemKind::kFrame:
+        if (!vector_page::IsEmpty(item.box)) {
+          PaintFrame(painter, item);
+        }
+        break;
+      case ItemKind::kText:
+        if (!item.text.empty() && item.size > 0.0F) {
+          PaintText(painter, fonts, item);
+        }
+        break;
+    }
+  }
+
+  if (!painter.end()) {
+    return "Writing to " + file_path + " failed.";
+  }
+  return std::nullopt;
+}
+
+}  // namespace pdf_page_writer
@@ -0,0 +1,25 @@
+#ifndef PDF_PAGE_WRITER_HPP
+#define PDF_PAGE_WRITER_HPP
+
+#include <optional>
+#include <string>
+
+#include "../infrastructure/graphics/vector_page.hpp"
+
+namespace pdf_page_writer {
+
+// Writes `page` as a one-page PDF of the page's size through QPdfWriter. The
+// rectangles and frames go in as filled paths and the text as text, in the
+// page's fonts: each is registered with Qt's font database from its file for
+// the time of the writing, and the PDF engine embeds the glyphs it uses. The
+// file stays a few hundred kilobytes at any print resolution.
+//
+// The font database needs a QGuiApplication. A --headless run has only a
+// QCoreApplication; it gets the error message, and --dump-svg is the vector
+// export it has. The error message also when the file cannot be written.
+[[nodiscard]] std::optional<std::string> WritePdfFile(
+    const vector_page::Page& page, const std::string& file_path);
+
+}  // namespace pdf_page_writer
+
+#endif  // PDF_PAGE_WRITER_HPP
@@ -165,8 +165,12 @@ QString SceneTreePanel::ShapeKindLabel(SnapshotShapeKind kind) {
       return "Fill";
     case SnapshotShapeKind::kBoxes:
       return "Boxes";
+    case SnapshotShapeKind::kGrid:
+      return "Grid";
     case SnapshotShapeKind::kFont:
       return "Font";
+    case SnapshotShapeKind::kTextBatch:
+      return "Text Batch";
     case SnapshotShapeKind::kNone:
       break;
   }
@@ -0,0 +1,216 @@
+#include <fontconfig/fontconfig.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <glm/mat4x4.hpp>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "application/calendar/calendar_scene_composer.hpp"
+#include "application/calendar/calendar_scene_nodes.hpp"
+#include "application/calendar/scene_rebuild.hpp"
+#include "domain/calendar_config.hpp"
+#include "domain/date.hpp"
+#include "domain/date_entry.hpp"
+#include "domain/date_entry_bars.hpp"
+#include "domain/date_group.hpp"
+#include "domain/date_period.hpp"
+#include "domain/font_config.hpp"
+#include "domain/page_setup_config.hpp"
+#include "domain/shape_configuration.hpp"
+#include "domain/text_edit_view.hpp"
+#include "domain/title_config.hpp"
+#include "infrastructure/graphics/drawable.hpp"
+#include "infrastructure/graphics/font.hpp"
+#include "infrastructure/graphics/font_match.hpp"
+#include "infrastructure/graphics/graphics_engine.hpp"
+#include "infrastructure/graphics/headless_gl_context.hpp"
+#include "infrastructure/graphics/page_geometry.hpp"
+#include "infrastructure/graphics/rect.hpp"
+#include "infrastructure/graphics/scene.hpp"
+#include "infrastructure/graphics/scene_graph.hpp"
+#include "infrastructure/graphics/shapes_base.hpp"
+
+// What a keystroke in the title costs, node by node: the title's shapes are
+// refilled, and every other node — grid, bars, labels, legend — keeps its
+// shape, its geometry and its uploaded buffers. A section that crept into the
+// text-edit plan would show here as a rewritten buffer, where the plan test
+// only sees an enum.
+//
+// The scene is real, so this needs an OpenGL 4.6 context and a font; without
+// either the test is skipped.
+
+namespace {
+
+// One node of the scene as a keystroke must leave it, if it is not the title.
+struct NodeState {
+  const Drawable* shape{nullptr};
+  std::size_t buffer_writes{0};
+  std::array<float, 4> bounds{};
+  glm::mat4 model{1.0F};
+  std::size_t children{0};
+
+  bool operator==(const NodeState&) const = default;
+};
+
+using SceneState = std::map<std::string, NodeState>;
+
+const std::set<std::string> kTitleNodes{
+    std::string(CalendarSceneNodes::kTitleFrameName),
+    std::string(CalendarSceneNodes::kTitleTextName),
+    std::string(CalendarSceneNodes::kTitleSelectionName),
+    std::string(CalendarSceneNodes::kTitleCaretName)};
+
+void Collect(const SceneNode& node, const std::string& parent_path,
+             SceneState& state) {
+  std::string path = parent_path + "/" + node.GetNodeName();
+  // Reused children may share a name; their position tells them apart.
+  while (state.contains(path)) {
+    path += "'";
+  }
+  NodeState& entry = state[path];
+  entry.model = node.GetModelMatrix();
+  entry.children = node.GetChildren().size();
+  if (const Drawable* shape = node.GetShape(); shape != nullptr) {
+    entry.shape = shape;
+    const RectF& bounds = shape->LocalBounds();
+    entry.bounds = {bounds.Left(), bounds.Right(), bounds.Bottom(),
+                    bounds.Top()};
+    if (const auto* buffered = dynamic_cast<const Shape*>(shape)) {
+      entry.buffer_writes = buffered->BufferWrites();
+    }
+  }
+  for (const auto& child : node.GetChildren()) {
+    Collect(*child, path, state);
+  }
+}
+
+SceneState Snapshot(const Scene& scene) {
+  SceneState state;
+  Collect(scene.Root(), "", state);
+  return state;
+}
+
+bool IsTitleNode(const std::string& path) {
+  const std::string name = path.substr(path.rfind('/') + 1);
+  return kTitleNodes.contains(name);
+}
+
+std::optional<std::string> DefaultFontFile(double point_size) {
+  FcConfig* config = FcInitLoadConfigAndFonts();
+  const auto file_path = MatchFontFile(
+      config, {.family = "sans-serif", .point_size = point_size});
+  FcConfigDestroy(config);
+  return file_path;
+}
+
+DateEntry MakeEntry(int begin_year, int begin_month, int end_month) {
+  DateEntry entry;
+  entry.SetDateInterval(
+      DatePeriod(Date::FromYmd(begin_year, begin_month, 1),
+                 Date::FromYmd(begin_year, end_month, 1)));
+  return entry;
+}
+
+class CalendarSceneComposerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    try {
+      context_.emplace(4, 6);
+    } catch (const std::exception& error) {
+      GTEST_SKIP() << "no OpenGL 4.6 context: " << error.what();
+    }
+    const auto font_file = DefaultFontFile(font_config_.SizePoints());
+    if (!font_file) {
+      GTEST_SKIP() << "no sans-serif font";
+    }
+    font_config_.SetFilePath(*font_file);
+    engine_ = std::make_unique<GraphicsEngine>(std::nullopt);
+    font_ = std::make_shared<Font>(*font_file, [] {});
+
+    const PageSetupConfig page_setup;
+    page_size_ = PageRect(page_setup);
+    page_margin_ = PageMarginRect(page_setup);
+    title_config_.SetTitleText("Calendar");
+    const std::vector<DateGroup> groups{DateGroup("Travel")};
+    date_groups_.Assign(groups);
+    date_entry_bars_.ReceiveDateGroups(groups);
+    date_entry_bars_.ReceiveDateEntries(
+        {MakeEntry(2030, 2, 4), MakeEntry(2031, 6, 9)});
+
+    composer_ = std::make_unique<CalendarSceneComposer>(
+        *engine_, scene_, font_, font_config_, page_size_, page_margin_,
+        title_config_, calendar_config_, shape_config_, date_groups_,
+        date_entry_bars_);
+  }
+
+  void TearDown() override {
+    if (context_) {
+      context_->MakeCurrent();
+    }
+    // The GL objects go while their context is still there.
+    composer_.reset();
+    scene_.Root().RemoveChildren();
+    font_.reset();
+    engine_.reset();
+  }
+
+  std::optional<HeadlessGlContext> context_;
+  std::unique_ptr<GraphicsEngine> engine_;
+  Scene scene_;
+  std::shared_ptr<Font> font_;
+  FontConfig font_config_;
+  RectF page_size_;
+  RectF page_margin_;
+  TitleConfig title_config_;
+  CalendarConfig calendar_config_;
+  ShapeConfigSet shape_config_;
+  DateGroups date_groups_;
+  DateEntryBars date_entry_bars_;
+  std::unique_ptr<CalendarSceneComposer> composer_;
+};
+
+}  // namespace
+
+TEST_F(CalendarSceneComposerTest, TextEditTouchesOnlyTitleNodes) {
+  composer_->Build(calendar_sections::SceneChange::kState);
+  const SceneState before = Snapshot(scene_);
+
+  composer_->SetTextEdit(TextEditView{.text = "Calendar 2030",
+                                      .caret = 13,
+                                      .selection_begin = 9,
+                                      .selection_end = 13});
+  composer_->Build(calendar_sections::SceneChange::kTextEdit);
+  const SceneState after = Snapshot(scene_);
+
+  ASSERT_EQ(after.size(), before.size());
+  std::size_t untouched = 0;
+  for (const auto& [path, state] : before) {
+    ASSERT_TRUE(after.contains(path)) << path;
+    if (IsTitleNode(path)) {
+      continue;
+    }
+    EXPECT_EQ(after.at(path), state) << path;
+    ++untouched;
+  }
+  // The grid, the bars, the labels and the legend are all in the count.
+  EXPECT_GT(untouched, kTitleNodes.size());
+
+  const std::string title_text_path = [&before] {
+    for (const auto& [path, state] : before) {
+      if (path.ends_with(CalendarSceneNodes::kTitleTextName)) {
+        return path;
+      }
+    }
+    return std::string();
+  }();
+  ASSERT_FALSE(title_text_path.empty());
+  EXPECT_GT(after.at(title_text_path).buffer_writes,
+            before.at(title_text_path).buffer_writes);
+}
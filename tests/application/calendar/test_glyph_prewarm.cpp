@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "application/calendar/glyph_prewarm.hpp"
+#include "domain/date_entry_bars.hpp"
+#include "domain/date_group.hpp"
+#include "domain/title_config.hpp"
+#include "infrastructure/graphics/utf8_codec.hpp"
+
+// The prewarm text decides which glyphs the font renders ahead of the build.
+// A character missing from it shows as a placeholder in the first frame; one
+// repeated costs nothing but is a sign the text was not reduced. This pins
+// that every drawn source contributes, and each character only once.
+
+namespace {
+
+bool Contains(const std::string& text, const std::string& characters) {
+  const std::vector<char32_t> have = DecodeUtf8(text);
+  for (const char32_t code_point : DecodeUtf8(characters)) {
+    if (std::find(have.begin(), have.end(), code_point) == have.end()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(GlyphPrewarm, CoversNumbersTitleAndGroupNames) {
+  TitleConfig title;
+  title.SetTitleText("Fahrtenbuch");
+  DateGroups groups;
+  groups.Assign({DateGroup("Urlaub"), DateGroup("Krank")});
+
+  const std::string text = ProjectGlyphText(title, groups, DateEntryBars());
+
+  EXPECT_TRUE(Contains(text, "0123456789%"));
+  EXPECT_TRUE(Contains(text, "Fahrtenbuch"));
+  EXPECT_TRUE(Contains(text, "UrlaubKrank"));
+  EXPECT_TRUE(Contains(text, "Annual sum"));
+}
+
+TEST(GlyphPrewarm, KeepsMultiByteCharactersWhole) {
+  TitleConfig title;
+  title.SetTitleText("Grüße");
+
+  const std::string text =
+      ProjectGlyphText(title, DateGroups(), DateEntryBars());
+
+  EXPECT_TRUE(Contains(text, "üß"));
+}
+
+TEST(GlyphPrewarm, ListsEveryCharacterOnce) {
+  TitleConfig title;
+  title.SetTitleText("aaaa 2024 2024");
+
+  const std::vector<char32_t> code_points = DecodeUtf8(
+      ProjectGlyphText(title, DateGroups(), DateEntryBars()));
+
+  std::vector<char32_t> sorted = code_points;
+  std::ranges::sort(sorted);
+  EXPECT_EQ(std::ranges::adjacent_find(sorted), sorted.end());
+}
+
+// A project load hands the font its text piece by piece; together the pieces
+// are the whole project's text.
+TEST(GlyphPrewarm, PiecesCoverTheProjectText) {
+  TitleConfig title;
+  title.SetTitleText("Fahrtenbuch");
+  DateGroups groups;
+  groups.Assign({DateGroup("Urlaub"), DateGroup("Krank")});
+  const DateEntryBars bars;
+
+  const std::string pieces = FixedGlyphText() + GroupGlyphText(groups) +
+                             BarGlyphText(bars) + title.TitleText();
+
+  EXPECT_TRUE(Contains(pieces, ProjectGlyphText(title, groups, bars)));
+  EXPECT_TRUE(Contains(FixedGlyphText(), "0123456789%"));
+  EXPECT_TRUE(Contains(GroupGlyphText(groups), "UrlaubKrank"));
+  EXPECT_FALSE(Contains(GroupGlyphText(groups), "F"));
+}
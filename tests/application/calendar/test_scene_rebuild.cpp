@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#include "application/calendar/scene_rebuild.hpp"
+
+// The rebuild plan decides what a change costs. A keystroke in the title used
+// to rebuild the whole calendar — days, months, bars and legend, with their
+// buffers — for one character; a state change that skipped a section would
+// leave it showing the old project. A build that left the highlights off
+// dropped the title's hover on every keystroke.
+
+using calendar_sections::SceneChange;
+using calendar_sections::Section;
+using calendar_sections::SectionsFor;
+
+namespace {
+
+// Records what a build refills and when it rehighlights, in order.
+class CountingBuilder : public calendar_sections::SectionBuilder {
+ public:
+  void Build(Section section) override {
+    built.push_back(section);
+    ++builds_per_section[section];
+  }
+
+  void Rehighlight() override {
+    ++rehighlights;
+    built_before_rehighlight = built.size();
+  }
+
+  std::vector<Section> built;
+  std::map<Section, int> builds_per_section;
+  int rehighlights{0};
+  std::size_t built_before_rehighlight{0};
+};
+
+}  // namespace
+
+TEST(SceneRebuildTest, TextEditTouchesOnlyTheTitle) {
+  const auto sections = SectionsFor(SceneChange::kTextEdit);
+
+  EXPECT_EQ(std::vector<Section>(sections.begin(), sections.end()),
+            std::vector<Section>{Section::kTitle});
+}
+
+TEST(SceneRebuildTest, StateChangeRebuildsEverySectionInOrder) {
+  const auto sections = SectionsFor(SceneChange::kState);
+
+  const std::vector<Section> expected = {
+      Section::kPage,   Section::kTitle,      Section::kCalendarLabels,
+      Section::kDays,   Section::kMonths,     Section::kYears,
+      Section::kBars,   Section::kYearTotals, Section::kLegend};
+  EXPECT_EQ(std::vector<Section>(sections.begin(), sections.end()), expected);
+}
+
+TEST(SceneRebuildTest, GlyphsRelayOutTheTextAlone) {
+  const auto sections = SectionsFor(SceneChange::kGlyphs);
+
+  EXPECT_EQ(std::vector<Section>(sections.begin(), sections.end()),
+            std::vector<Section>{Section::kText});
+}
+
+// The page section lays out what the others place themselves in; it has to
+// come first whenever it runs.
+TEST(SceneRebuildTest, PageSectionLeadsWheneverItRuns) {
+  for (const SceneChange change : {SceneChange::kState, SceneChange::kTextEdit,
+                                   SceneChange::kGlyphs}) {
+    const auto sections = SectionsFor(change);
+    const auto page = std::ranges::find(sections, Section::kPage);
+    EXPECT_TRUE(page == sections.end() || page == sections.begin());
+  }
+}
+
+// A keystroke after the first build refills the title alone: the grid, the
+// bars and the legend keep their nodes and buffers.
+TEST(SceneRebuildTest, TextEditBuildLeavesTheOtherSectionsAlone) {
+  CountingBuilder builder;
+  calendar_sections::RunBuild(SceneChange::kState,
+                               /*after_full_build=*/false, builder);
+  calendar_sections::RunBuild(SceneChange::kTextEdit,
+                               /*after_full_build=*/true, builder);
+
+  EXPECT_EQ(builder.builds_per_section[Section::kTitle], 2);
+  for (const Section untouched :
+       {Section::kPage, Section::kCalendarLabels, Section::kDays,
+        Section::kMonths, Section::kYears, Section::kBars,
+        Section::kYearTotals, Section::kLegend}) {
+    EXPECT_EQ(builder.builds_per_section[untouched], 1);
+  }
+}
+
+// Before any full build there is no layout to place the title in.
+TEST(SceneRebuildTest, FirstBuildIsFullWhateverTheChange) {
+  CountingBuilder builder;
+  calendar_sections::RunBuild(SceneChange::kTextEdit,
+                               /*after_full_build=*/false, builder);
+
+  const auto all = SectionsFor(SceneChange::kState);
+  EXPECT_EQ(builder.built, std::vector<Section>(all.begin(), all.end()));
+}
+
+// The title section refills the title frame, which resets the colours the
+// hover patched; the highlights go back on after every build, not just after
+// the bars were rebuilt.
+TEST(SceneRebuildTest, EveryBuildRehighlightsAfterItsSections) {
+  for (const SceneChange change : {SceneChange::kState, SceneChange::kTextEdit,
+                                   SceneChange::kGlyphs}) {
+    CountingBuilder builder;
+    calendar_sections::RunBuild(change, /*after_full_build=*/true,
+                                builder);
+
+    EXPECT_EQ(builder.rehighlights, 1);
+    EXPECT_EQ(builder.built_before_rehighlight, builder.built.size());
+  }
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <sstream>
+#include <string>
+
+#include "application/export_manifest.hpp"
+
+// A nightly batch runs unattended: a line that does not parse has to be
+// skipped and named, never take the lines around it down or get half
+// applied.
+
+namespace {
+
+application::ExportManifest Parse(const std::string& text) {
+  std::istringstream stream(text);
+  return application::ParseExportManifest(stream, "/batch");
+}
+
+}  // namespace
+
+TEST(ExportManifestTest, ReadsPathsAndOptions) {
+  const auto manifest = Parse(
+      "# nightly\n"
+      "\n"
+      "a.xml out/a.png\n"
+      "  \"b c.csv\"\t/abs/b.png dpi=300 years=2024-2026\r\n");
+
+  EXPECT_TRUE(manifest.errors.empty());
+  ASSERT_EQ(manifest.jobs.size(), 2U);
+  EXPECT_EQ(manifest.jobs[0].input, std::filesystem::path("/batch/a.xml"));
+  EXPECT_EQ(manifest.jobs[0].output, std::filesystem::path("/batch/out/a.png"));
+  EXPECT_FALSE(manifest.jobs[0].dpi.has_value());
+  EXPECT_FALSE(manifest.jobs[0].years.has_value());
+
+  EXPECT_EQ(manifest.jobs[1].input, std::filesystem::path("/batch/b c.csv"));
+  EXPECT_EQ(manifest.jobs[1].output, std::filesystem::path("/abs/b.png"));
+  EXPECT_EQ(manifest.jobs[1].dpi, 300);
+  ASSERT_TRUE(manifest.jobs[1].years.has_value());
+  EXPECT_EQ(manifest.jobs[1].years->first_year, 2024);
+  EXPECT_EQ(manifest.jobs[1].years->last_year, 2026);
+}
+
+TEST(ExportManifestTest, SkipsBadLinesAndNamesThem) {
+  const auto manifest = Parse(
+      "only_input.xml\n"
+      "a.xml a.png dpi=0\n"
+      "a.xml a.png years=2026-2024\n"
+      "a.xml a.png colour=red\n"
+      "\"open.xml a.png\n"
+      "good.xml good.png dpi=150\n");
+
+  ASSERT_EQ(manifest.jobs.size(), 1U);
+  EXPECT_EQ(manifest.jobs[0].dpi, 150);
+  ASSERT_EQ(manifest.errors.size(), 5U);
+  EXPECT_TRUE(manifest.errors[0].starts_with("line 1: "));
+  EXPECT_TRUE(manifest.errors[4].starts_with("line 5: "));
+}
+
+TEST(ExportManifestTest, MissingFileIsNotAnEmptyManifest) {
+  EXPECT_FALSE(application::ReadExportManifest(
+                   std::filesystem::path(testing::TempDir()) / "no_such.txt")
+                   .has_value());
+}
@@ -8,6 +8,8 @@
 #include "application/event_bus.hpp"
 #include "application/project_document.hpp"
 #include "domain/date_format.hpp"
+#include "domain/date_group.hpp"
+#include "domain/title_config.hpp"
 
 namespace {
 
@@ -134,6 +136,30 @@ TEST(ProjectDocumentTest, FreshDocumentHasNoFilePath) {
   EXPECT_FALSE(document.HasFilePath());
 }
 
+// A reset leaves nothing of the project before it: the stores are what a
+// fresh document holds, the path is gone, and the bus sees one change.
+TEST(ProjectDocumentTest, ResetReturnsToAFreshProject) {
+  EventBus bus;
+  LocaleDateFormatter formatter;
+  application::ProjectDocument document(bus, formatter);
+  const std::string fresh_state = document.CanonicalState();
+
+  document.DateGroups().ReceiveDateGroups({DateGroup("Team")});
+  TitleConfig title;
+  title.SetTitleText("Team A");
+  document.TitleConfiguration().ReceiveTitleConfig(title);
+  const std::string path = TempXmlPath("decade_document_reset.xml");
+  ASSERT_FALSE(document.SaveXml(path).has_value());
+  ASSERT_NE(document.CanonicalState(), fresh_state);
+
+  const BurstRecorder recorder(bus);
+  document.Reset();
+
+  EXPECT_EQ(document.CanonicalState(), fresh_state);
+  EXPECT_FALSE(document.HasFilePath());
+  EXPECT_TRUE(recorder.EveryStoreInsideOneBracket()) << recorder.events.size();
+}
+
 // Loading fills six stores one after another and every one of them publishes.
 // Whoever rebuilds on that must be able to do it once, so the publishes have to
 // arrive inside one bracket (#36).
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "application/event_bus.hpp"
+#include "application/project_document.hpp"
+#include "application/runtime_options.hpp"
+#include "application/startup_script.hpp"
+#include "domain/calendar_config.hpp"
+#include "domain/date_format.hpp"
+#include "domain/date_group.hpp"
+#include "domain/font_config.hpp"
+#include "domain/title_config.hpp"
+#include "infrastructure/graphics/png_strip_encoder.hpp"
+#include "infrastructure/graphics/png_writer.hpp"
+#include "infrastructure/graphics/software_raster.hpp"
+#include "infrastructure/graphics/vector_page.hpp"
+
+// A batch item's image shows its own file and nothing else: a CSV after a
+// project must not inherit the project's groups, title or calendar, and the
+// project after a CSV must look as if loaded alone. The page writer here
+// writes nothing; it takes down the project each image would have been
+// rendered from.
+
+namespace {
+
+std::string TempPath(const std::string& name) {
+  return testing::TempDir() + name;
+}
+
+// A project that differs from a fresh one in every store a CSV leaves alone.
+std::string WriteProject(const std::string& name) {
+  EventBus bus;
+  LocaleDateFormatter formatter;
+  application::ProjectDocument document(bus, formatter);
+  document.DateGroups().ReceiveDateGroups({DateGroup("Team")});
+  TitleConfig title;
+  title.SetTitleText("Team A");
+  document.TitleConfiguration().ReceiveTitleConfig(title);
+  CalendarConfig calendar;
+  calendar.SetAutoCalendarSpan(false);
+  calendar.SetSpan({.first_year = 2020, .last_year = 2022});
+  document.CalendarConfiguration().ReceiveCalendarConfig(calendar);
+
+  const std::string path = TempPath(name);
+  EXPECT_FALSE(document.SaveXml(path).has_value());
+  return path;
+}
+
+std::string WriteCsv(const std::string& name) {
+  const std::string path = TempPath(name);
+  std::ofstream csv(path);
+  csv << "23.09.1998,24.11.1998\n23.12.1998,16.01.1999\n";
+  return path;
+}
+
+// The project as a fresh document holds it after loading `path` alone.
+std::string LoadedAlone(const std::string& path) {
+  EventBus bus;
+  LocaleDateFormatter formatter;
+  application::ProjectDocument document(bus, formatter);
+  if (path.ends_with(".xml")) {
+    EXPECT_FALSE(document.LoadXml(path).has_value());
+  } else {
+    document.ImportCsv(path);
+  }
+  return document.CanonicalState();
+}
+
+// Runs a batch over `inputs`, one image each, and returns the project every
+// image would have been rendered from, by output name.
+std::map<std::string, std::string> RunBatch(
+    const std::string& name, const std::vector<std::string>& inputs) {
+  const std::string manifest_path = TempPath(name + ".batch");
+  {
+    std::ofstream manifest(manifest_path);
+    for (const std::string& input : inputs) {
+      manifest << '"' << input << "\" \"" << input << ".png\"\n";
+    }
+  }
+
+  EventBus bus;
+  LocaleDateFormatter formatter;
+  application::ProjectDocument document(bus, formatter);
+  application::RuntimeOptions options;
+  options.export_batch_path = manifest_path;
+  const application::StartupScript script(options, document);
+
+  std::map<std::string, std::string> rendered;
+  script.RunHeadless(
+      FontConfig(), /*msaa_samples=*/4,
+      [&](const std::string& file_path, int, const png_io::EncodeOptions&,
+          software_raster::PageRenderer,
+          const std::vector<png_io::PngText>&) {
+        rendered[file_path] = document.CanonicalState();
+        return true;
+      },
+      [](const std::string&, int, const png_io::EncodeOptions&,
+         software_raster::PageRenderer) { return true; },
+      [] { return vector_page::Page{}; });
+  return rendered;
+}
+
+}  // namespace
+
+TEST(StartupScriptTest, BatchCsvAfterProjectStartsFresh) {
+  const std::string project = WriteProject("decade_batch_a.xml");
+  const std::string csv = WriteCsv("decade_batch_a.csv");
+
+  const auto rendered = RunBatch("decade_batch_a", {project, csv});
+
+  ASSERT_EQ(rendered.size(), 2U);
+  EXPECT_EQ(rendered.at(project + ".png"), LoadedAlone(project));
+  EXPECT_EQ(rendered.at(csv + ".png"), LoadedAlone(csv));
+}
+
+TEST(StartupScriptTest, BatchProjectAfterCsvStartsFresh) {
+  const std::string project = WriteProject("decade_batch_b.xml");
+  const std::string csv = WriteCsv("decade_batch_b.csv");
+
+  const auto rendered = RunBatch("decade_batch_b", {csv, project});
+
+  ASSERT_EQ(rendered.size(), 2U);
+  EXPECT_EQ(rendered.at(csv + ".png"), LoadedAlone(csv));
+  EXPECT_EQ(rendered.at(project + ".png"), LoadedAlone(project));
+}
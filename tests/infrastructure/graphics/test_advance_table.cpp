@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+
+#include "infrastructure/graphics/advance_table.hpp"
+
+// The table places the title's caret and selection and finds the character
+// under the pointer. A stale entry after an edit would put the caret beside
+// the text it belongs to; a wrong bisection would set it one character off.
+// Advances here are made up: one em per code point value step from 'a'.
+
+namespace {
+
+float FakeAdvance(char32_t code_point) {
+  return static_cast<float>(code_point - U'a' + 1);
+}
+
+}  // namespace
+
+TEST(AdvanceTable, WidthIsThePrefixSum) {
+  AdvanceTable table;
+  table.Update(U"abc", FakeAdvance);
+
+  EXPECT_FLOAT_EQ(table.Width(0), 0.0F);
+  EXPECT_FLOAT_EQ(table.Width(1), 1.0F);
+  EXPECT_FLOAT_EQ(table.Width(2), 3.0F);
+  EXPECT_FLOAT_EQ(table.Width(3), 6.0F);
+  EXPECT_FLOAT_EQ(table.Width(10), 6.0F);
+}
+
+// "abc" spans [0,1), [1,3), [3,6): a click left of a character's middle
+// lands before it, right of it behind.
+TEST(AdvanceTable, IndexAtPicksTheNearerEdge) {
+  AdvanceTable table;
+  table.Update(U"abc", FakeAdvance);
+
+  EXPECT_EQ(table.IndexAt(-1.0F), 0U);
+  EXPECT_EQ(table.IndexAt(0.4F), 0U);
+  EXPECT_EQ(table.IndexAt(0.6F), 1U);
+  EXPECT_EQ(table.IndexAt(1.9F), 1U);
+  EXPECT_EQ(table.IndexAt(2.1F), 2U);
+  EXPECT_EQ(table.IndexAt(4.4F), 2U);
+  EXPECT_EQ(table.IndexAt(4.6F), 3U);
+  EXPECT_EQ(table.IndexAt(100.0F), 3U);
+}
+
+// Only what follows the first change is measured again.
+TEST(AdvanceTable, UpdateMeasuresFromTheFirstChangeOn) {
+  AdvanceTable table;
+  table.Update(U"abcd", FakeAdvance);
+
+  std::size_t measured = 0;
+  const auto counting = [&measured](char32_t code_point) {
+    ++measured;
+    return FakeAdvance(code_point);
+  };
+  table.Update(U"abcde", counting);
+  EXPECT_EQ(measured, 1U);
+
+  measured = 0;
+  table.Update(U"abXde", counting);
+  EXPECT_EQ(measured, 3U);
+
+  AdvanceTable fresh;
+  fresh.Update(U"abXde", FakeAdvance);
+  for (std::size_t count = 0; count <= 5; ++count) {
+    EXPECT_FLOAT_EQ(table.Width(count), fresh.Width(count));
+  }
+}
+
+TEST(AdvanceTable, ShorterTextDropsTheTail) {
+  AdvanceTable table;
+  table.Update(U"abcd", FakeAdvance);
+
+  table.Update(U"ab", FakeAdvance);
+
+  EXPECT_EQ(table.Size(), 2U);
+  EXPECT_FLOAT_EQ(table.Width(5), 3.0F);
+  EXPECT_EQ(table.IndexAt(100.0F), 2U);
+}
+
+TEST(AdvanceTable, ClearEmptiesTheTable) {
+  AdvanceTable table;
+  table.Update(U"abc", FakeAdvance);
+
+  table.Clear();
+
+  EXPECT_EQ(table.Size(), 0U);
+  EXPECT_FLOAT_EQ(table.Width(3), 0.0F);
+  EXPECT_EQ(table.IndexAt(1.0F), 0U);
+}
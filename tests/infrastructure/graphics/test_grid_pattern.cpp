@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <vector>
+
+#include "infrastructure/graphics/grid_pattern.hpp"
+#include "infrastructure/graphics/rect.hpp"
+
+// The grid shape replaced one rectangle per day. This holds the pattern it
+// paints by — grid_pattern::SampleColor, which the fragment shader follows
+// line by line — against those rectangles, stacked the way the rectangle
+// draws stacked them: fill inside, outline straddling the edges, later cells
+// over earlier ones. Compared at the pixel centres and at a spread of
+// multisample positions of a 200 dpi export.
+
+namespace {
+
+using grid_pattern::CellRow;
+using grid_pattern::CellSelection;
+using grid_pattern::CellStyle;
+using grid_pattern::Pattern;
+
+constexpr int kDaysPerWeek = 7;
+constexpr float kMillimetresPerInch = 25.4F;
+constexpr float kExportDpi = 200.0F;
+
+// What a BoxesShape left at `point` for `boxes`, in draw order.
+glm::vec4 PaintBoxes(const std::vector<RectF>& boxes, const CellStyle& style,
+                     glm::vec2 point) {
+  const float half = style.line_width * 0.5F;
+  const RectF margin(half, half, half, half);
+  glm::vec4 color(0.0F);
+  for (const RectF& box : boxes) {
+    const RectF outer = box.Expand(margin);
+    const RectF inner = box.Reduce(margin);
+    const auto contains = [&point](const RectF& rect) {
+      return point.x >= rect.Left() && point.x < rect.Right() &&
+             point.y >= rect.Bottom() && point.y < rect.Top();
+    };
+    if (!contains(outer)) {
+      continue;
+    }
+    color = grid_pattern::Composite(
+        color, contains(inner) ? style.fill_color : style.outline_color);
+  }
+  return color;
+}
+
+// The day and Sunday cells of one row the way BuildDays used to make them:
+// one rectangle per day, split by weekday. `first_weekday` is the weekday of
+// the row's first day, Sunday being zero.
+struct RowCells {
+  std::vector<RectF> days;
+  std::vector<RectF> sundays;
+};
+
+RowCells CellsOf(const RectF& row, int day_count, float day_width,
+                 int first_weekday) {
+  RowCells cells;
+  for (int day = 0; day < day_count; ++day) {
+    const float left = row.Left() + (static_cast<float>(day) * day_width);
+    const RectF cell(left, left + day_width, row.Bottom(), row.Top());
+    if ((first_weekday + day) % kDaysPerWeek == 0) {
+      cells.sundays.push_back(cell);
+    } else {
+      cells.days.push_back(cell);
+    }
+  }
+  return cells;
+}
+
+// Counts the sample points where the pattern and the rectangles disagree.
+std::size_t CountMismatches(const Pattern& pattern, const CellRow& row,
+                            const std::vector<RectF>& boxes) {
+  const float pixel = kMillimetresPerInch / kExportDpi;
+  const float half_line = pattern.style.line_width * 0.5F;
+  const std::vector<glm::vec2> offsets = {
+      {0.5F, 0.5F}, {0.0625F, 0.4375F}, {0.9375F, 0.5625F}, {0.3125F, 0.0F}};
+  std::size_t mismatches = 0;
+  for (float y = row.cells.Bottom() - (2 * half_line) - pixel;
+       y < row.cells.Top() + (2 * half_line) + pixel; y += pixel) {
+    for (float x = row.cells.Left() - (2 * half_line) - pixel;
+         x < row.cells.Right() + (2 * half_line) + pixel; x += pixel) {
+      for (const glm::vec2& offset : offsets) {
+        const glm::vec2 point(x + (offset.x * pixel), y + (offset.y * pixel));
+        const glm::vec4 expected = PaintBoxes(boxes, pattern.style, point);
+        const glm::vec4 actual = grid_pattern::SampleColor(pattern, row, point);
+        for (int component = 0; component < 4; ++component) {
+          if (std::abs(expected[component] - actual[component]) > 1e-6F) {
+            ++mismatches;
+            break;
+          }
+        }
+      }
+    }
+  }
+  return mismatches;
+}
+
+struct Case {
+  float day_width;
+  float line_width;
+  int day_count;
+  int first_weekday;
+};
+
+void ExpectMatchesRectangles(const Case& test_case) {
+  const RectF row_cells(
+      12.5F,
+      12.5F + (static_cast<float>(test_case.day_count) * test_case.day_width),
+      40.0F, 46.0F);
+  const CellRow row{
+      .cells = row_cells,
+      .phase = (kDaysPerWeek - test_case.first_weekday) % kDaysPerWeek};
+  const RowCells cells = CellsOf(row_cells, test_case.day_count,
+                                 test_case.day_width, test_case.first_weekday);
+  // Translucent on purpose: where two outlines overlap, the stacking shows.
+  const CellStyle day_style{.line_width = test_case.line_width,
+                            .outline_color = {0.2F, 0.3F, 0.4F, 0.6F},
+                            .fill_color = {0.9F, 0.9F, 0.8F, 0.5F}};
+  const CellStyle sunday_style{.line_width = test_case.line_width * 1.5F,
+                               .outline_color = {0.7F, 0.1F, 0.1F, 0.8F},
+                               .fill_color = {1.0F, 0.8F, 0.8F, 0.4F}};
+
+  const Pattern days{.cell_width = test_case.day_width,
+                     .period = kDaysPerWeek,
+                     .selection = CellSelection::kOffPhase,
+                     .style = day_style};
+  const Pattern sundays{.cell_width = test_case.day_width,
+                        .period = kDaysPerWeek,
+                        .selection = CellSelection::kOnPhase,
+                        .style = sunday_style};
+
+  EXPECT_EQ(grid_pattern::CellCount(days, row), test_case.day_count);
+  EXPECT_EQ(CountMismatches(days, row, cells.days), 0U);
+  EXPECT_EQ(CountMismatches(sundays, row, cells.sundays), 0U);
+}
+
+}  // namespace
+
+TEST(GridPatternTest, SundaysAreTheOnPhaseCells) {
+  const CellRow row{.cells = RectF(0.0F, 14.0F, 0.0F, 1.0F), .phase = 3};
+  const Pattern sundays{.cell_width = 1.0F,
+                        .period = kDaysPerWeek,
+                        .selection = CellSelection::kOnPhase,
+                        .style = {}};
+  const Pattern days{.cell_width = 1.0F,
+                     .period = kDaysPerWeek,
+                     .selection = CellSelection::kOffPhase,
+                     .style = {}};
+  for (int cell = 0; cell < 14; ++cell) {
+    const bool sunday = cell == 3 || cell == 10;
+    EXPECT_EQ(grid_pattern::IsDrawn(sundays, row, cell), sunday) << cell;
+    EXPECT_EQ(grid_pattern::IsDrawn(days, row, cell), !sunday) << cell;
+  }
+}
+
+TEST(GridPatternTest, CompositeOverTransparentKeepsTheColour) {
+  const glm::vec4 color(0.25F, 0.5F, 0.75F, 0.5F);
+  const glm::vec4 result = grid_pattern::Composite(glm::vec4(0.0F), color);
+  EXPECT_FLOAT_EQ(result.r, color.r);
+  EXPECT_FLOAT_EQ(result.g, color.g);
+  EXPECT_FLOAT_EQ(result.b, color.b);
+  EXPECT_FLOAT_EQ(result.a, color.a);
+}
+
+// Six weeks starting on a Wednesday, cells a good deal wider than the line. A
+// row of a few weeks shows everything a year would — the comparison walks all
+// rectangles per sample and gets slow past that.
+TEST(GridPatternTest, MatchesDayRectanglesForThinLines) {
+  ExpectMatchesRectangles(
+      {.day_width = 0.6F, .line_width = 0.1F, .day_count = 45,
+       .first_weekday = 3});
+}
+
+// Lines wider than a cell: an outline reaches past the direct neighbour, and
+// Sunday cells overlap only their own outline.
+TEST(GridPatternTest, MatchesDayRectanglesForLinesWiderThanACell) {
+  ExpectMatchesRectangles(
+      {.day_width = 0.3F, .line_width = 0.5F, .day_count = 40,
+       .first_weekday = 0});
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "infrastructure/graphics/lru_cache.hpp"
+
+// The cache bounds Font's laid-out text. Evicting the wrong entry would lay
+// out the calendar's recurring labels again at every rebuild; keeping a stale
+// one would draw old geometry for a changed text. This pins the order of
+// eviction and that lookups count as use.
+
+TEST(LruCache, FindsWhatWasInserted) {
+  LruCache<std::string, int> cache(4);
+
+  cache.Insert("Jan", 1);
+  cache.Insert("Feb", 2);
+
+  ASSERT_NE(cache.Find("Jan"), nullptr);
+  EXPECT_EQ(*cache.Find("Jan"), 1);
+  EXPECT_EQ(*cache.Find("Feb"), 2);
+  EXPECT_EQ(cache.Find("Mar"), nullptr);
+  EXPECT_EQ(cache.Size(), 2U);
+}
+
+TEST(LruCache, EvictsTheLeastRecentlyInserted) {
+  LruCache<std::string, int> cache(2);
+
+  cache.Insert("Jan", 1);
+  cache.Insert("Feb", 2);
+  cache.Insert("Mar", 3);
+
+  EXPECT_EQ(cache.Find("Jan"), nullptr);
+  EXPECT_NE(cache.Find("Feb"), nullptr);
+  EXPECT_NE(cache.Find("Mar"), nullptr);
+  EXPECT_EQ(cache.Size(), 2U);
+}
+
+// A label looked up at every rebuild stays, however many one-off strings pass
+// through.
+TEST(LruCache, FindCountsAsUse) {
+  LruCache<std::string, int> cache(2);
+
+  cache.Insert("Jan", 1);
+  cache.Insert("Feb", 2);
+  ASSERT_NE(cache.Find("Jan"), nullptr);
+  cache.Insert("Mar", 3);
+
+  EXPECT_NE(cache.Find("Jan"), nullptr);
+  EXPECT_EQ(cache.Find("Feb"), nullptr);
+}
+
+TEST(LruCache, InsertingAnExistingKeyReplacesItsValue) {
+  LruCache<std::string, int> cache(2);
+
+  cache.Insert("Jan", 1);
+  cache.Insert("Feb", 2);
+  EXPECT_EQ(cache.Insert("Jan", 10), 10);
+  cache.Insert("Mar", 3);
+
+  EXPECT_EQ(cache.Size(), 2U);
+  ASSERT_NE(cache.Find("Jan"), nullptr);
+  EXPECT_EQ(*cache.Find("Jan"), 10);
+  EXPECT_EQ(cache.Find("Feb"), nullptr);
+}
+
+TEST(LruCache, ClearEmptiesTheCache) {
+  LruCache<std::string, int> cache(2);
+
+  cache.Insert("Jan", 1);
+  cache.Clear();
+
+  EXPECT_EQ(cache.Size(), 0U);
+  EXPECT_EQ(cache.Find("Jan"), nullptr);
+}
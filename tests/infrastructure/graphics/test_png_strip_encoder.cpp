@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "infrastructure/graphics/png_strip_encoder.hpp"
+
+// The strips are deflated apart and joined afterwards. Whether the joints
+// hold — sync flushes, dictionaries, the combined checksum — shows when zlib
+// inflates the result as one stream; with the none filter the inflated bytes
+// are the rows themselves, each behind a zero filter byte.
+
+namespace {
+
+constexpr std::size_t kRowBytes = 4000;
+constexpr std::size_t kRows = 40;
+
+// Varied enough that deflate finds matches far back, within the dictionary.
+std::vector<unsigned char> SampleImage() {
+  std::vector<unsigned char> image(kRowBytes * kRows);
+  for (std::size_t index = 0; index < image.size(); ++index) {
+    image[index] = static_cast<unsigned char>((index * 7) ^ (index / 4001));
+  }
+  return image;
+}
+
+std::vector<unsigned char*> RowPointers(std::vector<unsigned char>& image,
+                                        std::size_t first, std::size_t count) {
+  std::vector<unsigned char*> rows;
+  for (std::size_t row = first; row < first + count; ++row) {
+    rows.push_back(&image[row * kRowBytes]);
+  }
+  return rows;
+}
+
+std::optional<std::vector<unsigned char>> Inflate(
+    const std::vector<unsigned char>& stream, std::size_t size) {
+  std::vector<unsigned char> out(size);
+  uLongf out_size = size;
+  if (uncompress(out.data(), &out_size, stream.data(), stream.size()) !=
+          Z_OK ||
+      out_size != size) {
+    return std::nullopt;
+  }
+  return out;
+}
+
+}  // namespace
+
+TEST(StripEncoderTest, StripsAcrossCallsInflateAsOneStream) {
+  std::vector<unsigned char> image = SampleImage();
+  std::vector<unsigned char> stream;
+  {
+    png_io::StripEncoder encoder(
+        kRowBytes, png_io::EncodeOptions{.compression_level = 6,
+                                         .filter = png_io::PngFilter::kNone,
+                                         .strip_bytes = 3 * kRowBytes});
+    encoder.Encode(RowPointers(image, 0, 25), false, stream);
+    encoder.Encode(RowPointers(image, 25, 15), true, stream);
+  }
+
+  const auto inflated = Inflate(stream, kRows * (kRowBytes + 1));
+  ASSERT_TRUE(inflated.has_value());
+  for (std::size_t row = 0; row < kRows; ++row) {
+    const std::size_t begin = row * (kRowBytes + 1);
+    EXPECT_EQ((*inflated)[begin], 0);
+    EXPECT_TRUE(std::equal(image.begin() + (row * kRowBytes),
+                           image.begin() + ((row + 1) * kRowBytes),
+                           inflated->begin() + begin + 1))
+        << "row " << row;
+  }
+}
+
+TEST(StripEncoderTest, StripCountLeavesTheBytesAlone) {
+  std::vector<unsigned char> image = SampleImage();
+  const std::vector<unsigned char*> rows = RowPointers(image, 0, kRows);
+  std::vector<unsigned char> one_strip;
+  std::vector<unsigned char> many_strips;
+  {
+    png_io::StripEncoder encoder(
+        kRowBytes, png_io::EncodeOptions{.compression_level = 6,
+                                         .filter = png_io::PngFilter::kUp,
+                                         .strip_bytes = kRows * kRowBytes * 2});
+    encoder.Encode(rows, true, one_strip);
+  }
+  {
+    png_io::StripEncoder encoder(
+        kRowBytes, png_io::EncodeOptions{.compression_level = 6,
+                                         .filter = png_io::PngFilter::kUp,
+                                         .strip_bytes = 2 * kRowBytes});
+    encoder.Encode(rows, true, many_strips);
+  }
+
+  EXPECT_NE(one_strip, many_strips);
+  EXPECT_EQ(Inflate(one_strip, kRows * (kRowBytes + 1)),
+            Inflate(many_strips, kRows * (kRowBytes + 1)));
+}
+
+// Without a pool the strips are the same, only encoded one after another.
+TEST(StripEncoderTest, OneWorkerWritesTheSameStream) {
+  std::vector<unsigned char> image = SampleImage();
+  const std::vector<unsigned char*> rows = RowPointers(image, 0, kRows);
+  std::vector<unsigned char> pooled;
+  std::vector<unsigned char> inline_stream;
+  {
+    png_io::StripEncoder encoder(
+        kRowBytes, png_io::EncodeOptions{.compression_level = 6,
+                                         .filter = png_io::PngFilter::kPaeth,
+                                         .strip_bytes = 4 * kRowBytes});
+    encoder.Encode(rows, true, pooled);
+  }
+  {
+    png_io::StripEncoder encoder(
+        kRowBytes, png_io::EncodeOptions{.compression_level = 6,
+                                         .filter = png_io::PngFilter::kPaeth,
+                                         .strip_bytes = 4 * kRowBytes,
+                                         .workers = 1});
+    encoder.Encode(rows, true, inline_stream);
+  }
+
+  EXPECT_EQ(pooled, inline_stream);
+}
+
+TEST(StripEncoderTest, FilterNames) {
+  EXPECT_EQ(png_io::FilterFromName("paeth"), png_io::PngFilter::kPaeth);
+  EXPECT_EQ(png_io::FilterFromName("adaptive"), png_io::PngFilter::kAdaptive);
+  EXPECT_EQ(png_io::FilterFromName("none"), png_io::PngFilter::kNone);
+  EXPECT_FALSE(png_io::FilterFromName("Paeth").has_value());
+  EXPECT_FALSE(png_io::FilterFromName("").has_value());
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include <png.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "infrastructure/graphics/png_writer.hpp"
+
+// The page export streams its image into PngRowWriter one band at a time and
+// never holds it whole. What comes out must be the rows that went in, in that
+// order, and an export that stops short must not leave a truncated file.
+
+namespace {
+
+constexpr std::size_t kWidth = 3;
+constexpr std::size_t kHeight = 5;
+
+std::string FilePath(const std::string& name) {
+  const std::filesystem::path path =
+      std::filesystem::path(testing::TempDir()) / name;
+  std::filesystem::remove(path);
+  return path.string();
+}
+
+// Every byte distinct, so a swapped or repeated row shows.
+std::vector<unsigned char> SamplePixels() {
+  std::vector<unsigned char> pixels(kWidth * kHeight * png_io::kBytesPerPixel);
+  for (std::size_t index = 0; index < pixels.size(); ++index) {
+    pixels[index] = static_cast<unsigned char>(index);
+  }
+  return pixels;
+}
+
+std::vector<unsigned char*> RowPointers(std::vector<unsigned char>& pixels,
+                                        std::size_t first, std::size_t count) {
+  std::vector<unsigned char*> rows;
+  for (std::size_t row = first; row < first + count; ++row) {
+    rows.push_back(&pixels[row * kWidth * png_io::kBytesPerPixel]);
+  }
+  return rows;
+}
+
+std::vector<unsigned char> ReadRgba(const std::string& path) {
+  png_image image{};
+  image.version = PNG_IMAGE_VERSION;
+  if (png_image_begin_read_from_file(&image, path.c_str()) == 0) {
+    return {};
+  }
+  image.format = PNG_FORMAT_RGBA;
+  std::vector<unsigned char> pixels(PNG_IMAGE_SIZE(image));
+  if (png_image_finish_read(&image, nullptr, pixels.data(), 0, nullptr) ==
+      0) {
+    return {};
+  }
+  EXPECT_EQ(image.width, kWidth);
+  EXPECT_EQ(image.height, kHeight);
+  return pixels;
+}
+
+constexpr png_io::PngImageSize kSize{.width = kWidth, .height = kHeight};
+
+}  // namespace
+
+TEST(PngRowWriterTest, BandsComeOutAsOneImage) {
+  const std::string path = FilePath("bands.png");
+  std::vector<unsigned char> pixels = SamplePixels();
+  {
+    png_io::PngRowWriter writer(path, kSize);
+    ASSERT_TRUE(writer.Good());
+    std::vector<unsigned char*> top = RowPointers(pixels, 0, 2);
+    std::vector<unsigned char*> bottom = RowPointers(pixels, 2, 3);
+    EXPECT_TRUE(writer.WriteRows(top));
+    EXPECT_TRUE(writer.WriteRows(bottom));
+    EXPECT_TRUE(writer.Finish());
+  }
+  EXPECT_EQ(ReadRgba(path), pixels);
+}
+
+TEST(PngRowWriterTest, EveryFilterAndLevelReadsBackUnchanged) {
+  using png_io::PngFilter;
+  std::vector<unsigned char> pixels = SamplePixels();
+  for (const PngFilter filter :
+       {PngFilter::kNone, PngFilter::kSub, PngFilter::kUp, PngFilter::kAverage,
+        PngFilter::kPaeth, PngFilter::kAdaptive}) {
+    for (const int level : {0, 1, 9}) {
+      const std::string path = FilePath("filters.png");
+      {
+        // One row a strip, so every seam between strips gets crossed.
+        png_io::PngRowWriter writer(
+            path, kSize,
+            png_io::EncodeOptions{.compression_level = level,
+                                  .filter = filter,
+                                  .strip_bytes = 1});
+        std::vector<unsigned char*> top = RowPointers(pixels, 0, 3);
+        std::vector<unsigned char*> bottom = RowPointers(pixels, 3, 2);
+        EXPECT_TRUE(writer.WriteRows(top));
+        EXPECT_TRUE(writer.WriteRows(bottom));
+        EXPECT_TRUE(writer.Finish());
+      }
+      EXPECT_EQ(ReadRgba(path), pixels)
+          << "filter " << static_cast<int>(filter) << ", level " << level;
+    }
+  }
+}
+
+TEST(PngRowWriterTest, RowsPastTheHeightAreRefused) {
+  const std::string path = FilePath("too_many.png");
+  std::vector<unsigned char> pixels = SamplePixels();
+  png_io::PngRowWriter writer(path, kSize);
+  std::vector<unsigned char*> all = RowPointers(pixels, 0, kHeight);
+  std::vector<unsigned char*> one_more = RowPointers(pixels, 0, 1);
+
+  EXPECT_TRUE(writer.WriteRows(all));
+  EXPECT_FALSE(writer.WriteRows(one_more));
+  EXPECT_TRUE(writer.Finish());
+}
+
+TEST(PngRowWriterTest, UnfinishedImageLeavesNoFile) {
+  const std::string path = FilePath("unfinished.png");
+  std::vector<unsigned char> pixels = SamplePixels();
+  {
+    png_io::PngRowWriter writer(path, kSize);
+    std::vector<unsigned char*> top = RowPointers(pixels, 0, 2);
+    EXPECT_TRUE(writer.WriteRows(top));
+    EXPECT_FALSE(writer.Finish());  // three rows still missing
+  }
+  EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST(PngRowWriterTest, UnopenableFileIsReported) {
+  const std::string path = FilePath("missing_directory/image.png");
+  png_io::PngRowWriter writer(path, kSize);
+
+  EXPECT_FALSE(writer.Good());
+  EXPECT_FALSE(writer.Finish());
+}
+
+// The export cache keeps its key in a tEXt chunk and reads it back without
+// decoding the image.
+TEST(PngRowWriterTest, TextIsReadBackByKeyword) {
+  const std::string path = FilePath("text.png");
+  std::vector<unsigned char> pixels = SamplePixels();
+  {
+    png_io::PngRowWriter writer(
+        path, kSize, {},
+        {png_io::PngText{.keyword = "Software", .text = "decade"},
+         png_io::PngText{.keyword = "Key", .text = "0123abcd"}});
+    std::vector<unsigned char*> rows = RowPointers(pixels, 0, kHeight);
+    EXPECT_TRUE(writer.WriteRows(rows));
+    EXPECT_TRUE(writer.Finish());
+  }
+  EXPECT_EQ(png_io::ReadPngText(path, "Key"), "0123abcd");
+  EXPECT_EQ(png_io::ReadPngText(path, "Software"), "decade");
+  EXPECT_EQ(png_io::ReadPngText(path, "Missing"), std::nullopt);
+  // The chunks leave the image as it was.
+  EXPECT_EQ(ReadRgba(path), pixels);
+}
+
+TEST(PngRowWriterTest, TextOfNoPngIsNothing) {
+  const std::string path = FilePath("not_a_png.png");
+  EXPECT_EQ(png_io::ReadPngText(path, "Key"), std::nullopt);
+  {
+    std::ofstream file(path);
+    file << "plain text";
+  }
+  EXPECT_EQ(png_io::ReadPngText(path, "Key"), std::nullopt);
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "infrastructure/graphics/program_binary_cache.hpp"
+
+// The cache decides whether a start trusts a program binary from disk. A key
+// that missed a driver or source change would hand the driver a binary for
+// other shaders; a file read past its end or under the wrong key would do
+// the same. Everything else here only costs a recompile.
+
+namespace {
+
+constexpr std::uint32_t kFormat = 0x8E21;
+
+ProgramBinaryCache::Binary SampleBinary() {
+  return ProgramBinaryCache::Binary{.format = kFormat,
+                                    .bytes = {1, 2, 3, 250, 0, 7}};
+}
+
+std::filesystem::path CacheDirectory(const std::string& name) {
+  const std::filesystem::path directory =
+      std::filesystem::path(testing::TempDir()) / name;
+  std::filesystem::remove_all(directory);
+  return directory;
+}
+
+}  // namespace
+
+TEST(ProgramBinaryCacheTest, KeyFollowsDriverAndSources) {
+  const std::uint64_t key =
+      ProgramBinaryCache::Key("Mesa llvmpipe 4.6", "vertex", "fragment");
+
+  EXPECT_EQ(key,
+            ProgramBinaryCache::Key("Mesa llvmpipe 4.6", "vertex", "fragment"));
+  EXPECT_NE(key,
+            ProgramBinaryCache::Key("Mesa llvmpipe 4.5", "vertex", "fragment"));
+  EXPECT_NE(key, ProgramBinaryCache::Key("Mesa llvmpipe 4.6", "vertex ",
+                                         "fragment"));
+  EXPECT_NE(key,
+            ProgramBinaryCache::Key("Mesa llvmpipe 4.6", "vertex", "fragmen"));
+  // Text moved across a field boundary is another program.
+  EXPECT_NE(ProgramBinaryCache::Key("ab", "c", ""),
+            ProgramBinaryCache::Key("a", "bc", ""));
+}
+
+TEST(ProgramBinaryCacheTest, EncodeDecodeRoundTrip) {
+  const auto file = ProgramBinaryCache::Encode(42, SampleBinary());
+
+  const auto decoded = ProgramBinaryCache::Decode(file, 42);
+
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(decoded->format, kFormat);
+  EXPECT_EQ(decoded->bytes, SampleBinary().bytes);
+}
+
+TEST(ProgramBinaryCacheTest, DecodeRejectsOtherKeyAndDamage) {
+  const auto file = ProgramBinaryCache::Encode(42, SampleBinary());
+
+  EXPECT_FALSE(ProgramBinaryCache::Decode(file, 43).has_value());
+
+  std::vector<std::uint8_t> truncated(file.begin(), file.end() - 1);
+  EXPECT_FALSE(ProgramBinaryCache::Decode(truncated, 42).has_value());
+
+  std::vector<std::uint8_t> longer = file;
+  longer.push_back(0);
+  EXPECT_FALSE(ProgramBinaryCache::Decode(longer, 42).has_value());
+
+  std::vector<std::uint8_t> bad_magic = file;
+  bad_magic[0] = 'X';
+  EXPECT_FALSE(ProgramBinaryCache::Decode(bad_magic, 42).has_value());
+
+  EXPECT_FALSE(ProgramBinaryCache::Decode({}, 42).has_value());
+}
+
+TEST(ProgramBinaryCacheTest, StoreThenLoadFromDisk) {
+  const ProgramBinaryCache cache(CacheDirectory("program_cache_round_trip"));
+
+  EXPECT_FALSE(cache.Load("Font Shader", 7).has_value());
+  cache.Store("Font Shader", 7, SampleBinary());
+
+  const auto loaded = cache.Load("Font Shader", 7);
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(loaded->bytes, SampleBinary().bytes);
+  EXPECT_FALSE(cache.Load("Font Shader", 8).has_value());
+  EXPECT_FALSE(cache.Load("Grid Shader", 7).has_value());
+}
+
+TEST(ProgramBinaryCacheTest, StoreReplacesAnOutdatedEntry) {
+  const ProgramBinaryCache cache(CacheDirectory("program_cache_replace"));
+  cache.Store("Grid Shader", 1, SampleBinary());
+
+  ProgramBinaryCache::Binary newer = SampleBinary();
+  newer.bytes.push_back(9);
+  cache.Store("Grid Shader", 2, newer);
+
+  EXPECT_FALSE(cache.Load("Grid Shader", 1).has_value());
+  const auto loaded = cache.Load("Grid Shader", 2);
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(loaded->bytes, newer.bytes);
+}
+
+TEST(ProgramBinaryCacheTest, CacheWithoutDirectoryHoldsNothing) {
+  const ProgramBinaryCache cache(std::nullopt);
+
+  cache.Store("Font Shader", 7, SampleBinary());
+
+  EXPECT_FALSE(cache.Load("Font Shader", 7).has_value());
+}
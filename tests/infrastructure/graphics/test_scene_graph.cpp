@@ -8,6 +8,7 @@
 
 #include "infrastructure/graphics/drawable.hpp"
 #include "infrastructure/graphics/rect.hpp"
+#include "infrastructure/graphics/scene.hpp"
 #include "infrastructure/graphics/scene_graph.hpp"
 
 // Characterisation test over SceneNode. It exists because of the seam that
@@ -16,7 +17,8 @@
 // without a live context and none of this was reachable.
 //
 // It pins the traversal: the accumulated transforms, the painter's layer, the
-// sibling order (#29) and the node path.
+// sibling order (#29) and the node path — and that Scene's culled draw keeps
+// that order for whatever the view leaves in.
 
 namespace {
 
@@ -184,6 +186,47 @@ TEST(SceneNodeCharacterisation, ANodeWithoutGeometryReportsNoBounds) {
   EXPECT_FALSE(root.WorldBounds().has_value());
 }
 
+// --- The culled draw ---
+
+// What the view misses is skipped; what it touches is drawn in the same
+// painter's order the whole-tree draw uses, layers included.
+TEST(SceneNodeCharacterisation, SceneDrawsOnlyWhatTheViewTouches) {
+  std::vector<std::string> log;
+  Scene scene;
+  auto top = MakeNode("top", log);
+  top->SetDrawLayer(1);
+  scene.Root().AddChild(top);
+  scene.Root().AddChild(MakeNode("bottom", log));
+  auto far = MakeNode("far", log);
+  far->SetModelMatrix(ShiftedBy(50.0F));
+  scene.Root().AddChild(far);
+
+  const Scene::CullStats stats = scene.Draw(RectF(0.0F, 2.0F, 0.0F, 2.0F));
+
+  ASSERT_EQ(log.size(), 2U);
+  EXPECT_EQ(log[0], "bottom@0");
+  EXPECT_EQ(log[1], "top@0");
+  EXPECT_EQ(stats.drawn, 2U);
+  EXPECT_EQ(stats.culled, 1U);
+}
+
+// The grids hold the bounds of the last collection until invalidated.
+TEST(SceneNodeCharacterisation, SceneSeesMovedNodesAfterInvalidate) {
+  std::vector<std::string> log;
+  Scene scene;
+  auto node = MakeNode("node", log);
+  scene.Root().AddChild(node);
+  const RectF view(40.0F, 60.0F, 0.0F, 2.0F);
+
+  EXPECT_EQ(scene.Draw(view).drawn, 0U);
+  node->SetModelMatrix(ShiftedBy(50.0F));
+  scene.Invalidate();
+
+  EXPECT_EQ(scene.Draw(view).drawn, 1U);
+  ASSERT_EQ(log.size(), 1U);
+  EXPECT_EQ(log[0], "node@50");
+}
+
 // --- The node path ---
 
 TEST(SceneNodeCharacterisation, NodePathJoinsTheNamesFromTheRoot) {
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include "infrastructure/graphics/rect.hpp"
+#include "infrastructure/graphics/scene_walk.hpp"
+
+// Where the CPU and vector exports put a world point. A y left pointing up
+// paints the page upside down; a transform left out draws every node at the
+// origin of its parent.
+
+using scene_walk::Mapping;
+using scene_walk::TargetBox;
+
+TEST(SceneWalkMapping, SpreadsTheRegionWithYDown) {
+  const Mapping mapping(RectF(10.0F, 30.0F, 0.0F, 5.0F), 40.0F, 20.0F);
+
+  const glm::vec2 point = mapping.ToTarget(glm::mat4(1.0F), 15.0F, 1.0F);
+  EXPECT_FLOAT_EQ(point.x, 10.0F);
+  EXPECT_FLOAT_EQ(point.y, 16.0F);
+  EXPECT_FLOAT_EQ(mapping.Scale().x, 2.0F);
+  EXPECT_FLOAT_EQ(mapping.Scale().y, 4.0F);
+}
+
+TEST(SceneWalkMapping, TakesCornersThroughTheWorldTransform) {
+  const Mapping mapping(RectF(0.0F, 10.0F, 0.0F, 10.0F), 10.0F, 10.0F);
+  const glm::mat4 world =
+      glm::translate(glm::mat4(1.0F), glm::vec3(2.0F, 3.0F, 0.0F));
+
+  const TargetBox box =
+      mapping.ToTarget(world, glm::vec4(1.0F, 4.0F, 0.0F, 2.0F));
+  EXPECT_FLOAT_EQ(box.left, 3.0F);
+  EXPECT_FLOAT_EQ(box.right, 6.0F);
+  EXPECT_FLOAT_EQ(box.top, 5.0F);
+  EXPECT_FLOAT_EQ(box.bottom, 7.0F);
+}
+
+// The fill of a rectangle narrower than its outline: the painters rely on it
+// coming out inverted, not flipped into a box of its own.
+TEST(SceneWalkMapping, InvertedBoxStaysInverted) {
+  const Mapping mapping(RectF(0.0F, 10.0F, 0.0F, 10.0F), 10.0F, 10.0F);
+
+  const TargetBox box =
+      mapping.ToTarget(glm::mat4(1.0F), glm::vec4(4.0F, 3.0F, 6.0F, 5.0F));
+  EXPECT_GT(box.left, box.right);
+  EXPECT_GT(box.top, box.bottom);
+}
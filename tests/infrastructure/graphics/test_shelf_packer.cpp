@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "infrastructure/graphics/shelf_packer.hpp"
+
+// The packer decides where every glyph field lands in the atlas. An overlap
+// would show as one glyph bleeding into another; a lost answer after growth as
+// glyphs sampling the wrong texels. This pins the shelf rules and that
+// growing never moves what was placed.
+
+namespace {
+
+struct Placed {
+  ShelfPacker::Slot slot;
+  int width;
+  int height;
+};
+
+bool Overlap(const Placed& lhs, const Placed& rhs) {
+  return lhs.slot.x < rhs.slot.x + rhs.width &&
+         rhs.slot.x < lhs.slot.x + lhs.width &&
+         lhs.slot.y < rhs.slot.y + rhs.height &&
+         rhs.slot.y < lhs.slot.y + lhs.height;
+}
+
+}  // namespace
+
+TEST(ShelfPacker, SimilarHeightsShareAShelf) {
+  ShelfPacker packer(100, 100);
+
+  const auto first = packer.Insert(30, 20);
+  const auto second = packer.Insert(30, 18);
+
+  ASSERT_TRUE(first.has_value());
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(first->y, 0);
+  EXPECT_EQ(second->y, 0);
+  EXPECT_EQ(second->x, 30);
+  EXPECT_EQ(packer.UsedHeight(), 20);
+}
+
+// A comma does not take the room of a capital: too short for the shelf, it
+// opens its own.
+TEST(ShelfPacker, MuchShorterRectanglesOpenTheirOwnShelf) {
+  ShelfPacker packer(100, 100);
+
+  ASSERT_TRUE(packer.Insert(30, 40).has_value());
+  const auto comma = packer.Insert(10, 12);
+
+  ASSERT_TRUE(comma.has_value());
+  EXPECT_EQ(comma->y, 40);
+  EXPECT_EQ(packer.UsedHeight(), 52);
+}
+
+// Full, the packer says so; grown, it places again, and nothing earlier moves
+// or overlaps.
+TEST(ShelfPacker, GrowingMakesRoomWithoutMovingAnything) {
+  ShelfPacker packer(64, 32);
+  std::vector<Placed> placed;
+  for (int index = 0; index < 4; ++index) {
+    const auto slot = packer.Insert(30, 16);
+    ASSERT_TRUE(slot.has_value());
+    placed.push_back({.slot = *slot, .width = 30, .height = 16});
+  }
+  EXPECT_FALSE(packer.Insert(30, 16).has_value());
+
+  packer.Grow(64);
+  for (int index = 0; index < 4; ++index) {
+    const auto slot = packer.Insert(30, 16);
+    ASSERT_TRUE(slot.has_value());
+    placed.push_back({.slot = *slot, .width = 30, .height = 16});
+  }
+
+  for (std::size_t lhs = 0; lhs < placed.size(); ++lhs) {
+    const Placed& box = placed[lhs];
+    EXPECT_LE(box.slot.x + box.width, packer.Width());
+    EXPECT_LE(box.slot.y + box.height, packer.Height());
+    for (std::size_t rhs = lhs + 1; rhs < placed.size(); ++rhs) {
+      EXPECT_FALSE(Overlap(box, placed[rhs]));
+    }
+  }
+  EXPECT_EQ(placed[0].slot.y, 0);
+  EXPECT_EQ(placed[4].slot.y, 32);
+}
+
+TEST(ShelfPacker, ARectangleWiderThanTheAreaThrows) {
+  ShelfPacker packer(64, 64);
+
+  EXPECT_THROW((void)packer.Insert(65, 1), std::invalid_argument);
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/vec4.hpp>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "infrastructure/graphics/software_raster.hpp"
+
+// The CPU export stands in for the GL pipeline, so it has to paint what that
+// pipeline paints: this pins the area coverage of rectangles and frames, the
+// blend, the distance-field glyphs and that the bands arrive whole and in
+// order.
+
+namespace {
+
+using software_raster::DistanceField;
+using software_raster::PixelBox;
+using software_raster::Primitive;
+
+const glm::vec4 kWhite(1.0F, 1.0F, 1.0F, 1.0F);
+const glm::vec4 kBlack(0.0F, 0.0F, 0.0F, 1.0F);
+
+// A `width` x `height` image painted in one band, as RGBA8 bytes.
+std::vector<unsigned char> Paint(const std::vector<Primitive>& primitives,
+                                 std::size_t width, std::size_t height) {
+  std::vector<unsigned char> image(width * height * 4);
+  std::vector<unsigned char*> rows(height);
+  for (std::size_t row = 0; row < height; ++row) {
+    rows[row] = &image[row * width * 4];
+  }
+  software_raster::RasterizeRows(primitives, kWhite, width, 0, rows);
+  return image;
+}
+
+unsigned char Red(const std::vector<unsigned char>& image, std::size_t width,
+                  std::size_t column, std::size_t row) {
+  return image[((row * width) + column) * 4];
+}
+
+}  // namespace
+
+TEST(SoftwareRaster, OverlapIsTheCoveredFractionOfAPixel) {
+  EXPECT_FLOAT_EQ(software_raster::Overlap(0.0F, 1.0F, 0.0F), 1.0F);
+  EXPECT_FLOAT_EQ(software_raster::Overlap(0.25F, 0.75F, 0.0F), 0.5F);
+  EXPECT_FLOAT_EQ(software_raster::Overlap(0.5F, 3.0F, 2.0F), 1.0F);
+  EXPECT_FLOAT_EQ(software_raster::Overlap(1.0F, 3.0F, 0.0F), 0.0F);
+  // An inverted span covers nothing.
+  EXPECT_FLOAT_EQ(software_raster::Overlap(0.8F, 0.2F, 0.0F), 0.0F);
+}
+
+// A rectangle on pixel edges paints its pixels in full and nothing else; one
+// ending halfway into a pixel blends that pixel half and half.
+TEST(SoftwareRaster, RectanglesCoverPixelsByArea) {
+  const std::vector<Primitive> primitives = {software_raster::Rectangle(
+      PixelBox{.left = 1.0F, .top = 1.0F, .right = 3.5F, .bottom = 3.0F},
+      kBlack)};
+  const auto image = Paint(primitives, 5, 4);
+
+  EXPECT_EQ(Red(image, 5, 0, 1), 255);
+  EXPECT_EQ(Red(image, 5, 1, 1), 0);
+  EXPECT_EQ(Red(image, 5, 2, 2), 0);
+  EXPECT_EQ(Red(image, 5, 3, 2), 128);
+  EXPECT_EQ(Red(image, 5, 4, 2), 255);
+  EXPECT_EQ(Red(image, 5, 1, 3), 255);
+}
+
+// A frame paints its outline and leaves the hole to what lies beneath, also
+// across a pixel it shares with the hole.
+TEST(SoftwareRaster, FramesLeaveTheirHole) {
+  const PixelBox outer{.left = 0.0F, .top = 0.0F, .right = 6.0F,
+                       .bottom = 6.0F};
+  const PixelBox inner{.left = 1.5F, .top = 2.0F, .right = 4.0F,
+                       .bottom = 4.0F};
+  const std::vector<Primitive> primitives = {
+      software_raster::Frame(outer, inner, kBlack)};
+  const auto image = Paint(primitives, 6, 6);
+
+  EXPECT_EQ(Red(image, 6, 0, 0), 0);
+  EXPECT_EQ(Red(image, 6, 5, 5), 0);
+  EXPECT_EQ(Red(image, 6, 2, 2), 255);
+  EXPECT_EQ(Red(image, 6, 3, 3), 255);
+  EXPECT_EQ(Red(image, 6, 1, 2), 128);
+}
+
+// Later primitives blend over earlier ones with their alpha, as GL's blend
+// does.
+TEST(SoftwareRaster, PrimitivesBlendInOrder) {
+  const PixelBox box{.left = 0.0F, .top = 0.0F, .right = 1.0F, .bottom = 1.0F};
+  const std::vector<Primitive> primitives = {
+      software_raster::Rectangle(box, kBlack),
+      software_raster::Rectangle(box, glm::vec4(1.0F, 1.0F, 1.0F, 0.5F))};
+  const auto image = Paint(primitives, 1, 1);
+
+  EXPECT_EQ(image[0], 128);
+  EXPECT_EQ(image[3], 255);
+}
+
+TEST(SoftwareRaster, FieldSamplesFilterLinearlyBetweenTexelCentres) {
+  const std::vector<std::uint8_t> texels = {0, 255, 0, 255};
+  const DistanceField field{.texels = texels, .width = 2, .height = 2};
+
+  EXPECT_FLOAT_EQ(software_raster::SampleField(field, 0.5F, 0.5F), 0.0F);
+  EXPECT_FLOAT_EQ(software_raster::SampleField(field, 1.5F, 0.5F), 1.0F);
+  EXPECT_FLOAT_EQ(software_raster::SampleField(field, 1.0F, 1.0F), 0.5F);
+  // Clamped to the edge beyond the outer texel centres.
+  EXPECT_FLOAT_EQ(software_raster::SampleField(field, -3.0F, 1.0F), 0.0F);
+  EXPECT_FLOAT_EQ(software_raster::SampleField(field, 9.0F, 1.0F), 1.0F);
+}
+
+// A field inside the outline everywhere paints the whole quad; one outside
+// everywhere paints nothing; an edge down the middle splits the quad there.
+TEST(SoftwareRaster, GlyphsPaintWhereTheFieldIsInside) {
+  const std::vector<std::uint8_t> inside(16, 255);
+  const std::vector<std::uint8_t> outside(16, 0);
+  // Distance rising from left to right, through 0.5 in the middle.
+  const std::vector<std::uint8_t> edge = {0,  85, 170, 255, 0,  85, 170, 255,
+                                          0,  85, 170, 255, 0,  85, 170, 255};
+  const DistanceField inside_field{.texels = inside, .width = 4, .height = 4};
+  const DistanceField outside_field{.texels = outside, .width = 4, .height = 4};
+  const DistanceField edge_field{.texels = edge, .width = 4, .height = 4};
+  const PixelBox quad{.left = 0.0F, .top = 0.0F, .right = 8.0F, .bottom = 8.0F};
+  const glm::vec4 texels(0.0F, 0.0F, 4.0F, 4.0F);
+
+  const auto full = Paint(
+      {software_raster::Glyph(quad, texels, inside_field, kBlack)}, 8, 8);
+  const auto empty = Paint(
+      {software_raster::Glyph(quad, texels, outside_field, kBlack)}, 8, 8);
+  const auto split =
+      Paint({software_raster::Glyph(quad, texels, edge_field, kBlack)}, 8, 8);
+
+  EXPECT_EQ(Red(full, 8, 0, 0), 0);
+  EXPECT_EQ(Red(full, 8, 7, 7), 0);
+  EXPECT_EQ(Red(empty, 8, 3, 3), 255);
+  EXPECT_EQ(Red(split, 8, 1, 4), 255);
+  EXPECT_EQ(Red(split, 8, 6, 4), 0);
+}
+
+// Every row arrives once, top first, whatever the band and worker count; a
+// sink that refuses stops the render.
+TEST(SoftwareRaster, ImagesArriveBandByBandInOrder) {
+  const std::vector<Primitive> primitives = {software_raster::Rectangle(
+      PixelBox{.left = 0.0F, .top = 10.0F, .right = 3.0F, .bottom = 11.0F},
+      kBlack)};
+  std::vector<unsigned char> reds;
+  const bool rendered = software_raster::RenderImage(
+      primitives, kWhite, 3, 23, 4, [&reds](std::span<unsigned char*> rows) {
+        for (unsigned char* row : rows) {
+          reds.push_back(row[0]);
+        }
+        return true;
+      });
+
+  ASSERT_TRUE(rendered);
+  ASSERT_EQ(reds.size(), 23U);
+  for (std::size_t row = 0; row < reds.size(); ++row) {
+    EXPECT_EQ(reds[row], row == 10 ? 0 : 255) << "row " << row;
+  }
+
+  std::size_t bands = 0;
+  EXPECT_FALSE(software_raster::RenderImage(
+      primitives, kWhite, 3, 23, 4, [&bands](std::span<unsigned char*>) {
+        ++bands;
+        return false;
+      }));
+  EXPECT_EQ(bands, 1U);
+}
+
+TEST(SoftwareRaster, RendererNames) {
+  EXPECT_EQ(software_raster::PageRendererFromName("gl"),
+            software_raster::PageRenderer::kGl);
+  EXPECT_EQ(software_raster::PageRendererFromName("cpu"),
+            software_raster::PageRenderer::kCpu);
+  EXPECT_EQ(software_raster::PageRendererFromName("llvmpipe"), std::nullopt);
+}
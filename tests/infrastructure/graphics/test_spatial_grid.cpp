@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "infrastructure/graphics/rect.hpp"
+#include "infrastructure/graphics/spatial_grid.hpp"
+
+// The grid culls the scene, so a box it misses is a shape that silently stops
+// being drawn. This holds its queries against the obvious answer — every box
+// tested against the region — over a calendar-like spread: a page-sized
+// background and a field of day cells, queried by views from a single day to
+// beyond the page.
+
+namespace {
+
+// What the grid must return: every box touching the region, ascending.
+std::vector<std::size_t> BruteForce(const std::vector<RectF>& boxes,
+                                    const RectF& region) {
+  std::vector<std::size_t> hits;
+  for (std::size_t id = 0; id < boxes.size(); ++id) {
+    const RectF& box = boxes[id];
+    if (box.Left() <= region.Right() && region.Left() <= box.Right() &&
+        box.Bottom() <= region.Top() && region.Bottom() <= box.Top()) {
+      hits.push_back(id);
+    }
+  }
+  return hits;
+}
+
+// The page first, then 12 rows of 31 cells of 5 x 8 — the order a scene layer
+// would hold them in.
+std::vector<RectF> CalendarBoxes() {
+  std::vector<RectF> boxes = {RectF(0.0F, 160.0F, 0.0F, 100.0F)};
+  for (int row = 0; row < 12; ++row) {
+    for (int day = 0; day < 31; ++day) {
+      const auto left = 2.0F + (5.0F * static_cast<float>(day));
+      const auto bottom = 2.0F + (8.0F * static_cast<float>(row));
+      boxes.emplace_back(left, left + 5.0F, bottom, bottom + 8.0F);
+    }
+  }
+  return boxes;
+}
+
+}  // namespace
+
+TEST(SpatialGrid, QueriesMatchTestingEveryBox) {
+  const std::vector<RectF> boxes = CalendarBoxes();
+  const SpatialGrid grid(boxes);
+  const std::vector<RectF> views = {
+      RectF(3.0F, 6.0F, 3.0F, 9.0F),          // inside one day
+      RectF(40.0F, 70.0F, 20.0F, 45.0F),      // a few weeks
+      RectF(-50.0F, 300.0F, -50.0F, 200.0F),  // the whole page and more
+      RectF(7.0F, 7.0F, 10.0F, 10.0F),        // a point on a shared edge
+      RectF(200.0F, 250.0F, 0.0F, 50.0F),     // right of the page
+  };
+
+  std::vector<std::size_t> hits;
+  for (const RectF& view : views) {
+    grid.Query(view, hits);
+    EXPECT_EQ(hits, BruteForce(boxes, view));
+  }
+}
+
+// A box spanning many cells is reported once, in its place in the order.
+TEST(SpatialGrid, HitsAreAscendingAndUnique) {
+  const std::vector<RectF> boxes = CalendarBoxes();
+  const SpatialGrid grid(boxes);
+
+  std::vector<std::size_t> hits;
+  grid.Query(RectF(0.0F, 160.0F, 0.0F, 100.0F), hits);
+
+  ASSERT_EQ(hits.size(), boxes.size());
+  for (std::size_t id = 0; id < hits.size(); ++id) {
+    EXPECT_EQ(hits[id], id);
+  }
+}
+
+// Boxes all on one line leave the grid no height to divide; it still answers.
+TEST(SpatialGrid, FlatExtentsStillAnswer) {
+  const std::vector<RectF> boxes = {RectF(0.0F, 10.0F, 5.0F, 5.0F),
+                                    RectF(20.0F, 30.0F, 5.0F, 5.0F)};
+  const SpatialGrid grid(boxes);
+
+  std::vector<std::size_t> hits;
+  grid.Query(RectF(25.0F, 40.0F, 0.0F, 10.0F), hits);
+
+  ASSERT_EQ(hits.size(), 1U);
+  EXPECT_EQ(hits[0], 1U);
+}
+
+TEST(SpatialGrid, AnEmptyGridFindsNothing) {
+  const SpatialGrid grid;
+
+  std::vector<std::size_t> hits = {7};
+  grid.Query(RectF(0.0F, 1.0F, 0.0F, 1.0F), hits);
+
+  EXPECT_TRUE(hits.empty());
+  EXPECT_EQ(grid.Size(), 0U);
+}
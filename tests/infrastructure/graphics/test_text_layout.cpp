@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <map>
+#include <string>
+
+#include "infrastructure/graphics/glyph_rasterizer.hpp"
+#include "infrastructure/graphics/text_layout.hpp"
+
+// The layout the labels draw with and the stream TextBatchShape uploads for
+// a whole label layer. A glyph placed one advance off shows as crowded or
+// gapped text; a batch that does not equal its labels laid out one by one
+// draws a layer differently from the same text drawn alone. Metrics here are
+// made up: glyph 'a' + n advances n + 1 em, its outline and quad one em
+// square; a space advances one em and has no outline.
+
+namespace {
+
+using text_layout::ShapedText;
+using text_layout::TextStream;
+
+const glm::vec4 kRed(1.0F, 0.0F, 0.0F, 1.0F);
+const glm::vec4 kBlue(0.0F, 0.0F, 1.0F, 1.0F);
+
+class FakeLetters {
+ public:
+  const Letter& operator()(char32_t code_point) {
+    const auto found = letters_.find(code_point);
+    if (found != letters_.end()) {
+      return found->second;
+    }
+    Letter letter;
+    if (code_point == U' ') {
+      letter.advance = 1.0F;
+    } else {
+      letter.size = glm::vec2(1.0F, 1.0F);
+      letter.bearing = glm::vec2(0.0F, 1.0F);
+      letter.quad_size = glm::vec2(1.0F, 1.0F);
+      letter.quad_bearing = glm::vec2(0.0F, 1.0F);
+      letter.advance = static_cast<float>(code_point - U'a' + 1);
+    }
+    return letters_.emplace(code_point, letter).first->second;
+  }
+
+ private:
+  std::map<char32_t, Letter> letters_;
+};
+
+ShapedText ShapeOf(const std::u32string& text) {
+  FakeLetters letters;
+  return text_layout::Shape(
+      text, [&letters](char32_t code_point) -> const Letter& {
+        return letters(code_point);
+      });
+}
+
+// The x of glyph `index`'s bottom-left vertex.
+float GlyphLeft(const TextRun& run, std::size_t index) {
+  return run.positions[(index * text_layout::kVerticesPerGlyph) + 1].x;
+}
+
+}  // namespace
+
+TEST(TextLayout, GlyphsFollowTheirAdvances) {
+  const ShapedText shaped = ShapeOf(U"abc");
+
+  ASSERT_EQ(shaped.run.positions.size(), 3 * text_layout::kVerticesPerGlyph);
+  EXPECT_FLOAT_EQ(GlyphLeft(shaped.run, 0), 0.0F);
+  EXPECT_FLOAT_EQ(GlyphLeft(shaped.run, 1), 1.0F);
+  EXPECT_FLOAT_EQ(GlyphLeft(shaped.run, 2), 3.0F);
+  EXPECT_FLOAT_EQ(shaped.width, 6.0F);
+  EXPECT_FLOAT_EQ(shaped.run.bounds.Right(), 4.0F);
+}
+
+TEST(TextLayout, PlaceScalesAndShifts) {
+  const TextRun run =
+      text_layout::Place(ShapeOf(U"ab"), glm::vec3(10.0F, 20.0F, 0.5F), 2.0F);
+
+  EXPECT_FLOAT_EQ(GlyphLeft(run, 0), 10.0F);
+  EXPECT_FLOAT_EQ(GlyphLeft(run, 1), 12.0F);
+  EXPECT_FLOAT_EQ(run.positions.front().z, 0.5F);
+  EXPECT_EQ(run.origin, glm::vec3(10.0F, 20.0F, 0.5F));
+  EXPECT_FLOAT_EQ(run.bounds.Left(), 10.0F);
+  EXPECT_FLOAT_EQ(run.bounds.Right(), 14.0F);
+  EXPECT_FLOAT_EQ(run.bounds.Top(), 22.0F);
+}
+
+TEST(TextLayout, BlankTextHasNoOutline) {
+  const ShapedText shaped = ShapeOf(U"  ");
+
+  EXPECT_FALSE(shaped.has_outline);
+  EXPECT_FLOAT_EQ(shaped.width, 2.0F);
+}
+
+// The batch is its labels laid out one by one, in order, each vertex in its
+// label's colour.
+TEST(TextLayout, BatchMatchesTheLabelsLaidOutAlone) {
+  const TextRun first =
+      text_layout::Place(ShapeOf(U"ab"), glm::vec3(0.0F), 1.0F);
+  const TextRun second =
+      text_layout::Place(ShapeOf(U"cab"), glm::vec3(5.0F, -3.0F, 0.0F), 2.0F);
+
+  TextStream stream;
+  text_layout::Append(stream, first, "ab", 1.0F, kRed);
+  text_layout::Append(stream, second, "cab", 2.0F, kBlue);
+
+  const std::size_t first_size = first.positions.size();
+  ASSERT_EQ(stream.positions.size(), first_size + second.positions.size());
+  ASSERT_EQ(stream.colors.size(), stream.positions.size());
+  ASSERT_EQ(stream.texture_positions.size(), stream.positions.size());
+  for (std::size_t index = 0; index < first_size; ++index) {
+    EXPECT_EQ(stream.positions[index], first.positions[index]);
+    EXPECT_EQ(stream.colors[index], kRed);
+  }
+  for (std::size_t index = 0; index < second.positions.size(); ++index) {
+    EXPECT_EQ(stream.positions[first_size + index], second.positions[index]);
+    EXPECT_EQ(stream.colors[first_size + index], kBlue);
+  }
+
+  ASSERT_EQ(stream.texts.size(), 2U);
+  EXPECT_EQ(stream.texts[1].text, "cab");
+  EXPECT_EQ(stream.texts[1].origin, second.origin);
+  EXPECT_FLOAT_EQ(stream.texts[1].size, 2.0F);
+}
+
+// The layer's bounds cover every label with an outline and ignore blank ones,
+// whose bounds are a placeholder at the origin.
+TEST(TextLayout, BatchBoundsJoinTheOutlinedLabels) {
+  TextStream stream;
+  text_layout::Append(stream,
+                      text_layout::Place(ShapeOf(U" "), glm::vec3(0.0F), 1.0F),
+                      " ", 1.0F, kRed);
+  text_layout::Append(
+      stream, text_layout::Place(ShapeOf(U"a"), glm::vec3(2.0F), 1.0F), "a",
+      1.0F, kRed);
+  text_layout::Append(
+      stream,
+      text_layout::Place(ShapeOf(U"a"), glm::vec3(5.0F, 4.0F, 0.0F), 1.0F),
+      "a", 1.0F, kRed);
+
+  EXPECT_TRUE(stream.bounded);
+  EXPECT_FLOAT_EQ(stream.bounds.Left(), 2.0F);
+  EXPECT_FLOAT_EQ(stream.bounds.Right(), 6.0F);
+  EXPECT_FLOAT_EQ(stream.bounds.Bottom(), 2.0F);
+  EXPECT_FLOAT_EQ(stream.bounds.Top(), 5.0F);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+#include "infrastructure/graphics/tile_budget.hpp"
+
+// The export's tile side: as large as the memory budget allows at the sample
+// count, never past a driver limit, and always some tile however tight the
+// budget.
+
+namespace {
+
+using tile_budget::ChooseTileSize;
+using tile_budget::TileLimits;
+
+constexpr std::size_t kMiB = std::size_t{1} << 20U;
+
+constexpr TileLimits kDesktop{.max_texture_size = 32768,
+                              .max_renderbuffer_size = 32768,
+                              .max_viewport_size = 32768,
+                              .max_samples = 32};
+
+}  // namespace
+
+TEST(TileBudgetTest, MultisamplingCostsATextureOfSamples) {
+  EXPECT_EQ(tile_budget::TileBytes(256, 1), 256U * 256U * 4U);
+  EXPECT_EQ(tile_budget::TileBytes(256, 16), 256U * 256U * 4U * 17U);
+}
+
+TEST(TileBudgetTest, LargestMultipleOfGranularityWithinBudget) {
+  const std::size_t side = ChooseTileSize(kDesktop, 16, 512 * kMiB);
+
+  EXPECT_EQ(side, 2560U);
+  EXPECT_LE(tile_budget::TileBytes(side, 16), 512 * kMiB);
+  EXPECT_GT(tile_budget::TileBytes(side + tile_budget::kGranularity, 16),
+            512 * kMiB);
+}
+
+TEST(TileBudgetTest, FewerSamplesGiveLargerTiles) {
+  EXPECT_GT(ChooseTileSize(kDesktop, 4, 512 * kMiB),
+            ChooseTileSize(kDesktop, 16, 512 * kMiB));
+}
+
+// The render caps the samples at what the driver offers; the budget counts
+// the capped number.
+TEST(TileBudgetTest, SamplesAreCappedAtTheDriverLimit) {
+  TileLimits limits = kDesktop;
+  limits.max_samples = 8;
+
+  EXPECT_EQ(ChooseTileSize(limits, 16, 512 * kMiB),
+            ChooseTileSize(limits, 8, 512 * kMiB));
+}
+
+TEST(TileBudgetTest, DriverLimitsCapTheSide) {
+  TileLimits limits = kDesktop;
+  limits.max_renderbuffer_size = 2048;
+
+  EXPECT_EQ(ChooseTileSize(limits, 1, 1024 * kMiB), 2048U);
+
+  limits.max_viewport_size = 1000;
+  EXPECT_EQ(ChooseTileSize(limits, 1, 1024 * kMiB), 768U);
+}
+
+TEST(TileBudgetTest, TightBudgetStillGetsATile) {
+  EXPECT_EQ(ChooseTileSize(kDesktop, 16, 1), tile_budget::kGranularity);
+
+  TileLimits tiny = kDesktop;
+  tiny.max_texture_size = 64;
+  EXPECT_EQ(ChooseTileSize(tiny, 16, 1), 64U);
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "infrastructure/graphics/png_writer.hpp"
+#include "infrastructure/graphics/tile_pyramid.hpp"
+
+// The Deep Zoom pyramid: level sizes halving down to one pixel, the
+// descriptor, and the cutter writing each level's tiles at their sizes
+// whatever bands the rows arrive in.
+
+namespace {
+
+using tile_pyramid::Level;
+
+// Width and height out of a PNG's IHDR, bytes 16 to 23, big-endian.
+std::array<std::size_t, 2> PngSize(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  std::array<unsigned char, 24> header{};
+  file.read(reinterpret_cast<char*>(header.data()), header.size());
+  const auto word = [&header](std::size_t offset) {
+    std::size_t value = 0;
+    for (std::size_t byte = 0; byte < 4; ++byte) {
+      value = (value << 8U) | header[offset + byte];
+    }
+    return value;
+  };
+  return {word(16), word(20)};
+}
+
+class TilePyramidFiles : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    directory_ = std::filesystem::temp_directory_path() /
+                 ("decade_tile_pyramid_" +
+                  std::string(::testing::UnitTest::GetInstance()
+                                  ->current_test_info()
+                                  ->name()));
+    std::filesystem::remove_all(directory_);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(directory_); }
+
+  std::filesystem::path directory_;
+};
+
+}  // namespace
+
+TEST(TilePyramid, LevelsHalveDownToOnePixel) {
+  const std::vector<Level> levels = tile_pyramid::Levels(600, 300);
+
+  // 600x300, 300x150, 150x75, 75x38, 38x19, 19x10, 10x5, 5x3, 3x2, 2x1, 1x1.
+  ASSERT_EQ(levels.size(), 11U);
+  EXPECT_EQ(levels.front().width, 1U);
+  EXPECT_EQ(levels.front().height, 1U);
+  EXPECT_EQ(levels[7].width, 75U);
+  EXPECT_EQ(levels[7].height, 38U);
+  EXPECT_EQ(levels.back().index, 10U);
+  EXPECT_EQ(levels.back().width, 600U);
+  EXPECT_EQ(levels.back().columns, 3U);
+  EXPECT_EQ(levels.back().rows, 2U);
+  EXPECT_EQ(levels[9].columns, 2U);
+  EXPECT_EQ(levels[9].rows, 1U);
+}
+
+TEST(TilePyramid, EmptyImageHasNoLevels) {
+  EXPECT_TRUE(tile_pyramid::Levels(0, 10).empty());
+  EXPECT_TRUE(tile_pyramid::Levels(10, 0).empty());
+}
+
+TEST(TilePyramid, DescriptorNamesSizeAndTiles) {
+  const std::string descriptor = tile_pyramid::Descriptor(600, 300);
+
+  EXPECT_NE(descriptor.find("xmlns=\"http://schemas.microsoft.com/deepzoom/"
+                            "2008\" Format=\"png\" Overlap=\"0\" "
+                            "TileSize=\"256\""),
+            std::string::npos);
+  EXPECT_NE(descriptor.find("<Size Width=\"600\" Height=\"300\"/>"),
+            std::string::npos);
+}
+
+TEST(TilePyramid, TilesSitBesideTheDescriptor) {
+  EXPECT_EQ(tile_pyramid::TilesDirectory("out/page.dzi"),
+            std::filesystem::path("out/page_files"));
+}
+
+// Bands of 7 rows straddle the tile rows; the tiles still come out whole,
+// the last column and row holding the remainder.
+TEST_F(TilePyramidFiles, CutterWritesEveryTileAtItsSize) {
+  const Level level{.index = 2, .width = 20, .height = 13, .columns = 3,
+                    .rows = 2};
+  tile_pyramid::TileCutter cutter(level, directory_, {}, 8);
+  ASSERT_TRUE(cutter.Good());
+
+  std::vector<unsigned char> pixels(level.width * level.height *
+                                    png_io::kBytesPerPixel);
+  for (std::size_t index = 0; index < pixels.size(); ++index) {
+    pixels[index] = static_cast<unsigned char>(index);
+  }
+  std::vector<unsigned char*> rows;
+  for (std::size_t row = 0; row < level.height; ++row) {
+    rows.push_back(&pixels[row * level.width * png_io::kBytesPerPixel]);
+  }
+  for (std::size_t first = 0; first < rows.size(); first += 7) {
+    const std::size_t count = std::min<std::size_t>(7, rows.size() - first);
+    ASSERT_TRUE(cutter.AddRows(std::span(rows).subspan(first, count)));
+  }
+  ASSERT_TRUE(cutter.Finish());
+  EXPECT_EQ(cutter.TilesWritten(), 6U);
+
+  const std::filesystem::path level_directory = directory_ / "2";
+  EXPECT_EQ(PngSize(level_directory / "0_0.png"),
+            (std::array<std::size_t, 2>{8, 8}));
+  EXPECT_EQ(PngSize(level_directory / "2_0.png"),
+            (std::array<std::size_t, 2>{4, 8}));
+  EXPECT_EQ(PngSize(level_directory / "1_1.png"),
+            (std::array<std::size_t, 2>{8, 5}));
+  EXPECT_EQ(PngSize(level_directory / "2_1.png"),
+            (std::array<std::size_t, 2>{4, 5}));
+}
+
+// A level whose rows stop short is not finished.
+TEST_F(TilePyramidFiles, MissingRowsDoNotFinish) {
+  const Level level{.index = 0, .width = 4, .height = 4, .columns = 1,
+                    .rows = 1};
+  tile_pyramid::TileCutter cutter(level, directory_, {}, 8);
+  std::vector<unsigned char> row(level.width * png_io::kBytesPerPixel);
+  std::array<unsigned char*, 1> rows{row.data()};
+  ASSERT_TRUE(cutter.AddRows(rows));
+
+  EXPECT_FALSE(cutter.Finish());
+  EXPECT_EQ(cutter.TilesWritten(), 0U);
+}
+
+// A tile that cannot be written fails the row and is not counted; the tiles
+// beside it still are.
+TEST_F(TilePyramidFiles, UnwritableTileIsNotCounted) {
+  const Level level{.index = 1, .width = 16, .height = 4, .columns = 2,
+                    .rows = 1};
+  tile_pyramid::TileCutter cutter(level, directory_, {}, 8);
+  ASSERT_TRUE(cutter.Good());
+  // A directory where the second tile's file would go.
+  std::filesystem::create_directories(directory_ / "1" / "1_0.png");
+
+  std::vector<unsigned char> pixels(level.width * level.height *
+                                    png_io::kBytesPerPixel);
+  std::vector<unsigned char*> rows;
+  for (std::size_t row = 0; row < level.height; ++row) {
+    rows.push_back(&pixels[row * level.width * png_io::kBytesPerPixel]);
+  }
+
+  EXPECT_FALSE(cutter.AddRows(rows));
+  EXPECT_FALSE(cutter.Finish());
+  EXPECT_EQ(cutter.TilesWritten(), 1U);
+}
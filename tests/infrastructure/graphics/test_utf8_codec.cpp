@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "infrastructure/graphics/unicode.hpp"
+#include "infrastructure/graphics/utf8_codec.hpp"
+
+// The decoder turns every label and the title into glyph lookups. It decodes
+// the bytes itself and leaves only text needing normalisation to ICU, so it
+// has to agree with ICU byte for byte — on valid text, and on broken text,
+// where a different count of U+FFFD would shift every glyph behind it. The
+// fuzz cases compare against ICU's own conversion plus NFC.
+
+namespace {
+
+std::vector<char32_t> DecodeWithIcu(const std::string& text) {
+  const icu::UnicodeString utf16 = icu::UnicodeString::fromUTF8(
+      icu::StringPiece(text.data(), static_cast<std::int32_t>(text.size())));
+  UErrorCode status = U_ZERO_ERROR;
+  const icu::UnicodeString normalized =
+      icu::Normalizer2::getNFCInstance(status)->normalize(utf16, status);
+  std::vector<char32_t> code_points;
+  AppendCodePoints(normalized, 0, normalized.length(), code_points);
+  return code_points;
+}
+
+// Text the way it goes wrong: mostly ASCII, some well-formed sequences of
+// every length, combining marks, and now and then a byte of any value —
+// stray trail bytes, cut sequences, overlongs, surrogates.
+std::string RandomText(std::mt19937& random) {
+  std::uniform_int_distribution<int> length(0, 48);
+  std::uniform_int_distribution<int> kind(0, 9);
+  std::uniform_int_distribution<int> byte(0, 0xFF);
+  std::uniform_int_distribution<int> ascii(0x20, 0x7E);
+  const std::vector<std::string> pieces = {
+      "\xC3\xA4",          // ä
+      "e\xCC\x81",         // e + combining acute
+      "\xCC\x81",          // a combining acute alone
+      "\xE2\x82\xAC",      // €
+      "\xF0\x9F\x98\x80",  // an emoji, outside the BMP
+      "\xCE\xA9",          // Ω
+      "\xED\xA0\x80",      // an encoded surrogate
+      "\xC0\xAF",          // an overlong slash
+      "\xE2\x82",          // a cut sequence
+      "\xF4\x90\x80\x80",  // past U+10FFFF
+  };
+  std::uniform_int_distribution<std::size_t> piece(0, pieces.size() - 1);
+
+  std::string text;
+  const int count = length(random);
+  for (int index = 0; index < count; ++index) {
+    const int choice = kind(random);
+    if (choice < 6) {
+      text += static_cast<char>(ascii(random));
+    } else if (choice < 9) {
+      text += pieces[piece(random)];
+    } else {
+      text += static_cast<char>(byte(random));
+    }
+  }
+  return text;
+}
+
+}  // namespace
+
+TEST(Utf8Codec, AsciiDecodesToItsBytes) {
+  const std::string text = "Kalender 2024 - the whole year at a glance, 100 %";
+
+  const std::vector<char32_t> decoded = DecodeUtf8(text);
+
+  ASSERT_EQ(decoded.size(), text.size());
+  for (std::size_t index = 0; index < text.size(); ++index) {
+    EXPECT_EQ(decoded[index], static_cast<char32_t>(text[index]));
+  }
+}
+
+TEST(Utf8Codec, ComposesBaseAndCombiningMark) {
+  EXPECT_EQ(DecodeUtf8("e\xCC\x81"), std::vector<char32_t>{0xE9});
+}
+
+TEST(Utf8Codec, ReplacesEachMaximalIllFormedSubpartOnce) {
+  // A cut three-byte sequence is one replacement; the ASCII behind it stays.
+  EXPECT_EQ(DecodeUtf8("\xE2\x82x"), (std::vector<char32_t>{0xFFFD, 'x'}));
+  // An encoded surrogate: no valid prefix, every byte on its own.
+  EXPECT_EQ(DecodeUtf8("\xED\xA0\x80"),
+            (std::vector<char32_t>{0xFFFD, 0xFFFD, 0xFFFD}));
+}
+
+TEST(Utf8Codec, IntoKeepsTheBufferAndReplacesItsContents) {
+  std::vector<char32_t> buffer;
+  DecodeUtf8Into("a long first label, longer than the second", buffer);
+  const std::size_t capacity = buffer.capacity();
+
+  DecodeUtf8Into("Jan", buffer);
+
+  EXPECT_EQ(buffer, (std::vector<char32_t>{'J', 'a', 'n'}));
+  EXPECT_EQ(buffer.capacity(), capacity);
+}
+
+// The text editor's buffer is a u32string; the result must be the same.
+TEST(Utf8Codec, IntoAStringMatchesIntoAVector) {
+  const std::string text = "Gr\xC3\xBC\xC3\x9F" "e\xCC\x81 \xE2\x82";
+  std::u32string as_string;
+
+  DecodeUtf8Into(text, as_string);
+
+  const std::vector<char32_t> as_vector = DecodeUtf8(text);
+  EXPECT_EQ(std::vector<char32_t>(as_string.begin(), as_string.end()),
+            as_vector);
+}
+
+TEST(Utf8Codec, AgreesWithIcuOnRandomText) {
+  std::mt19937 random(20241018);
+  std::vector<char32_t> decoded;
+  for (int round = 0; round < 5000; ++round) {
+    const std::string text = RandomText(random);
+
+    DecodeUtf8Into(text, decoded);
+
+    ASSERT_EQ(decoded, DecodeWithIcu(text)) << "round " << round;
+  }
+}
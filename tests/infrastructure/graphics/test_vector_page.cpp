@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <sstream>
+#include <string>
+
+#include "infrastructure/graphics/vector_page.hpp"
+
+// The SVG the vector export writes: the page's size in millimetres, items in
+// order, frames with their hole cut out, text escaped, and what draws nothing
+// left out.
+
+namespace {
+
+using vector_page::Page;
+using vector_page::PageBox;
+
+const glm::vec4 kBlack(0.0F, 0.0F, 0.0F, 1.0F);
+
+std::string Svg(const Page& page) {
+  std::ostringstream out;
+  vector_page::WriteSvg(page, out);
+  return out.str();
+}
+
+Page A4Landscape() {
+  Page page;
+  page.width = 297.0F;
+  page.height = 210.0F;
+  return page;
+}
+
+}  // namespace
+
+TEST(VectorPage, DocumentIsSizedInMillimetres) {
+  const std::string svg = Svg(A4Landscape());
+
+  EXPECT_NE(
+      svg.find("width=\"297mm\" height=\"210mm\" viewBox=\"0 0 297 210\""),
+      std::string::npos);
+  EXPECT_NE(svg.find("</svg>"), std::string::npos);
+}
+
+TEST(VectorPage, RectanglesCarryColourAndOpacity) {
+  Page page = A4Landscape();
+  page.items.push_back(vector_page::Rectangle(
+      PageBox{.left = 10.0F, .top = 20.5F, .right = 30.0F, .bottom = 40.0F},
+      glm::vec4(1.0F, 0.5F, 0.0F, 0.25F)));
+  const std::string svg = Svg(page);
+
+  EXPECT_NE(svg.find("<rect x=\"10\" y=\"20.5\" width=\"20\" height=\"19.5\" "
+                     "fill=\"#ff8000\" fill-opacity=\"0.25\"/>"),
+            std::string::npos);
+}
+
+TEST(VectorPage, FramesCutTheirHoleEvenOdd) {
+  Page page = A4Landscape();
+  page.items.push_back(vector_page::Frame(
+      PageBox{.left = 0.0F, .top = 0.0F, .right = 10.0F, .bottom = 10.0F},
+      PageBox{.left = 1.0F, .top = 1.0F, .right = 9.0F, .bottom = 9.0F},
+      kBlack));
+  const std::string svg = Svg(page);
+
+  EXPECT_NE(svg.find("<path d=\"M0 0H10V10H0ZM1 1H9V9H1Z\" "
+                     "fill-rule=\"evenodd\" fill=\"#000000\"/>"),
+            std::string::npos);
+}
+
+// An outline wider than its box leaves no hole: the frame covers the box.
+TEST(VectorPage, FramesWithoutHoleFillTheirBox) {
+  Page page = A4Landscape();
+  page.items.push_back(vector_page::Frame(
+      PageBox{.left = 0.0F, .top = 0.0F, .right = 2.0F, .bottom = 2.0F},
+      PageBox{.left = 1.5F, .top = 1.5F, .right = 0.5F, .bottom = 0.5F},
+      kBlack));
+  const std::string svg = Svg(page);
+
+  EXPECT_EQ(svg.find("<path"), std::string::npos);
+  EXPECT_NE(svg.find("<rect x=\"0\" y=\"0\" width=\"2\" height=\"2\""),
+            std::string::npos);
+}
+
+TEST(VectorPage, TextIsEscapedAndNamesItsFont) {
+  Page page = A4Landscape();
+  page.fonts.push_back(
+      vector_page::PageFont{.family = "DejaVu Sans", .file_path = ""});
+  page.items.push_back(vector_page::Text("Q1 <R&D> \"fix\"",
+                                         glm::vec2(5.0F, 12.25F), 4.0F, 0,
+                                         kBlack));
+  const std::string svg = Svg(page);
+
+  EXPECT_NE(svg.find("<text x=\"5\" y=\"12.25\" font-size=\"4\" "
+                     "font-family=\"'DejaVu Sans', sans-serif\" "
+                     "fill=\"#000000\" xml:space=\"preserve\">"
+                     "Q1 &lt;R&amp;D&gt; &quot;fix&quot;</text>"),
+            std::string::npos);
+}
+
+// Transparent items, empty boxes and blank text draw nothing and are not
+// written.
+TEST(VectorPage, InvisibleItemsAreLeftOut) {
+  Page page = A4Landscape();
+  page.items.push_back(vector_page::Rectangle(
+      PageBox{.left = 0.0F, .top = 0.0F, .right = 1.0F, .bottom = 1.0F},
+      glm::vec4(0.0F)));
+  page.items.push_back(vector_page::Rectangle(
+      PageBox{.left = 3.0F, .top = 0.0F, .right = 2.0F, .bottom = 1.0F},
+      kBlack));
+  page.items.push_back(
+      vector_page::Text("", glm::vec2(0.0F), 4.0F, 0, kBlack));
+  const std::string svg = Svg(page);
+
+  EXPECT_EQ(svg.find("<rect"), std::string::npos);
+  EXPECT_EQ(svg.find("<text"), std::string::npos);
+}
+
+TEST(VectorPage, ItemsKeepTheirOrder) {
+  Page page = A4Landscape();
+  const PageBox box{.left = 0.0F, .top = 0.0F, .right = 1.0F, .bottom = 1.0F};
+  page.items.push_back(
+      vector_page::Rectangle(box, glm::vec4(1.0F, 0.0F, 0.0F, 1.0F)));
+  page.items.push_back(
+      vector_page::Rectangle(box, glm::vec4(0.0F, 0.0F, 1.0F, 1.0F)));
+  const std::string svg = Svg(page);
+
+  EXPECT_LT(svg.find("#ff0000"), svg.find("#0000ff"));
+}
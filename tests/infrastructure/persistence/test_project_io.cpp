@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <fstream>
+#include <iterator>
 #include <optional>
 #include <string>
 #include <vector>
@@ -120,3 +121,25 @@ TEST(ProjectIoTest, RoundTripSucceedsWithoutError) {
   EXPECT_EQ(target.date_entries.Get().Items()[0].GetDateInterval().Begin(),
             Date::FromYmd(2030, 1, 1));
 }
+
+// The export cache hashes this string, so it has to be the saved file to the
+// byte and come out the same for the same state.
+TEST(ProjectIoTest, ProjectXmlIsTheSavedFile) {
+  ProjectStores stores;
+  SeedProject(stores);
+  const std::string path = TempXmlPath("decade_canonical.xml");
+  ASSERT_FALSE(Save(path, stores).has_value());
+  std::ifstream file(path);
+  const std::string saved((std::istreambuf_iterator<char>(file)),
+                          std::istreambuf_iterator<char>());
+
+  const auto xml = [](const ProjectStores& s) {
+    return persistence::ProjectXml(s.date_groups, s.date_entries,
+                                   s.page_setup, s.title_config,
+                                   s.shape_configuration,
+                                   s.calendar_configuration);
+  };
+  EXPECT_EQ(xml(stores), saved);
+  EXPECT_EQ(xml(stores), xml(stores));
+  EXPECT_NE(xml(ProjectStores{}), saved);
+}